@@ -29,6 +29,7 @@ option(ENABLE_AVX    "Enable compile-time AVX support."    ON)
 option(ENABLE_AVX2   "Enable compile-time AVX2 support."   ON)
 option(ENABLE_FMA    "Enable compile-time FMA support."    ON)
 option(ENABLE_AVX512 "Enable compile-time AVX512 support." ON)
+option(ENABLE_PCLMUL "Enable compile-time PCLMULQDQ support." ON)
 
 if (ENABLE_SSE)
     #
@@ -203,8 +204,31 @@ if (ENABLE_SSE)
             message(STATUS "This is a skylake-avx512 CPU, as AVX512 was disabled the architecture will be set to skylake")
         endif ()
     endif()
+    if (ENABLE_PCLMUL)
 
+        #
+        # Check compiler for carry-less multiply intrinsics
+        #
+        if (CMAKE_COMPILER_IS_GNUCC OR (CMAKE_C_COMPILER_ID MATCHES "Clang") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+            set(CMAKE_REQUIRED_FLAGS "-msse4.1 -mpclmul")
+            check_c_source_runs("
+            #include <immintrin.h>
+            int main()
+            {
+              __m128i a = _mm_set_epi64x(0, 0x3);
+              __m128i b = _mm_set_epi64x(0, 0x5);
+              __m128i c = _mm_clmulepi64_si128(a, b, 0x00);
+              // (x + 1) * (x^2 + 1) = x^3 + x^2 + x + 1
+              return (_mm_cvtsi128_si32(c) == 0xF) ? 0 : -1;
+            }"
+                    HAVE_PCLMUL)
+        endif()
+
+        if (HAVE_PCLMUL)
+            message(STATUS "PCLMULQDQ is enabled - it is only used when the CPU supports it")
+        endif()
+    endif()
 
 endif()
 
-mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512)
+mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512, HAVE_PCLMUL)
@@ -0,0 +1,270 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include "srsran/support/srsran_assert.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Open-addressing hash map with linear probing, meant for hot-path lookups keyed by integer IDs (TEIDs, IPs, RNTIs).
+ * Slots are stored contiguously, so a lookup usually touches a single cache line. The table grows by a factor of two
+ * whenever the load factor exceeds 1/2. Keys are spread with Fibonacci hashing, so keys that only differ in their
+ * upper bits (e.g. IPv4 addresses in network byte order) still land in different slots.
+ * Erasure uses backward-shift deletion (no tombstones), which invalidates iterators and references to other elements.
+ * @tparam K unsigned integer key type
+ * @tparam T mapped type. Must be default constructible and movable
+ */
+template <typename K, typename T>
+class flat_hash_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+  using obj_t = std::pair<K, T>;
+
+  static const size_t min_capacity = 16;
+
+public:
+  using key_type        = K;
+  using mapped_type     = T;
+  using value_type      = std::pair<K, T>;
+  using difference_type = std::ptrdiff_t;
+
+  template <typename MapPtr, typename Obj>
+  class iter_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Obj;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+
+    iter_impl() = default;
+    iter_impl(MapPtr map, size_t idx_) : ptr(map), idx(idx_)
+    {
+      if (idx < ptr->capacity() and not ptr->used[idx]) {
+        ++(*this);
+      }
+    }
+
+    iter_impl& operator++()
+    {
+      while (++idx < ptr->capacity() and not ptr->used[idx]) {
+      }
+      return *this;
+    }
+
+    reference operator*() const
+    {
+      srsran_assert(idx < ptr->capacity(), "Iterator out-of-bounds (%zd >= %zd)", idx, ptr->capacity());
+      return ptr->slots[idx];
+    }
+    pointer operator->() const
+    {
+      srsran_assert(idx < ptr->capacity(), "Iterator out-of-bounds (%zd >= %zd)", idx, ptr->capacity());
+      return &ptr->slots[idx];
+    }
+
+    bool operator==(const iter_impl& other) const { return ptr == other.ptr and idx == other.idx; }
+    bool operator!=(const iter_impl& other) const { return not(*this == other); }
+
+  private:
+    friend class flat_hash_map<K, T>;
+    MapPtr ptr = nullptr;
+    size_t idx = 0;
+  };
+  using iterator       = iter_impl<flat_hash_map<K, T>*, obj_t>;
+  using const_iterator = iter_impl<const flat_hash_map<K, T>*, const obj_t>;
+
+  explicit flat_hash_map(size_t initial_capacity = min_capacity) { rehash(initial_capacity); }
+
+  bool contains(K id) const { return find_idx(id) < capacity(); }
+
+  size_t count(K id) const { return contains(id) ? 1 : 0; }
+
+  iterator find(K id) { return iterator(this, find_idx(id)); }
+
+  const_iterator find(K id) const { return const_iterator(this, find_idx(id)); }
+
+  /// Inserts a new element. Returns the position of the element with key "id" and whether the insertion took place.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(K id, Args&&... args)
+  {
+    size_t idx = find_idx(id);
+    if (idx < capacity()) {
+      return std::make_pair(iterator(this, idx), false);
+    }
+    if ((nof_elems + 1) * 2 > capacity()) {
+      rehash(capacity() * 2);
+    }
+    idx               = free_slot(id);
+    slots[idx].first  = id;
+    slots[idx].second = T(std::forward<Args>(args)...);
+    used[idx]         = true;
+    nof_elems++;
+    return std::make_pair(iterator(this, idx), true);
+  }
+
+  std::pair<iterator, bool> insert(const value_type& obj) { return emplace(obj.first, obj.second); }
+  std::pair<iterator, bool> insert(value_type&& obj) { return emplace(obj.first, std::move(obj.second)); }
+
+  /// Returns the element with key "id", default-constructing it if not present
+  T& operator[](K id) { return emplace(id).first->second; }
+
+  T& at(K id)
+  {
+    size_t idx = find_idx(id);
+    srsran_assert(idx < capacity(), "Accessing non-existent ID=%zd", (size_t)id);
+    return slots[idx].second;
+  }
+  const T& at(K id) const
+  {
+    size_t idx = find_idx(id);
+    srsran_assert(idx < capacity(), "Accessing non-existent ID=%zd", (size_t)id);
+    return slots[idx].second;
+  }
+
+  size_t erase(K id)
+  {
+    size_t idx = find_idx(id);
+    if (idx >= capacity()) {
+      return 0;
+    }
+    erase_idx(idx);
+    return 1;
+  }
+
+  /// Erases the element pointed by "it". Since elements may shift backwards, the returned iterator might still point
+  /// to the same slot. Erasing while iterating may visit an element twice if its probe sequence wraps around.
+  iterator erase(iterator it)
+  {
+    srsran_assert(it.idx < capacity() and it.ptr == this, "Iterator out-of-bounds (%zd >= %zd)", it.idx, capacity());
+    erase_idx(it.idx);
+    return iterator(this, it.idx);
+  }
+
+  void clear()
+  {
+    for (size_t i = 0; i < capacity(); ++i) {
+      if (used[i]) {
+        used[i]  = false;
+        slots[i] = obj_t{};
+      }
+    }
+    nof_elems = 0;
+  }
+
+  /// Ensures "n" elements can be stored without rehashing
+  void reserve(size_t n)
+  {
+    if (n * 2 > capacity()) {
+      rehash(n * 2);
+    }
+  }
+
+  size_t size() const { return nof_elems; }
+  bool   empty() const { return nof_elems == 0; }
+  size_t capacity() const { return slots.size(); }
+
+  iterator       begin() { return iterator(this, 0); }
+  iterator       end() { return iterator(this, capacity()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity()); }
+
+private:
+  size_t home_slot(K id) const { return (size_t)(((uint64_t)id * 0x9E3779B97F4A7C15ULL) >> hash_shift); }
+  size_t next_slot(size_t idx) const { return (idx + 1) & (capacity() - 1); }
+
+  /// Returns slot index of "id" or capacity() if not present
+  size_t find_idx(K id) const
+  {
+    for (size_t idx = home_slot(id); used[idx]; idx = next_slot(idx)) {
+      if (slots[idx].first == id) {
+        return idx;
+      }
+    }
+    return capacity();
+  }
+
+  size_t free_slot(K id) const
+  {
+    size_t idx = home_slot(id);
+    while (used[idx]) {
+      idx = next_slot(idx);
+    }
+    return idx;
+  }
+
+  void erase_idx(size_t hole)
+  {
+    // Backward-shift deletion: move back any element of the following cluster whose home slot is not between the
+    // hole and its current position
+    size_t idx = next_slot(hole);
+    for (; used[idx]; idx = next_slot(idx)) {
+      size_t home = home_slot(slots[idx].first);
+      if (((idx - home) & (capacity() - 1)) >= ((idx - hole) & (capacity() - 1))) {
+        slots[hole] = std::move(slots[idx]);
+        hole        = idx;
+      }
+    }
+    used[hole]  = false;
+    slots[hole] = obj_t{};
+    nof_elems--;
+  }
+
+  void rehash(size_t new_capacity)
+  {
+    size_t   cap      = min_capacity;
+    uint32_t log2_cap = 4;
+    while (cap < new_capacity) {
+      cap <<= 1U;
+      log2_cap++;
+    }
+    std::vector<obj_t>   old_slots(cap);
+    std::vector<uint8_t> old_used(cap, false);
+    std::swap(old_slots, slots);
+    std::swap(old_used, used);
+    hash_shift = 64 - log2_cap;
+    for (size_t i = 0; i < old_slots.size(); ++i) {
+      if (old_used[i]) {
+        size_t idx = free_slot(old_slots[i].first);
+        slots[idx] = std::move(old_slots[i]);
+        used[idx]  = true;
+      }
+    }
+  }
+
+  std::vector<obj_t>   slots;
+  std::vector<uint8_t> used;
+  size_t               nof_elems  = 0;
+  uint32_t             hash_shift = 64;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
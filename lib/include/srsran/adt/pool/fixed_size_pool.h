@@ -24,6 +24,8 @@
 
 #include "memblock_cache.h"
 #include "srsran/adt/circular_buffer.h"
+#include <algorithm>
+#include <atomic>
 #include <thread>
 
 namespace srsran {
@@ -36,6 +38,9 @@ namespace srsran {
  * Since there is no stealing of blocks between workers, it is possible that a worker can't allocate while another
  * worker still has blocks in its own cache. To minimize the impact of this event, an upper bound is place on a worker
  * thread cache size. Once a worker reaches that upper bound, it sends half of its stored blocks to the central cache.
+ * Workers that only deallocate (e.g. a stack thread freeing buffers allocated by the socket thread) do not need a
+ * local cache, so they hand their blocks back to the central cache in batches of batch_steal_size.
+ * Blocks are not zero-initialized when handed to a worker.
  * Note: Taking into account the usage of thread_local, this class is made a singleton
  * Note2: No considerations were made regarding false sharing between threads. It is assumed that the blocks are big
  *        enough to fill a cache line.
@@ -62,7 +67,7 @@ class concurrent_fixed_memory_pool
     std::lock_guard<std::mutex> lock(mutex);
     allocated_blocks.resize(nof_objects_);
     for (std::unique_ptr<obj_storage_t>& b : allocated_blocks) {
-      b.reset(new obj_storage_t());
+      b.reset(new obj_storage_t);
       srsran_assert(b.get() != nullptr, "Failed to instantiate fixed memory pool");
       central_mem_cache.push(static_cast<void*>(b.get()));
     }
@@ -103,11 +108,12 @@ public:
       std::array<void*, batch_steal_size> popped_blocks;
       size_t                              n = central_mem_cache.try_pop(popped_blocks);
       for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
-        worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
+        worker_ctxt->cache.push(popped_blocks[i]);
       }
       node = worker_ctxt->cache.try_pop();
     }
+    worker_ctxt->nof_allocs_since_flush++;
+    worker_ctxt->update_cache_size();
 
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     if (node == nullptr) {
@@ -135,10 +141,27 @@ public:
     // push to local memory block cache
     worker_ctxt->cache.push(static_cast<void*>(p));
 
-    if (worker_ctxt->cache.size() >= local_growth_thres) {
+    if (worker_ctxt->nof_allocs_since_flush == 0 and worker_ctxt->cache.size() >= batch_steal_size) {
+      // this worker does not allocate blocks from its cache. Return them to the central cache, where they can be
+      // picked by the allocating workers
+      central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size());
+    } else if (worker_ctxt->cache.size() >= local_growth_thres) {
       // if local cache reached max capacity, send half of the blocks to central cache
       central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size() / 2);
+      worker_ctxt->nof_allocs_since_flush = 0;
     }
+    worker_ctxt->update_cache_size();
+  }
+
+  /// Number of blocks that are currently not allocated (central cache + worker local caches).
+  size_t nof_free_blocks()
+  {
+    size_t                      nof_free = central_mem_cache.size();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::atomic<size_t>* cache_size : worker_cache_sizes) {
+      nof_free += cache_size->load(std::memory_order_relaxed);
+    }
+    return nof_free;
   }
 
   void enable_logger(bool enabled)
@@ -170,12 +193,27 @@ private:
     std::thread::id    id;
     free_memblock_list cache;
 
-    worker_ctxt() : id(std::this_thread::get_id()) {}
+    /// Number of allocations made by this worker since it last returned blocks to the central cache
+    size_t nof_allocs_since_flush = 0;
+    /// Copy of cache.size() that can be read by other threads for metrics purposes
+    std::atomic<size_t> cache_size{0};
+
+    worker_ctxt() : id(std::this_thread::get_id())
+    {
+      pool_type*                  pool = pool_type::get_instance();
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      pool->worker_cache_sizes.push_back(&cache_size);
+    }
     ~worker_ctxt()
     {
-      concurrent_free_memblock_list& central_cache = pool_type::get_instance()->central_mem_cache;
-      central_cache.steal_blocks(cache, cache.size());
+      pool_type* pool = pool_type::get_instance();
+      pool->central_mem_cache.steal_blocks(cache, cache.size());
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      pool->worker_cache_sizes.erase(
+          std::find(pool->worker_cache_sizes.begin(), pool->worker_cache_sizes.end(), &cache_size));
     }
+
+    void update_cache_size() { cache_size.store(cache.size(), std::memory_order_relaxed); }
   };
 
   worker_ctxt* get_worker_cache()
@@ -201,6 +239,7 @@ private:
   concurrent_free_memblock_list                central_mem_cache;
   std::mutex                                   mutex;
   std::vector<std::unique_ptr<obj_storage_t> > allocated_blocks;
+  std::vector<const std::atomic<size_t>*>      worker_cache_sizes;
 };
 
 } // namespace srsran
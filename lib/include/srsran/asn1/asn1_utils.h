@@ -29,7 +29,10 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace asn1 {
 
@@ -42,6 +45,12 @@ constexpr Integer ceil_frac(Integer n, Integer d)
   return (n + (d - 1)) / d;
 }
 
+/// Number of bits required to represent "n" different values, i.e. ceil(log2(n))
+inline uint32_t ceil_log2(uint32_t n)
+{
+  return (n <= 1) ? 0 : 32u - (uint32_t)__builtin_clz(n - 1);
+}
+
 template <std::size_t arg1, std::size_t... others>
 struct static_max;
 
@@ -185,6 +194,92 @@ public:
   SRSASN_CODE align_bytes_zero();
 };
 
+/*********************
+     unpack arena
+*********************/
+
+/**
+ * Monotonic allocator for the storage of the dyn_arrays (sequences of, octet strings...) allocated while an
+ * unpack_arena_scope is active in the calling thread. It is meant to be used per decoded message, so that the
+ * allocations of a message are served from a few blocks that are reused by the next message after reset().
+ * The objects allocated from the arena must be destroyed before reset() is called. copy_ptr keeps allocating from
+ * the heap, as its ownership can be moved to longer lived objects.
+ */
+class unpack_arena
+{
+public:
+  explicit unpack_arena(std::size_t block_size_ = 16384) : block_size(block_size_) {}
+  unpack_arena(const unpack_arena&) = delete;
+  unpack_arena& operator=(const unpack_arena&) = delete;
+
+  void* allocate(std::size_t nof_bytes, std::size_t align)
+  {
+    std::size_t offset = (cur_offset + align - 1) & ~(align - 1);
+    if (cur_block < blocks.size() and offset + nof_bytes <= blocks[cur_block].size) {
+      cur_offset = offset + nof_bytes;
+      nof_bytes_used += nof_bytes;
+      return blocks[cur_block].data.get() + offset;
+    }
+    return allocate_new_block(nof_bytes);
+  }
+
+  /// Makes all the memory of the arena available again. The blocks are kept for the next messages
+  void reset()
+  {
+    cur_block      = 0;
+    cur_offset     = 0;
+    nof_bytes_used = 0;
+  }
+
+  std::size_t nof_bytes_allocated() const { return nof_bytes_used; }
+  std::size_t nof_blocks() const { return blocks.size(); }
+
+private:
+  struct block_t {
+    std::unique_ptr<uint8_t[]> data;
+    std::size_t                size;
+  };
+
+  void* allocate_new_block(std::size_t nof_bytes);
+
+  std::size_t          block_size;
+  std::vector<block_t> blocks;
+  std::size_t          cur_block      = 0;
+  std::size_t          cur_offset     = 0;
+  std::size_t          nof_bytes_used = 0;
+};
+
+/// Arena used by the ASN.1 containers of the calling thread, or nullptr to use the heap
+inline unpack_arena*& current_unpack_arena()
+{
+  static thread_local unpack_arena* arena = nullptr;
+  return arena;
+}
+
+/// Makes the containers created or resized by the calling thread allocate from an arena during its lifetime
+class unpack_arena_scope
+{
+public:
+  explicit unpack_arena_scope(unpack_arena& arena) : prev_arena(current_unpack_arena())
+  {
+    current_unpack_arena() = &arena;
+  }
+  unpack_arena_scope(const unpack_arena_scope&) = delete;
+  unpack_arena_scope& operator=(const unpack_arena_scope&) = delete;
+  ~unpack_arena_scope() { current_unpack_arena() = prev_arena; }
+
+private:
+  unpack_arena* prev_arena;
+};
+
+/// Unpacks a message allocating its containers from an arena. The message must be destroyed before the arena is reset
+template <class Msg>
+SRSASN_CODE unpack_with_arena(Msg& msg, cbit_ref& bref, unpack_arena& arena)
+{
+  unpack_arena_scope scope(arena);
+  return msg.unpack(bref);
+}
+
 /*********************
   function helpers
 *********************/
@@ -197,27 +292,22 @@ public:
   using const_iterator = const T*;
 
   dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  explicit dyn_array(uint32_t new_size) : size_(new_size) { data_ = allocate_(new_size, cap_); }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
-    cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = allocate_(nof_items, cap_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
+      cap_  = nof_items;
     }
   }
-  ~dyn_array()
-  {
-    if (data_ != NULL) {
-      delete[] data_;
-    }
-  }
+  ~dyn_array() { deallocate_(data_, cap_); }
   uint32_t      size() const { return size_; }
-  uint32_t      capacity() const { return cap_; }
+  uint32_t      capacity() const { return cap_ & ~arena_flag; }
   T&            operator[](uint32_t idx) { return data_[idx]; }
   const T&      operator[](uint32_t idx) const { return data_[idx]; }
   dyn_array<T>& operator=(const dyn_array<T>& other)
@@ -234,7 +324,7 @@ public:
     if (new_size == size_) {
       return;
     }
-    if (cap_ >= new_size) {
+    if (capacity() >= new_size) {
       if (new_size > size_) {
         std::fill(data_ + size_, data_ + new_size, T());
       }
@@ -242,18 +332,19 @@ public:
       return;
     }
 
-    new_cap     = new_size > new_cap ? new_size : new_cap;
-    T* new_data = nullptr;
+    new_cap              = new_size > new_cap ? new_size : new_cap;
+    T*       new_data    = nullptr;
+    uint32_t new_cap_tag = new_cap;
     if (new_cap > 0) {
-      new_data = new T[new_cap];
+      new_data = allocate_(new_cap, new_cap_tag);
       if (data_ != nullptr) {
         unsigned min_size = std::min(size_, new_size);
         std::move(data_, data_ + min_size, new_data);
       }
     }
-    cap_  = new_cap;
+    deallocate_(data_, cap_);
+    cap_  = new_cap_tag;
     size_ = new_size;
-    delete[] data_;
     data_ = new_data;
   }
   iterator erase(iterator it)
@@ -288,6 +379,39 @@ public:
   const_iterator end() const { return &data_[size()]; }
 
 private:
+  /// Set in cap_ when the storage belongs to an unpack_arena, and therefore must not be deleted
+  static const uint32_t arena_flag = 1u << 31u;
+
+  static T* allocate_(uint32_t n, uint32_t& cap_tag)
+  {
+    unpack_arena* arena = current_unpack_arena();
+    if (arena == nullptr) {
+      cap_tag = n;
+      return new T[n];
+    }
+    T* ptr = static_cast<T*>(arena->allocate(sizeof(T) * n, alignof(T)));
+    for (uint32_t i = 0; i < n; ++i) {
+      new (ptr + i) T;
+    }
+    cap_tag = n | arena_flag;
+    return ptr;
+  }
+  static void deallocate_(T* ptr, uint32_t cap_tag)
+  {
+    if (ptr == nullptr) {
+      return;
+    }
+    if ((cap_tag & arena_flag) == 0) {
+      delete[] ptr;
+      return;
+    }
+    if (not std::is_trivially_destructible<T>::value) {
+      for (uint32_t i = 0; i < (cap_tag & ~arena_flag); ++i) {
+        ptr[i].~T();
+      }
+    }
+  }
+
   T*       data_ = nullptr;
   uint32_t size_ = 0;
   uint32_t cap_  = 0;
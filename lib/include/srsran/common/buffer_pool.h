@@ -25,6 +25,8 @@
 #include "byte_buffer.h"
 #include "srsran/adt/bounded_vector.h"
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <map>
 #include <pthread.h>
 #include <stack>
@@ -166,8 +168,39 @@ private:
   uint32_t               capacity;
 };
 
+namespace detail {
+
+/// Header prepended to every byte buffer allocated from the byte buffer pools. It stores the buffer size class
+constexpr size_t byte_buffer_tag_size = alignof(max_alignment_t);
+
+constexpr size_t byte_buffer_block_size(byte_buffer_size_class size_class)
+{
+  return byte_buffer_tag_size + (size_class == byte_buffer_size_class::large
+                                     ? sizeof(byte_buffer_t)
+                                     : offsetof(byte_buffer_t, buffer) + byte_buffer_class_capacity(size_class));
+}
+
+} // namespace detail
+
+/// Type of the byte buffer pool of a given size class
+template <byte_buffer_size_class SizeClass>
+using byte_buffer_class_pool = concurrent_fixed_memory_pool<detail::byte_buffer_block_size(SizeClass)>;
+
 /// Type of global byte buffer pool
-using byte_buffer_pool = concurrent_fixed_memory_pool<sizeof(byte_buffer_t)>;
+using byte_buffer_pool = byte_buffer_class_pool<byte_buffer_size_class::large>;
+
+/// Occupancy of the byte buffer pools, per size class
+struct byte_buffer_pool_metrics_t {
+  struct class_metrics_t {
+    uint32_t payload_size    = 0;
+    uint32_t block_size      = 0;
+    uint32_t nof_blocks      = 0;
+    uint32_t nof_free_blocks = 0;
+  };
+  std::array<class_metrics_t, (size_t)byte_buffer_size_class::nof_classes> classes;
+};
+
+byte_buffer_pool_metrics_t get_byte_buffer_pool_metrics();
 
 /// Function used to generate unique byte buffers
 inline unique_byte_buffer_t make_byte_buffer() noexcept
@@ -180,21 +213,39 @@ inline unique_byte_buffer_t make_byte_buffer(uint32_t size, uint8_t value) noexc
   return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t(size, value));
 }
 
-inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
+/// Function used to generate unique byte buffers of a given size class
+inline unique_byte_buffer_t make_byte_buffer(byte_buffer_size_class size_class) noexcept
 {
-  std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
+  byte_buffer_t* buffer = new (size_class, std::nothrow) byte_buffer_t();
+  if (buffer != nullptr) {
+    buffer->buffer_capacity = byte_buffer_class_capacity(size_class);
+  }
+  return std::unique_ptr<byte_buffer_t>(buffer);
+}
+
+/// Function used to generate unique byte buffers of the smallest size class that fits "payload_size" bytes
+inline unique_byte_buffer_t make_sized_byte_buffer(uint32_t payload_size, const char* debug_ctxt) noexcept
+{
+  unique_byte_buffer_t buffer = make_byte_buffer(byte_buffer_select_class(payload_size));
   if (buffer == nullptr) {
     srslog::fetch_basic_logger("POOL").error("Failed to allocate byte buffer in %s", debug_ctxt);
   }
   return buffer;
 }
 
-inline unique_byte_buffer_t make_byte_buffer(const uint8_t* payload, uint32_t len, const char* debug_ctxt) noexcept
+inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
 {
   std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
   if (buffer == nullptr) {
     srslog::fetch_basic_logger("POOL").error("Failed to allocate byte buffer in %s", debug_ctxt);
-  } else {
+  }
+  return buffer;
+}
+
+inline unique_byte_buffer_t make_byte_buffer(const uint8_t* payload, uint32_t len, const char* debug_ctxt) noexcept
+{
+  unique_byte_buffer_t buffer = make_sized_byte_buffer(len, debug_ctxt);
+  if (buffer != nullptr) {
     if (buffer->get_tailroom() >= len) {
       memcpy(buffer->msg, payload, len);
       buffer->N_bytes = len;
@@ -24,11 +24,14 @@
 
 #include "common.h"
 #include "srsran/adt/span.h"
+#include "srsran/support/srsran_assert.h"
 #include <chrono>
 #include <cstdint>
 
 //#define SRSRAN_BUFFER_POOL_LOG_ENABLED
 #define SRSRAN_BUFFER_POOL_LOG_NAME_LEN 128
+/// Minimum tailroom left after the payload when selecting the size class of a byte buffer
+#define SRSRAN_BYTE_BUFFER_TAILROOM_RESERVE 32
 
 namespace srsran {
 
@@ -83,9 +86,19 @@ private:
  * Byte buffer
  *
  * Generic byte buffer with headroom to accommodate packet headers and custom
- * copy constructors & assignment operators for quick copying. Byte buffer
- * holds a next pointer to support linked lists.
+ * copy constructors & assignment operators for quick copying.
+ * Byte buffers allocated from the byte buffer pools may only own a prefix of
+ * the "buffer" array, depending on their size class. For this reason, "buffer" is
+ * kept as the last member and get_tailroom() is derived from the buffer capacity.
  *****************************************************************************/
+
+/// Payload capacity of the byte buffer size classes (excluding headroom)
+#define SRSRAN_BYTE_BUFFER_SMALL_PAYLOAD_SIZE 256
+#define SRSRAN_BYTE_BUFFER_MEDIUM_PAYLOAD_SIZE 2048
+
+/// Size classes of byte buffers allocated from the byte buffer pools
+enum class byte_buffer_size_class : uint8_t { small = 0, medium, large, nof_classes };
+
 class byte_buffer_t
 {
 public:
@@ -93,8 +106,7 @@ public:
   using const_iterator = const uint8_t*;
 
   uint32_t N_bytes = 0;
-  uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
-  uint8_t* msg = nullptr;
+  uint8_t* msg     = nullptr;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
   char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
 #endif
@@ -104,6 +116,10 @@ public:
     buffer_latency_calc tp;
   } md;
 
+  /// Total number of bytes of "buffer" (headroom included) owned by this byte buffer
+  uint32_t buffer_capacity = SRSRAN_MAX_BUFFER_SIZE_BYTES;
+  uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+
   byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
   {
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
@@ -128,7 +144,16 @@ public:
     // avoid self assignment
     if (&buf == this)
       return *this;
-    msg     = &buffer[buf.msg - &(*buf.buffer)];
+    uint32_t headroom = buf.msg - &(*buf.buffer);
+    if (headroom + buf.N_bytes > buffer_capacity) {
+      // contents do not fit with the same headroom in a smaller size class
+      headroom = SRSRAN_BUFFER_HEADER_OFFSET;
+    }
+    srsran_assert(headroom + buf.N_bytes <= buffer_capacity,
+                  "Byte buffer with capacity=%d cannot hold %d bytes",
+                  buffer_capacity,
+                  buf.N_bytes);
+    msg     = &buffer[headroom];
     N_bytes = buf.N_bytes;
     md      = buf.md;
     memcpy(msg, buf.msg, N_bytes);
@@ -143,7 +168,7 @@ public:
   }
   uint32_t get_headroom() { return msg - buffer; }
   // Returns the remaining space from what is reported to be the length of msg
-  uint32_t                  get_tailroom() const { return (sizeof(buffer) - (msg - buffer) - N_bytes); }
+  uint32_t                  get_tailroom() const { return (buffer_capacity - (msg - buffer) - N_bytes); }
   std::chrono::microseconds get_latency_us() const { return md.tp.get_latency_us(); }
 
   std::chrono::high_resolution_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
@@ -169,13 +194,37 @@ public:
   iterator       end() { return msg + N_bytes; }
   const_iterator end() const { return msg + N_bytes; }
 
+  /// Allocates a byte buffer of the largest size class
   void* operator new(size_t sz);
   void* operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept;
+  /// Allocates a byte buffer of the given size class. The caller must set buffer_capacity accordingly
+  void* operator new(size_t sz, byte_buffer_size_class size_class, const std::nothrow_t& nothrow_value) noexcept;
   void* operator new[](size_t sz) = delete;
   void  operator delete(void* ptr);
+  void  operator delete(void* ptr, byte_buffer_size_class size_class, const std::nothrow_t& nothrow_value) noexcept;
   void  operator delete[](void* ptr) = delete;
 };
 
+/// Number of bytes of "buffer" (headroom included) owned by a byte buffer of a given size class
+constexpr uint32_t byte_buffer_class_capacity(byte_buffer_size_class size_class)
+{
+  return size_class == byte_buffer_size_class::small
+             ? SRSRAN_BUFFER_HEADER_OFFSET + SRSRAN_BYTE_BUFFER_SMALL_PAYLOAD_SIZE
+             : (size_class == byte_buffer_size_class::medium
+                    ? SRSRAN_BUFFER_HEADER_OFFSET + SRSRAN_BYTE_BUFFER_MEDIUM_PAYLOAD_SIZE
+                    : SRSRAN_MAX_BUFFER_SIZE_BYTES);
+}
+
+/// Smallest size class that fits a payload of "payload_size" bytes (plus some tailroom for trailers, e.g. MAC-I)
+constexpr byte_buffer_size_class byte_buffer_select_class(uint32_t payload_size)
+{
+  return payload_size + SRSRAN_BYTE_BUFFER_TAILROOM_RESERVE <= SRSRAN_BYTE_BUFFER_SMALL_PAYLOAD_SIZE
+             ? byte_buffer_size_class::small
+             : (payload_size + SRSRAN_BYTE_BUFFER_TAILROOM_RESERVE <= SRSRAN_BYTE_BUFFER_MEDIUM_PAYLOAD_SIZE
+                    ? byte_buffer_size_class::medium
+                    : byte_buffer_size_class::large);
+}
+
 struct bit_buffer_t {
   uint32_t N_bits = 0;
   uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BITS];
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         latency_histogram.h
+ *  Description:  Lock-free latency histograms for the stages of the TTI
+ *                pipeline. Every thread records into its own shard with
+ *                relaxed atomic increments, the metrics reader sums the
+ *                shards. Bins are log-linear: 4 bins per octave between
+ *                1.024 us and 16.8 ms, plus an underflow and an overflow bin.
+ *****************************************************************************/
+
+#ifndef SRSRAN_LATENCY_HISTOGRAM_H
+#define SRSRAN_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+namespace srsran {
+
+constexpr uint32_t LATENCY_HIST_NOF_OCTAVES     = 14;
+constexpr uint32_t LATENCY_HIST_BINS_PER_OCTAVE = 4;
+constexpr uint32_t LATENCY_HIST_MIN_NS_LOG2     = 10;
+constexpr uint32_t LATENCY_HIST_NOF_BINS        = LATENCY_HIST_NOF_OCTAVES * LATENCY_HIST_BINS_PER_OCTAVE + 2;
+
+/// Largest latency in nanoseconds counted by the i-th bin. The last bin is unbounded
+constexpr uint64_t latency_hist_bin_max_ns(uint32_t bin)
+{
+  return (bin == 0) ? (1ULL << LATENCY_HIST_MIN_NS_LOG2)
+                    : (uint64_t)(LATENCY_HIST_BINS_PER_OCTAVE + (bin - 1) % LATENCY_HIST_BINS_PER_OCTAVE + 1)
+                          << ((bin - 1) / LATENCY_HIST_BINS_PER_OCTAVE + LATENCY_HIST_MIN_NS_LOG2 - 2);
+}
+
+/// Index of the bin counting a latency of "latency_ns" nanoseconds
+inline uint32_t latency_hist_bin(uint64_t latency_ns)
+{
+  if (latency_ns < (1ULL << LATENCY_HIST_MIN_NS_LOG2)) {
+    return 0;
+  }
+  uint32_t msb    = 63 - __builtin_clzll(latency_ns);
+  uint32_t octave = msb - LATENCY_HIST_MIN_NS_LOG2;
+  if (octave >= LATENCY_HIST_NOF_OCTAVES) {
+    return LATENCY_HIST_NOF_BINS - 1;
+  }
+  return 1 + octave * LATENCY_HIST_BINS_PER_OCTAVE + ((latency_ns >> (msb - 2)) & 0x3U);
+}
+
+struct latency_hist_metrics_t {
+  uint64_t                                    count  = 0;
+  uint64_t                                    sum_ns = 0;
+  uint64_t                                    max_ns = 0;
+  std::array<uint64_t, LATENCY_HIST_NOF_BINS> bins   = {};
+
+  double mean_us() const { return (count > 0) ? (double)sum_ns / count / 1000.0 : 0.0; }
+  /// Upper bound of the bin holding the "quantile" (0 to 1) of the recorded latencies
+  double percentile_us(double quantile) const;
+};
+
+class latency_histogram
+{
+public:
+  /// Threads beyond this number share shards, which stays correct but may bounce cache lines
+  static constexpr uint32_t nof_shards = 16;
+
+  void record(std::chrono::nanoseconds latency)
+  {
+    uint64_t ns = latency.count() > 0 ? latency.count() : 0;
+    shard_t& s  = shards[get_shard_idx()];
+    s.count.fetch_add(1, std::memory_order_relaxed);
+    s.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    s.bins[latency_hist_bin(ns)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t cur_max = s.max_ns.load(std::memory_order_relaxed);
+    while (ns > cur_max and not s.max_ns.compare_exchange_weak(cur_max, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Sums the shards and clears them, so that every call returns the latencies recorded since the previous one
+  latency_hist_metrics_t read_metrics();
+
+private:
+  struct alignas(64) shard_t {
+    std::atomic<uint64_t>                                    count  = {0};
+    std::atomic<uint64_t>                                    sum_ns = {0};
+    std::atomic<uint64_t>                                    max_ns = {0};
+    std::array<std::atomic<uint64_t>, LATENCY_HIST_NOF_BINS> bins   = {};
+  };
+
+  static uint32_t get_shard_idx();
+
+  std::array<shard_t, nof_shards> shards;
+};
+
+/// Stages of the TTI pipeline with a latency histogram
+enum class tti_stage : uint32_t {
+  rx_wait = 0, ///< Time blocked waiting for the samples of the next subframe
+  fft,
+  chest,
+  dl_encode, ///< PDCCH, PDSCH, PHICH and PMCH encoding of one carrier
+  ul_decode, ///< PUCCH and PUSCH decoding of one carrier
+  mac_sched,
+  sf_proc, ///< Subframe processing of a PHY worker, from the start of the UL processing until the TX hand-over
+  radio_tx,
+  nof_stages
+};
+constexpr uint32_t NOF_TTI_STAGES = (uint32_t)tti_stage::nof_stages;
+
+const char* tti_stage_to_string(tti_stage stage);
+
+struct tti_latency_metrics_t {
+  std::array<latency_hist_metrics_t, NOF_TTI_STAGES> stages;
+};
+
+/// Histograms of the TTI pipeline shared by all the components of a process
+latency_histogram& get_tti_latency_histogram(tti_stage stage);
+
+/// Reads (and clears) the histograms of all the TTI pipeline stages
+tti_latency_metrics_t get_tti_latency_metrics();
+
+/// Records the time spent between construction and destruction into the histogram of a TTI pipeline stage
+class tti_latency_scope
+{
+public:
+  explicit tti_latency_scope(tti_stage stage) :
+    hist(get_tti_latency_histogram(stage)), t_start(std::chrono::steady_clock::now())
+  {}
+  tti_latency_scope(const tti_latency_scope&) = delete;
+  tti_latency_scope& operator=(const tti_latency_scope&) = delete;
+  ~tti_latency_scope() { hist.record(std::chrono::steady_clock::now() - t_start); }
+
+private:
+  latency_histogram&                    hist;
+  std::chrono::steady_clock::time_point t_start;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LATENCY_HISTOGRAM_H
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RX_SOCKET_HANDLER_H
 #define SRSRAN_RX_SOCKET_HANDLER_H
 
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/threads.h"
@@ -180,6 +181,21 @@ using sctp_recv_callback_t =
 /// Function signature for SDU byte buffers received from any sockaddr_in-based socket
 using recvfrom_callback_t = srsran::move_callback<void(srsran::unique_byte_buffer_t, const sockaddr_in&)>;
 
+/// Maximum number of datagrams read from a socket with a single recvmmsg(...) call
+constexpr uint32_t SOCKET_MAX_RX_BURST = 32;
+
+/// SDU byte buffer received from any sockaddr_in-based socket, and its source address
+struct rx_sdu_t {
+  srsran::unique_byte_buffer_t sdu;
+  sockaddr_in                  from;
+};
+
+/// Burst of SDUs received with a single recvmmsg(...) call
+using rx_sdu_burst_t = srsran::bounded_vector<rx_sdu_t, SOCKET_MAX_RX_BURST>;
+
+/// Function signature for bursts of SDU byte buffers received from any sockaddr_in-based socket
+using recvmmsg_callback_t = srsran::move_callback<void(rx_sdu_burst_t&)>;
+
 /**
  * Helper function that creates a callback that is called when a SCTP socket has data, and does the following tasks:
  * 1. receive SDU byte buffer from SCTP socket and associated metadata - sockaddr_in, sctp_sndrcvinfo, flags
@@ -200,6 +216,13 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but all the datagrams pending in the socket (up to SOCKET_MAX_RX_BURST) are read with a
+ * single recvmmsg(...) call into pre-allocated byte buffers, and dispatched into the "queue" as a single task
+ */
+socket_manager_itf::recv_callback_t
+make_sdu_burst_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvmmsg_callback_t rx_callback);
+
 inline socket_manager& get_rx_io_manager()
 {
   static socket_manager io;
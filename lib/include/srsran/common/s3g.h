@@ -101,4 +101,41 @@ void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
 uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length);
 
+/* Multi-buffer SNOW 3G.
+ * Up to S3G_MB_NOF_LANES independent keystreams are generated in parallel,
+ * one per lane. The state is stored lane-interleaved (structure of arrays),
+ * so that each LFSR/FSM word of all lanes can be processed at once with
+ * SIMD instructions (AVX2 gathers for the S-box lookups) when available.
+ * The S-boxes and the MULalpha/DIValpha multiplications are evaluated with
+ * pre-computed 32-bit tables.
+ */
+#define S3G_MB_NOF_LANES 8
+#define S3G_MB_NOF_WORDS 16
+
+typedef struct {
+  uint32_t lfsr[16][S3G_MB_NOF_LANES];
+  uint32_t fsm[3][S3G_MB_NOF_LANES];
+} S3G_MB_STATE;
+
+/* Initializes a single lane with the key k[4] and the IV iv[4], in the same
+ * format as s3g_initialize(). The keystream of the lane starts with z_1 on
+ * the next call to s3g_mb_generate_keystream(). The rest of lanes are not
+ * modified.
+ */
+void s3g_mb_initialize_lane(S3G_MB_STATE* state, uint32_t lane, const uint32_t k[4], const uint32_t iv[4]);
+
+/* Initializes the lanes set in lane_mask (bit l for lane l) with the keys
+ * k[l] and IVs iv[l]. When enough lanes are set, the lanes are initialized in
+ * parallel.
+ */
+void s3g_mb_initialize_lanes(S3G_MB_STATE* state, uint32_t lane_mask, const uint32_t k[][4], const uint32_t iv[][4]);
+
+/* Generates the next S3G_MB_NOF_WORDS keystream words of the lanes set in
+ * lane_mask (bit l for lane l). Lanes that are not set in the mask must be
+ * re-initialized before being used again. When few lanes are set, lanes are
+ * clocked one by one instead of in parallel.
+ * Output ks: word t of lane l is written in ks[t * S3G_MB_NOF_LANES + l].
+ */
+void s3g_mb_generate_keystream(S3G_MB_STATE* state, uint32_t lane_mask, uint32_t* ks);
+
 #endif // SRSRAN_S3G_H
\ No newline at end of file
@@ -26,6 +26,7 @@
  * Common security header - wraps ciphering/integrity check algorithms.
  *****************************************************************************/
 
+#include "srsran/adt/span.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
@@ -309,6 +310,26 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/// PDU of a ciphering burst. "msg_out" can be equal to "msg" for in-place ciphering
+struct cipher_burst_item_t {
+  const uint8_t* msg;
+  uint8_t*       msg_out;
+  uint32_t       msg_len; // In bytes
+  uint32_t       count;
+};
+
+/// Ciphers all PDUs of a burst of the same key, bearer and direction. The SNOW 3G/ZUC keystreams of up to 8 PDUs
+/// are generated in parallel lanes; a lane is re-initialized with the next PDU as soon as its PDU is complete
+int security_128_eea1_burst(const uint8_t*                  key,
+                            uint8_t                         bearer,
+                            uint8_t                         direction,
+                            span<const cipher_burst_item_t> items);
+
+int security_128_eea3_burst(const uint8_t*                  key,
+                            uint8_t                         bearer,
+                            uint8_t                         direction,
+                            span<const cipher_burst_item_t> items);
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SECURITY_AES_H
+#define SRSRAN_SECURITY_AES_H
+
+/******************************************************************************
+ * 128-EEA2/128-EIA2 with a pre-computed AES-128 key schedule.
+ *
+ * The key schedule and the CMAC subkeys K1/K2 are derived once per key (e.g.
+ * when a PDCP entity is configured) instead of once per PDU. When the build
+ * targets AES-NI (__AES__), blocks are encrypted with AES-NI, 8 counter blocks
+ * in flight. If VAES is also available, counter blocks are encrypted two per
+ * 256-bit register. Otherwise the mbedtls AES implementation is used.
+ *****************************************************************************/
+
+#include "srsran/adt/span.h"
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
+#include <cstdint>
+
+namespace srsran {
+
+class aes_128_key_schedule
+{
+public:
+  aes_128_key_schedule();
+  ~aes_128_key_schedule();
+  aes_128_key_schedule(const aes_128_key_schedule& other) = delete;
+  aes_128_key_schedule& operator=(const aes_128_key_schedule& other) = delete;
+
+  /// Expands the 16 byte key "key" and derives the CMAC subkeys
+  void set_key(const uint8_t* key);
+  void reset() { key_set = false; }
+  bool is_set() const { return key_set; }
+
+  /// Encrypts the 16 byte block "in" into "out"
+  void encrypt_block(const uint8_t* in, uint8_t* out) const;
+
+private:
+  friend struct aes_128_backend;
+
+#ifdef __AES__
+  alignas(16) uint8_t round_keys[11 * 16];
+#else
+  mutable aes_context ctx;
+#endif
+  uint8_t k1[16];
+  uint8_t k2[16];
+  bool    key_set = false;
+};
+
+/// Name of the AES backend selected at compile time ("VAES", "AES-NI" or "mbedtls")
+const char* security_aes_backend_name();
+
+int security_128_eia2(const aes_128_key_schedule& ks,
+                      uint32_t                    count,
+                      uint32_t                    bearer,
+                      uint8_t                     direction,
+                      const uint8_t*              msg,
+                      uint32_t                    msg_len,
+                      uint8_t*                    mac);
+
+int security_128_eea2(const aes_128_key_schedule& ks,
+                      uint32_t                    count,
+                      uint8_t                     bearer,
+                      uint8_t                     direction,
+                      const uint8_t*              msg,
+                      uint32_t                    msg_len,
+                      uint8_t*                    msg_out);
+
+/// Ciphers all PDUs of a burst of the same bearer and direction. Keystream blocks of consecutive PDUs are
+/// generated together, so short PDUs keep the AES pipeline as busy as long ones
+int security_128_eea2_burst(const aes_128_key_schedule&     ks,
+                            uint8_t                         bearer,
+                            uint8_t                         direction,
+                            span<const cipher_burst_item_t> items);
+
+} // namespace srsran
+
+#endif // SRSRAN_SECURITY_AES_H
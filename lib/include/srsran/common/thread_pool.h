@@ -34,6 +34,7 @@
 #include "srsran/srslog/srslog.h"
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -153,6 +154,91 @@ private:
   bool                                    running = false;
 };
 
+/**
+ * Fork-join pool of threads with one task queue per thread. Tasks are pushed into the queue of the calling thread and
+ * grouped by a task_group. Waiting on a group runs the tasks of the caller's queue (newest first) and, when it is
+ * empty, steals the oldest task of another queue. Idle pool threads steal as well. Threads not belonging to the pool
+ * get a queue assigned the first time they push a task; if there are more of them than "nof_ext_queues", they share
+ * the last one.
+ */
+class work_stealing_pool
+{
+  using task_t = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+
+public:
+  /// Set of tasks a thread waits for
+  class task_group
+  {
+  public:
+    uint32_t nof_pending() const { return pending.load(std::memory_order_acquire); }
+
+  private:
+    friend class work_stealing_pool;
+    std::atomic<uint32_t>   pending = {0};
+    std::mutex              mutex;
+    std::condition_variable cvar;
+  };
+
+  work_stealing_pool(uint32_t    nof_workers,
+                     uint32_t    nof_ext_queues,
+                     std::string name  = "STEAL",
+                     int32_t     prio_ = -1,
+                     uint32_t    mask_ = 255);
+  work_stealing_pool(const work_stealing_pool&) = delete;
+  work_stealing_pool(work_stealing_pool&&)      = delete;
+  work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+  work_stealing_pool& operator=(work_stealing_pool&&) = delete;
+  ~work_stealing_pool();
+  void stop();
+
+  void push_task(task_group& group, task_t&& task);
+  /// Runs or steals tasks until all tasks of the group have finished
+  void wait(task_group& group);
+
+  size_t   nof_workers() const { return workers.size(); }
+  uint64_t nof_stolen_tasks() const { return nof_stolen.load(std::memory_order_relaxed); }
+
+private:
+  struct task_item {
+    task_group* group = nullptr;
+    task_t      task;
+  };
+  struct task_queue {
+    std::mutex            mutex;
+    std::deque<task_item> tasks;
+  };
+
+  class worker_t : public thread
+  {
+  public:
+    worker_t(work_stealing_pool* parent_, uint32_t queue_idx_, const std::string& name_);
+    void stop() { wait_thread_finish(); }
+
+  private:
+    void run_thread() override;
+
+    work_stealing_pool* parent    = nullptr;
+    uint32_t            queue_idx = 0;
+  };
+
+  uint32_t get_queue_idx();
+  bool     pop_task(uint32_t queue_idx, task_item& item);
+  bool     steal_task(uint32_t thief_idx, task_item& item);
+  void     run_task(task_item& item);
+
+  int32_t                                   prio    = -1;
+  uint32_t                                  mask    = 255;
+  uint32_t                                  pool_id = 0;
+  std::vector<std::unique_ptr<task_queue> > queues;
+  std::vector<std::unique_ptr<worker_t> >   workers;
+  std::atomic<uint32_t>                     next_ext_queue = {0};
+  std::atomic<int32_t>                      nof_queued     = {0};
+  std::atomic<uint64_t>                     nof_stolen     = {0};
+  std::mutex                                idle_mutex;
+  std::condition_variable                   idle_cvar;
+  bool                                      running = true;
+};
+
 /// Class used to create a single worker with an input task queue with a single reader
 class task_worker : public thread
 {
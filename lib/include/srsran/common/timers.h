@@ -32,11 +32,15 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <inttypes.h>
 #include <limits>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -56,20 +60,26 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - time_wheel - hierarchical timing wheel with NOF_WHEEL_LEVELS levels of WHEEL_SIZE slots. The level of a running
+ *   timer is given by the most significant bit in which its timeout differs from the current time, and its slot by
+ *   the timeout bits of that level. The lowest level thus only holds timers that expire in the slot tic, and the
+ *   timers of the higher levels are cascaded down when the time reaches their slot. Starting and stopping a timer is
+ *   O(1), and each timer is cascaded at most NOF_WHEEL_LEVELS - 1 times before expiring.
+ * Threading:
+ * - The thread calling step_all() owns the wheel. Its accesses to the timers do not take any lock.
+ * - Other threads update the timer state atomically, so that the getters see the change straight away, and leave the
+ *   wheel update to the owner thread via a mutex protected list of pending commands, which the owner applies before
+ *   its next access or step. step_all() must always be called from the same thread.
  */
 class timer_handler
 {
-  using tic_diff_t                      = uint32_t;
-  using tic_t                           = uint32_t;
-  constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
-  constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
-  constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  using tic_diff_t                           = uint32_t;
+  using tic_t                                = uint32_t;
+  constexpr static uint32_t INVALID_ID       = std::numeric_limits<uint32_t>::max();
+  constexpr static size_t   WHEEL_SHIFT      = 8U;
+  constexpr static size_t   WHEEL_SIZE       = 1U << WHEEL_SHIFT;
+  constexpr static size_t   WHEEL_MASK       = WHEEL_SIZE - 1U;
+  constexpr static size_t   NOF_WHEEL_LEVELS = (sizeof(tic_t) * 8U) / WHEEL_SHIFT;
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -85,14 +95,56 @@ class timer_handler
     return mode_flag + (static_cast<uint64_t>(duration) << 32U) + timeout;
   }
 
-  struct timer_impl : public intrusive_double_linked_list_element<>, public intrusive_forward_list_element<> {
+  /// Node of the circular lists of the wheel slots. The slots are sentinel nodes, so that a timer can be unlinked
+  /// without knowing its slot
+  struct wheel_node {
+    wheel_node* prev = this;
+    wheel_node* next = this;
+
+    wheel_node() = default;
+    wheel_node(const wheel_node&) = delete;
+    wheel_node& operator=(const wheel_node&) = delete;
+
+    bool empty() const { return next == this; }
+    bool is_linked() const { return next != this; }
+    void push_back(wheel_node& node)
+    {
+      node.prev  = prev;
+      node.next  = this;
+      prev->next = &node;
+      prev       = &node;
+    }
+    void unlink()
+    {
+      prev->next = next;
+      next->prev = prev;
+      prev       = this;
+      next       = this;
+    }
+    /// Moves all the nodes of this list to the empty list "dest"
+    void move_to(wheel_node& dest)
+    {
+      if (empty()) {
+        return;
+      }
+      dest.next  = next;
+      dest.prev  = prev;
+      next->prev = &dest;
+      prev->next = &dest;
+      next       = this;
+      prev       = this;
+    }
+  };
+
+  struct timer_impl : public wheel_node, public intrusive_forward_list_element<> {
     // const
     const uint32_t id;
     timer_handler& parent;
     // writes protected by backend lock
     bool                                  allocated = false;
     std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
-    srsran::move_callback<void(uint32_t)> callback;
+    srsran::move_callback<void(uint32_t)> callback;          ///< only accessed by the owner thread
+    tic_t                                 wheel_timeout = 0; ///< timeout of the wheel slot, see update_timer_link_()
 
     explicit timer_impl(timer_handler& parent_, uint32_t id_) : parent(parent_), id(id_) {}
     timer_impl(const timer_impl&) = delete;
@@ -119,8 +171,7 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      set_(duration_);
+      parent.modify_timer_(*this, [this, duration_](uint64_t old_state) { return set_(old_state, duration_); });
     }
 
     void set(uint32_t duration_, srsran::move_callback<void(uint32_t)> callback_)
@@ -129,45 +180,46 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      set_(duration_);
-      callback = std::move(callback_);
+      parent.modify_timer_(
+          *this, [this, duration_](uint64_t old_state) { return set_(old_state, duration_); }, &callback_);
     }
 
     void run()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      parent.start_run_(*this);
+      parent.modify_timer_(*this, [this](uint64_t old_state) {
+        uint32_t duration = decode_duration(old_state);
+        return encode_state(RUNNING_FLAG, duration, parent.cur_time.load(std::memory_order_relaxed) + duration);
+      });
     }
 
     void stop()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
       // does not call callback
-      parent.stop_timer_(*this, false);
+      parent.modify_timer_(*this, [](uint64_t old_state) { return stop_state_(old_state, false); });
     }
 
-    void deallocate()
-    {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      parent.dealloc_timer_(*this);
-    }
+    void deallocate() { parent.dealloc_timer_(*this); }
 
   private:
-    void set_(uint32_t duration_)
+    uint64_t set_(uint64_t old_state, uint32_t duration_) const
     {
       duration_ = std::max(duration_, 1U); // the next step will be one place ahead of current one
-      // called in locked context
-      uint64_t old_state = state.load(std::memory_order_relaxed);
       if (decode_is_running(old_state)) {
         // if already running, just extends timer lifetime
-        parent.start_run_(*this, duration_);
-      } else {
-        state.store(encode_state(STOPPED_FLAG, duration_, 0), std::memory_order_relaxed);
+        return encode_state(RUNNING_FLAG, duration_, parent.cur_time.load(std::memory_order_relaxed) + duration_);
       }
+      return encode_state(STOPPED_FLAG, duration_, 0);
     }
   };
 
+  /// Wheel updates requested by threads other than the owner. As a timer can not be used after its release, the
+  /// commands can be applied in the order callbacks, wheel updates, releases
+  struct pending_cmds_t {
+    std::vector<std::pair<timer_impl*, srsran::move_callback<void(uint32_t)> > > callbacks;
+    std::vector<timer_impl*>                                                     updates;
+    std::vector<timer_impl*>                                                     releases;
+  };
+
 public:
   class unique_timer
   {
@@ -234,7 +286,6 @@ public:
 
   explicit timer_handler(uint32_t capacity = 64)
   {
-    time_wheel.resize(WHEEL_SIZE);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -248,39 +299,77 @@ public:
 
   void step_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
-
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
-
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
-          lock.unlock();
-
-          timer.callback(timer.id);
-
-          // Lock again to keep protecting the wheel
-          lock.lock();
+    std::thread::id self_id = std::this_thread::get_id();
+    if (owner_id.load(std::memory_order_relaxed) != self_id) {
+      srsran_assert(owner_id.load(std::memory_order_relaxed) == std::thread::id(),
+                    "timer_handler::step_all() called from more than one thread");
+      owner_id.store(self_id, std::memory_order_relaxed);
+    }
+    apply_pending_cmds_();
+
+    tic_t cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
+    wheel_time           = cur_time_local;
+    overdue_time         = cur_time_local;
+
+    // Cascade the timers of the higher level slots reached by the new time, starting from the highest level, as the
+    // timers may go down more than one level
+    for (size_t level = NOF_WHEEL_LEVELS - 1; level > 0; --level) {
+      if ((cur_time_local & ((1U << (level * WHEEL_SHIFT)) - 1U)) == 0) {
+        wheel_node cascaded;
+        time_wheel[level][(cur_time_local >> (level * WHEEL_SHIFT)) & WHEEL_MASK].move_to(cascaded);
+        while (not cascaded.empty()) {
+          relink_timer_(static_cast<timer_impl&>(*cascaded.next));
         }
       }
     }
 
+    // The timers are taken out of the slot before calling any callback, as callbacks may start or stop timers
+    wheel_node expiring;
+    time_wheel[0][cur_time_local & WHEEL_MASK].move_to(expiring);
+    overdue_time = cur_time_local + 1;
+    while (not expiring.empty()) {
+      timer_impl& timer = static_cast<timer_impl&>(*expiring.next);
+      timer.unlink();
+
+      uint64_t old_state = timer.state.load(std::memory_order_relaxed);
+      if (not decode_is_running(old_state)) {
+        continue;
+      }
+      // Timers updated by other threads stay in the wheel until the owner applies the update
+      if (static_cast<int32_t>(decode_timeout(old_state) - cur_time_local) > 0 or
+          not timer.state.compare_exchange_strong(
+              old_state,
+              encode_state(EXPIRED_FLAG, decode_duration(old_state), decode_timeout(old_state)),
+              std::memory_order_relaxed)) {
+        relink_timer_(timer);
+        continue;
+      }
+
+      // Call callback if configured
+      if (not timer.callback.is_empty()) {
+        timer.callback(timer.id);
+      }
+    }
+
     cur_time.fetch_add(1, std::memory_order_relaxed);
   }
 
   void stop_all()
   {
     std::lock_guard<std::mutex> lock(mutex);
+    bool                        owner = is_owner_thread();
     // does not call callback
     for (timer_impl& timer : timer_list) {
-      stop_timer_(timer, false);
+      if (not timer.allocated) {
+        continue;
+      }
+      update_state_(timer, [](uint64_t old_state) { return stop_state_(old_state, false); });
+      if (owner) {
+        timer.unlink();
+      } else {
+        pending_cmds.updates.push_back(&timer);
+        has_pending_cmds.store(true, std::memory_order_release);
+      }
     }
   }
 
@@ -289,13 +378,16 @@ public:
   uint32_t nof_timers() const
   {
     std::lock_guard<std::mutex> lock(mutex);
-    return timer_list.size() - nof_free_timers;
+    return nof_timers_allocated;
   }
 
+  /// Counts the running timers. Not meant for the fast path, it goes through all the timers
   uint32_t nof_running_timers() const
   {
     std::lock_guard<std::mutex> lock(mutex);
-    return nof_timers_running_;
+    return std::count_if(timer_list.begin(), timer_list.end(), [](const timer_impl& timer) {
+      return timer.allocated and timer.is_running_();
+    });
   }
 
   constexpr static uint32_t max_timer_duration() { return MAX_TIMER_DURATION; }
@@ -317,6 +409,8 @@ public:
   static size_t get_wheel_size() { return WHEEL_SIZE; }
 
 private:
+  bool is_owner_thread() const { return owner_id.load(std::memory_order_relaxed) == std::this_thread::get_id(); }
+
   timer_impl& alloc_timer()
   {
     std::lock_guard<std::mutex> lock(mutex);
@@ -332,75 +426,166 @@ private:
       t = &timer_list.back();
     }
     t->allocated = true;
+    nof_timers_allocated++;
     return *t;
   }
 
   void dealloc_timer_(timer_impl& timer)
   {
+    bool owner = is_owner_thread();
+    if (owner) {
+      // the timer can not return to the free list with pending commands
+      apply_pending_cmds_();
+    }
+    // destroyed after releasing the lock, in case the callback owns timers
+    srsran::move_callback<void(uint32_t)> old_callback;
+
+    std::lock_guard<std::mutex> lock(mutex);
     if (not timer.allocated) {
       // already deallocated
       return;
     }
-    stop_timer_(timer, false);
     timer.allocated = false;
-    timer.state.store(encode_state(STOPPED_FLAG, 0, 0), std::memory_order_relaxed);
-    timer.callback = srsran::move_callback<void(uint32_t)>();
+    nof_timers_allocated--;
+    update_state_(timer, [](uint64_t old_state) { return encode_state(STOPPED_FLAG, 0, 0); });
+    if (not owner) {
+      // the timer is returned to the free list once the owner unlinks it
+      pending_cmds.releases.push_back(&timer);
+      has_pending_cmds.store(true, std::memory_order_release);
+      return;
+    }
+    timer.unlink();
+    old_callback = std::move(timer.callback);
     free_list.push_front(&timer);
     nof_free_timers++;
     // leave id unchanged.
   }
 
-  void start_run_(timer_impl& timer, uint32_t duration_ = 0)
+  static uint64_t stop_state_(uint64_t old_state, bool expiry)
+  {
+    if (not decode_is_running(old_state)) {
+      return old_state;
+    }
+    return encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(old_state), decode_timeout(old_state));
+  }
+
+  /// Atomically updates the timer state, as the owner and other threads may update it concurrently
+  template <typename F>
+  static void update_state_(timer_impl& timer, const F& new_state_func)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
-    uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
+    uint64_t old_state = timer.state.load(std::memory_order_relaxed);
+    while (not timer.state.compare_exchange_weak(old_state, new_state_func(old_state), std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Updates the timer state and its position in the wheel. The owner thread does it straight away, other threads
+  /// leave the wheel update and the callback change to the owner
+  template <typename F>
+  void modify_timer_(timer_impl&                            timer,
+                     const F&                               new_state_func,
+                     srsran::move_callback<void(uint32_t)>* new_callback = nullptr)
+  {
+    if (is_owner_thread()) {
+      // apply first the changes of other threads that may have happened before
+      apply_pending_cmds_();
+      update_state_(timer, new_state_func);
+      if (new_callback != nullptr) {
+        timer.callback = std::move(*new_callback);
+      }
+      update_timer_link_(timer);
       return;
     }
 
-    // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-      nof_timers_running_--;
+    std::lock_guard<std::mutex> lock(mutex);
+    update_state_(timer, new_state_func);
+    if (new_callback != nullptr) {
+      pending_cmds.callbacks.emplace_back(&timer, std::move(*new_callback));
+    }
+    pending_cmds.updates.push_back(&timer);
+    has_pending_cmds.store(true, std::memory_order_release);
+  }
+
+  /// Applies the wheel updates requested by other threads. Only called by the owner thread
+  void apply_pending_cmds_()
+  {
+    if (not has_pending_cmds.load(std::memory_order_acquire)) {
+      return;
+    }
+    // The commands are applied from a local, as destroying a callback may release timers that it owns, which applies
+    // the commands requested in the meantime. The member only keeps the capacity of the vectors between
+    // calls
+    pending_cmds_t cmds = std::move(cmds_to_apply);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::swap(pending_cmds, cmds);
+      has_pending_cmds.store(false, std::memory_order_relaxed);
+    }
+    for (auto& cmd : cmds.callbacks) {
+      cmd.first->callback = std::move(cmd.second);
+    }
+    for (timer_impl* timer : cmds.updates) {
+      update_timer_link_(*timer);
     }
+    for (timer_impl* timer : cmds.releases) {
+      timer->unlink();
+      srsran::move_callback<void(uint32_t)> old_callback = std::move(timer->callback);
+      std::lock_guard<std::mutex>           lock(mutex);
+      free_list.push_front(timer);
+      nof_free_timers++;
+    }
+    cmds.callbacks.clear();
+    cmds.updates.clear();
+    cmds.releases.clear();
+    cmds_to_apply = std::move(cmds);
+  }
 
-    // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
-    timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-    nof_timers_running_++;
+  /// Updates the wheel after a change of the timer state. The wheel is left untouched when the timer stops or its
+  /// timeout is extended, which is the usual case of restarted timers. The timer is moved to the right slot (or
+  /// dropped if stopped) once the time reaches its current slot. Only called by the owner thread
+  void update_timer_link_(timer_impl& timer)
+  {
+    uint64_t state = timer.state.load(std::memory_order_relaxed);
+    if (not decode_is_running(state) or
+        (timer.is_linked() and static_cast<int32_t>(decode_timeout(state) - timer.wheel_timeout) >= 0)) {
+      return;
+    }
+    relink_timer_(timer);
   }
 
-  /// called when user manually stops timer (as an alternative to expiry)
-  void stop_timer_(timer_impl& timer, bool expiry)
+  /// Places the timer in the wheel slot of its timeout. Only called by the owner thread
+  void relink_timer_(timer_impl& timer)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    if (not decode_is_running(timer_old_state)) {
+    timer.unlink();
+    uint64_t state = timer.state.load(std::memory_order_relaxed);
+    if (not decode_is_running(state)) {
       return;
     }
 
-    // If already running, need to disconnect it from previous wheel
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-    uint64_t new_state =
-        encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
-    timer.state.store(new_state, std::memory_order_relaxed);
-    nof_timers_running_--;
+    tic_t timeout       = decode_timeout(state);
+    timer.wheel_timeout = timeout;
+    if (static_cast<int32_t>(timeout - wheel_time) <= 0) {
+      // Timeout already reached (e.g. timer run from another thread during the last step)
+      time_wheel[0][overdue_time & WHEEL_MASK].push_back(timer);
+      return;
+    }
+    uint32_t level = (31U - __builtin_clz(timeout ^ wheel_time)) / WHEEL_SHIFT;
+    time_wheel[level][(timeout >> (level * WHEEL_SHIFT)) & WHEEL_MASK].push_back(timer);
   }
 
-  std::atomic<tic_t> cur_time{0};
-  size_t             nof_timers_running_ = 0, nof_free_timers = 0;
+  std::atomic<tic_t>    cur_time{0};
+  size_t                nof_free_timers = 0, nof_timers_allocated = 0;
+  // Only accessed by the owner thread: time of the wheel slots, and time in which the timers that already reached
+  // their timeout are expired (the current step while the lowest level slot has not been processed yet)
+  tic_t wheel_time = 0, overdue_time = 1;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
-  std::deque<timer_impl>                                         timer_list;
-  srsran::intrusive_forward_list<timer_impl>                     free_list;
-  std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel;
-  mutable std::mutex                                             mutex; // Protect priority queue
+  std::deque<timer_impl>                                           timer_list;
+  srsran::intrusive_forward_list<timer_impl>                       free_list;
+  std::array<std::array<wheel_node, WHEEL_SIZE>, NOF_WHEEL_LEVELS> time_wheel;
+  std::atomic<std::thread::id>                                     owner_id{std::thread::id()};
+  std::atomic<bool>                                                has_pending_cmds{false};
+  pending_cmds_t                                                   pending_cmds;
+  pending_cmds_t                                                   cmds_to_apply; ///< only accessed by the owner thread
+  mutable std::mutex                                               mutex; // Protect timer allocation and pending_cmds
 };
 
 using unique_timer = timer_handler::unique_timer;
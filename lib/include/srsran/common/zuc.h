@@ -56,4 +56,35 @@ typedef struct {
 void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv);
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream);
 
+/* Multi-buffer ZUC: up to ZUC_MB_NOF_LANES independent keystreams are
+ * generated in parallel, one per lane, with a lane-interleaved state that is
+ * processed with SIMD instructions when available.
+ */
+#define ZUC_MB_NOF_LANES 8
+#define ZUC_MB_NOF_WORDS 16
+
+typedef struct {
+  u32 lfsr[16][ZUC_MB_NOF_LANES];
+  u32 r1[ZUC_MB_NOF_LANES];
+  u32 r2[ZUC_MB_NOF_LANES];
+} zuc_mb_state_t;
+
+/* Initializes a single lane with the 16 byte key k and IV iv, as
+ * zuc_initialize(). The keystream of the lane starts with its first word on
+ * the next call to zuc_mb_generate_keystream().
+ */
+void zuc_mb_initialize_lane(zuc_mb_state_t* state, u32 lane, const u8* k, const u8* iv);
+
+/* Initializes the lanes set in lane_mask (bit l for lane l) with the keys
+ * k[l] and IVs iv[l], in parallel when enough lanes are set.
+ */
+void zuc_mb_initialize_lanes(zuc_mb_state_t* state, u32 lane_mask, const u8 k[][16], const u8 iv[][16]);
+
+/* Generates the next ZUC_MB_NOF_WORDS keystream words of the lanes set in
+ * lane_mask (bit l for lane l). Lanes that are not set in the mask must be
+ * re-initialized before being used again. Word t of lane l is written in
+ * p_keystream[t * ZUC_MB_NOF_LANES + l].
+ */
+void zuc_mb_generate_keystream(zuc_mb_state_t* state, u32 lane_mask, u32* p_keystream);
+
 #endif // SRSRAN_ZUC_H
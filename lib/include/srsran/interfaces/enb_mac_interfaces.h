@@ -33,6 +33,8 @@ struct mac_args_t {
   sched_interface::sched_args_t sched;
   int                           lcid_padding;
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
+  uint32_t                      ul_softbuffer_pool_cb; ///< UL code blocks shared by all UEs, 0 for per-HARQ buffers
+  bool                          ul_softbuffer_8bit;    ///< Pooled UL soft bits are saturated to 8-bit
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
 };
@@ -29,7 +29,11 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
+#include "srsenb/hdr/stack/upper/gtpu_metrics.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -52,15 +56,19 @@ struct stack_metrics_t {
   rlc_metrics_t  rlc;
   pdcp_metrics_t pdcp;
   s1ap_metrics_t s1ap;
+  gtpu_metrics_t gtpu;
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t               rf;
+  std::vector<phy_metrics_t>         phy;
+  stack_metrics_t                    stack;
+  stack_metrics_t                    nr_stack;
+  srsran::sys_metrics_t              sys;
+  srsran::byte_buffer_pool_metrics_t pool;
+  srsran::tti_latency_metrics_t      tti_latency;      ///< TTI pipeline latencies since the previous report
+  srsran_sequence_cache_metrics_t    scrambling_cache; ///< Cumulative PHY scrambling cache counters
+  bool                               running;
 };
 
 // ENB interface
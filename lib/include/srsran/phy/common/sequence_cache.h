@@ -0,0 +1,128 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         sequence_cache.h
+ *
+ *  Description:  Bounded cache of packed scrambling sequences. The PDSCH/PUSCH
+ *                scrambling seed only depends on the RNTI, codeword, slot and
+ *                cell, so the same sequences are generated every radio frame
+ *                for steady-state UEs. The cache is keyed by the seed and can be
+ *                shared by several workers.
+ *
+ *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.2
+ *                3GPP TS 38.211 version 15.8.0 Release 15 Sec. 5.2.1
+ *****************************************************************************/
+
+#ifndef SRSRAN_SEQUENCE_CACHE_H
+#define SRSRAN_SEQUENCE_CACHE_H
+
+#include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of sequences in each set of the cache, the least recently used one in a set is replaced on a miss
+ */
+#define SRSRAN_SEQUENCE_CACHE_WAYS 4
+
+/**
+ * @brief Usage counters of a sequence cache
+ */
+typedef struct SRSRAN_API {
+  uint32_t nof_entries; ///< Number of sequences the cache can hold
+  uint32_t max_len;     ///< Maximum sequence length in bits
+  uint64_t nof_hits;    ///< Number of requests served from the cache
+  uint64_t nof_misses;  ///< Number of requests that generated a sequence
+  uint64_t nof_evicted; ///< Number of valid sequences replaced by a miss
+  uint64_t nof_bypass;  ///< Number of requests longer than max_len, not cached
+} srsran_sequence_cache_metrics_t;
+
+typedef struct SRSRAN_API {
+  uint32_t seed;
+  uint32_t len;      ///< Number of valid bits in c, 0 if the entry is empty
+  uint64_t last_use; ///< Cache tick of the last request served by this entry
+  uint8_t* c;        ///< Packed sequence, MSB first
+} srsran_sequence_cache_entry_t;
+
+typedef struct SRSRAN_API {
+  uint32_t nof_sets;
+  uint32_t max_len;
+  uint64_t tick;
+
+  srsran_sequence_cache_entry_t*  entries; ///< nof_sets x SRSRAN_SEQUENCE_CACHE_WAYS entries
+  pthread_rwlock_t*               locks;   ///< One lock per set
+  srsran_sequence_cache_metrics_t metrics;
+} srsran_sequence_cache_t;
+
+/**
+ * @brief Initialises a cache holding at least nof_entries sequences of up to max_len bits
+ * @return SRSRAN_SUCCESS or SRSRAN_ERROR
+ */
+SRSRAN_API int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries, uint32_t max_len);
+
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+/**
+ * @brief Drops every cached sequence, for example after a cell reconfiguration. The metrics are kept.
+ */
+SRSRAN_API void srsran_sequence_cache_reset(srsran_sequence_cache_t* q);
+
+SRSRAN_API void srsran_sequence_cache_get_metrics(srsran_sequence_cache_t* q, srsran_sequence_cache_metrics_t* metrics);
+
+/*
+ * The functions below behave as their srsran_sequence_apply_* counterparts. A NULL cache generates the sequence on the
+ * fly, so the callers do not need to handle the disabled case.
+ */
+SRSRAN_API void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                                   uint32_t                 seed,
+                                                   const uint8_t*           in,
+                                                   uint8_t*                 out,
+                                                   uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                                uint32_t                 seed,
+                                                const uint8_t*           in,
+                                                uint8_t*                 out,
+                                                uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                              uint32_t                 seed,
+                                              const int8_t*            in,
+                                              int8_t*                  out,
+                                              uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                              uint32_t                 seed,
+                                              const int16_t*           in,
+                                              int16_t*                 out,
+                                              uint32_t                 len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_SEQUENCE_CACHE_H
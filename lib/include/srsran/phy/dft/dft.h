@@ -82,6 +82,22 @@ SRSRAN_API int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
                                       int                idist,
                                       int                odist);
 
+/**
+ * @brief Guru plan for nof_batches batches of how_many transforms of contiguous samples. Transform i of batch b reads
+ * from in_buffer + b * ibatch_dist + i * idist and writes to out_buffer + b * obatch_dist + i * odist
+ */
+SRSRAN_API int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t* plan,
+                                            int                dft_points,
+                                            srsran_dft_dir_t   dir,
+                                            cf_t*              in_buffer,
+                                            cf_t*              out_buffer,
+                                            int                how_many,
+                                            int                idist,
+                                            int                odist,
+                                            int                nof_batches,
+                                            int                ibatch_dist,
+                                            int                obatch_dist);
+
 SRSRAN_API int srsran_dft_plan_r(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
 
 SRSRAN_API int srsran_dft_replan(srsran_dft_plan_t* plan, const int new_dft_points);
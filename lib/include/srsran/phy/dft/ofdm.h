@@ -90,6 +90,28 @@ typedef struct SRSRAN_API {
   srsran_cfr_t      tx_cfr; ///< Tx CFR object
 } srsran_ofdm_t;
 
+/**
+ * @struct srsran_ofdm_many_t
+ * Batched OFDM engine for several antenna ports. Every port is transformed with a single FFTW advanced plan that covers
+ * all the symbols of the subframe and reads or writes the time domain samples in place, skipping the cyclic prefix. The
+ * frequency domain side is a work buffer shared by all ports. The resource grid mapping, DFT window offset, phase
+ * compensation, normalization and amplitude scaling are applied while copying to and from the work buffer.
+ *
+ * The per port OFDM objects keep providing the configuration and the input/output buffers.
+ */
+typedef struct SRSRAN_API {
+  srsran_ofdm_t*    ofdm;                        ///< Array of per port OFDM objects
+  uint32_t          nof_ports;                   ///< Number of ports transformed in each call
+  uint32_t          symbol_sz;                   ///< Symbol size the plans were created for
+  uint32_t          nof_symbols;                 ///< Number of symbols per subframe the plans were created for
+  uint32_t          nof_re;                      ///< Number of subcarriers the work buffer guards were cleared for
+  srsran_dft_dir_t  dir;                         ///< Transform direction
+  srsran_dft_plan_t plan[SRSRAN_MAX_PORTS];      ///< Plan of each port, one transform per symbol of the subframe
+  cf_t*             td_buffer[SRSRAN_MAX_PORTS]; ///< Time domain sample of the first symbol each plan was created for
+  cf_t*             work;                        ///< Frequency domain work buffer, one symbol after another
+  uint32_t          work_len;                    ///< Allocated work buffer length in samples
+} srsran_ofdm_many_t;
+
 /**
  * @brief Initialises or reconfigures OFDM receiver
  *
@@ -150,4 +172,34 @@ SRSRAN_API void srsran_ofdm_set_non_mbsfn_region(srsran_ofdm_t* q, uint8_t non_m
 
 SRSRAN_API int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr);
 
+/**
+ * @brief Binds a batched OFDM engine to an array of initialised OFDM objects and plans the transforms
+ *
+ * @note It must be called again after any of the OFDM objects is reconfigured. Until then, the run functions fall back
+ * to the per port srsran_ofdm_tx_sf() and srsran_ofdm_rx_sf()
+ *
+ * @param q Batched OFDM engine, zeroed before the first call
+ * @param ofdm Array of nof_ports OFDM objects, all of them with the same direction, bandwidth and cyclic prefix
+ * @param nof_ports Number of OFDM objects
+ * @return SRSRAN_SUCCESS if the plan is ready, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ofdm_many_set(srsran_ofdm_many_t* q, srsran_ofdm_t* ofdm, uint32_t nof_ports);
+
+SRSRAN_API void srsran_ofdm_many_free(srsran_ofdm_many_t* q);
+
+/**
+ * @brief Modulates a subframe of every port, equivalent to srsran_ofdm_tx_sf() on each of them
+ *
+ * @param q Batched OFDM engine
+ * @param amplitude Scaling of the resource grid, applied while copying it into the work buffer
+ */
+SRSRAN_API void srsran_ofdm_many_tx_sf(srsran_ofdm_many_t* q, float amplitude);
+
+/**
+ * @brief Demodulates a subframe of every port, equivalent to srsran_ofdm_rx_sf() on each of them
+ *
+ * @param q Batched OFDM engine
+ */
+SRSRAN_API void srsran_ofdm_many_rx_sf(srsran_ofdm_many_t* q);
+
 #endif // SRSRAN_OFDM_H
@@ -66,10 +66,11 @@ typedef struct SRSRAN_API {
 
   srsran_cfr_cfg_t cfr_config;
 
-  cf_t*         sf_symbols[SRSRAN_MAX_PORTS];
-  cf_t*         out_buffer[SRSRAN_MAX_PORTS];
-  srsran_ofdm_t ifft[SRSRAN_MAX_PORTS];
-  srsran_ofdm_t ifft_mbsfn;
+  cf_t*              sf_symbols[SRSRAN_MAX_PORTS];
+  cf_t*              out_buffer[SRSRAN_MAX_PORTS];
+  srsran_ofdm_t      ifft[SRSRAN_MAX_PORTS];
+  srsran_ofdm_t      ifft_mbsfn;
+  srsran_ofdm_many_t ifft_many;
 
   srsran_pbch_t   pbch;
   srsran_pcfich_t pcfich;
@@ -106,6 +107,11 @@ SRSRAN_API int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell);
 
 SRSRAN_API int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr);
 
+/**
+ * @brief Sets a scrambling sequence cache, it can be shared with other objects. NULL disables it.
+ */
+SRSRAN_API void srsran_enb_dl_set_sequence_cache(srsran_enb_dl_t* q, srsran_sequence_cache_t* cache);
+
 SRSRAN_API bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc);
 
 SRSRAN_API void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf);
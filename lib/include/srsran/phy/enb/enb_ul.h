@@ -55,6 +55,7 @@ typedef struct SRSRAN_API {
   cf_t*                 sf_symbols;
   cf_t*                 in_buffer;
   srsran_chest_ul_res_t chest_res;
+  bool                  shared_grid;
 
   srsran_ofdm_t     fft;
   srsran_chest_ul_t chest;
@@ -66,6 +67,10 @@ typedef struct SRSRAN_API {
 /* This function shall be called just after the initial synchronization */
 SRSRAN_API int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb);
 
+/* Initialises an object that decodes PUSCH/PUCCH from the resource grid of "parent" instead of running its own FFT.
+ * Several of them allow decoding the users of a subframe in parallel. It must be freed before the parent */
+SRSRAN_API int srsran_enb_ul_init_shared(srsran_enb_ul_t* q, const srsran_enb_ul_t* parent, uint32_t max_prb);
+
 SRSRAN_API void srsran_enb_ul_free(srsran_enb_ul_t* q);
 
 SRSRAN_API int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
@@ -73,6 +78,11 @@ SRSRAN_API int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
                                       srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
                                       srsran_refsignal_srs_cfg_t*        srs_cfg);
 
+/**
+ * @brief Sets a scrambling sequence cache, it can be shared with other objects. NULL disables it.
+ */
+SRSRAN_API void srsran_enb_ul_set_sequence_cache(srsran_enb_ul_t* q, srsran_sequence_cache_t* cache);
+
 SRSRAN_API void srsran_enb_ul_fft(srsran_enb_ul_t* q);
 
 SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
@@ -80,6 +90,14 @@ SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
                                        srsran_pucch_cfg_t* cfg,
                                        srsran_pucch_res_t* res);
 
+/* Channel estimation and decoding of srsran_enb_ul_get_pusch(), for callers that time or schedule them separately */
+SRSRAN_API int srsran_enb_ul_estimate_pusch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pusch_cfg_t* cfg);
+
+SRSRAN_API int srsran_enb_ul_decode_pusch(srsran_enb_ul_t*    q,
+                                          srsran_ul_sf_cfg_t* ul_sf,
+                                          srsran_pusch_cfg_t* cfg,
+                                          srsran_pusch_res_t* res);
+
 SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_ul_sf_cfg_t* ul_sf,
                                        srsran_pusch_cfg_t* cfg,
@@ -44,6 +44,13 @@ typedef struct SRSRAN_API {
   uint64_t crcmask;
   uint64_t crchighbit;
   uint32_t srsran_crc_out;
+
+  // Folding constants for the carry-less multiply engine. All of them are computed modulo the polynomial scaled to
+  // degree 32 (fold_poly), so that any CRC order up to 32 bits shares the same folding and reduction code. fold_poly
+  // is left to zero when the CPU lacks PCLMULQDQ, and the table is used instead.
+  uint64_t fold_poly;
+  uint64_t fold_k[4]; ///< x^192, x^128, x^96 and x^64 modulo fold_poly
+  uint64_t fold_mu;   ///< Barrett constant, floor(x^64 / fold_poly)
 } srsran_crc_t;
 
 SRSRAN_API int srsran_crc_init(srsran_crc_t* h, uint32_t srsran_crc_poly, int srsran_crc_order);
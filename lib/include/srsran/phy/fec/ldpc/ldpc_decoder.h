@@ -35,6 +35,11 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 
+/*!
+ * \brief Maximum number of code blocks that can be decoded in lockstep by srsran_ldpc_decoder_decode_batch_c().
+ */
+#define SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE 8
+
 /*!
  * \brief Types of LDPC decoder.
  */
@@ -55,28 +60,32 @@ typedef enum {
  * \brief Describes the LDPC decoder configuration arguments.
  */
 typedef struct {
-  srsran_ldpc_decoder_type_t type;         /*!< \brief Type of LDPC decoder. */
-  srsran_basegraph_t         bg;           /*!< \brief The desired base graph (BG1 or BG2). */
-  uint16_t                   ls;           /*!< \brief The desired lifting size. */
-  float                      scaling_fctr; /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
-  uint32_t                   max_nof_iter; /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  srsran_ldpc_decoder_type_t type;           /*!< \brief Type of LDPC decoder. */
+  srsran_basegraph_t         bg;             /*!< \brief The desired base graph (BG1 or BG2). */
+  uint16_t                   ls;             /*!< \brief The desired lifting size. */
+  float                      scaling_fctr;   /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
+  uint32_t                   max_nof_iter;   /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  uint32_t                   max_batch_size; /*!< \brief Maximum number of code blocks decoded in lockstep, set to 0 or
+                                                1 to disable batched decoding. */
 } srsran_ldpc_decoder_args_t;
 
 /*!
  * \brief Describes an LDPC decoder.
  */
 typedef struct SRSRAN_API {
-  void*              ptr;          /*!< \brief Registers used by the decoder. */
-  srsran_basegraph_t bg;           /*!< \brief Current base graph. */
-  uint16_t           ls;           /*!< \brief Current lifting size. */
-  uint32_t           max_nof_iter; /*!< \brief Maximum number of iterations. */
-  uint8_t            bgN;          /*!< \brief Number of variable nodes in the BG. */
-  uint16_t           liftN;        /*!< \brief Number of variable nodes in the lifted graph. */
-  uint8_t            bgM;          /*!< \brief Number of check nodes in the BG. */
-  uint16_t           liftM;        /*!< \brief Number of check nodes in the lifted graph. */
-  uint8_t            bgK;          /*!< \brief Number of "uncoded bits" in the BG. */
-  uint16_t           liftK;        /*!< \brief Number of uncoded bits in the lifted graph. */
-  uint16_t*          pcm;          /*!< \brief Pointer to the parity check matrix (compact form). */
+  void*              ptr;            /*!< \brief Registers used by the decoder. */
+  void*              ptr_batch;      /*!< \brief Registers used by the batched decoder, NULL if not available. */
+  srsran_basegraph_t bg;             /*!< \brief Current base graph. */
+  uint16_t           ls;             /*!< \brief Current lifting size. */
+  uint32_t           max_nof_iter;   /*!< \brief Maximum number of iterations. */
+  uint32_t           max_batch_size; /*!< \brief Maximum number of code blocks decoded in lockstep. */
+  uint8_t            bgN;            /*!< \brief Number of variable nodes in the BG. */
+  uint16_t           liftN;          /*!< \brief Number of variable nodes in the lifted graph. */
+  uint8_t            bgM;            /*!< \brief Number of check nodes in the BG. */
+  uint16_t           liftM;          /*!< \brief Number of check nodes in the lifted graph. */
+  uint8_t            bgK;            /*!< \brief Number of "uncoded bits" in the BG. */
+  uint16_t           liftK;          /*!< \brief Number of uncoded bits in the lifted graph. */
+  uint16_t*          pcm;            /*!< \brief Pointer to the parity check matrix (compact form). */
 
   int8_t (*var_indices)[MAX_CNCT]; /*!< \brief Pointer to lists of variable indices connected to a given check node. */
 
@@ -99,6 +108,14 @@ typedef struct SRSRAN_API {
                   uint8_t*,
                   uint32_t,
                   srsran_crc_t*); /*!< \brief Pointer to the decoding function (16-bit version). */
+  int (*decode_batch_c)(void*,
+                        const int8_t* const*,
+                        uint8_t* const*,
+                        uint32_t,
+                        uint32_t,
+                        srsran_crc_t*,
+                        int*); /*!< \brief Pointer to the batched decoding function (8-bit version), NULL if not
+                                  available. */
 } srsran_ldpc_decoder_t;
 
 /*!
@@ -179,4 +196,29 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Decodes a number of code blocks that share the base graph and the lifting size of the decoder, using 8-bit
+ * integer-valued LLRs. Consecutive code blocks whose rate-matched lengths cover the same number of layers are decoded
+ * in lockstep, up to the maximum batch size given at initialization; the remaining ones are decoded one by one. Either
+ * way, each code block is decoded exactly as by srsran_ldpc_decoder_decode_crc_c(). Currently, only the AVX2 decoder
+ * with lifting sizes not larger than 16 and the AVX512 decoder with lifting sizes not larger than 32 decode several code
+ * blocks at once, packing them in the idle register lanes.
+ * \param[in] q A pointer to the LDPC decoder (a srsran_ldpc_decoder_t structure
+ *    instance) that carries out the decoding.
+ * \param[in] llrs The LLRs of each code block.
+ * \param[out] message The message (uncoded bits) resulting from the decoding of each code block.
+ * \param[in] cdwd_rm_length The number of bits forming each codeword (after rate matching).
+ * \param[in] nof_cbs The number of code blocks.
+ * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
+ * \param[out] nof_iter For each code block, the number of used iterations, and 0 if CRC is provided and did not match
+ * \return -1 if an error occurred, 0 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_decoder_decode_batch_c(srsran_ldpc_decoder_t* q,
+                                                  const int8_t* const*   llrs,
+                                                  uint8_t* const*        message,
+                                                  const uint32_t*        cdwd_rm_length,
+                                                  uint32_t               nof_cbs,
+                                                  srsran_crc_t*          crc,
+                                                  int*                   nof_iter);
+
 #endif // SRSRAN_LDPCDECODER_H
@@ -32,12 +32,53 @@
 #define SRSRAN_SOFTBUFFER_H
 
 #include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Storage format of the soft bits held by a soft-buffer pool
+ */
+typedef enum SRSRAN_API {
+  SRSRAN_SOFTBUFFER_LLR_16BIT = 0, ///< One int16_t per soft bit, suitable for every decoder
+  SRSRAN_SOFTBUFFER_LLR_8BIT,      ///< One saturated int8_t per soft bit, only for 8-bit LLR decoders
+} srsran_softbuffer_llr_t;
+
+/**
+ * @brief Usage counters of a soft-buffer pool
+ */
+typedef struct SRSRAN_API {
+  uint32_t nof_cb;         ///< Number of code-block buffers owned by the pool
+  uint32_t nof_cb_used;    ///< Number of code-block buffers currently leased
+  uint32_t nof_cb_peak;    ///< Highest number of code-block buffers leased at the same time
+  uint64_t nof_leases;     ///< Number of successful leases
+  uint64_t nof_lease_fail; ///< Number of leases refused because the pool was exhausted
+  uint64_t nof_bytes;      ///< Memory owned by the pool in bytes
+  uint64_t nof_bytes_used; ///< Memory held by leased code-block buffers in bytes
+} srsran_softbuffer_pool_metrics_t;
+
+/**
+ * @brief Pool of Rx code-block buffers shared by many soft-buffers. Code blocks are leased when a HARQ process starts
+ * a new transmission and returned once it is decoded, so memory scales with active HARQ processes.
+ */
+typedef struct SRSRAN_API {
+  uint32_t                         nof_cb;
+  uint32_t                         max_cb_size;
+  srsran_softbuffer_llr_t          llr_type;
+  uint32_t                         cb_nbytes;
+  int16_t**                        buffer_f;
+  uint8_t**                        data;
+  int16_t**                        free_buffer_f;
+  uint8_t**                        free_data;
+  uint32_t                         nof_free;
+  srsran_softbuffer_pool_metrics_t metrics;
+  pthread_mutex_t                  mutex;
+} srsran_softbuffer_pool_t;
+
 typedef struct SRSRAN_API {
   uint32_t  max_cb;
   uint32_t  max_cb_size;
@@ -45,6 +86,8 @@ typedef struct SRSRAN_API {
   uint8_t** data;
   bool*     cb_crc;
   bool      tb_crc;
+
+  srsran_softbuffer_pool_t* pool; ///< Pool the code blocks are leased from, NULL if they are owned
 } srsran_softbuffer_rx_t;
 
 typedef struct SRSRAN_API {
@@ -67,11 +110,50 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises Rx soft-buffer that leases its code blocks from a shared pool
+ * @note No code block is held until srsran_softbuffer_rx_reset_tbs() or srsran_softbuffer_rx_reset_cb() is called, and
+ * the storage format is the pool's, so an 8-bit pool can only serve decoders working with 8-bit LLRs
+ * @param q The Rx soft-buffer pointer
+ * @param pool Initialised soft-buffer pool
+ * @param max_cb The maximum number of code blocks the soft-buffer can lease
+ * @return It returns SRSRAN_SUCCESS if it initialises the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int
+srsran_softbuffer_rx_init_pool(srsran_softbuffer_rx_t* q, srsran_softbuffer_pool_t* pool, uint32_t max_cb);
+
+/**
+ * @brief Resets the Rx soft-buffer. Pool soft-buffers return all their code blocks to the pool
+ */
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
-SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
+/**
+ * @brief Resets the code blocks needed by a transport block of the given size. Pool soft-buffers lease them
+ * @return SRSRAN_SUCCESS, or SRSRAN_ERROR if the pool could not provide the code blocks
+ */
+SRSRAN_API int srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
+
+/**
+ * @brief Resets the given number of code blocks. Pool soft-buffers return their code blocks and lease new ones
+ * @return SRSRAN_SUCCESS, or SRSRAN_ERROR if the pool could not provide the code blocks
+ */
+SRSRAN_API int srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
+
+/**
+ * @brief Returns the code blocks of a pool soft-buffer once its transport block is no longer needed. It does nothing
+ * for soft-buffers that own their code blocks
+ * @param q Rx soft-buffer object
+ */
+SRSRAN_API void srsran_softbuffer_rx_release(srsran_softbuffer_rx_t* q);
 
-SRSRAN_API void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
+/**
+ * @brief Checks that the soft-buffer holds storage for a number of code blocks
+ * @param q Rx soft-buffer object
+ * @param nof_cb Number of code blocks to decode
+ * @return true if the first nof_cb code blocks can be decoded, false otherwise
+ */
+SRSRAN_API bool srsran_softbuffer_rx_is_ready(const srsran_softbuffer_rx_t* q, uint32_t nof_cb);
 
 SRSRAN_API void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* p);
 
@@ -104,6 +186,48 @@ SRSRAN_API void srsran_softbuffer_tx_reset_cb(srsran_softbuffer_tx_t* q, uint32_
 
 SRSRAN_API void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* p);
 
+/**
+ * @brief Initialises a pool of Rx code-block buffers
+ * @param q The pool object
+ * @param nof_cb Number of code-block buffers to allocate
+ * @param max_cb_size The code block size in soft bits
+ * @param llr_type Storage format of the soft bits
+ * @return It returns SRSRAN_SUCCESS if it allocates the pool successfully, otherwise it returns SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_pool_init(srsran_softbuffer_pool_t* q,
+                                           uint32_t                  nof_cb,
+                                           uint32_t                  max_cb_size,
+                                           srsran_softbuffer_llr_t   llr_type);
+
+/**
+ * @brief Frees the pool. All soft-buffers using it must have been freed before
+ */
+SRSRAN_API void srsran_softbuffer_pool_free(srsran_softbuffer_pool_t* q);
+
+/**
+ * @brief Leases a number of zeroed code-block buffers. Either all of them are leased or none
+ * @param q The pool object
+ * @param nof_cb Number of code-block buffers to lease
+ * @param buffer_f Destination of the soft-bit buffer pointers
+ * @param data Destination of the decoded data buffer pointers
+ * @return SRSRAN_SUCCESS if the buffers were leased, SRSRAN_ERROR if the pool does not have enough free buffers
+ */
+SRSRAN_API int srsran_softbuffer_pool_lease(srsran_softbuffer_pool_t* q,
+                                            uint32_t                  nof_cb,
+                                            int16_t**                 buffer_f,
+                                            uint8_t**                 data);
+
+/**
+ * @brief Returns code-block buffers to the pool and clears the given pointers. NULL entries are skipped
+ */
+SRSRAN_API void
+srsran_softbuffer_pool_release(srsran_softbuffer_pool_t* q, uint32_t nof_cb, int16_t** buffer_f, uint8_t** data);
+
+/**
+ * @brief Reads the pool usage counters
+ */
+SRSRAN_API void srsran_softbuffer_pool_get_metrics(srsran_softbuffer_pool_t* q, srsran_softbuffer_pool_metrics_t* m);
+
 #ifdef __cplusplus
 }
 #endif
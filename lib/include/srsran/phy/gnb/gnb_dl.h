@@ -47,7 +47,8 @@ typedef struct SRSRAN_API {
   srsran_carrier_nr_t   carrier;
   srsran_pdcch_cfg_nr_t pdcch_cfg;
 
-  srsran_ofdm_t fft[SRSRAN_MAX_PORTS];
+  srsran_ofdm_t      fft[SRSRAN_MAX_PORTS];
+  srsran_ofdm_many_t fft_many;
 
   cf_t*             sf_symbols[SRSRAN_MAX_PORTS];
   srsran_pdsch_nr_t pdsch;
@@ -68,6 +69,11 @@ SRSRAN_API int srsran_gnb_dl_set_pdcch_config(srsran_gnb_dl_t*             q,
                                               const srsran_pdcch_cfg_nr_t* cfg,
                                               const srsran_dci_cfg_nr_t*   dci_cfg);
 
+/**
+ * @brief Sets a scrambling sequence cache, it can be shared with other objects. NULL disables it.
+ */
+SRSRAN_API void srsran_gnb_dl_set_sequence_cache(srsran_gnb_dl_t* q, srsran_sequence_cache_t* cache);
+
 SRSRAN_API void srsran_gnb_dl_free(srsran_gnb_dl_t* q);
 
 SRSRAN_API int srsran_gnb_dl_base_zero(srsran_gnb_dl_t* q);
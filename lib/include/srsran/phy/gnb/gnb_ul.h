@@ -55,6 +55,11 @@ SRSRAN_API void srsran_gnb_ul_free(srsran_gnb_ul_t* q);
 
 SRSRAN_API int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrier_nr_t* carrier);
 
+/**
+ * @brief Sets a scrambling sequence cache, it can be shared with other objects. NULL disables it.
+ */
+SRSRAN_API void srsran_gnb_ul_set_sequence_cache(srsran_gnb_ul_t* q, srsran_sequence_cache_t* cache);
+
 SRSRAN_API int srsran_gnb_ul_fft(srsran_gnb_ul_t* q);
 
 SRSRAN_API int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
@@ -23,9 +23,10 @@
  *  File:         demod_soft.h
  *
  *  Description:  Soft demodulator.
- *                Supports BPSK, QPSK, 16QAM and 64QAM.
+ *                Supports BPSK, QPSK, 16QAM, 64QAM, 256QAM and 1024QAM.
  *
  *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.1
+ *                3GPP TS 38.211 version 17.1.0 Release 17 Sec. 5.1
  *****************************************************************************/
 
 #ifndef SRSRAN_DEMOD_SOFT_H
@@ -42,4 +43,36 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/**
+ * @brief Soft demodulation with the LLRs divided by the noise variance of the symbols
+ *
+ * The LLRs are the ones of srsran_demod_soft_demodulate(), srsran_demod_soft_demodulate_s() and
+ * srsran_demod_soft_demodulate_b() respectively, divided by noise_var. This keeps them proportional to the max-log LLR
+ * of each modulation, so codewords received at different SNR can be soft-combined. Fixed-point LLRs saturate.
+ *
+ * @param modulation Modulation of the symbols
+ * @param symbols Equalized symbols
+ * @param llr Destination LLRs, nsymbols times the modulation order
+ * @param nsymbols Number of symbols
+ * @param noise_var Noise variance of the equalized symbols, must be greater than zero
+ * @return 0 if the modulation and noise variance are valid, -1 otherwise
+ */
+SRSRAN_API int srsran_demod_soft_demodulate_nvar(srsran_mod_t modulation,
+                                                 const cf_t*  symbols,
+                                                 float*       llr,
+                                                 int          nsymbols,
+                                                 float        noise_var);
+
+SRSRAN_API int srsran_demod_soft_demodulate_nvar_s(srsran_mod_t modulation,
+                                                   const cf_t*  symbols,
+                                                   short*       llr,
+                                                   int          nsymbols,
+                                                   float        noise_var);
+
+SRSRAN_API int srsran_demod_soft_demodulate_nvar_b(srsran_mod_t modulation,
+                                                   const cf_t*  symbols,
+                                                   int8_t*      llr,
+                                                   int          nsymbols,
+                                                   float        noise_var);
+
 #endif // SRSRAN_DEMOD_SOFT_H
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/chest_dl.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/mimo/layermap.h"
 #include "srsran/phy/mimo/precoding.h"
 #include "srsran/phy/modem/demod_soft.h"
@@ -55,6 +56,8 @@ typedef struct SRSRAN_API {
 
   bool llr_is_8bit;
 
+  srsran_sequence_cache_t* sequence_cache; ///< Optional scrambling sequence cache, NULL generates them on the fly
+
   /* buffers */
   // void buffers are shared for tx and rx
   cf_t* ce[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS]; /* Channel estimation (Rx only) */
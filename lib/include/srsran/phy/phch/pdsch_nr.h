@@ -32,6 +32,7 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/dmrs_sch.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/modem/evm.h"
 #include "srsran/phy/modem/modem_table.h"
 #include "srsran/phy/phch/phch_cfg_nr.h"
@@ -68,6 +69,8 @@ typedef struct SRSRAN_API {
   uint32_t             meas_time_us;
   srsran_re_pattern_t  dmrs_re_pattern;
   uint32_t             nof_rvd_re;
+
+  srsran_sequence_cache_t* sequence_cache; ///< Optional scrambling sequence cache, NULL generates them on the fly
 } srsran_pdsch_nr_t;
 
 /**
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/refsignal_ul.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/dft/dft_precoding.h"
 #include "srsran/phy/mimo/layermap.h"
 #include "srsran/phy/mimo/precoding.h"
@@ -55,6 +56,8 @@ typedef struct SRSRAN_API {
 
   bool llr_is_8bit;
 
+  srsran_sequence_cache_t* sequence_cache; ///< Optional scrambling sequence cache, NULL generates them on the fly
+
   srsran_dft_precoding_t dft_precoding;
 
   /* buffers */
@@ -24,6 +24,7 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/dmrs_sch.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/modem/evm.h"
 #include "srsran/phy/modem/modem_table.h"
 #include "srsran/phy/phch/phch_cfg_nr.h"
@@ -75,6 +76,8 @@ typedef struct SRSRAN_API {
   uint32_t             G_csi1;    ///< Number of encoded CSI part 1 bits
   uint32_t             G_csi2;    ///< Number of encoded CSI part 2 bits
   uint32_t             G_ulsch;   ///< Number of encoded shared channel
+
+  srsran_sequence_cache_t* sequence_cache; ///< Optional scrambling sequence cache, NULL generates them on the fly
 } srsran_pusch_nr_t;
 
 /**
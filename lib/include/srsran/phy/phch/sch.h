@@ -71,12 +71,24 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Optional threads decoding code blocks in parallel with the caller */
+  void*    cb_coworkers_ptr;
+  uint32_t nof_cb_coworkers;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
 
 SRSRAN_API void srsran_sch_free(srsran_sch_t* q);
 
+/**
+ * Spawns nof_coworkers threads, each with its own turbo decoder, that decode the code blocks of a transport block in
+ * parallel with the calling thread. Setting nof_coworkers to 0 disables parallel code block decoding.
+ */
+SRSRAN_API int srsran_sch_enable_cb_coworkers(srsran_sch_t* q, uint32_t nof_coworkers);
+
+SRSRAN_API void srsran_sch_disable_cb_coworkers(srsran_sch_t* q);
+
 SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations);
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
@@ -63,7 +63,8 @@ typedef struct SRSRAN_API {
   srsran_carrier_nr_t   carrier;
   srsran_pdcch_cfg_nr_t cfg;
 
-  srsran_ofdm_t fft[SRSRAN_MAX_PORTS];
+  srsran_ofdm_t      fft[SRSRAN_MAX_PORTS];
+  srsran_ofdm_many_t fft_many;
 
   cf_t*                 sf_symbols[SRSRAN_MAX_PORTS];
   srsran_chest_dl_res_t chest;
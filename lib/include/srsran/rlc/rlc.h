@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_H
 #define SRSRAN_RLC_H
 
+#include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
@@ -105,9 +106,12 @@ private:
   srsue::rrc_interface_rlc*  rrc    = nullptr;
   srsran::timer_handler*     timers = nullptr;
 
-  typedef std::map<uint16_t, std::unique_ptr<rlc_common> >  rlc_map_t;
+  // LCID-indexed tables of RLC entities
+  typedef static_circular_map<uint16_t, std::unique_ptr<rlc_common>, SRSRAN_N_RADIO_BEARERS> rlc_map_t;
+  typedef static_circular_map<uint16_t, std::unique_ptr<rlc_common>, SRSRAN_N_MCH_LCIDS>     rlc_mrb_map_t;
 
-  rlc_map_t        rlc_array, rlc_array_mrb;
+  rlc_map_t        rlc_array;
+  rlc_mrb_map_t    rlc_array_mrb;
   pthread_rwlock_t rwlock;
 
   uint32_t default_lcid = 0;
@@ -27,6 +27,7 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
 #include <array>
+#include <limits>
 #include <list>
 #include <vector>
 
@@ -459,87 +460,235 @@ private:
   size_t                     rpos = 0;
 };
 
+/**
+ * Retransmission queue of the NR AM entity. Entries live in a pool of nodes that is only grown when it runs out, so
+ * that pushing and popping retransmissions does not allocate in steady state. Besides the FIFO order, the entries of
+ * each SN are chained from a table indexed by SN modulo the AM window size, so that lookups and removals by SN only
+ * visit the entries of that SN.
+ */
 template <class T>
-class pdu_retx_queue_list
+class pdu_retx_window
 {
-  std::list<T> queue;
+  static constexpr uint32_t invalid_idx = std::numeric_limits<uint32_t>::max();
+
+  struct node_t {
+    T        retx;
+    uint32_t prev    = invalid_idx; ///< FIFO order, also used to chain the free nodes
+    uint32_t next    = invalid_idx;
+    uint32_t sn_prev = invalid_idx; ///< Chain of the entries with the same SN, newest first
+    uint32_t sn_next = invalid_idx;
+  };
 
 public:
-  ~pdu_retx_queue_list() = default;
-  T& push()
+  class const_iterator
+  {
+  public:
+    const_iterator(const pdu_retx_window<T>* parent_, uint32_t idx_) : parent(parent_), idx(idx_) {}
+    const T&        operator*() const { return parent->nodes[idx].retx; }
+    const T*        operator->() const { return &parent->nodes[idx].retx; }
+    const_iterator& operator++()
+    {
+      idx = parent->nodes[idx].next;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const { return idx == other.idx; }
+    bool operator!=(const const_iterator& other) const { return idx != other.idx; }
+
+  private:
+    const pdu_retx_window<T>* parent;
+    uint32_t                  idx;
+  };
+
+  /// Sets the AM window size (power of 2) and drops all entries
+  void resize(uint32_t window_size, uint32_t initial_capacity = 256)
   {
-    queue.emplace_back();
-    return queue.back();
+    srsran_assert(window_size > 0 and (window_size & (window_size - 1)) == 0, "Invalid window size=%d", window_size);
+    sn_head.assign(window_size, invalid_idx);
+    nodes.clear();
+    nodes.reserve(initial_capacity);
+    head = tail = free_head = invalid_idx;
+    count                   = 0;
   }
 
-  void pop()
+  /// Appends an entry for the given SN. The remaining fields of the entry are set by the caller
+  T& push(uint32_t sn)
   {
-    if (not queue.empty()) {
-      queue.pop_front();
+    srsran_assert(not sn_head.empty(), "Retransmission queue used before being configured");
+    uint32_t idx = alloc_node();
+    node_t&  n   = nodes[idx];
+    n.retx       = T();
+    n.retx.sn    = sn;
+
+    n.prev = tail;
+    n.next = invalid_idx;
+    if (tail != invalid_idx) {
+      nodes[tail].next = idx;
+    } else {
+      head = idx;
     }
+    tail = idx;
+
+    uint32_t& sn_first = sn_head[sn_key(sn)];
+    n.sn_prev          = invalid_idx;
+    n.sn_next          = sn_first;
+    if (sn_first != invalid_idx) {
+      nodes[sn_first].sn_prev = idx;
+    }
+    sn_first = idx;
+    count++;
+    return n.retx;
   }
 
-  T& front()
+  /**
+   * @brief coalesce_segment extends the newest queued segment of the SN with the given bytes, if that segment has not
+   * started to be retransmitted and ends right where the new bytes start. Segments are not coalesced into one that
+   * would span the whole SDU, as it would be sent with the SI of a first segment.
+   * @return true if the bytes were appended to an existing entry, false if a new entry has to be pushed
+   */
+  bool coalesce_segment(uint32_t sn, uint32_t so, uint32_t length, uint32_t sdu_length)
   {
-    assert(not queue.empty());
-    return queue.front();
+    uint32_t idx = find_sn(sn);
+    if (idx == invalid_idx) {
+      return false;
+    }
+    T& retx = nodes[idx].retx;
+    if (not retx.is_segment or retx.current_so != retx.so_start or retx.so_start + retx.segment_length != so) {
+      return false;
+    }
+    if (retx.so_start == 0 and so + length >= sdu_length) {
+      return false;
+    }
+    retx.segment_length += length;
+    return true;
   }
 
-  const std::list<T>& get_inner_queue() const { return queue; }
+  void pop()
+  {
+    if (head != invalid_idx) {
+      erase(head);
+    }
+  }
 
-  void   clear() { queue.clear(); }
-  size_t size() const { return queue.size(); }
-  bool   empty() const { return queue.empty(); }
+  T& front()
+  {
+    srsran_assert(not empty(), "Accessing front of empty retransmission queue");
+    return nodes[head].retx;
+  }
 
-  bool has_sn(uint32_t sn) const
+  void clear()
   {
-    if (queue.empty()) {
-      return false;
+    for (uint32_t idx = head; idx != invalid_idx; idx = nodes[idx].next) {
+      sn_head[sn_key(nodes[idx].retx.sn)] = invalid_idx;
     }
-    for (auto elem : queue) {
-      if (elem.sn == sn) {
-        return true;
-      }
+    // Rebuild the free list in index order, keeping the nodes already allocated
+    free_head = invalid_idx;
+    for (uint32_t idx = nodes.size(); idx > 0; --idx) {
+      nodes[idx - 1].next = free_head;
+      free_head           = idx - 1;
     }
-    return false;
-  };
+    head = tail = invalid_idx;
+    count       = 0;
+  }
+
+  size_t size() const { return count; }
+  bool   empty() const { return count == 0; }
+
+  bool has_sn(uint32_t sn) const { return find_sn(sn) != invalid_idx; }
 
   bool has_sn(uint32_t sn, uint32_t so) const
   {
-    if (queue.empty()) {
+    if (sn_head.empty()) {
       return false;
     }
-    for (auto elem : queue) {
-      if (elem.sn == sn) {
-        if (elem.overlaps(so)) {
-          return true;
-        }
+    for (uint32_t idx = sn_head[sn_key(sn)]; idx != invalid_idx; idx = nodes[idx].sn_next) {
+      if (nodes[idx].retx.sn == sn and nodes[idx].retx.overlaps(so)) {
+        return true;
       }
     }
     return false;
-  };
+  }
 
   /**
-   * @brief remove_sn removes SN from queue and returns after first match
+   * @brief remove_sn removes all the entries of an SN from the queue
    * @param sn sequence number to be removed from queue
-   * @return true if one element was removed, false if no element to remove was found
+   * @return true if at least one element was removed, false if no element to remove was found
    */
   bool remove_sn(uint32_t sn)
   {
-    if (queue.empty()) {
-      return false;
-    }
-    auto iter = queue.begin();
-    while (iter != queue.end()) {
-      if (iter->sn == sn) {
-        iter = queue.erase(iter);
-        return true;
-      } else {
-        ++iter;
+    bool     removed = false;
+    uint32_t idx     = sn_head.empty() ? invalid_idx : sn_head[sn_key(sn)];
+    while (idx != invalid_idx) {
+      uint32_t next = nodes[idx].sn_next;
+      if (nodes[idx].retx.sn == sn) {
+        erase(idx);
+        removed = true;
       }
+      idx = next;
     }
-    return false;
+    return removed;
   }
+
+  const_iterator begin() const { return const_iterator(this, head); }
+  const_iterator end() const { return const_iterator(this, invalid_idx); }
+
+private:
+  uint32_t sn_key(uint32_t sn) const { return sn & (sn_head.size() - 1); }
+
+  uint32_t find_sn(uint32_t sn) const
+  {
+    if (sn_head.empty()) {
+      return invalid_idx;
+    }
+    uint32_t idx = sn_head[sn_key(sn)];
+    while (idx != invalid_idx and nodes[idx].retx.sn != sn) {
+      idx = nodes[idx].sn_next;
+    }
+    return idx;
+  }
+
+  uint32_t alloc_node()
+  {
+    if (free_head == invalid_idx) {
+      nodes.emplace_back();
+      return nodes.size() - 1;
+    }
+    uint32_t idx = free_head;
+    free_head    = nodes[idx].next;
+    return idx;
+  }
+
+  void erase(uint32_t idx)
+  {
+    node_t& n = nodes[idx];
+    if (n.prev != invalid_idx) {
+      nodes[n.prev].next = n.next;
+    } else {
+      head = n.next;
+    }
+    if (n.next != invalid_idx) {
+      nodes[n.next].prev = n.prev;
+    } else {
+      tail = n.prev;
+    }
+    if (n.sn_prev != invalid_idx) {
+      nodes[n.sn_prev].sn_next = n.sn_next;
+    } else {
+      sn_head[sn_key(n.retx.sn)] = n.sn_next;
+    }
+    if (n.sn_next != invalid_idx) {
+      nodes[n.sn_next].sn_prev = n.sn_prev;
+    }
+    n.next    = free_head;
+    free_head = idx;
+    count--;
+  }
+
+  std::vector<node_t>   nodes;
+  std::vector<uint32_t> sn_head;
+  uint32_t              head      = invalid_idx;
+  uint32_t              tail      = invalid_idx;
+  uint32_t              free_head = invalid_idx;
+  size_t                count     = 0;
 };
 
 } // namespace srsran
@@ -164,7 +164,7 @@ private:
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_tx_pdu_nr> > tx_window;
 
   // Queues, buffers and container
-  pdu_retx_queue_list<rlc_amd_retx_nr_t> retx_queue;
+  pdu_retx_window<rlc_amd_retx_nr_t> retx_queue;
   uint32_t         sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
   pdcp_sn_vector_t notify_info_vec;
 
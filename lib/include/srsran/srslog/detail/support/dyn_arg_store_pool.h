@@ -24,6 +24,9 @@
 
 #include "srsran/srslog/bundled/fmt/printf.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
+#include <atomic>
+#include <limits>
+#include <memory>
 
 namespace srslog {
 
@@ -32,34 +35,37 @@ namespace detail {
 /// Keeps a pool of dynamic_format_arg_store objects. The main reason for this class is that the arg store objects are
 /// implemented with std::vectors, so we want to avoid allocating memory each time we create a new object. Instead,
 /// reserve memory for each vector during initialization and recycle the objects.
+/// Free objects are kept in a lock-free stack of indexes. The head carries a tag that changes on every update, so that
+/// a thread that was preempted in the middle of an alloc can not pop an object that was allocated and freed meanwhile.
 class dyn_arg_store_pool
 {
+  static constexpr uint32_t null_idx = std::numeric_limits<uint32_t>::max();
+
 public:
-  dyn_arg_store_pool()
+  dyn_arg_store_pool() : pool(SRSLOG_QUEUE_CAPACITY), next(new std::atomic<uint32_t>[SRSLOG_QUEUE_CAPACITY])
   {
-    pool.resize(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
+    for (uint32_t i = 0; i != SRSLOG_QUEUE_CAPACITY; ++i) {
       // Reserve for 10 normal and 2 named arguments.
-      elem.reserve(10, 2);
-    }
-    free_list.reserve(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
-      free_list.push_back(&elem);
+      pool[i].reserve(10, 2);
+      next[i].store((i + 1 == SRSLOG_QUEUE_CAPACITY) ? null_idx : i + 1, std::memory_order_relaxed);
     }
+    head.store(make_head(0, 0), std::memory_order_relaxed);
   }
 
   /// Returns a pointer to a free dyn arg store object, otherwise returns nullptr.
   fmt::dynamic_format_arg_store<fmt::printf_context>* alloc()
   {
-    scoped_lock lock(m);
-    if (free_list.empty()) {
-      return nullptr;
+    uint64_t old_head = head.load(std::memory_order_acquire);
+    while (true) {
+      uint32_t idx = head_idx(old_head);
+      if (idx == null_idx) {
+        return nullptr;
+      }
+      uint64_t new_head = make_head(next[idx].load(std::memory_order_relaxed), head_tag(old_head) + 1);
+      if (head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire)) {
+        return &pool[idx];
+      }
     }
-
-    auto* p = free_list.back();
-    free_list.pop_back();
-
-    return p;
   }
 
   /// Deallocate the given dyn arg store object returning it to the pool.
@@ -70,14 +76,25 @@ public:
     }
 
     p->clear();
-    scoped_lock lock(m);
-    free_list.push_back(p);
+    uint32_t idx      = static_cast<uint32_t>(p - pool.data());
+    uint64_t old_head = head.load(std::memory_order_relaxed);
+    while (true) {
+      next[idx].store(head_idx(old_head), std::memory_order_relaxed);
+      if (head.compare_exchange_weak(
+              old_head, make_head(idx, head_tag(old_head) + 1), std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+      }
+    }
   }
 
 private:
+  static uint64_t make_head(uint32_t idx, uint32_t tag) { return (uint64_t(tag) << 32U) | idx; }
+  static uint32_t head_idx(uint64_t h) { return static_cast<uint32_t>(h); }
+  static uint32_t head_tag(uint64_t h) { return static_cast<uint32_t>(h >> 32U); }
+
   std::vector<fmt::dynamic_format_arg_store<fmt::printf_context> > pool;
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context>*> free_list;
-  mutable mutex                                                    m;
+  std::unique_ptr<std::atomic<uint32_t>[]>                         next;
+  std::atomic<uint64_t>                                            head;
 };
 
 } // namespace detail
@@ -22,26 +22,63 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 #define SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
-#include "srsran/srslog/detail/support/thread_utils.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace srslog {
 
 namespace detail {
 
-//: TODO: this is a temp work queue.
-
-/// Thread safe generic data type work queue.
+/// Bounded lock-free multi-producer/single-consumer work queue.
+///
+/// Every slot of the ring carries a sequence number that tells producers and
+/// the consumer whose turn it is: producers claim a position with a CAS on the
+/// tail and publish the element by advancing the sequence of its slot, the
+/// consumer owns the head and hands the slot back one lap ahead. Producers never
+/// block, a full queue is reported to the caller instead.
+/// NOTE: push may be called concurrently from any thread, all the pop methods
+/// must be called from a single consumer thread.
 template <typename T, size_t capacity = SRSLOG_QUEUE_CAPACITY>
 class work_queue
 {
-  srsran::dyn_circular_buffer<T> queue;
-  mutable mutex                  m;
-  static constexpr size_t        threshold = capacity * 0.98;
+  static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+  static constexpr size_t mask            = capacity - 1;
+  static constexpr size_t threshold       = capacity * 0.98;
+  static constexpr size_t cache_line_size = 64;
+
+  struct slot {
+    std::atomic<size_t>                                        seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T& value() { return *reinterpret_cast<T*>(&storage); }
+  };
+
+  std::unique_ptr<slot[]> slots;
+  std::atomic<size_t>     tail;
+  // Keep the producer and consumer positions in different cache lines.
+  char                pad[cache_line_size - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> head;
 
 public:
-  work_queue() : queue(capacity) {}
+  work_queue() : slots(new slot[capacity]), tail(0), head(0)
+  {
+    for (size_t i = 0; i != capacity; ++i) {
+      slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~work_queue()
+  {
+    // Destroy the elements that were never popped.
+    while (try_pop_and_discard()) {
+    }
+  }
 
   work_queue(const work_queue&) = delete;
   work_queue& operator=(const work_queue&) = delete;
@@ -50,30 +87,36 @@ public:
   /// queue is full, otherwise true.
   bool push(const T& value)
   {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
-    }
-    queue.push(value);
-    m.unlock();
-
-    return true;
+    T copy(value);
+    return push(std::move(copy));
   }
 
   /// Inserts a new element into the back of the queue. Returns false when the
   /// queue is full, otherwise true.
   bool push(T&& value)
   {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
+    size_t pos = tail.load(std::memory_order_relaxed);
+    slot*  s;
+    while (true) {
+      s          = &slots[pos & mask];
+      size_t seq = s->seq.load(std::memory_order_acquire);
+      auto   dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (dif == 0) {
+        // The slot is free, try to claim the position.
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // Discard the new element if we reach the maximum capacity.
+        return false;
+      } else {
+        // Another producer claimed the position, retry with the new tail.
+        pos = tail.load(std::memory_order_relaxed);
+      }
     }
-    queue.push(std::move(value));
-    m.unlock();
+
+    new (&s->storage) T(std::move(value));
+    s->seq.store(pos + 1, std::memory_order_release);
 
     return true;
   }
@@ -82,32 +125,58 @@ public:
   /// Returns a pair with a bool indicating if the pop has been successful.
   std::pair<bool, T> try_pop()
   {
-    m.lock();
+    std::pair<bool, T> item{false, T()};
+    pop_batch(
+        [&item](T&& value) {
+          item.first  = true;
+          item.second = std::move(value);
+        },
+        1);
+    return item;
+  }
 
-    if (queue.empty()) {
-      m.unlock();
-      return {false, T()};
+  /// Extracts up to max_items consecutive elements from the front of the queue,
+  /// passing each of them to func as an rvalue. Returns the number of popped
+  /// elements.
+  template <typename F>
+  size_t pop_batch(F&& func, size_t max_items = capacity)
+  {
+    size_t pos   = head.load(std::memory_order_relaxed);
+    size_t count = 0;
+    for (; count != max_items; ++count, ++pos) {
+      slot& s = slots[pos & mask];
+      if (s.seq.load(std::memory_order_acquire) != pos + 1) {
+        // Slot not yet published.
+        break;
+      }
+
+      T& value = s.value();
+      func(std::move(value));
+      value.~T();
+
+      // Hand the slot back to the producers for the next lap.
+      s.seq.store(pos + capacity, std::memory_order_release);
+      head.store(pos + 1, std::memory_order_relaxed);
     }
-
-    // Here we have been woken up normally.
-    T Item = std::move(queue.top());
-    queue.pop();
-
-    m.unlock();
-
-    return {true, std::move(Item)};
+    return count;
   }
 
   /// Capacity of the queue.
   size_t get_capacity() const { return capacity; }
 
-  /// Returns true when the queue is almost full, otherwise returns false.
-  bool is_almost_full() const
+  /// Returns an approximation of the number of elements in the queue.
+  size_t size() const
   {
-    scoped_lock lock(m);
-
-    return queue.size() > threshold;
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_relaxed);
+    return (t > h) ? t - h : 0;
   }
+
+  /// Returns true when the queue is almost full, otherwise returns false.
+  bool is_almost_full() const { return size() > threshold; }
+
+private:
+  bool try_pop_and_discard() { return pop_batch([](T&&) {}, 1) != 0; }
 };
 
 } // namespace detail
@@ -120,6 +120,9 @@ private:
   }
 
 private:
+  /// Replays the contexts stored in a binary log through these callbacks.
+  friend class binary_log_decoder;
+
   /// Derived classes should implement the following callbacks to format metric
   /// objects. Each callback is invoked at a different place of the formatting
   /// algorithm.
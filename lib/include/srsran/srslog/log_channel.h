@@ -68,7 +68,8 @@ public:
     should_print_context(config.should_print_context),
     ctx_value(0),
     hex_max_size(0),
-    is_enabled(true)
+    is_enabled(true),
+    nof_dropped(0)
   {}
 
   log_channel(const log_channel& other) = delete;
@@ -87,6 +88,10 @@ public:
   /// Set the log channel context to the specified value.
   void set_context(uint32_t x) { ctx_value = x; }
 
+  /// Returns the number of log entries of this channel that have been
+  /// discarded because the backend was running out of space.
+  uint64_t dropped_entries() const { return nof_dropped.load(std::memory_order_relaxed); }
+
   /// Set the maximum number of bytes to can be printed in a hex dump.
   /// Set to -1 to indicate no hex dump limit.
   void set_hex_dump_max_size(int size) { hex_max_size = size; }
@@ -103,6 +108,7 @@ public:
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
+      count_dropped_entry();
       return;
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
@@ -119,7 +125,9 @@ public:
                                 store,
                                 log_name,
                                 log_tag}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      count_dropped_entry();
+    }
   }
 
   /// Builds the provided log entry and passes it to the backend. When the
@@ -134,6 +142,7 @@ public:
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
+      count_dropped_entry();
       return;
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
@@ -156,7 +165,9 @@ public:
                                 log_name,
                                 log_tag,
                                 std::vector<uint8_t>(buffer, buffer + len)}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      count_dropped_entry();
+    }
   }
 
   /// Builds the provided log entry and passes it to the backend. When the
@@ -180,7 +191,9 @@ public:
                                 nullptr,
                                 log_name,
                                 log_tag}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      count_dropped_entry();
+    }
   }
 
   /// Builds the provided log entry and passes it to the backend. When the
@@ -195,6 +208,7 @@ public:
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
+      count_dropped_entry();
       return;
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
@@ -211,9 +225,14 @@ public:
                                 store,
                                 log_name,
                                 log_tag}};
-    backend.push(std::move(entry));
+    if (!backend.push(std::move(entry))) {
+      count_dropped_entry();
+    }
   }
 
+private:
+  void count_dropped_entry() { nof_dropped.fetch_add(1, std::memory_order_relaxed); }
+
 private:
   const std::string     log_id;
   sink&                 log_sink;
@@ -224,6 +243,7 @@ private:
   std::atomic<uint32_t> ctx_value;
   std::atomic<int>      hex_max_size;
   std::atomic<bool>     is_enabled;
+  std::atomic<uint64_t> nof_dropped;
 };
 
 } // namespace srslog
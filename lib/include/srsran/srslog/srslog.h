@@ -156,6 +156,13 @@ std::unique_ptr<log_formatter> create_text_formatter();
 /// Creates a new instance of a JSON formatter.
 std::unique_ptr<log_formatter> create_json_formatter();
 
+/// Creates a new instance of a binary formatter. Log entries are stored
+/// unformatted and have to be converted to text offline with the
+/// srslog_decoder tool, passing the files of a rotated log in order.
+/// NOTE: Each instance holds the string tables of one log, so it should not be
+/// shared by sinks writing to different files.
+std::unique_ptr<log_formatter> create_binary_formatter();
+
 ///
 /// Sink management functions.
 ///
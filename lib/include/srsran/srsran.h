@@ -43,6 +43,7 @@ extern "C" {
 
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/common/sequence.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/common/timestamp.h"
 #include "srsran/phy/utils/phy_logger.h"
 
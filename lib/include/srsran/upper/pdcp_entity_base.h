@@ -23,10 +23,12 @@
 #define SRSRAN_PDCP_ENTITY_BASE_H
 
 #include "srsran/adt/accumulators.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/security.h"
+#include "srsran/common/security_aes.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/timers.h"
@@ -48,6 +50,9 @@ namespace srsran {
 // See TS 38.323 v15.2.0, section 4.3.1
 #define PDCP_MAX_SDU_SIZE 9000
 
+// Maximum number of SDUs ciphered in one pass by write_sdus()
+#define PDCP_MAX_TX_BURST 32
+
 typedef enum {
   PDCP_D_C_CONTROL_PDU = 0,
   PDCP_D_C_DATA_PDU,
@@ -120,6 +125,8 @@ public:
 
   // GW/SDAP/RRC interface
   virtual void write_sdu(unique_byte_buffer_t sdu, int sn = -1) = 0;
+  // Handles a burst of SDUs of this bearer, ciphering all of them in one pass. The SDUs are moved out of "sdus"
+  virtual void write_sdus(span<unique_byte_buffer_t> sdus) = 0;
 
   // RLC interface
   virtual void write_pdu(unique_byte_buffer_t pdu)               = 0;
@@ -169,11 +176,18 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // AES-128 key schedules for 128-EEA2/128-EIA2, expanded once in config_security()
+  srsran::aes_128_key_schedule rrc_enc_aes;
+  srsran::aes_128_key_schedule up_enc_aes;
+  srsran::aes_128_key_schedule rrc_int_aes;
+  srsran::aes_128_key_schedule up_int_aes;
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   void cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct);
   void cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg);
+  void cipher_encrypt_burst(span<const cipher_burst_item_t> pdus);
 
   // Common packing functions
   bool            is_control_pdu(const unique_byte_buffer_t& pdu);
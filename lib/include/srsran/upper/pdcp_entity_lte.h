@@ -126,6 +126,7 @@ public:
 
   // GW/RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) override;
+  void write_sdus(span<unique_byte_buffer_t> sdus) override;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) override;
@@ -166,6 +167,21 @@ private:
   uint32_t reordering_window = 0;
   uint32_t maximum_pdcp_sn   = 0;
 
+  // TX helpers. prepare_tx_pdu() adds header and MAC-I and returns false if the SDU has to be dropped
+  bool prepare_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn, uint32_t& tx_count);
+  void send_tx_pdu(unique_byte_buffer_t pdu);
+
+  // TX state before preparing an SDU of a burst, restored if RLC cannot take the resulting PDU
+  struct tx_state_t {
+    uint32_t           next_pdcp_tx_sn;
+    uint32_t           tx_hfn;
+    int32_t            enable_security_tx_sn;
+    srsran_direction_t integrity_direction;
+    srsran_direction_t encryption_direction;
+  };
+  tx_state_t get_tx_state() const;
+  void       discard_tx_burst(span<unique_byte_buffer_t> pdus, const tx_state_t& state);
+
   // PDU handlers
   void handle_control_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_srb_pdu(srsran::unique_byte_buffer_t pdu);
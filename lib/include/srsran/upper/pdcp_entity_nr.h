@@ -55,6 +55,7 @@ public:
 
   // RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) final;
+  void write_sdus(span<unique_byte_buffer_t> sdus) final;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) final;
@@ -102,6 +103,11 @@ private:
   std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
   timer_handler::unique_timer              reordering_timer;
 
+  // TX helpers. prepare_tx_pdu() adds header and MAC-I and returns false if the SDU has to be dropped
+  bool prepare_tx_pdu(unique_byte_buffer_t& sdu);
+  void send_tx_pdu(unique_byte_buffer_t pdu);
+  void discard_tx_burst(span<unique_byte_buffer_t> pdus, uint32_t tx_next_, bool tx_overflow_);
+
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
   void pass_to_upper_layers(unique_byte_buffer_t pdu);
@@ -109,6 +109,27 @@ map_enum_number<const int64_t>(const int64_t* array, uint32_t nof_types, uint32_
 template const float
 map_enum_number<const float>(const float* array, uint32_t nof_types, uint32_t enum_val, const char* enum_type);
 
+/*********************
+     unpack arena
+*********************/
+
+void* unpack_arena::allocate_new_block(std::size_t nof_bytes)
+{
+  // Reuse the blocks kept by reset() before allocating new ones. Blocks are allocated with new[], so they are aligned
+  // for any fundamental type at offset 0
+  cur_block = (cur_block < blocks.size()) ? cur_block + 1 : blocks.size();
+  while (cur_block < blocks.size() and blocks[cur_block].size < nof_bytes) {
+    ++cur_block;
+  }
+  if (cur_block == blocks.size()) {
+    std::size_t sz = std::max(block_size, nof_bytes);
+    blocks.push_back(block_t{std::unique_ptr<uint8_t[]>(new uint8_t[sz]), sz});
+  }
+  cur_offset = nof_bytes;
+  nof_bytes_used += nof_bytes;
+  return blocks[cur_block].data.get();
+}
+
 /*********************
        bit_ref
 *********************/
@@ -144,12 +165,51 @@ int bit_ref_impl<Ptr>::distance_bytes_end() const
   return ((int)(max_ptr - ptr)) - ((offset) ? 1 : 0);
 }
 
+// Big-endian 64-bit word accesses, used to read or write all the bits of a field at once
+static inline uint64_t load_be64(const uint8_t* ptr)
+{
+  uint64_t w;
+  memcpy(&w, ptr, sizeof(w));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  w = __builtin_bswap64(w);
+#endif
+  return w;
+}
+
+static inline void store_be64(uint8_t* ptr, uint64_t w)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  w = __builtin_bswap64(w);
+#endif
+  memcpy(ptr, &w, sizeof(w));
+}
+
 SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
 {
   if (n_bits >= 64) {
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+  uint32_t end_bit = offset + n_bits;
+  if (end_bit <= 64 and ptr + (end_bit + 7) / 8 <= max_ptr) {
+    // Fast path: place the field in a 64-bit word aligned to the current byte, and write the bytes it spans. As in the
+    // bitwise path below, the bits of the current byte before the offset are kept, the remaining bits of the last byte
+    // written are zeroed, and the following bytes are left untouched
+    uint64_t w = (val & ((1ULL << n_bits) - 1)) << (64 - end_bit);
+    if (offset != 0) {
+      w |= (uint64_t)(*ptr & (uint8_t)(0xffu << (8u - offset))) << 56u;
+    }
+    uint32_t nof_bytes = (end_bit + 7) / 8;
+    for (uint32_t i = 0; i < nof_bytes; ++i) {
+      ptr[i] = static_cast<uint8_t>(w >> (56u - 8u * i));
+    }
+    ptr += end_bit / 8;
+    offset = end_bit % 8;
+    return SRSASN_SUCCESS;
+  }
   uint64_t mask;
   while (n_bits > 0) {
     if (ptr >= max_ptr) {
@@ -182,6 +242,18 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     log_error("This method only supports unpacking up to %d bits", (int)sizeof(T) * 8);
     return SRSASN_ERROR_DECODE_FAIL;
   }
+  if (n_bits == 0) {
+    val = 0;
+    return SRSASN_SUCCESS;
+  }
+  uint32_t end_bit = offset + n_bits;
+  if (end_bit <= 64 and ptr + sizeof(uint64_t) <= max_ptr) {
+    // Fast path: extract the field from the 64-bit word starting at ptr
+    val = static_cast<T>((load_be64(ptr) << offset) >> (64 - n_bits));
+    ptr += end_bit / 8;
+    offset = end_bit % 8;
+    return SRSASN_SUCCESS;
+  }
   val = 0;
   while (n_bits > 0) {
     if (ptr >= max_ptr) {
@@ -260,9 +332,15 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
-    for (uint32_t i = 0; i < n_bytes; ++i) {
-      HANDLE_CODE(unpack(buf[i], 8));
+    // Every output byte takes the last 8 - offset bits of one input byte and the first offset bits of the next one
+    uint32_t i = 0;
+    for (; i + sizeof(uint64_t) <= n_bytes; i += sizeof(uint64_t)) {
+      store_be64(&buf[i], (load_be64(ptr + i) << offset) | (ptr[i + sizeof(uint64_t)] >> (8u - offset)));
+    }
+    for (; i < n_bytes; ++i) {
+      buf[i] = static_cast<uint8_t>((ptr[i] << offset) | (ptr[i + 1] >> (8u - offset)));
     }
+    ptr += n_bytes;
   }
   return SRSASN_SUCCESS;
 }
@@ -285,8 +363,8 @@ template <typename Ptr>
 SRSASN_CODE bit_ref_impl<Ptr>::advance_bits(uint32_t n_bits)
 {
   uint32_t extra_bits     = (offset + n_bits) % 8;
-  uint32_t bytes_required = ceilf((offset + n_bits) / 8.0f);
-  uint32_t bytes_offset   = floorf((offset + n_bits) / 8.0f);
+  uint32_t bytes_required = (offset + n_bits + 7) / 8;
+  uint32_t bytes_offset   = (offset + n_bits) / 8;
 
   if (ptr + bytes_required > max_ptr) {
     log_error("advance_bytes: Buffer size limit was achieved");
@@ -323,9 +401,21 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
-    for (uint32_t i = 0; i < n_bytes; ++i) {
-      pack(buf[i], 8);
+    // Each input byte is split between two output bytes. The bits of the first byte before the offset are kept
+    uint32_t rshift = offset, lshift = 8u - offset;
+    uint8_t  carry  = static_cast<uint8_t>(*ptr & (uint8_t)(0xffu << lshift));
+    uint32_t i      = 0;
+    for (; i + sizeof(uint64_t) <= n_bytes; i += sizeof(uint64_t)) {
+      uint64_t w = load_be64(&buf[i]);
+      store_be64(ptr + i, ((uint64_t)carry << 56u) | (w >> rshift));
+      carry = static_cast<uint8_t>(w << lshift);
+    }
+    for (; i < n_bytes; ++i) {
+      ptr[i] = static_cast<uint8_t>(carry | (buf[i] >> rshift));
+      carry  = static_cast<uint8_t>(buf[i] << lshift);
     }
+    ptr[n_bytes] = carry;
+    ptr += n_bytes;
   }
   return SRSASN_SUCCESS;
 }
@@ -402,10 +492,10 @@ SRSASN_CODE pack_enum(bit_ref& bref, uint32_t e, uint32_t nof_types, uint32_t no
   }
   SRSASN_CODE ret;
   if (has_ext) {
-    uint32_t nof_bits = (uint32_t)ceilf(log2f(nof_types - nof_exts));
+    uint32_t nof_bits = ceil_log2(nof_types - nof_exts);
     ret               = pack_enum(bref, e, nof_bits, nof_types - nof_exts);
   } else {
-    uint32_t nof_bits = (uint32_t)ceilf(log2f(nof_types));
+    uint32_t nof_bits = ceil_log2(nof_types);
     ret               = pack_enum(bref, e, nof_bits);
   }
   return ret;
@@ -415,7 +505,7 @@ ValOrError unpack_enum(uint32_t nof_types, uint32_t nof_exts, bool has_ext, cbit
 {
   ValOrError ret;
   if (has_ext) {
-    uint32_t nof_bits = (uint32_t)ceilf(log2f(nof_types - nof_exts));
+    uint32_t nof_bits = ceil_log2(nof_types - nof_exts);
     bool     ext;
     ret.code = bref.unpack(ext, 1);
     if (ret.code != SRSASN_SUCCESS) {
@@ -428,7 +518,7 @@ ValOrError unpack_enum(uint32_t nof_types, uint32_t nof_exts, bool has_ext, cbit
       ret.val += nof_types - nof_exts;
     }
   } else {
-    uint32_t nof_bits = (uint32_t)ceilf(log2f(nof_types));
+    uint32_t nof_bits = ceil_log2(nof_types);
     ret.code          = bref.unpack(ret.val, nof_bits);
   }
   if (ret.val >= nof_types) {
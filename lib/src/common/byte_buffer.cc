@@ -24,25 +24,103 @@
 
 namespace srsran {
 
+namespace {
+
+void* allocate_tagged_block(byte_buffer_size_class size_class) noexcept
+{
+  void* block = nullptr;
+  switch (size_class) {
+    case byte_buffer_size_class::small:
+      block = byte_buffer_class_pool<byte_buffer_size_class::small>::get_instance()->allocate_node(
+          detail::byte_buffer_block_size(size_class));
+      break;
+    case byte_buffer_size_class::medium:
+      block = byte_buffer_class_pool<byte_buffer_size_class::medium>::get_instance()->allocate_node(
+          detail::byte_buffer_block_size(size_class));
+      break;
+    default:
+      block = byte_buffer_pool::get_instance()->allocate_node(detail::byte_buffer_block_size(size_class));
+      break;
+  }
+  if (block == nullptr) {
+    return nullptr;
+  }
+  *static_cast<byte_buffer_size_class*>(block) = size_class;
+  return offset_byte_ptr(block, detail::byte_buffer_tag_size);
+}
+
+void deallocate_tagged_block(void* ptr) noexcept
+{
+  void* block = static_cast<uint8_t*>(ptr) - detail::byte_buffer_tag_size;
+  switch (*static_cast<byte_buffer_size_class*>(block)) {
+    case byte_buffer_size_class::small:
+      byte_buffer_class_pool<byte_buffer_size_class::small>::get_instance()->deallocate_node(block);
+      break;
+    case byte_buffer_size_class::medium:
+      byte_buffer_class_pool<byte_buffer_size_class::medium>::get_instance()->deallocate_node(block);
+      break;
+    default:
+      byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+  }
+}
+
+template <byte_buffer_size_class SizeClass>
+void fill_class_metrics(byte_buffer_pool_metrics_t& metrics)
+{
+  auto*                                        pool = byte_buffer_class_pool<SizeClass>::get_instance();
+  byte_buffer_pool_metrics_t::class_metrics_t& m    = metrics.classes[(size_t)SizeClass];
+  m.payload_size    = byte_buffer_class_capacity(SizeClass) - SRSRAN_BUFFER_HEADER_OFFSET;
+  m.block_size      = detail::byte_buffer_block_size(SizeClass);
+  m.nof_blocks      = pool->size();
+  m.nof_free_blocks = pool->nof_free_blocks();
+}
+
+} // namespace
+
 void* byte_buffer_t::operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept
 {
   assert(sz == sizeof(byte_buffer_t));
-  return byte_buffer_pool::get_instance()->allocate_node(sz);
+  return allocate_tagged_block(byte_buffer_size_class::large);
 }
 
 void* byte_buffer_t::operator new(size_t sz)
 {
   assert(sz == sizeof(byte_buffer_t));
-  void* ptr = byte_buffer_pool::get_instance()->allocate_node(sz);
+  void* ptr = allocate_tagged_block(byte_buffer_size_class::large);
   if (ptr == nullptr) {
     throw std::bad_alloc();
   }
   return ptr;
 }
 
+void* byte_buffer_t::operator new(size_t                 sz,
+                                  byte_buffer_size_class size_class,
+                                  const std::nothrow_t&  nothrow_value) noexcept
+{
+  assert(sz == sizeof(byte_buffer_t));
+  return allocate_tagged_block(size_class);
+}
+
 void byte_buffer_t::operator delete(void* ptr)
 {
-  byte_buffer_pool::get_instance()->deallocate_node(ptr);
+  deallocate_tagged_block(ptr);
+}
+
+void byte_buffer_t::operator delete(void*                  ptr,
+                                    byte_buffer_size_class size_class,
+                                    const std::nothrow_t&  nothrow_value) noexcept
+{
+  deallocate_tagged_block(ptr);
+}
+
+byte_buffer_pool_metrics_t get_byte_buffer_pool_metrics()
+{
+  byte_buffer_pool_metrics_t metrics;
+  fill_class_metrics<byte_buffer_size_class::small>(metrics);
+  fill_class_metrics<byte_buffer_size_class::medium>(metrics);
+  fill_class_metrics<byte_buffer_size_class::large>(metrics);
+  return metrics;
 }
 
 } // namespace srsran
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/latency_histogram.h"
+#include <algorithm>
+
+namespace srsran {
+
+double latency_hist_metrics_t::percentile_us(double quantile) const
+{
+  if (count == 0) {
+    return 0.0;
+  }
+  uint64_t target = std::max<uint64_t>(1, (uint64_t)(quantile * count + 0.5));
+  uint64_t acc    = 0;
+  for (uint32_t bin = 0; bin < LATENCY_HIST_NOF_BINS - 1; ++bin) {
+    acc += bins[bin];
+    if (acc >= target) {
+      return std::min(latency_hist_bin_max_ns(bin), max_ns) / 1000.0;
+    }
+  }
+  return max_ns / 1000.0;
+}
+
+uint32_t latency_histogram::get_shard_idx()
+{
+  static std::atomic<uint32_t> next_shard_idx = {0};
+  static thread_local uint32_t shard_idx      = next_shard_idx.fetch_add(1, std::memory_order_relaxed) % nof_shards;
+  return shard_idx;
+}
+
+latency_hist_metrics_t latency_histogram::read_metrics()
+{
+  latency_hist_metrics_t m;
+  for (shard_t& s : shards) {
+    m.count += s.count.exchange(0, std::memory_order_relaxed);
+    m.sum_ns += s.sum_ns.exchange(0, std::memory_order_relaxed);
+    m.max_ns = std::max(m.max_ns, s.max_ns.exchange(0, std::memory_order_relaxed));
+    for (uint32_t bin = 0; bin < LATENCY_HIST_NOF_BINS; ++bin) {
+      m.bins[bin] += s.bins[bin].exchange(0, std::memory_order_relaxed);
+    }
+  }
+  return m;
+}
+
+const char* tti_stage_to_string(tti_stage stage)
+{
+  static const char* names[] = {
+      "rx_wait", "fft", "chest", "dl_encode", "ul_decode", "mac_sched", "sf_proc", "radio_tx", "invalid"};
+  return names[std::min((uint32_t)stage, NOF_TTI_STAGES)];
+}
+
+static std::array<latency_histogram, NOF_TTI_STAGES> tti_latency_histograms;
+
+latency_histogram& get_tti_latency_histogram(tti_stage stage)
+{
+  return tti_latency_histograms[(uint32_t)stage];
+}
+
+tti_latency_metrics_t get_tti_latency_metrics()
+{
+  tti_latency_metrics_t m;
+  for (uint32_t i = 0; i < NOF_TTI_STAGES; ++i) {
+    m.stages[i] = tti_latency_histograms[i].read_metrics();
+  }
+  return m;
+}
+
+} // namespace srsran
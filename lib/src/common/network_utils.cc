@@ -662,15 +662,17 @@ public:
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
-      logger.error("Unable to allocate byte buffer");
-      return true;
+    if (rx_buffer == nullptr) {
+      rx_buffer = srsran::make_byte_buffer();
+      if (rx_buffer == nullptr) {
+        logger.error("Unable to allocate byte buffer");
+        return true;
+      }
     }
     sockaddr_in from    = {};
     socklen_t   fromlen = sizeof(from);
 
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
+    ssize_t n_recv = recvfrom(fd, rx_buffer->msg, rx_buffer->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
       return true;
@@ -680,7 +682,17 @@ public:
       return true;
     }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    // Small datagrams are copied to a byte buffer of a smaller size class. The receive buffer is reused.
+    srsran::unique_byte_buffer_t pdu;
+    if (srsran::byte_buffer_select_class(n_recv) != srsran::byte_buffer_size_class::large) {
+      pdu = srsran::make_byte_buffer(rx_buffer->msg, n_recv, __FUNCTION__);
+      if (pdu == nullptr) {
+        return true;
+      }
+    } else {
+      pdu          = std::move(rx_buffer);
+      pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    }
 
     // Defer handling of received packet to provided queue
     queue.push(
@@ -690,9 +702,10 @@ public:
   }
 
 private:
-  srslog::basic_logger&      logger;
-  srsran::task_queue_handle& queue;
-  callback_t                 func;
+  srslog::basic_logger&        logger;
+  srsran::task_queue_handle&   queue;
+  callback_t                   func;
+  srsran::unique_byte_buffer_t rx_buffer;
 };
 
 socket_manager_itf::recv_callback_t
@@ -701,4 +714,101 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+/**
+ * Description: Functor for the case the received data is in the form of unique_byte_buffer, and a recvmmsg(...) call
+ * is used to read all the pending datagrams at once. The whole burst is dispatched to the queue as a single task
+ */
+class recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvmmsg_callback_t;
+  explicit recvmmsg_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
+    logger(logger), queue(queue_), func(std::move(func_))
+  {}
+
+  bool operator()(int fd)
+  {
+    // Refill the receive buffers that were handed over in the previous burst
+    uint32_t nof_buffers = 0;
+    for (; nof_buffers < SOCKET_MAX_RX_BURST; ++nof_buffers) {
+      srsran::unique_byte_buffer_t& rx_buffer = rx_buffers[nof_buffers];
+      if (rx_buffer == nullptr) {
+        rx_buffer = srsran::make_byte_buffer();
+        if (rx_buffer == nullptr) {
+          logger.error("Unable to allocate byte buffer");
+          break;
+        }
+      }
+      iovecs[nof_buffers].iov_base          = rx_buffer->msg;
+      iovecs[nof_buffers].iov_len           = rx_buffer->get_tailroom();
+      msgs[nof_buffers].msg_hdr             = {};
+      msgs[nof_buffers].msg_hdr.msg_name    = &from[nof_buffers];
+      msgs[nof_buffers].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[nof_buffers].msg_hdr.msg_iov     = &iovecs[nof_buffers];
+      msgs[nof_buffers].msg_hdr.msg_iovlen  = 1;
+      msgs[nof_buffers].msg_len             = 0;
+    }
+    if (nof_buffers == 0) {
+      return true;
+    }
+
+    // Wait for the first datagram only, and read whatever else is already pending
+    int n_recv = recvmmsg(fd, msgs.data(), nof_buffers, MSG_WAITFORONE, nullptr);
+    if (n_recv == -1 and errno != EAGAIN) {
+      logger.error("Error reading from socket: %s", strerror(errno));
+      return true;
+    }
+    if (n_recv == -1 and errno == EAGAIN) {
+      logger.debug("Socket timeout reached");
+      return true;
+    }
+
+    rx_sdu_burst_t burst;
+    for (int i = 0; i < n_recv; ++i) {
+      uint32_t len = msgs[i].msg_len;
+      if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+        logger.warning("Discarding truncated datagram of %d bytes", len);
+        continue;
+      }
+
+      // Small datagrams are copied to a byte buffer of a smaller size class. The receive buffer is reused.
+      rx_sdu_t rx_sdu;
+      rx_sdu.from = from[i];
+      if (srsran::byte_buffer_select_class(len) != srsran::byte_buffer_size_class::large) {
+        rx_sdu.sdu = srsran::make_byte_buffer(rx_buffers[i]->msg, len, __FUNCTION__);
+        if (rx_sdu.sdu == nullptr) {
+          continue;
+        }
+      } else {
+        rx_sdu.sdu          = std::move(rx_buffers[i]);
+        rx_sdu.sdu->N_bytes = len;
+      }
+      burst.push_back(std::move(rx_sdu));
+    }
+    if (burst.empty()) {
+      return true;
+    }
+
+    // Defer handling of the received burst to provided queue
+    queue.push(std::bind([this](rx_sdu_burst_t& sdus) { func(sdus); }, std::move(burst)));
+
+    return true;
+  }
+
+private:
+  srslog::basic_logger&                                         logger;
+  srsran::task_queue_handle&                                    queue;
+  callback_t                                                    func;
+  std::array<srsran::unique_byte_buffer_t, SOCKET_MAX_RX_BURST> rx_buffers;
+  std::array<mmsghdr, SOCKET_MAX_RX_BURST>                      msgs;
+  std::array<iovec, SOCKET_MAX_RX_BURST>                        iovecs;
+  std::array<sockaddr_in, SOCKET_MAX_RX_BURST>                  from;
+};
+
+socket_manager_itf::recv_callback_t
+make_sdu_burst_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvmmsg_callback_t rx_callback)
+{
+  return socket_manager_itf::recv_callback_t(recvmmsg_pdu_task(logger, queue, std::move(rx_callback)));
+}
+
 } // namespace srsran
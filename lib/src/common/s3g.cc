@@ -21,6 +21,10 @@
 
 #include "srsran/common/s3g.h"
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
+
 /* S-box SQ */
 static const uint8_t SQ[256] = {
     0x25, 0x24, 0x73, 0x67, 0xD7, 0xAE, 0x5C, 0x30, 0xA4, 0xEE, 0x6E, 0xCB, 0x7D, 0xB5, 0x82, 0xDB, 0xE4, 0x8E, 0x48,
@@ -565,4 +569,260 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
     MAC_I[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
 
   return MAC_I;
-}
\ No newline at end of file
+}
+/*********************************************************************
+    Multi-buffer SNOW 3G
+
+    The LFSR of every lane is kept in a circular buffer of 16 words.
+    At clock t, word s_i is found in lfsr[(t + i) % 16] and the new
+    s_15 replaces s_0 in lfsr[t % 16]. Keystream words are generated in
+    blocks of S3G_MB_NOF_WORDS = 16 clocks, so that the LFSR is back in
+    its natural order at the end of every block.
+*********************************************************************/
+
+typedef struct {
+  uint32_t s1[4][256];
+  uint32_t s2[4][256];
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+} s3g_mb_tables_t;
+
+/* Below this number of lanes, lanes are initialized and clocked one by one */
+#define S3G_MB_MIN_SIMD_LANES 3
+
+static uint32_t s3g_mb_rotr(uint32_t x, uint32_t n)
+{
+  return (x >> n) | (x << (32 - n));
+}
+
+/* The S-boxes S1 and S2 are a byte substitution followed by a MixColumn
+ * operation, which is computed as the XOR of four rotated table entries. */
+static void s3g_mb_fill_sbox_table(uint32_t table[4][256], const uint8_t* sbox, uint8_t c)
+{
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t s  = sbox[i];
+    uint32_t mx = s3g_mul_x(sbox[i], c);
+    table[0][i] = (mx << 24) | ((mx ^ s) << 16) | (s << 8) | s;
+    table[1][i] = s3g_mb_rotr(table[0][i], 8);
+    table[2][i] = s3g_mb_rotr(table[0][i], 16);
+    table[3][i] = s3g_mb_rotr(table[0][i], 24);
+  }
+}
+
+static const s3g_mb_tables_t* s3g_mb_get_tables()
+{
+  static const s3g_mb_tables_t* tables = []() {
+    static s3g_mb_tables_t t;
+    s3g_mb_fill_sbox_table(t.s1, S, 0x1b);
+    s3g_mb_fill_sbox_table(t.s2, SQ, 0x69);
+    for (uint32_t i = 0; i < 256; i++) {
+      t.mul_alpha[i] = s3g_mul_alpha(i);
+      t.div_alpha[i] = s3g_div_alpha(i);
+    }
+    return &t;
+  }();
+  return tables;
+}
+
+static inline uint32_t s3g_mb_sbox(const uint32_t table[4][256], uint32_t w)
+{
+  return table[0][w >> 24] ^ table[1][(w >> 16) & 0xff] ^ table[2][(w >> 8) & 0xff] ^ table[3][w & 0xff];
+}
+
+/* Loads the key and IV in the LFSR, as in section 4.1 */
+static void s3g_mb_load_key(uint32_t s[16], const uint32_t k[4], const uint32_t iv[4])
+{
+  s[15] = k[3] ^ iv[0];
+  s[14] = k[2];
+  s[13] = k[1];
+  s[12] = k[0] ^ iv[1];
+  s[11] = k[3] ^ 0xffffffff;
+  s[10] = k[2] ^ 0xffffffff ^ iv[2];
+  s[9]  = k[1] ^ 0xffffffff ^ iv[3];
+  s[8]  = k[0] ^ 0xffffffff;
+  s[7]  = k[3];
+  s[6]  = k[2];
+  s[5]  = k[1];
+  s[4]  = k[0];
+  s[3]  = k[3] ^ 0xffffffff;
+  s[2]  = k[2] ^ 0xffffffff;
+  s[1]  = k[1] ^ 0xffffffff;
+  s[0]  = k[0] ^ 0xffffffff;
+}
+
+void s3g_mb_initialize_lane(S3G_MB_STATE* state, uint32_t lane, const uint32_t k[4], const uint32_t iv[4])
+{
+  const s3g_mb_tables_t* tab = s3g_mb_get_tables();
+  uint32_t               s[16];
+  uint32_t               r1 = 0, r2 = 0, r3 = 0;
+
+  s3g_mb_load_key(s, k, iv);
+
+  // 32 clocks in initialisation mode and one clock in keystream mode, discarding the FSM output
+  uint32_t t = 0;
+  for (; t < 33; t++) {
+    uint32_t s0  = s[t % 16];
+    uint32_t s11 = s[(t + 11) % 16];
+    uint32_t f   = (s[(t + 15) % 16] + r1) ^ r2;
+    uint32_t r   = r2 + (r3 ^ s[(t + 5) % 16]);
+    r3           = s3g_mb_sbox(tab->s2, r2);
+    r2           = s3g_mb_sbox(tab->s1, r1);
+    r1           = r;
+
+    uint32_t v = (s0 << 8) ^ tab->mul_alpha[s0 >> 24] ^ s[(t + 2) % 16] ^ (s11 >> 8) ^ tab->div_alpha[s11 & 0xff];
+    s[t % 16]  = (t < 32) ? (v ^ f) : v;
+  }
+
+  for (uint32_t i = 0; i < 16; i++) {
+    state->lfsr[i][lane] = s[(t + i) % 16];
+  }
+  state->fsm[0][lane] = r1;
+  state->fsm[1][lane] = r2;
+  state->fsm[2][lane] = r3;
+}
+
+/* Clocks a single lane S3G_MB_NOF_WORDS times in keystream mode. The lane
+ * state is copied to local variables so that it can be kept in registers. */
+static void s3g_mb_generate_lane(S3G_MB_STATE* state, uint32_t lane, uint32_t* ks)
+{
+  const s3g_mb_tables_t* tab = s3g_mb_get_tables();
+  uint32_t               s[16];
+  uint32_t               r1 = state->fsm[0][lane], r2 = state->fsm[1][lane], r3 = state->fsm[2][lane];
+
+  for (uint32_t i = 0; i < 16; i++) {
+    s[i] = state->lfsr[i][lane];
+  }
+
+  for (uint32_t t = 0; t < S3G_MB_NOF_WORDS; t++) {
+    uint32_t s0  = s[t % 16];
+    uint32_t s11 = s[(t + 11) % 16];
+
+    ks[t * S3G_MB_NOF_LANES + lane] = ((s[(t + 15) % 16] + r1) ^ r2) ^ s0;
+
+    uint32_t r = r2 + (r3 ^ s[(t + 5) % 16]);
+    r3         = s3g_mb_sbox(tab->s2, r2);
+    r2         = s3g_mb_sbox(tab->s1, r1);
+    r1         = r;
+
+    s[t % 16] = (s0 << 8) ^ tab->mul_alpha[s0 >> 24] ^ s[(t + 2) % 16] ^ (s11 >> 8) ^ tab->div_alpha[s11 & 0xff];
+  }
+
+  for (uint32_t i = 0; i < 16; i++) {
+    state->lfsr[i][lane] = s[i];
+  }
+  state->fsm[0][lane] = r1;
+  state->fsm[1][lane] = r2;
+  state->fsm[2][lane] = r3;
+}
+
+#ifdef LV_HAVE_AVX2
+
+static inline __m256i s3g_mb_sbox_avx2(const uint32_t table[4][256], __m256i w)
+{
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  __m256i       r    = _mm256_i32gather_epi32((const int*)table[0], _mm256_srli_epi32(w, 24), 4);
+  r = _mm256_xor_si256(
+      r, _mm256_i32gather_epi32((const int*)table[1], _mm256_and_si256(_mm256_srli_epi32(w, 16), mask), 4));
+  r = _mm256_xor_si256(
+      r, _mm256_i32gather_epi32((const int*)table[2], _mm256_and_si256(_mm256_srli_epi32(w, 8), mask), 4));
+  return _mm256_xor_si256(r, _mm256_i32gather_epi32((const int*)table[3], _mm256_and_si256(w, mask), 4));
+}
+
+/* Clocks all lanes from clock t_begin to t_end, one 256-bit register per
+ * LFSR/FSM word. In initialisation mode the FSM output is fed back to the
+ * LFSR, otherwise the keystream is written in ks (if not NULL). */
+static void s3g_mb_clock_avx2(S3G_MB_STATE* state, uint32_t t_begin, uint32_t t_end, bool init, uint32_t* ks)
+{
+  const s3g_mb_tables_t* tab  = s3g_mb_get_tables();
+  const __m256i          mask = _mm256_set1_epi32(0xff);
+  __m256i                r1   = _mm256_loadu_si256((__m256i*)state->fsm[0]);
+  __m256i                r2   = _mm256_loadu_si256((__m256i*)state->fsm[1]);
+  __m256i                r3   = _mm256_loadu_si256((__m256i*)state->fsm[2]);
+
+  for (uint32_t t = t_begin; t < t_end; t++) {
+    __m256i s0  = _mm256_loadu_si256((__m256i*)state->lfsr[t % 16]);
+    __m256i s2  = _mm256_loadu_si256((__m256i*)state->lfsr[(t + 2) % 16]);
+    __m256i s5  = _mm256_loadu_si256((__m256i*)state->lfsr[(t + 5) % 16]);
+    __m256i s11 = _mm256_loadu_si256((__m256i*)state->lfsr[(t + 11) % 16]);
+    __m256i s15 = _mm256_loadu_si256((__m256i*)state->lfsr[(t + 15) % 16]);
+
+    __m256i f = _mm256_xor_si256(_mm256_add_epi32(s15, r1), r2);
+    if (ks != NULL) {
+      _mm256_storeu_si256((__m256i*)&ks[(t - t_begin) * S3G_MB_NOF_LANES], _mm256_xor_si256(f, s0));
+    }
+
+    __m256i r = _mm256_add_epi32(r2, _mm256_xor_si256(r3, s5));
+    r3        = s3g_mb_sbox_avx2(tab->s2, r2);
+    r2        = s3g_mb_sbox_avx2(tab->s1, r1);
+    r1        = r;
+
+    __m256i v = _mm256_xor_si256(_mm256_slli_epi32(s0, 8), s2);
+    v = _mm256_xor_si256(v, _mm256_i32gather_epi32((const int*)tab->mul_alpha, _mm256_srli_epi32(s0, 24), 4));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(s11, 8));
+    v = _mm256_xor_si256(v, _mm256_i32gather_epi32((const int*)tab->div_alpha, _mm256_and_si256(s11, mask), 4));
+    if (init) {
+      v = _mm256_xor_si256(v, f);
+    }
+    _mm256_storeu_si256((__m256i*)state->lfsr[t % 16], v);
+  }
+
+  _mm256_storeu_si256((__m256i*)state->fsm[0], r1);
+  _mm256_storeu_si256((__m256i*)state->fsm[1], r2);
+  _mm256_storeu_si256((__m256i*)state->fsm[2], r3);
+}
+
+#endif // LV_HAVE_AVX2
+
+void s3g_mb_initialize_lanes(S3G_MB_STATE* state, uint32_t lane_mask, const uint32_t k[][4], const uint32_t iv[][4])
+{
+#ifdef LV_HAVE_AVX2
+  if (__builtin_popcount(lane_mask) >= S3G_MB_MIN_SIMD_LANES) {
+    S3G_MB_STATE init = {};
+    uint32_t     s[16];
+    for (uint32_t lane = 0; lane < S3G_MB_NOF_LANES; lane++) {
+      if (lane_mask & (1U << lane)) {
+        s3g_mb_load_key(s, k[lane], iv[lane]);
+        for (uint32_t i = 0; i < 16; i++) {
+          init.lfsr[i][lane] = s[i];
+        }
+      }
+    }
+
+    // 32 clocks in initialisation mode and one clock in keystream mode, discarding the FSM output
+    s3g_mb_clock_avx2(&init, 0, 32, true, NULL);
+    s3g_mb_clock_avx2(&init, 0, 1, false, NULL);
+
+    for (uint32_t lane = 0; lane < S3G_MB_NOF_LANES; lane++) {
+      if (lane_mask & (1U << lane)) {
+        for (uint32_t i = 0; i < 16; i++) {
+          state->lfsr[i][lane] = init.lfsr[(i + 1) % 16][lane];
+        }
+        for (uint32_t i = 0; i < 3; i++) {
+          state->fsm[i][lane] = init.fsm[i][lane];
+        }
+      }
+    }
+    return;
+  }
+#endif // LV_HAVE_AVX2
+  for (uint32_t lane = 0; lane < S3G_MB_NOF_LANES; lane++) {
+    if (lane_mask & (1U << lane)) {
+      s3g_mb_initialize_lane(state, lane, k[lane], iv[lane]);
+    }
+  }
+}
+
+void s3g_mb_generate_keystream(S3G_MB_STATE* state, uint32_t lane_mask, uint32_t* ks)
+{
+#ifdef LV_HAVE_AVX2
+  if (__builtin_popcount(lane_mask) >= S3G_MB_MIN_SIMD_LANES) {
+    s3g_mb_clock_avx2(state, 0, S3G_MB_NOF_WORDS, false, ks);
+    return;
+  }
+#endif // LV_HAVE_AVX2
+  for (uint32_t lane = 0; lane < S3G_MB_NOF_LANES; lane++) {
+    if (lane_mask & (1U << lane)) {
+      s3g_mb_generate_lane(state, lane, ks);
+    }
+  }
+}
@@ -24,9 +24,15 @@
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
+#include "srsran/common/zuc.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
 
+#ifdef __PCLMUL__
+#include <immintrin.h>
+#endif // __PCLMUL__
+
 #define FC_EPS_K_ASME_DERIVATION 0x10
 #define FC_EPS_K_ENB_DERIVATION 0x11
 #define FC_EPS_NH_DERIVATION 0x12
@@ -804,6 +810,278 @@ int kdf_common(const uint8_t                  fc,
 
   return SRSRAN_SUCCESS;
 }
+
+/******************************************************************************
+ * SNOW 3G and ZUC helpers
+ *****************************************************************************/
+
+static inline uint32_t load_be32(const uint8_t* ptr)
+{
+  return ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) | ((uint32_t)ptr[2] << 8) | (uint32_t)ptr[3];
+}
+
+/// Loads up to 4 bytes as a big endian word, padding with zeros
+static inline uint32_t load_be32_partial(const uint8_t* ptr, uint32_t len)
+{
+  uint32_t w = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    w |= (uint32_t)ptr[i] << (24 - 8 * i);
+  }
+  return w;
+}
+
+static inline void store_be32(uint8_t* ptr, uint32_t w)
+{
+  ptr[0] = (w >> 24) & 0xff;
+  ptr[1] = (w >> 16) & 0xff;
+  ptr[2] = (w >> 8) & 0xff;
+  ptr[3] = w & 0xff;
+}
+
+/// 128-EEA1/128-EIA1 key in the SNOW 3G key word order
+static void s3g_load_key(const uint8_t* key, uint32_t k[4])
+{
+  for (uint32_t i = 0; i < 4; i++) {
+    k[3 - i] = load_be32(&key[4 * i]);
+  }
+}
+
+/// Keystream generator of 128-EEA1, based on the multi-buffer SNOW 3G
+class eea1_keystream
+{
+public:
+  static const uint32_t nof_lanes = S3G_MB_NOF_LANES;
+  static const uint32_t nof_words = S3G_MB_NOF_WORDS;
+
+  eea1_keystream(const uint8_t* key, uint8_t bearer, uint8_t direction) :
+    bearer_dir(((bearer & 0x1fU) << 27) | ((direction & 0x1U) << 26))
+  {
+    s3g_load_key(key, k[0]);
+    for (uint32_t lane = 1; lane < nof_lanes; lane++) {
+      memcpy(k[lane], k[0], sizeof(k[0]));
+    }
+  }
+
+  void init_lanes(uint32_t lane_mask, const uint32_t* count)
+  {
+    uint32_t iv[nof_lanes][4];
+    for (uint32_t lane = 0; lane < nof_lanes; lane++) {
+      iv[lane][0] = bearer_dir;
+      iv[lane][1] = count[lane];
+      iv[lane][2] = bearer_dir;
+      iv[lane][3] = count[lane];
+    }
+    s3g_mb_initialize_lanes(&state, lane_mask, k, iv);
+  }
+
+  void generate(uint32_t lane_mask, uint32_t* ks) { s3g_mb_generate_keystream(&state, lane_mask, ks); }
+
+private:
+  S3G_MB_STATE state = {};
+  uint32_t     k[nof_lanes][4];
+  uint32_t     bearer_dir;
+};
+
+/// Keystream generator of 128-EEA3, based on the multi-buffer ZUC
+class eea3_keystream
+{
+public:
+  static const uint32_t nof_lanes = ZUC_MB_NOF_LANES;
+  static const uint32_t nof_words = ZUC_MB_NOF_WORDS;
+
+  eea3_keystream(const uint8_t* key, uint8_t bearer, uint8_t direction) :
+    bearer_dir(((bearer & 0x1fU) << 3) | ((direction & 0x1U) << 2))
+  {
+    for (uint32_t lane = 0; lane < nof_lanes; lane++) {
+      memcpy(k[lane], key, sizeof(k[lane]));
+    }
+  }
+
+  void init_lanes(uint32_t lane_mask, const uint32_t* count)
+  {
+    uint8_t iv[nof_lanes][16] = {};
+    for (uint32_t lane = 0; lane < nof_lanes; lane++) {
+      store_be32(&iv[lane][0], count[lane]);
+      iv[lane][4] = bearer_dir;
+      memcpy(&iv[lane][8], &iv[lane][0], 8);
+    }
+    zuc_mb_initialize_lanes(&state, lane_mask, k, iv);
+  }
+
+  void generate(uint32_t lane_mask, uint32_t* ks) { zuc_mb_generate_keystream(&state, lane_mask, ks); }
+
+private:
+  zuc_mb_state_t state = {};
+  uint8_t        k[nof_lanes][16];
+  uint8_t        bearer_dir;
+};
+
+/// Ciphers a burst of PDUs, one PDU per keystream lane. When the PDU of a lane is complete, the lane is
+/// re-initialized with the next pending PDU, so that all lanes are kept busy regardless of the PDU sizes
+template <typename Keystream>
+static void stream_cipher_burst(Keystream& keystream, span<const cipher_burst_item_t> items)
+{
+  const uint32_t             block_len = Keystream::nof_words * 4;
+  const cipher_burst_item_t* lane_item[Keystream::nof_lanes];
+  uint32_t                   lane_offset[Keystream::nof_lanes];
+  uint32_t                   lane_count[Keystream::nof_lanes] = {};
+  uint32_t                   ks[Keystream::nof_words * Keystream::nof_lanes];
+  uint8_t                    ks_bytes[block_len];
+  size_t                     next_item = 0;
+  uint32_t                   lane_mask = 0;
+  uint32_t                   init_mask = 0;
+
+  // Assigns the next non-empty PDU to the lane, or disables the lane if there are no PDUs left
+  auto assign_lane = [&](uint32_t lane) {
+    while (next_item < items.size() && items[next_item].msg_len == 0) {
+      next_item++;
+    }
+    if (next_item == items.size()) {
+      lane_mask &= ~(1U << lane);
+      return;
+    }
+    lane_item[lane]   = &items[next_item++];
+    lane_offset[lane] = 0;
+    lane_count[lane]  = lane_item[lane]->count;
+    lane_mask |= 1U << lane;
+    init_mask |= 1U << lane;
+  };
+
+  for (uint32_t lane = 0; lane < Keystream::nof_lanes; lane++) {
+    assign_lane(lane);
+  }
+
+  while (lane_mask != 0) {
+    if (init_mask != 0) {
+      keystream.init_lanes(init_mask, lane_count);
+      init_mask = 0;
+    }
+    keystream.generate(lane_mask, ks);
+    for (uint32_t lane = 0; lane < Keystream::nof_lanes; lane++) {
+      if ((lane_mask & (1U << lane)) == 0) {
+        continue;
+      }
+      const cipher_burst_item_t* item = lane_item[lane];
+      for (uint32_t t = 0; t < Keystream::nof_words; t++) {
+        store_be32(&ks_bytes[4 * t], ks[t * Keystream::nof_lanes + lane]);
+      }
+      uint32_t       offset = lane_offset[lane];
+      uint32_t       len    = std::min(block_len, item->msg_len - offset);
+      const uint8_t* in     = item->msg + offset;
+      uint8_t*       out    = item->msg_out + offset;
+      for (uint32_t i = 0; i < len; i++) {
+        out[i] = in[i] ^ ks_bytes[i];
+      }
+      lane_offset[lane] += len;
+      if (lane_offset[lane] == item->msg_len) {
+        assign_lane(lane);
+      }
+    }
+  }
+}
+
+/// Multiplication in GF(2^64) with the 128-EIA1 polynomial x^64 + x^4 + x^3 + x + 1
+static inline uint64_t eia1_mul_x(uint64_t v)
+{
+  return (v << 1) ^ ((v >> 63) * 0x1bU);
+}
+
+#ifdef __PCLMUL__
+
+static inline uint64_t eia1_mul(uint64_t a, uint64_t b)
+{
+  const __m128i poly = _mm_cvtsi64_si128(0x1b);
+  __m128i       prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(a), _mm_cvtsi64_si128(b), 0x00);
+  // Fold the upper 64 bits twice, x^64 = x^4 + x^3 + x + 1
+  __m128i fold1 = _mm_clmulepi64_si128(prod, poly, 0x01);
+  __m128i fold2 = _mm_clmulepi64_si128(fold1, poly, 0x01);
+  return (uint64_t)_mm_cvtsi128_si64(_mm_xor_si128(_mm_xor_si128(prod, fold1), fold2));
+}
+
+/// Multiplication by a constant of GF(2^64)
+class eia1_multiplier
+{
+public:
+  explicit eia1_multiplier(uint64_t p_) : p(p_) {}
+  uint64_t operator()(uint64_t v) const { return eia1_mul(v, p); }
+
+private:
+  uint64_t p;
+};
+
+#else // __PCLMUL__
+
+static uint64_t eia1_mul(uint64_t a, uint64_t b)
+{
+  uint64_t result = 0;
+  for (uint32_t i = 0; i < 64; i++) {
+    result ^= a & (0 - ((b >> i) & 1U));
+    a = eia1_mul_x(a);
+  }
+  return result;
+}
+
+/// Multiplication by a constant of GF(2^64), 4 bits of the multiplicand at a time
+class eia1_multiplier
+{
+public:
+  explicit eia1_multiplier(uint64_t p)
+  {
+    for (uint32_t j = 0; j < 16; j++) {
+      table[j][0] = 0;
+      for (uint32_t b = 0; b < 4; b++) {
+        table[j][1U << b] = p;
+        p                 = eia1_mul_x(p);
+      }
+      for (uint32_t n = 3; n < 16; n++) {
+        table[j][n] = table[j][n & (n - 1)] ^ table[j][n & (0 - n)];
+      }
+    }
+  }
+
+  uint64_t operator()(uint64_t v) const
+  {
+    uint64_t result = 0;
+    for (uint32_t j = 0; j < 16; j++) {
+      result ^= table[j][(v >> (4 * j)) & 0xf];
+    }
+    return result;
+  }
+
+private:
+  uint64_t table[16][16];
+};
+
+#endif // __PCLMUL__
+
+/// Reverses the bit order of a 32 bit word
+static inline uint32_t bit_reverse32(uint32_t w)
+{
+  w = ((w >> 1) & 0x55555555) | ((w & 0x55555555) << 1);
+  w = ((w >> 2) & 0x33333333) | ((w & 0x33333333) << 2);
+  w = ((w >> 4) & 0x0f0f0f0f) | ((w & 0x0f0f0f0f) << 4);
+  return __builtin_bswap32(w);
+}
+
+/// XOR of the keystream words of 128-EIA3 selected by the 32 bits of message word "m", being "ks" the 64 keystream
+/// bits starting at the position of its first bit
+static inline uint32_t eia3_word(uint64_t ks, uint32_t m)
+{
+#ifdef __PCLMUL__
+  // Bit i of the message selects ks << i, which is a carry-less multiplication by the bit-reversed message word
+  __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(ks), _mm_cvtsi32_si128(bit_reverse32(m)), 0x00);
+  return (uint32_t)((uint64_t)_mm_cvtsi128_si64(prod) >> 32);
+#else  // __PCLMUL__
+  uint32_t t = 0;
+  while (m != 0) {
+    uint32_t i = __builtin_clz(m);
+    t ^= (uint32_t)((ks << i) >> 32);
+    m &= ~(0x80000000U >> i);
+  }
+  return t;
+#endif // __PCLMUL__
+}
+
 /******************************************************************************
  * Integrity Protection
  *****************************************************************************/
@@ -816,7 +1094,39 @@ uint8_t security_128_eia1(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac)
 {
-  return liblte_security_128_eia1(key, count, bearer, direction, msg, msg_len, mac);
+  uint32_t k[4];
+  s3g_load_key(key, k);
+  uint32_t fresh = (bearer & 0x1fU) << 27;
+  uint32_t iv[4] = {fresh ^ ((direction & 0x1U) << 15), count ^ ((direction & 0x1U) << 31), fresh, count};
+
+  // Keystream words z_1 to z_5 are found in the first lane
+  S3G_MB_STATE state = {};
+  uint32_t     z[S3G_MB_NOF_WORDS * S3G_MB_NOF_LANES];
+  s3g_mb_initialize_lane(&state, 0, k, iv);
+  s3g_mb_generate_keystream(&state, 1U, z);
+  uint64_t p = ((uint64_t)z[0] << 32) | z[S3G_MB_NOF_LANES];
+  uint64_t q = ((uint64_t)z[2 * S3G_MB_NOF_LANES] << 32) | z[3 * S3G_MB_NOF_LANES];
+
+  // Evaluate the message polynomial at P, one 64 bit block at a time
+  eia1_multiplier mul_p(p);
+  uint64_t        eval = 0;
+  uint32_t        i    = 0;
+  for (; i + 8 <= msg_len; i += 8) {
+    eval = mul_p(eval ^ (((uint64_t)load_be32(&msg[i]) << 32) | load_be32(&msg[i + 4])));
+  }
+  if (i < msg_len) {
+    uint32_t rem = msg_len - i;
+    uint64_t m   = (uint64_t)load_be32_partial(&msg[i], std::min(rem, 4U)) << 32;
+    if (rem > 4) {
+      m |= load_be32_partial(&msg[i + 4], rem - 4);
+    }
+    eval = mul_p(eval ^ m);
+  }
+  eval ^= (uint64_t)msg_len * 8;
+  eval = eia1_mul(eval, q);
+
+  store_be32(mac, (uint32_t)(eval >> 32) ^ z[4 * S3G_MB_NOF_LANES]);
+  return SRSRAN_SUCCESS;
 }
 
 uint8_t security_128_eia2(const uint8_t* key,
@@ -838,7 +1148,59 @@ uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac)
 {
-  return liblte_security_128_eia3(key, count, bearer, direction, msg, msg_len * 8, mac);
+  uint8_t iv[16] = {};
+  store_be32(&iv[0], count);
+  iv[4] = (bearer << 3) & 0xf8;
+  store_be32(&iv[8], count ^ ((direction & 0x1U) << 31));
+  iv[12] = iv[4];
+  iv[14] = (direction & 0x1U) << 7;
+
+  zuc_mb_state_t state = {};
+  zuc_mb_initialize_lane(&state, 0, key, iv);
+
+  // Keystream words [base, base + 32) of the first lane. A new block of keystream words is generated when the
+  // message position moves past the first half of the window
+  uint32_t ks_block[ZUC_MB_NOF_WORDS * ZUC_MB_NOF_LANES];
+  uint32_t z[2 * ZUC_MB_NOF_WORDS];
+  uint32_t base = 0;
+
+  auto next_block = [&](uint32_t* dst) {
+    zuc_mb_generate_keystream(&state, 1U, ks_block);
+    for (uint32_t i = 0; i < ZUC_MB_NOF_WORDS; i++) {
+      dst[i] = ks_block[i * ZUC_MB_NOF_LANES];
+    }
+  };
+  // Returns the 64 keystream bits starting at word "word_idx"
+  auto ks_window = [&](uint32_t word_idx) {
+    if (word_idx - base >= ZUC_MB_NOF_WORDS) {
+      memcpy(z, &z[ZUC_MB_NOF_WORDS], sizeof(uint32_t) * ZUC_MB_NOF_WORDS);
+      next_block(&z[ZUC_MB_NOF_WORDS]);
+      base += ZUC_MB_NOF_WORDS;
+    }
+    return ((uint64_t)z[word_idx - base] << 32) | z[word_idx - base + 1];
+  };
+  next_block(z);
+  next_block(&z[ZUC_MB_NOF_WORDS]);
+
+  // Message words
+  uint32_t t        = 0;
+  uint32_t nof_full = msg_len / 4;
+  uint32_t rem      = msg_len % 4;
+  uint32_t w        = 0;
+  for (; w < nof_full; w++) {
+    t ^= eia3_word(ks_window(w), load_be32(&msg[4 * w]));
+  }
+  uint64_t ks = ks_window(w);
+  if (rem > 0) {
+    t ^= eia3_word(ks, load_be32_partial(&msg[4 * w], rem));
+  }
+
+  // Keystream word at the message length, then the last keystream word of the (msg_len * 8 + 64) bits
+  t ^= (uint32_t)((ks << (rem * 8)) >> 32);
+  t ^= z[w + (rem > 0 ? 2 : 1) - base];
+
+  store_be32(mac, t);
+  return SRSRAN_SUCCESS;
 }
 
 uint8_t security_md5(const uint8_t* input, size_t len, uint8_t* output)
@@ -860,7 +1222,8 @@ uint8_t security_128_eea1(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out)
 {
-  return liblte_security_encryption_eea1(key, count, bearer, direction, msg, msg_len * 8, msg_out);
+  cipher_burst_item_t item = {msg, msg_out, msg_len, count};
+  return security_128_eea1_burst(key, bearer, direction, span<const cipher_burst_item_t>(&item, 1));
 }
 
 uint8_t security_128_eea2(uint8_t* key,
@@ -882,7 +1245,34 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out)
 {
-  return liblte_security_encryption_eea3(key, count, bearer, direction, msg, msg_len * 8, msg_out);
+  cipher_burst_item_t item = {msg, msg_out, msg_len, count};
+  return security_128_eea3_burst(key, bearer, direction, span<const cipher_burst_item_t>(&item, 1));
+}
+
+int security_128_eea1_burst(const uint8_t*                  key,
+                            uint8_t                         bearer,
+                            uint8_t                         direction,
+                            span<const cipher_burst_item_t> items)
+{
+  if (key == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  eea1_keystream keystream(key, bearer, direction);
+  stream_cipher_burst(keystream, items);
+  return SRSRAN_SUCCESS;
+}
+
+int security_128_eea3_burst(const uint8_t*                  key,
+                            uint8_t                         bearer,
+                            uint8_t                         direction,
+                            span<const cipher_burst_item_t> items)
+{
+  if (key == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  eea3_keystream keystream(key, bearer, direction);
+  stream_cipher_burst(keystream, items);
+  return SRSRAN_SUCCESS;
 }
 
 /******************************************************************************
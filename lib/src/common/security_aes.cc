@@ -0,0 +1,437 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security_aes.h"
+#include "srsran/config.h"
+#include <algorithm>
+#include <string.h>
+
+#ifdef __AES__
+#include <immintrin.h>
+#endif // __AES__
+
+namespace srsran {
+
+#define AES_BLOCK_LEN 16
+#define AES_CTR_NOF_LANES 8
+
+#ifdef __AES__
+
+typedef __m128i aes_block_t;
+
+static inline aes_block_t aes_block_load(const uint8_t* ptr)
+{
+  return _mm_loadu_si128((const __m128i*)ptr);
+}
+
+static inline void aes_block_store(uint8_t* ptr, aes_block_t b)
+{
+  _mm_storeu_si128((__m128i*)ptr, b);
+}
+
+static inline aes_block_t aes_block_xor(aes_block_t a, aes_block_t b)
+{
+  return _mm_xor_si128(a, b);
+}
+
+static inline aes_block_t aes_block_zero()
+{
+  return _mm_setzero_si128();
+}
+
+// Counter block of 128-EEA2 (TS 33.401 Annex B.1.3): COUNT | BEARER | DIRECTION | 0...0 | block index
+static inline aes_block_t aes_ctr_block(uint32_t count, uint8_t bearer_dir, uint32_t idx)
+{
+  return _mm_set_epi32((int)__builtin_bswap32(idx), 0, (int)bearer_dir, (int)__builtin_bswap32(count));
+}
+
+static inline __m128i aes_128_key_expand(__m128i key, __m128i assist)
+{
+  assist = _mm_shuffle_epi32(assist, _MM_SHUFFLE(3, 3, 3, 3));
+  key    = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key    = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key    = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, assist);
+}
+
+#define AES_128_KEY_EXPAND(rk, i, rcon)                                                                                \
+  rk[i] = aes_128_key_expand(rk[i - 1], _mm_aeskeygenassist_si128(rk[i - 1], rcon))
+
+struct aes_128_backend {
+  static const __m128i* round_keys(const aes_128_key_schedule& ks) { return (const __m128i*)ks.round_keys; }
+
+  static void set_key(aes_128_key_schedule& ks, const uint8_t* key)
+  {
+    __m128i* rk = (__m128i*)ks.round_keys;
+    rk[0]       = _mm_loadu_si128((const __m128i*)key);
+    AES_128_KEY_EXPAND(rk, 1, 0x01);
+    AES_128_KEY_EXPAND(rk, 2, 0x02);
+    AES_128_KEY_EXPAND(rk, 3, 0x04);
+    AES_128_KEY_EXPAND(rk, 4, 0x08);
+    AES_128_KEY_EXPAND(rk, 5, 0x10);
+    AES_128_KEY_EXPAND(rk, 6, 0x20);
+    AES_128_KEY_EXPAND(rk, 7, 0x40);
+    AES_128_KEY_EXPAND(rk, 8, 0x80);
+    AES_128_KEY_EXPAND(rk, 9, 0x1b);
+    AES_128_KEY_EXPAND(rk, 10, 0x36);
+  }
+
+  static aes_block_t encrypt(const aes_128_key_schedule& ks, aes_block_t b)
+  {
+    const __m128i* rk = round_keys(ks);
+    b                 = _mm_xor_si128(b, rk[0]);
+    for (uint32_t r = 1; r < 10; r++) {
+      b = _mm_aesenc_si128(b, rk[r]);
+    }
+    return _mm_aesenclast_si128(b, rk[10]);
+  }
+
+  // Encrypts AES_CTR_NOF_LANES independent blocks. The rounds of all blocks are interleaved to hide the AESENC latency
+  static void encrypt_lanes(const aes_128_key_schedule& ks, aes_block_t* b, uint32_t nof_blocks)
+  {
+    const __m128i* rk = round_keys(ks);
+#if defined(__VAES__) && defined(__AVX2__)
+    __m256i v[AES_CTR_NOF_LANES / 2];
+    __m256i k = _mm256_broadcastsi128_si256(rk[0]);
+    for (uint32_t i = 0; i < AES_CTR_NOF_LANES / 2; i++) {
+      v[i] = _mm256_xor_si256(_mm256_set_m128i(b[2 * i + 1], b[2 * i]), k);
+    }
+    for (uint32_t r = 1; r < 10; r++) {
+      k = _mm256_broadcastsi128_si256(rk[r]);
+      for (uint32_t i = 0; i < AES_CTR_NOF_LANES / 2; i++) {
+        v[i] = _mm256_aesenc_epi128(v[i], k);
+      }
+    }
+    k = _mm256_broadcastsi128_si256(rk[10]);
+    for (uint32_t i = 0; i < AES_CTR_NOF_LANES / 2; i++) {
+      v[i]         = _mm256_aesenclast_epi128(v[i], k);
+      b[2 * i]     = _mm256_castsi256_si128(v[i]);
+      b[2 * i + 1] = _mm256_extracti128_si256(v[i], 1);
+    }
+#else  // defined(__VAES__) && defined(__AVX2__)
+    for (uint32_t i = 0; i < AES_CTR_NOF_LANES; i++) {
+      b[i] = _mm_xor_si128(b[i], rk[0]);
+    }
+    for (uint32_t r = 1; r < 10; r++) {
+      for (uint32_t i = 0; i < AES_CTR_NOF_LANES; i++) {
+        b[i] = _mm_aesenc_si128(b[i], rk[r]);
+      }
+    }
+    for (uint32_t i = 0; i < AES_CTR_NOF_LANES; i++) {
+      b[i] = _mm_aesenclast_si128(b[i], rk[10]);
+    }
+#endif // defined(__VAES__) && defined(__AVX2__)
+  }
+
+  static const uint8_t* k1(const aes_128_key_schedule& ks) { return ks.k1; }
+  static const uint8_t* k2(const aes_128_key_schedule& ks) { return ks.k2; }
+};
+
+#else // __AES__
+
+struct aes_block_t {
+  uint8_t v[AES_BLOCK_LEN];
+};
+
+static inline aes_block_t aes_block_load(const uint8_t* ptr)
+{
+  aes_block_t b;
+  memcpy(b.v, ptr, AES_BLOCK_LEN);
+  return b;
+}
+
+static inline void aes_block_store(uint8_t* ptr, aes_block_t b)
+{
+  memcpy(ptr, b.v, AES_BLOCK_LEN);
+}
+
+static inline aes_block_t aes_block_xor(aes_block_t a, aes_block_t b)
+{
+  for (uint32_t i = 0; i < AES_BLOCK_LEN; i++) {
+    a.v[i] ^= b.v[i];
+  }
+  return a;
+}
+
+static inline aes_block_t aes_block_zero()
+{
+  aes_block_t b = {};
+  return b;
+}
+
+// Counter block of 128-EEA2 (TS 33.401 Annex B.1.3): COUNT | BEARER | DIRECTION | 0...0 | block index
+static inline aes_block_t aes_ctr_block(uint32_t count, uint8_t bearer_dir, uint32_t idx)
+{
+  aes_block_t b = {};
+  b.v[0]        = (count >> 24U) & 0xffU;
+  b.v[1]        = (count >> 16U) & 0xffU;
+  b.v[2]        = (count >> 8U) & 0xffU;
+  b.v[3]        = count & 0xffU;
+  b.v[4]        = bearer_dir;
+  b.v[12]       = (idx >> 24U) & 0xffU;
+  b.v[13]       = (idx >> 16U) & 0xffU;
+  b.v[14]       = (idx >> 8U) & 0xffU;
+  b.v[15]       = idx & 0xffU;
+  return b;
+}
+
+struct aes_128_backend {
+  static void set_key(aes_128_key_schedule& ks, const uint8_t* key) { aes_setkey_enc(&ks.ctx, key, 128); }
+
+  static aes_block_t encrypt(const aes_128_key_schedule& ks, aes_block_t b)
+  {
+    aes_block_t out;
+    aes_crypt_ecb(&ks.ctx, AES_ENCRYPT, b.v, out.v);
+    return out;
+  }
+
+  static void encrypt_lanes(const aes_128_key_schedule& ks, aes_block_t* b, uint32_t nof_blocks)
+  {
+    for (uint32_t i = 0; i < nof_blocks; i++) {
+      b[i] = encrypt(ks, b[i]);
+    }
+  }
+
+  static const uint8_t* k1(const aes_128_key_schedule& ks) { return ks.k1; }
+  static const uint8_t* k2(const aes_128_key_schedule& ks) { return ks.k2; }
+};
+
+#endif // __AES__
+
+const char* security_aes_backend_name()
+{
+#if defined(__AES__) && defined(__VAES__) && defined(__AVX2__)
+  return "VAES";
+#elif defined(__AES__)
+  return "AES-NI";
+#else
+  return "mbedtls";
+#endif
+}
+
+/******************************************************************************
+ * Key schedule
+ *****************************************************************************/
+
+aes_128_key_schedule::aes_128_key_schedule()
+{
+#ifndef __AES__
+  mbedtls_aes_init(&ctx);
+#endif // __AES__
+}
+
+aes_128_key_schedule::~aes_128_key_schedule()
+{
+#ifndef __AES__
+  mbedtls_aes_free(&ctx);
+#endif // __AES__
+}
+
+// Left shift of a 128-bit string by one bit, as used by the CMAC subkey generation (RFC 4493 section 2.3)
+static void cmac_subkey(const uint8_t* in, uint8_t* out)
+{
+  for (uint32_t i = 0; i < AES_BLOCK_LEN - 1; i++) {
+    out[i] = (in[i] << 1U) | ((in[i + 1] >> 7U) & 0x01U);
+  }
+  out[AES_BLOCK_LEN - 1] = in[AES_BLOCK_LEN - 1] << 1U;
+  if (in[0] & 0x80U) {
+    out[AES_BLOCK_LEN - 1] ^= 0x87U;
+  }
+}
+
+void aes_128_key_schedule::set_key(const uint8_t* key)
+{
+  aes_128_backend::set_key(*this, key);
+
+  // CMAC subkeys K1 and K2 are derived from L = AES(K, 0)
+  uint8_t L[AES_BLOCK_LEN];
+  aes_block_store(L, aes_128_backend::encrypt(*this, aes_block_zero()));
+  cmac_subkey(L, k1);
+  cmac_subkey(k1, k2);
+
+  key_set = true;
+}
+
+void aes_128_key_schedule::encrypt_block(const uint8_t* in, uint8_t* out) const
+{
+  aes_block_store(out, aes_128_backend::encrypt(*this, aes_block_load(in)));
+}
+
+/******************************************************************************
+ * Integrity Protection
+ *****************************************************************************/
+
+int security_128_eia2(const aes_128_key_schedule& ks,
+                      uint32_t                    count,
+                      uint32_t                    bearer,
+                      uint8_t                     direction,
+                      const uint8_t*              msg,
+                      uint32_t                    msg_len,
+                      uint8_t*                    mac)
+{
+  if (not ks.is_set() or (msg == nullptr and msg_len > 0) or mac == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  // The CMAC input is COUNT | BEARER | DIRECTION | 0...0 (64 bits) followed by the message. Only the first and the last
+  // blocks need to be assembled, the blocks in between are read directly from the message
+  uint8_t first[AES_BLOCK_LEN] = {};
+  first[0]                     = (count >> 24U) & 0xffU;
+  first[1]                     = (count >> 16U) & 0xffU;
+  first[2]                     = (count >> 8U) & 0xffU;
+  first[3]                     = count & 0xffU;
+  first[4]                     = ((bearer & 0x1fU) << 3U) | ((direction & 0x01U) << 2U);
+  if (msg_len > 0) {
+    memcpy(&first[8], msg, std::min(msg_len, 8U));
+  }
+
+  uint32_t total_len  = msg_len + 8;
+  uint32_t nof_blocks = (total_len + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN;
+
+  aes_block_t T = aes_block_zero();
+  for (uint32_t i = 0; i + 1 < nof_blocks; i++) {
+    aes_block_t M = (i == 0) ? aes_block_load(first) : aes_block_load(&msg[i * AES_BLOCK_LEN - 8]);
+    T             = aes_128_backend::encrypt(ks, aes_block_xor(T, M));
+  }
+
+  // Last block is either complete and XORed with K1, or padded with 10...0 and XORed with K2
+  uint8_t  last[AES_BLOCK_LEN] = {};
+  uint32_t last_len            = total_len - (nof_blocks - 1) * AES_BLOCK_LEN;
+  if (nof_blocks == 1) {
+    memcpy(last, first, last_len);
+  } else {
+    memcpy(last, &msg[(nof_blocks - 1) * AES_BLOCK_LEN - 8], last_len);
+  }
+  const uint8_t* subkey = aes_128_backend::k1(ks);
+  if (last_len < AES_BLOCK_LEN) {
+    last[last_len] = 0x80;
+    subkey         = aes_128_backend::k2(ks);
+  }
+  T = aes_block_xor(T, aes_block_xor(aes_block_load(last), aes_block_load(subkey)));
+  T = aes_128_backend::encrypt(ks, T);
+
+  uint8_t tag[AES_BLOCK_LEN];
+  aes_block_store(tag, T);
+  memcpy(mac, tag, 4);
+
+  return SRSRAN_SUCCESS;
+}
+
+/******************************************************************************
+ * Encryption / Decryption
+ *****************************************************************************/
+
+namespace {
+
+// Destination of a keystream block
+struct aes_ctr_lane_t {
+  const uint8_t* in;
+  uint8_t*       out;
+  uint32_t       len;
+};
+
+class aes_ctr_pipeline
+{
+public:
+  explicit aes_ctr_pipeline(const aes_128_key_schedule& ks_) : ks(ks_) {}
+
+  void push(uint32_t count, uint8_t bearer_dir, const uint8_t* in, uint8_t* out, uint32_t len)
+  {
+    uint32_t nof_blocks = (len + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN;
+    for (uint32_t i = 0; i < nof_blocks; i++) {
+      uint32_t offset      = i * AES_BLOCK_LEN;
+      blocks[nof_lanes]    = aes_ctr_block(count, bearer_dir, i);
+      lanes[nof_lanes].in  = &in[offset];
+      lanes[nof_lanes].out = &out[offset];
+      lanes[nof_lanes].len = std::min(len - offset, (uint32_t)AES_BLOCK_LEN);
+      if (++nof_lanes == AES_CTR_NOF_LANES) {
+        flush();
+      }
+    }
+  }
+
+  void flush()
+  {
+    if (nof_lanes == 0) {
+      return;
+    }
+    aes_128_backend::encrypt_lanes(ks, blocks, nof_lanes);
+    for (uint32_t i = 0; i < nof_lanes; i++) {
+      const aes_ctr_lane_t& lane = lanes[i];
+      if (lane.len == AES_BLOCK_LEN) {
+        aes_block_store(lane.out, aes_block_xor(aes_block_load(lane.in), blocks[i]));
+      } else {
+        uint8_t ks_bytes[AES_BLOCK_LEN];
+        aes_block_store(ks_bytes, blocks[i]);
+        for (uint32_t j = 0; j < lane.len; j++) {
+          lane.out[j] = lane.in[j] ^ ks_bytes[j];
+        }
+      }
+    }
+    nof_lanes = 0;
+  }
+
+private:
+  const aes_128_key_schedule& ks;
+  aes_block_t                 blocks[AES_CTR_NOF_LANES] = {};
+  aes_ctr_lane_t              lanes[AES_CTR_NOF_LANES]  = {};
+  uint32_t                    nof_lanes = 0;
+};
+
+} // namespace
+
+int security_128_eea2(const aes_128_key_schedule& ks,
+                      uint32_t                    count,
+                      uint8_t                     bearer,
+                      uint8_t                     direction,
+                      const uint8_t*              msg,
+                      uint32_t                    msg_len,
+                      uint8_t*                    msg_out)
+{
+  cipher_burst_item_t item = {msg, msg_out, msg_len, count};
+  return security_128_eea2_burst(ks, bearer, direction, span<const cipher_burst_item_t>(&item, 1));
+}
+
+int security_128_eea2_burst(const aes_128_key_schedule&     ks,
+                            uint8_t                         bearer,
+                            uint8_t                         direction,
+                            span<const cipher_burst_item_t> items)
+{
+  if (not ks.is_set()) {
+    return SRSRAN_ERROR;
+  }
+  for (const cipher_burst_item_t& item : items) {
+    if (item.msg_len > 0 and (item.msg == nullptr or item.msg_out == nullptr)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  uint8_t          bearer_dir = ((bearer & 0x1fU) << 3U) | ((direction & 0x01U) << 2U);
+  aes_ctr_pipeline pipeline(ks);
+  for (const cipher_burst_item_t& item : items) {
+    pipeline.push(item.count, bearer_dir, item.msg, item.msg_out, item.msg_len);
+  }
+  pipeline.flush();
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
@@ -21,6 +21,7 @@
 
 #include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
 #include <assert.h>
 #include <chrono>
 #include <stdio.h>
@@ -401,6 +402,178 @@ void task_thread_pool::worker_t::run_thread()
   running = false;
 }
 
+namespace {
+
+/// Queue of the calling thread in the pool with identifier "pool_id". Identifiers are never reused
+struct local_queue_t {
+  uint32_t pool_id   = 0;
+  uint32_t queue_idx = 0;
+};
+thread_local local_queue_t local_queue;
+std::atomic<uint32_t>      next_pool_id = {1};
+
+} // namespace
+
+work_stealing_pool::work_stealing_pool(uint32_t    nof_workers,
+                                       uint32_t    nof_ext_queues,
+                                       std::string name,
+                                       int32_t     prio_,
+                                       uint32_t    mask_) :
+  prio(prio_), mask(mask_), pool_id(next_pool_id.fetch_add(1, std::memory_order_relaxed))
+{
+  // The first queues belong to the pool threads, the rest to the threads pushing tasks from outside the pool
+  uint32_t nof_queues = nof_workers + std::max(nof_ext_queues, 1U);
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    queues.emplace_back(new task_queue);
+  }
+  next_ext_queue = nof_workers;
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(new worker_t(this, i, name + std::to_string(i)));
+  }
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+  stop();
+}
+
+void work_stealing_pool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  idle_cvar.notify_all();
+  for (std::unique_ptr<worker_t>& w : workers) {
+    w->stop();
+  }
+}
+
+uint32_t work_stealing_pool::get_queue_idx()
+{
+  if (local_queue.pool_id != pool_id) {
+    local_queue.pool_id   = pool_id;
+    uint32_t idx          = next_ext_queue.fetch_add(1, std::memory_order_relaxed);
+    local_queue.queue_idx = std::min(idx, (uint32_t)queues.size() - 1);
+  }
+  return local_queue.queue_idx;
+}
+
+void work_stealing_pool::push_task(task_group& group, task_t&& task)
+{
+  group.pending.fetch_add(1, std::memory_order_relaxed);
+
+  task_queue& q = *queues[get_queue_idx()];
+  {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks.emplace_back();
+    q.tasks.back().group = &group;
+    q.tasks.back().task  = std::move(task);
+  }
+
+  // Wake up an idle pool thread to steal it. The counter may go transiently negative if the task is popped first
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex);
+    nof_queued.fetch_add(1, std::memory_order_relaxed);
+  }
+  idle_cvar.notify_one();
+}
+
+bool work_stealing_pool::pop_task(uint32_t queue_idx, task_item& item)
+{
+  task_queue&                 q = *queues[queue_idx];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if (q.tasks.empty()) {
+    return false;
+  }
+  item = std::move(q.tasks.back());
+  q.tasks.pop_back();
+  nof_queued.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool work_stealing_pool::steal_task(uint32_t thief_idx, task_item& item)
+{
+  // Start with the queue next to the thief's one, so that thieves spread over the victims
+  for (uint32_t i = 1; i < queues.size(); ++i) {
+    task_queue&                 q = *queues[(thief_idx + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (not q.tasks.empty()) {
+      item = std::move(q.tasks.front());
+      q.tasks.pop_front();
+      nof_queued.fetch_sub(1, std::memory_order_relaxed);
+      nof_stolen.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void work_stealing_pool::run_task(task_item& item)
+{
+  item.task();
+
+  // The group may be destroyed as soon as the waiter sees no pending tasks, so the count is decremented while holding
+  // the group mutex, which the waiter always acquires before returning
+  task_group&                 group = *item.group;
+  std::lock_guard<std::mutex> lock(group.mutex);
+  if (group.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    group.cvar.notify_all();
+  }
+}
+
+void work_stealing_pool::wait(task_group& group)
+{
+  uint32_t  queue_idx = get_queue_idx();
+  task_item item;
+  while (group.nof_pending() > 0) {
+    if (pop_task(queue_idx, item) or steal_task(queue_idx, item)) {
+      run_task(item);
+      continue;
+    }
+    // The remaining tasks of the group are running in other threads
+    break;
+  }
+
+  std::unique_lock<std::mutex> lock(group.mutex);
+  group.cvar.wait(lock, [&group]() { return group.nof_pending() == 0; });
+}
+
+work_stealing_pool::worker_t::worker_t(work_stealing_pool* parent_, uint32_t queue_idx_, const std::string& name_) :
+  thread(name_), parent(parent_), queue_idx(queue_idx_)
+{
+  if (parent->mask == 255) {
+    start(parent->prio);
+  } else {
+    start_cpu_mask(parent->prio, parent->mask);
+  }
+}
+
+void work_stealing_pool::worker_t::run_thread()
+{
+  local_queue.pool_id   = parent->pool_id;
+  local_queue.queue_idx = queue_idx;
+
+  task_item item;
+  while (true) {
+    if (parent->pop_task(queue_idx, item) or parent->steal_task(queue_idx, item)) {
+      parent->run_task(item);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(parent->idle_mutex);
+    parent->idle_cvar.wait(lock, [this]() {
+      return not parent->running or parent->nof_queued.load(std::memory_order_relaxed) > 0;
+    });
+    if (not parent->running) {
+      break;
+    }
+  }
+}
+
 task_worker::task_worker(std::string thread_name_,
                          uint32_t    queue_size,
                          bool        start_deferred,
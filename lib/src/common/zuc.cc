@@ -30,6 +30,11 @@
 ---------------------------------------------------------*/
 
 #include "srsran/common/zuc.h"
+#include <stddef.h>
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
 
 #define MAKEU32(a, b, c, d) (((u32)(a) << 24) | ((u32)(b) << 16) | ((u32)(c) << 8) | ((u32)(d)))
 #define MulByPow2(x, k) ((((x) << k) | ((x) >> (31 - k))) & 0x7FFFFFFF)
@@ -252,3 +257,267 @@ void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keyst
     LFSRWithWorkMode(state);
   }
 }
+
+/* Multi-buffer ZUC
+ *
+ * The LFSR of every lane is kept in a circular buffer of 16 words: at clock
+ * t, s_i is found in lfsr[(t + i) % 16] and the new s_15 replaces s_0.
+ * Keystream words are generated in blocks of ZUC_MB_NOF_WORDS = 16 clocks,
+ * so that the LFSR is back in its natural order at the end of every block.
+ * The S-box S = (S0, S1, S0, S1) is evaluated with four 32-bit tables.
+ */
+
+typedef struct {
+  u32 s[4][256];
+} zuc_mb_tables_t;
+
+/* Below this number of lanes, lanes are initialized and clocked one by one */
+#define ZUC_MB_MIN_SIMD_LANES 3
+
+static const zuc_mb_tables_t* zuc_mb_get_tables()
+{
+  static const zuc_mb_tables_t* tables = []() {
+    static zuc_mb_tables_t t;
+    for (u32 i = 0; i < 256; i++) {
+      t.s[0][i] = (u32)S0[i] << 24;
+      t.s[1][i] = (u32)S1[i] << 16;
+      t.s[2][i] = (u32)S0[i] << 8;
+      t.s[3][i] = (u32)S1[i];
+    }
+    return &t;
+  }();
+  return tables;
+}
+
+static inline u32 zuc_mb_sbox(const zuc_mb_tables_t* tab, u32 w)
+{
+  return tab->s[0][w >> 24] | tab->s[1][(w >> 16) & 0xff] | tab->s[2][(w >> 8) & 0xff] | tab->s[3][w & 0xff];
+}
+
+/* Clocks the LFSR s and the registers r1/r2 of a single lane from clock
+ * t_begin to t_end. In initialisation mode the output of F is fed back to
+ * the LFSR, otherwise the keystream is written in p_keystream (if not NULL)
+ * with a stride of ZUC_MB_NOF_LANES words. */
+static inline void
+zuc_mb_clock_lane(u32 s[16], u32* r1, u32* r2, u32 t_begin, u32 t_end, bool init, u32* p_keystream)
+{
+  const zuc_mb_tables_t* tab = zuc_mb_get_tables();
+  u32                    R1 = *r1, R2 = *r2;
+
+  for (u32 t = t_begin; t < t_end; t++) {
+    u32 s0  = s[t % 16];
+    u32 s15 = s[(t + 15) % 16];
+    u32 x0  = ((s15 & 0x7FFF8000) << 1) | (s[(t + 14) % 16] & 0xFFFF);
+    u32 x1  = (s[(t + 11) % 16] << 16) | (s[(t + 9) % 16] >> 15);
+    u32 x2  = (s[(t + 7) % 16] << 16) | (s[(t + 5) % 16] >> 15);
+    u32 w   = (x0 ^ R1) + R2;
+    u32 w1  = R1 + x1;
+    u32 w2  = R2 ^ x2;
+    R1      = zuc_mb_sbox(tab, L1((w1 << 16) | (w2 >> 16)));
+    R2      = zuc_mb_sbox(tab, L2((w2 << 16) | (w1 >> 16)));
+
+    if (p_keystream != NULL) {
+      p_keystream[(t - t_begin) * ZUC_MB_NOF_LANES] = w ^ ((s[(t + 2) % 16] << 16) | (s0 >> 15));
+    }
+
+    u32 f = s0;
+    f     = AddM(f, MulByPow2(s0, 8));
+    f     = AddM(f, MulByPow2(s[(t + 4) % 16], 20));
+    f     = AddM(f, MulByPow2(s[(t + 10) % 16], 21));
+    f     = AddM(f, MulByPow2(s[(t + 13) % 16], 17));
+    f     = AddM(f, MulByPow2(s15, 15));
+    if (init) {
+      f = AddM(f, w >> 1);
+    }
+    s[t % 16] = f;
+  }
+
+  *r1 = R1;
+  *r2 = R2;
+}
+
+void zuc_mb_initialize_lane(zuc_mb_state_t* state, u32 lane, const u8* k, const u8* iv)
+{
+  u32 s[16];
+  u32 r1 = 0, r2 = 0;
+
+  for (u32 i = 0; i < 16; i++) {
+    s[i] = MAKEU31(k[i], EK_d[i], iv[i]);
+  }
+
+  // 32 clocks in initialisation mode and one clock in work mode, discarding the output of F
+  zuc_mb_clock_lane(s, &r1, &r2, 0, 32, true, NULL);
+  zuc_mb_clock_lane(s, &r1, &r2, 0, 1, false, NULL);
+
+  for (u32 i = 0; i < 16; i++) {
+    state->lfsr[i][lane] = s[(i + 1) % 16];
+  }
+  state->r1[lane] = r1;
+  state->r2[lane] = r2;
+}
+
+/* Clocks a single lane ZUC_MB_NOF_WORDS times in work mode. The lane state
+ * is copied to local variables so that it can be kept in registers. */
+static void zuc_mb_generate_lane(zuc_mb_state_t* state, u32 lane, u32* p_keystream)
+{
+  u32 s[16];
+  u32 r1 = state->r1[lane], r2 = state->r2[lane];
+
+  for (u32 i = 0; i < 16; i++) {
+    s[i] = state->lfsr[i][lane];
+  }
+
+  zuc_mb_clock_lane(s, &r1, &r2, 0, ZUC_MB_NOF_WORDS, false, &p_keystream[lane]);
+
+  for (u32 i = 0; i < 16; i++) {
+    state->lfsr[i][lane] = s[i];
+  }
+  state->r1[lane] = r1;
+  state->r2[lane] = r2;
+}
+
+#ifdef LV_HAVE_AVX2
+
+static inline __m256i zuc_mb_rot_avx2(__m256i x, int k)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+}
+
+static inline __m256i zuc_mb_mul_pow2_avx2(__m256i x, int k)
+{
+  return _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 31 - k)),
+                          _mm256_set1_epi32(0x7FFFFFFF));
+}
+
+static inline __m256i zuc_mb_add_mod_avx2(__m256i a, __m256i b)
+{
+  __m256i c = _mm256_add_epi32(a, b);
+  return _mm256_add_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_srli_epi32(c, 31));
+}
+
+static inline __m256i zuc_mb_sbox_avx2(const zuc_mb_tables_t* tab, __m256i w)
+{
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  __m256i       r    = _mm256_i32gather_epi32((const int*)tab->s[0], _mm256_srli_epi32(w, 24), 4);
+  r = _mm256_or_si256(
+      r, _mm256_i32gather_epi32((const int*)tab->s[1], _mm256_and_si256(_mm256_srli_epi32(w, 16), mask), 4));
+  r = _mm256_or_si256(
+      r, _mm256_i32gather_epi32((const int*)tab->s[2], _mm256_and_si256(_mm256_srli_epi32(w, 8), mask), 4));
+  return _mm256_or_si256(r, _mm256_i32gather_epi32((const int*)tab->s[3], _mm256_and_si256(w, mask), 4));
+}
+
+static inline __m256i zuc_mb_load_avx2(const zuc_mb_state_t* state, u32 i)
+{
+  return _mm256_loadu_si256((const __m256i*)state->lfsr[i % 16]);
+}
+
+/* Same as zuc_mb_clock_lane() for all lanes, one 256-bit register per
+ * LFSR/F word */
+static void zuc_mb_clock_avx2(zuc_mb_state_t* state, u32 t_begin, u32 t_end, bool init, u32* p_keystream)
+{
+  const zuc_mb_tables_t* tab    = zuc_mb_get_tables();
+  const __m256i          mask16 = _mm256_set1_epi32(0xFFFF);
+  __m256i                r1     = _mm256_loadu_si256((__m256i*)state->r1);
+  __m256i                r2     = _mm256_loadu_si256((__m256i*)state->r2);
+
+  for (u32 t = t_begin; t < t_end; t++) {
+    __m256i s0  = zuc_mb_load_avx2(state, t);
+    __m256i s15 = zuc_mb_load_avx2(state, t + 15);
+
+    // Bit reorganization
+    __m256i x0 = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(s15, _mm256_set1_epi32(0x7FFF8000)), 1),
+                                 _mm256_and_si256(zuc_mb_load_avx2(state, t + 14), mask16));
+    __m256i x1 = _mm256_or_si256(_mm256_slli_epi32(zuc_mb_load_avx2(state, t + 11), 16),
+                                 _mm256_srli_epi32(zuc_mb_load_avx2(state, t + 9), 15));
+    __m256i x2 = _mm256_or_si256(_mm256_slli_epi32(zuc_mb_load_avx2(state, t + 7), 16),
+                                 _mm256_srli_epi32(zuc_mb_load_avx2(state, t + 5), 15));
+
+    // F
+    __m256i w  = _mm256_add_epi32(_mm256_xor_si256(x0, r1), r2);
+    __m256i w1 = _mm256_add_epi32(r1, x1);
+    __m256i w2 = _mm256_xor_si256(r2, x2);
+    __m256i u  = _mm256_or_si256(_mm256_slli_epi32(w1, 16), _mm256_srli_epi32(w2, 16));
+    __m256i v  = _mm256_or_si256(_mm256_slli_epi32(w2, 16), _mm256_srli_epi32(w1, 16));
+    u          = _mm256_xor_si256(_mm256_xor_si256(u, zuc_mb_rot_avx2(u, 2)),
+                         _mm256_xor_si256(_mm256_xor_si256(zuc_mb_rot_avx2(u, 10), zuc_mb_rot_avx2(u, 18)),
+                                          zuc_mb_rot_avx2(u, 24)));
+    v          = _mm256_xor_si256(_mm256_xor_si256(v, zuc_mb_rot_avx2(v, 8)),
+                         _mm256_xor_si256(_mm256_xor_si256(zuc_mb_rot_avx2(v, 14), zuc_mb_rot_avx2(v, 22)),
+                                          zuc_mb_rot_avx2(v, 30)));
+    r1         = zuc_mb_sbox_avx2(tab, u);
+    r2         = zuc_mb_sbox_avx2(tab, v);
+
+    if (p_keystream != NULL) {
+      __m256i x3 = _mm256_or_si256(_mm256_slli_epi32(zuc_mb_load_avx2(state, t + 2), 16), _mm256_srli_epi32(s0, 15));
+      _mm256_storeu_si256((__m256i*)&p_keystream[(t - t_begin) * ZUC_MB_NOF_LANES], _mm256_xor_si256(w, x3));
+    }
+
+    // LFSR
+    __m256i f = s0;
+    f         = zuc_mb_add_mod_avx2(f, zuc_mb_mul_pow2_avx2(s0, 8));
+    f         = zuc_mb_add_mod_avx2(f, zuc_mb_mul_pow2_avx2(zuc_mb_load_avx2(state, t + 4), 20));
+    f         = zuc_mb_add_mod_avx2(f, zuc_mb_mul_pow2_avx2(zuc_mb_load_avx2(state, t + 10), 21));
+    f         = zuc_mb_add_mod_avx2(f, zuc_mb_mul_pow2_avx2(zuc_mb_load_avx2(state, t + 13), 17));
+    f         = zuc_mb_add_mod_avx2(f, zuc_mb_mul_pow2_avx2(s15, 15));
+    if (init) {
+      f = zuc_mb_add_mod_avx2(f, _mm256_srli_epi32(w, 1));
+    }
+    _mm256_storeu_si256((__m256i*)state->lfsr[t % 16], f);
+  }
+
+  _mm256_storeu_si256((__m256i*)state->r1, r1);
+  _mm256_storeu_si256((__m256i*)state->r2, r2);
+}
+
+#endif // LV_HAVE_AVX2
+
+void zuc_mb_initialize_lanes(zuc_mb_state_t* state, u32 lane_mask, const u8 k[][16], const u8 iv[][16])
+{
+#ifdef LV_HAVE_AVX2
+  if (__builtin_popcount(lane_mask) >= ZUC_MB_MIN_SIMD_LANES) {
+    zuc_mb_state_t init = {};
+    for (u32 lane = 0; lane < ZUC_MB_NOF_LANES; lane++) {
+      if (lane_mask & (1U << lane)) {
+        for (u32 i = 0; i < 16; i++) {
+          init.lfsr[i][lane] = MAKEU31(k[lane][i], EK_d[i], iv[lane][i]);
+        }
+      }
+    }
+
+    // 32 clocks in initialisation mode and one clock in work mode, discarding the output of F
+    zuc_mb_clock_avx2(&init, 0, 32, true, NULL);
+    zuc_mb_clock_avx2(&init, 0, 1, false, NULL);
+
+    for (u32 lane = 0; lane < ZUC_MB_NOF_LANES; lane++) {
+      if (lane_mask & (1U << lane)) {
+        for (u32 i = 0; i < 16; i++) {
+          state->lfsr[i][lane] = init.lfsr[(i + 1) % 16][lane];
+        }
+        state->r1[lane] = init.r1[lane];
+        state->r2[lane] = init.r2[lane];
+      }
+    }
+    return;
+  }
+#endif // LV_HAVE_AVX2
+  for (u32 lane = 0; lane < ZUC_MB_NOF_LANES; lane++) {
+    if (lane_mask & (1U << lane)) {
+      zuc_mb_initialize_lane(state, lane, k[lane], iv[lane]);
+    }
+  }
+}
+
+void zuc_mb_generate_keystream(zuc_mb_state_t* state, u32 lane_mask, u32* p_keystream)
+{
+#ifdef LV_HAVE_AVX2
+  if (__builtin_popcount(lane_mask) >= ZUC_MB_MIN_SIMD_LANES) {
+    zuc_mb_clock_avx2(state, 0, ZUC_MB_NOF_WORDS, false, p_keystream);
+    return;
+  }
+#endif // LV_HAVE_AVX2
+  for (u32 lane = 0; lane < ZUC_MB_NOF_LANES; lane++) {
+    if (lane_mask & (1U << lane)) {
+      zuc_mb_generate_lane(state, lane, p_keystream);
+    }
+  }
+}
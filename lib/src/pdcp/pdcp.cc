@@ -101,6 +101,15 @@ void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
   }
 }
 
+void pdcp::write_sdus(uint32_t lcid, span<unique_byte_buffer_t> sdus)
+{
+  if (valid_lcid(lcid)) {
+    pdcp_array.at(lcid)->write_sdus(sdus);
+  } else {
+    logger.warning("LCID %d doesn't exist. Deallocating %zd SDUs", lcid, sdus.size());
+  }
+}
+
 void pdcp::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
   if (valid_mch_lcid(lcid)) {
@@ -44,6 +44,22 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
   logger.debug(sec_cfg.k_up_enc.data(), 32, "K_up_enc");
   logger.debug(sec_cfg.k_rrc_int.data(), 32, "K_rrc_int");
   logger.debug(sec_cfg.k_up_int.data(), 32, "K_up_int");
+
+  // Expand the AES key schedules once, rather than for every PDU
+  if (sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+    rrc_enc_aes.set_key(&sec_cfg.k_rrc_enc[16]);
+    up_enc_aes.set_key(&sec_cfg.k_up_enc[16]);
+  } else {
+    rrc_enc_aes.reset();
+    up_enc_aes.reset();
+  }
+  if (sec_cfg.integ_algo == INTEGRITY_ALGORITHM_ID_128_EIA2) {
+    rrc_int_aes.set_key(&sec_cfg.k_rrc_int[16]);
+    up_int_aes.set_key(&sec_cfg.k_up_int[16]);
+  } else {
+    rrc_int_aes.reset();
+    up_int_aes.reset();
+  }
 }
 
 /****************************************************************************
@@ -67,7 +83,8 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      security_128_eia2(
+          is_srb() ? rrc_int_aes : up_int_aes, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
@@ -105,7 +122,8 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      security_128_eia2(
+          is_srb() ? rrc_int_aes : up_int_aes, count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
@@ -162,8 +180,8 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
       memcpy(ct, ct_tmp, msg_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      security_128_eea2(
+          is_srb() ? rrc_enc_aes : up_enc_aes, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
@@ -202,8 +220,8 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
       memcpy(msg, msg_tmp, ct_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea2(
+          is_srb() ? rrc_enc_aes : up_enc_aes, count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
@@ -215,6 +233,33 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(msg, ct_len, "Cipher decrypt output msg");
 }
 
+void pdcp_entity_base::cipher_encrypt_burst(span<const cipher_burst_item_t> pdus)
+{
+  const uint8_t* k_enc = is_srb() ? sec_cfg.k_rrc_enc.data() : sec_cfg.k_up_enc.data();
+
+  logger.debug("Cipher encrypt burst input: %zd PDUs, Bearer ID: %d, Direction %s",
+               pdus.size(),
+               cfg.bearer_id,
+               cfg.tx_direction == SECURITY_DIRECTION_DOWNLINK ? "Downlink" : "Uplink");
+
+  switch (sec_cfg.cipher_algo) {
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      security_128_eea1_burst(&k_enc[16], cfg.bearer_id - 1, cfg.tx_direction, pdus);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      security_128_eea2_burst(is_srb() ? rrc_enc_aes : up_enc_aes, cfg.bearer_id - 1, cfg.tx_direction, pdus);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      security_128_eea3_burst(&k_enc[16], cfg.bearer_id - 1, cfg.tx_direction, pdus);
+      break;
+    default:
+      for (const cipher_burst_item_t& pdu : pdus) {
+        cipher_encrypt(const_cast<uint8_t*>(pdu.msg), pdu.msg_len, pdu.count, pdu.msg_out);
+      }
+      break;
+  }
+}
+
 /****************************************************************************
  * Common pack functions
  ***************************************************************************/
@@ -25,6 +25,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
+#include <array>
 #include <bitset>
 
 namespace srsran {
@@ -144,20 +145,103 @@ void pdcp_entity_lte::reset()
 
 // GW/RRC interface
 void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
+{
+  uint32_t tx_count = 0;
+  if (not prepare_tx_pdu(sdu, upper_sn, tx_count)) {
+    return;
+  }
+
+  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+    cipher_encrypt(
+        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
+  }
+
+  send_tx_pdu(std::move(sdu));
+}
+
+void pdcp_entity_lte::write_sdus(span<unique_byte_buffer_t> sdus)
+{
+  // Headers and MAC-I are added to up to PDCP_MAX_TX_BURST SDUs, which are then ciphered together and passed to RLC
+  std::array<cipher_burst_item_t, PDCP_MAX_TX_BURST> pdus;
+  std::array<tx_state_t, PDCP_MAX_TX_BURST>          tx_states;
+  for (size_t offset = 0; offset < sdus.size(); offset += PDCP_MAX_TX_BURST) {
+    span<unique_byte_buffer_t> burst    = sdus.subspan(offset, std::min(sdus.size() - offset, pdus.size()));
+    uint32_t                   nof_pdus = 0;
+
+    for (size_t i = 0; i < burst.size(); i++) {
+      unique_byte_buffer_t& sdu      = burst[i];
+      uint32_t              tx_count = 0;
+
+      tx_states[i] = get_tx_state();
+      if (not prepare_tx_pdu(sdu, -1, tx_count)) {
+        sdu.reset();
+        continue;
+      }
+      // Security may have been enabled while preparing this SDU
+      if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+        pdus[nof_pdus++] = {&sdu->msg[cfg.hdr_len_bytes],
+                            &sdu->msg[cfg.hdr_len_bytes],
+                            sdu->N_bytes - cfg.hdr_len_bytes,
+                            tx_count};
+      }
+    }
+    cipher_encrypt_burst(span<const cipher_burst_item_t>(pdus.data(), nof_pdus));
+
+    // The RLC queue was only checked before the whole burst was prepared, so check it again for every PDU
+    for (size_t i = 0; i < burst.size(); i++) {
+      if (burst[i] == nullptr) {
+        continue;
+      }
+      if (rlc->sdu_queue_is_full(lcid)) {
+        discard_tx_burst(burst.subspan(i, burst.size() - i), tx_states[i]);
+        break;
+      }
+      send_tx_pdu(std::move(burst[i]));
+    }
+  }
+}
+
+pdcp_entity_lte::tx_state_t pdcp_entity_lte::get_tx_state() const
+{
+  return {st.next_pdcp_tx_sn, st.tx_hfn, enable_security_tx_sn, integrity_direction, encryption_direction};
+}
+
+// Drops the PDUs RLC cannot take and gives their SNs back, so that no gap is left in the transmitted SNs
+void pdcp_entity_lte::discard_tx_burst(span<unique_byte_buffer_t> pdus, const tx_state_t& state)
+{
+  for (unique_byte_buffer_t& pdu : pdus) {
+    if (pdu == nullptr) {
+      continue;
+    }
+    logger.info(pdu->msg, pdu->N_bytes, "Dropping %s PDU due to full queue, SN=%d", rb_name.c_str(), pdu->md.pdcp_sn);
+    if (!rlc->rb_is_um(lcid) and is_drb()) {
+      undelivered_sdus->clear_sdu(pdu->md.pdcp_sn);
+    }
+    pdu.reset();
+  }
+
+  st.next_pdcp_tx_sn    = state.next_pdcp_tx_sn;
+  st.tx_hfn             = state.tx_hfn;
+  enable_security_tx_sn = state.enable_security_tx_sn;
+  integrity_direction   = state.integrity_direction;
+  encryption_direction  = state.encryption_direction;
+}
+
+bool pdcp_entity_lte::prepare_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn, uint32_t& tx_count)
 {
   if (!active) {
     logger.warning("Dropping %s SDU due to inactive bearer", rb_name.c_str());
-    return;
+    return false;
   }
 
   if (rlc->is_suspended(lcid)) {
     logger.warning("Trying to send SDU while re-establishment is in progress. Dropping SDU. LCID=%d", lcid);
-    return;
+    return false;
   }
 
   if (rlc->sdu_queue_is_full(lcid)) {
     logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
-    return;
+    return false;
   }
 
   // Get COUNT to be used with this packet
@@ -168,7 +252,7 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     used_sn = upper_sn; // SN provided by the upper layers, due to handover.
   }
 
-  uint32_t tx_count = COUNT(st.tx_hfn, used_sn); // Normal scenario
+  tx_count = COUNT(st.tx_hfn, used_sn); // Normal scenario
 
   // If the bearer is mapped to RLC AM, save TX_COUNT and a copy of the PDU.
   // This will be used for reestablishment, where unack'ed PDUs will be re-transmitted.
@@ -179,7 +263,7 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     if (not store_sdu(used_sn, sdu)) {
       // Could not store the SDU, discarding
       logger.warning("Could not store SDU. Discarding SN=%d", used_sn);
-      return;
+      return false;
     }
   }
   // check for pending security config in transmit direction
@@ -202,19 +286,6 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
-    cipher_encrypt(
-        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
-  }
-
-  logger.info(sdu->msg,
-              sdu->N_bytes,
-              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
-              rb_name.c_str(),
-              used_sn,
-              srsran_direction_text[integrity_direction],
-              srsran_direction_text[encryption_direction]);
-
   // Set SDU metadata for RLC AM
   sdu->md.pdcp_sn = used_sn;
 
@@ -226,15 +297,27 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
       st.next_pdcp_tx_sn = 0;
     }
   }
+  return true;
+}
+
+void pdcp_entity_lte::send_tx_pdu(unique_byte_buffer_t pdu)
+{
+  logger.info(pdu->msg,
+              pdu->N_bytes,
+              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
+              rb_name.c_str(),
+              pdu->md.pdcp_sn,
+              srsran_direction_text[integrity_direction],
+              srsran_direction_text[encryption_direction]);
 
   // Pass PDU to lower layers
   metrics.num_tx_pdus++;
-  metrics.num_tx_pdu_bytes += sdu->N_bytes;
+  metrics.num_tx_pdu_bytes += pdu->N_bytes;
   // Count TX'd bytes as if they were ACK'd if RLC is UM
   if (rlc->rb_is_um(lcid)) {
     metrics.num_tx_acked_bytes = metrics.num_tx_pdu_bytes;
   }
-  rlc->write_sdu(lcid, std::move(sdu));
+  rlc->write_sdu(lcid, std::move(pdu));
 }
 
 // RLC interface
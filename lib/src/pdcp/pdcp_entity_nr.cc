@@ -21,6 +21,7 @@
 
 #include "srsran/upper/pdcp_entity_nr.h"
 #include "srsran/common/security.h"
+#include <array>
 
 namespace srsran {
 
@@ -101,6 +102,85 @@ void pdcp_entity_nr::reset()
 
 // SDAP/RRC interface
 void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
+{
+  if (not prepare_tx_pdu(sdu)) {
+    return;
+  }
+
+  // TS 38.323, section 5.8: Ciphering
+  // The data unit that is ciphered is the MAC-I and the
+  // data part of the PDCP Data PDU except the
+  // SDAP header and the SDAP Control PDU if included in the PDCP SDU.
+  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+    cipher_encrypt(&sdu->msg[cfg.hdr_len_bytes],
+                   sdu->N_bytes - cfg.hdr_len_bytes,
+                   sdu->md.pdcp_sn,
+                   &sdu->msg[cfg.hdr_len_bytes]);
+  }
+
+  send_tx_pdu(std::move(sdu));
+}
+
+void pdcp_entity_nr::write_sdus(span<unique_byte_buffer_t> sdus)
+{
+  // Headers and MAC-I are added to up to PDCP_MAX_TX_BURST SDUs, which are then ciphered together and passed to RLC
+  std::array<cipher_burst_item_t, PDCP_MAX_TX_BURST> pdus;
+  for (size_t offset = 0; offset < sdus.size(); offset += PDCP_MAX_TX_BURST) {
+    span<unique_byte_buffer_t> burst    = sdus.subspan(offset, std::min(sdus.size() - offset, pdus.size()));
+    uint32_t                   nof_pdus = 0;
+
+    // TX_NEXT to go back to if RLC cannot take the PDUs of this burst
+    uint32_t burst_tx_next     = tx_next;
+    bool     burst_tx_overflow = tx_overflow;
+
+    for (unique_byte_buffer_t& sdu : burst) {
+      if (not prepare_tx_pdu(sdu)) {
+        sdu.reset();
+        continue;
+      }
+      if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+        pdus[nof_pdus++] = {&sdu->msg[cfg.hdr_len_bytes],
+                            &sdu->msg[cfg.hdr_len_bytes],
+                            sdu->N_bytes - cfg.hdr_len_bytes,
+                            sdu->md.pdcp_sn};
+      }
+    }
+    cipher_encrypt_burst(span<const cipher_burst_item_t>(pdus.data(), nof_pdus));
+
+    // The RLC queue was only checked before the whole burst was prepared, so check it again for every PDU
+    for (size_t i = 0; i < burst.size(); i++) {
+      if (burst[i] == nullptr) {
+        continue;
+      }
+      if (rlc->sdu_queue_is_full(lcid)) {
+        discard_tx_burst(burst.subspan(i, burst.size() - i), burst_tx_next, burst_tx_overflow);
+        break;
+      }
+      burst_tx_next     = burst[i]->md.pdcp_sn + 1;
+      burst_tx_overflow = burst_tx_next == 0;
+      send_tx_pdu(std::move(burst[i]));
+    }
+  }
+}
+
+// Drops the PDUs RLC cannot take and gives their COUNTs back, so that no gap is left in the transmitted COUNTs
+void pdcp_entity_nr::discard_tx_burst(span<unique_byte_buffer_t> pdus, uint32_t tx_next_, bool tx_overflow_)
+{
+  for (unique_byte_buffer_t& pdu : pdus) {
+    if (pdu == nullptr) {
+      continue;
+    }
+    logger.info(
+        pdu->msg, pdu->N_bytes, "Dropping %s PDU due to full queue, COUNT=%d", rb_name.c_str(), pdu->md.pdcp_sn);
+    discard_timers_map.erase(pdu->md.pdcp_sn);
+    pdu.reset();
+  }
+
+  tx_next     = tx_next_;
+  tx_overflow = tx_overflow_;
+}
+
+bool pdcp_entity_nr::prepare_tx_pdu(unique_byte_buffer_t& sdu)
 {
   // Log SDU
   logger.info(sdu->msg,
@@ -113,13 +193,13 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
 
   if (rlc->sdu_queue_is_full(lcid)) {
     logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
-    return;
+    return false;
   }
 
   // Check for COUNT overflow
   if (tx_overflow) {
     logger.warning("TX_NEXT has overflowed. Dropping packet");
-    return;
+    return false;
   }
   if (tx_next + 1 == 0) {
     tx_overflow = true;
@@ -152,34 +232,29 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
     append_mac(sdu, mac);
   }
 
-  // TS 38.323, section 5.8: Ciphering
-  // The data unit that is ciphered is the MAC-I and the
-  // data part of the PDCP Data PDU except the
-  // SDAP header and the SDAP Control PDU if included in the PDCP SDU.
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
-    cipher_encrypt(
-        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_next, &sdu->msg[cfg.hdr_len_bytes]);
-  }
-
   // Set meta-data for RLC AM
   sdu->md.pdcp_sn = tx_next;
 
-  logger.info(sdu->msg,
-              sdu->N_bytes,
+  // Increment TX_NEXT
+  tx_next++;
+  return true;
+}
+
+void pdcp_entity_nr::send_tx_pdu(unique_byte_buffer_t pdu)
+{
+  logger.info(pdu->msg,
+              pdu->N_bytes,
               "TX %s PDU (%dB), HFN=%d, SN=%d, integrity=%s, encryption=%s",
               rb_name.c_str(),
-              sdu->N_bytes,
-              HFN(tx_next),
-              SN(tx_next),
+              pdu->N_bytes,
+              HFN(pdu->md.pdcp_sn),
+              SN(pdu->md.pdcp_sn),
               srsran_direction_text[integrity_direction],
               srsran_direction_text[encryption_direction]);
 
   // Check if PDCP is associated with more than on RLC entity TODO
   // Write to lower layers
-  rlc->write_sdu(lcid, std::move(sdu));
-
-  // Increment TX_NEXT
-  tx_next++;
+  rlc->write_sdu(lcid, std::move(pdu));
 }
 
 // RLC interface
@@ -219,10 +219,10 @@ bool srsran_N_id_1_isvalid(uint32_t N_id_1)
 
 srsran_mod_t srsran_str2mod(const char* str)
 {
-  char mod_str[7] = {};
+  char mod_str[8] = {};
 
   // Convert letters to upper case
-  for (uint32_t i = 0; str[i] != '\0' && i < 6; i++) {
+  for (uint32_t i = 0; str[i] != '\0' && i < 7; i++) {
     char c = str[i];
     if (c >= 'a' && c <= 'z') {
       c &= (~' ');
@@ -238,6 +238,8 @@ srsran_mod_t srsran_str2mod(const char* str)
     return SRSRAN_MOD_64QAM;
   } else if (!strcmp(mod_str, "256QAM")) {
     return SRSRAN_MOD_256QAM;
+  } else if (!strcmp(mod_str, "1024QAM")) {
+    return SRSRAN_MOD_1024QAM;
   } else {
     return (srsran_mod_t)SRSRAN_ERROR_INVALID_INPUTS;
   }
@@ -256,6 +258,8 @@ char* srsran_mod_string(srsran_mod_t mod)
       return "64QAM";
     case SRSRAN_MOD_256QAM:
       return "256QAM";
+    case SRSRAN_MOD_1024QAM:
+      return "1024QAM";
     default:
       return "N/A";
   }
@@ -274,6 +278,8 @@ uint32_t srsran_mod_bits_x_symbol(srsran_mod_t mod)
       return 6;
     case SRSRAN_MOD_256QAM:
       return 8;
+    case SRSRAN_MOD_1024QAM:
+      return 10;
     default:
       return 0;
   }
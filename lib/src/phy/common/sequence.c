@@ -768,7 +768,7 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
     out[i] = in[i] ^ reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
   }
 #else  // SEQUENCE_PAR_BITS % 8 == 0
-  while (i < (length / 8 - (SEQUENCE_PAR_BITS - 1) / 8)) {
+  while (i + (SEQUENCE_PAR_BITS - 1) / 8 < length / 8) {
     uint32_t c = (uint32_t)(x1 ^ x2);
 
     for (uint32_t j = 0; j < SEQUENCE_PAR_BITS / 8; j++) {
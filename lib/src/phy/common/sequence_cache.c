@@ -0,0 +1,351 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/common/sequence_cache.h"
+#include "srsran/phy/common/sequence.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif /* LV_HAVE_SSE */
+
+/*
+ * Spreads the seed bits before selecting the set. LTE seeds carry the cell identifier in the LSB and the RNTI in the
+ * MSB, so the raw seed modulo the number of sets would map every UE of a cell to the same set.
+ */
+static inline uint32_t sequence_cache_set(const srsran_sequence_cache_t* q, uint32_t seed)
+{
+  uint32_t h = seed;
+  h ^= h >> 16U;
+  h *= 0x7feb352dU;
+  h ^= h >> 15U;
+  h *= 0x846ca68bU;
+  h ^= h >> 16U;
+  return h % q->nof_sets;
+}
+
+static inline srsran_sequence_cache_entry_t*
+sequence_cache_find(srsran_sequence_cache_entry_t* ways, uint32_t seed, uint32_t len)
+{
+  for (uint32_t i = 0; i < SRSRAN_SEQUENCE_CACHE_WAYS; i++) {
+    if (ways[i].len != 0 && ways[i].seed == seed && ways[i].len >= len) {
+      return &ways[i];
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Returns the packed sequence for the seed, holding the set lock. Hits only take the lock in read mode so that several
+ * workers can scramble from the same set concurrently; misses generate the sequence with the lock in write mode.
+ */
+static const uint8_t* sequence_cache_lock(srsran_sequence_cache_t* q, uint32_t set, uint32_t seed, uint32_t len)
+{
+  srsran_sequence_cache_entry_t* ways = &q->entries[set * SRSRAN_SEQUENCE_CACHE_WAYS];
+  pthread_rwlock_t*              lock = &q->locks[set];
+  uint64_t                       tick = __atomic_add_fetch(&q->tick, 1, __ATOMIC_RELAXED);
+
+  pthread_rwlock_rdlock(lock);
+  srsran_sequence_cache_entry_t* e = sequence_cache_find(ways, seed, len);
+  if (e != NULL) {
+    __atomic_store_n(&e->last_use, tick, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&q->metrics.nof_hits, 1, __ATOMIC_RELAXED);
+    return e->c;
+  }
+  pthread_rwlock_unlock(lock);
+
+  pthread_rwlock_wrlock(lock);
+
+  // Another worker may have generated it in the meantime
+  e = sequence_cache_find(ways, seed, len);
+  if (e != NULL) {
+    e->last_use = tick;
+    __atomic_add_fetch(&q->metrics.nof_hits, 1, __ATOMIC_RELAXED);
+    return e->c;
+  }
+
+  // Extend the entry of the same seed if it is too short, otherwise replace an empty or the least recently used entry
+  e = &ways[0];
+  for (uint32_t i = 0; i < SRSRAN_SEQUENCE_CACHE_WAYS; i++) {
+    if (ways[i].len != 0 && ways[i].seed == seed) {
+      e = &ways[i];
+      break;
+    }
+    if (ways[i].len == 0 || (e->len != 0 && ways[i].last_use < e->last_use)) {
+      e = &ways[i];
+    }
+  }
+
+  uint32_t gen_len = len;
+  if (e->len != 0 && e->seed == seed) {
+    // Grow geometrically, allocations of the same UE change size from one TTI to the next
+    gen_len = SRSRAN_MIN(q->max_len, SRSRAN_MAX(len, 2 * e->len));
+  } else if (e->len != 0) {
+    __atomic_add_fetch(&q->metrics.nof_evicted, 1, __ATOMIC_RELAXED);
+  }
+
+  srsran_vec_u8_zero(e->c, (gen_len + 7) / 8);
+  srsran_sequence_apply_packed(e->c, e->c, gen_len, seed);
+  e->seed     = seed;
+  e->len      = gen_len;
+  e->last_use = tick;
+  __atomic_add_fetch(&q->metrics.nof_misses, 1, __ATOMIC_RELAXED);
+
+  return e->c;
+}
+
+// Returns true if the request has to be served without the cache
+static inline bool sequence_cache_bypass(srsran_sequence_cache_t* q, uint32_t len)
+{
+  if (q == NULL || q->entries == NULL) {
+    return true;
+  }
+  if (len > q->max_len) {
+    __atomic_add_fetch(&q->metrics.nof_bypass, 1, __ATOMIC_RELAXED);
+    return true;
+  }
+  return false;
+}
+
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries, uint32_t max_len)
+{
+  if (q == NULL || nof_entries == 0 || max_len == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+  q->nof_sets = SRSRAN_CEIL(nof_entries, SRSRAN_SEQUENCE_CACHE_WAYS);
+  q->max_len  = max_len;
+
+  uint32_t nof_ways = q->nof_sets * SRSRAN_SEQUENCE_CACHE_WAYS;
+  q->entries        = SRSRAN_MEM_ALLOC(srsran_sequence_cache_entry_t, nof_ways);
+  q->locks          = SRSRAN_MEM_ALLOC(pthread_rwlock_t, q->nof_sets);
+  if (q->entries == NULL || q->locks == NULL) {
+    ERROR("Error allocating sequence cache");
+    srsran_sequence_cache_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->entries, srsran_sequence_cache_entry_t, nof_ways);
+
+  for (uint32_t i = 0; i < q->nof_sets; i++) {
+    pthread_rwlock_init(&q->locks[i], NULL);
+  }
+
+  for (uint32_t i = 0; i < nof_ways; i++) {
+    q->entries[i].c = srsran_vec_u8_malloc((max_len + 7) / 8);
+    if (q->entries[i].c == NULL) {
+      ERROR("Error allocating sequence cache");
+      srsran_sequence_cache_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  q->metrics.nof_entries = nof_ways;
+  q->metrics.max_len     = max_len;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->entries != NULL) {
+    for (uint32_t i = 0; i < q->nof_sets * SRSRAN_SEQUENCE_CACHE_WAYS; i++) {
+      if (q->entries[i].c != NULL) {
+        free(q->entries[i].c);
+      }
+    }
+    free(q->entries);
+  }
+
+  if (q->locks != NULL) {
+    if (q->entries != NULL) {
+      for (uint32_t i = 0; i < q->nof_sets; i++) {
+        pthread_rwlock_destroy(&q->locks[i]);
+      }
+    }
+    free(q->locks);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+}
+
+void srsran_sequence_cache_reset(srsran_sequence_cache_t* q)
+{
+  if (q == NULL || q->entries == NULL) {
+    return;
+  }
+
+  for (uint32_t set = 0; set < q->nof_sets; set++) {
+    pthread_rwlock_wrlock(&q->locks[set]);
+    for (uint32_t i = 0; i < SRSRAN_SEQUENCE_CACHE_WAYS; i++) {
+      q->entries[set * SRSRAN_SEQUENCE_CACHE_WAYS + i].len = 0;
+    }
+    pthread_rwlock_unlock(&q->locks[set]);
+  }
+}
+
+void srsran_sequence_cache_get_metrics(srsran_sequence_cache_t* q, srsran_sequence_cache_metrics_t* metrics)
+{
+  if (q == NULL || metrics == NULL) {
+    return;
+  }
+
+  metrics->nof_entries = q->metrics.nof_entries;
+  metrics->max_len     = q->metrics.max_len;
+  metrics->nof_hits    = __atomic_load_n(&q->metrics.nof_hits, __ATOMIC_RELAXED);
+  metrics->nof_misses  = __atomic_load_n(&q->metrics.nof_misses, __ATOMIC_RELAXED);
+  metrics->nof_evicted = __atomic_load_n(&q->metrics.nof_evicted, __ATOMIC_RELAXED);
+  metrics->nof_bypass  = __atomic_load_n(&q->metrics.nof_bypass, __ATOMIC_RELAXED);
+}
+
+void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                        uint32_t                 seed,
+                                        const uint8_t*           in,
+                                        uint8_t*                 out,
+                                        uint32_t                 len)
+{
+  if (sequence_cache_bypass(q, len)) {
+    srsran_sequence_apply_packed(in, out, len, seed);
+    return;
+  }
+
+  uint32_t       set = sequence_cache_set(q, seed);
+  const uint8_t* c   = sequence_cache_lock(q, set, seed, len);
+
+  srsran_vec_xor_bbb(in, c, out, len / 8);
+
+  // The cached sequence may be longer than the request, only the first bits of the last byte are applied
+  uint32_t rem8 = len % 8;
+  if (rem8 != 0) {
+    out[len / 8] = in[len / 8] ^ (uint8_t)(c[len / 8] & (0xffU << (8U - rem8)));
+  }
+
+  pthread_rwlock_unlock(&q->locks[set]);
+}
+
+void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                     uint32_t                 seed,
+                                     const uint8_t*           in,
+                                     uint8_t*                 out,
+                                     uint32_t                 len)
+{
+  if (sequence_cache_bypass(q, len)) {
+    srsran_sequence_apply_bit(in, out, len, seed);
+    return;
+  }
+
+  uint32_t       set = sequence_cache_set(q, seed);
+  const uint8_t* c   = sequence_cache_lock(q, set, seed, len);
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_SSE
+  for (; i + 16 <= len; i += 16) {
+    // Broadcasts each of the two sequence bytes to 8 lanes and keeps one bit per lane, MSB first
+    __m128i bits = _mm_cvtsi32_si128(c[i / 8] | (c[i / 8 + 1] << 8U));
+    __m128i sel  = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    __m128i mask = _mm_shuffle_epi8(bits, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+    mask         = _mm_cmpeq_epi8(_mm_and_si128(mask, sel), sel);
+
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_xor_si128(v, _mm_and_si128(mask, _mm_set1_epi8(1)));
+    _mm_storeu_si128((__m128i*)(out + i), v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; i < len; i++) {
+    out[i] = in[i] ^ ((c[i / 8] >> (7U - i % 8U)) & 1U);
+  }
+
+  pthread_rwlock_unlock(&q->locks[set]);
+}
+
+void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                   uint32_t                 seed,
+                                   const int8_t*            in,
+                                   int8_t*                  out,
+                                   uint32_t                 len)
+{
+  if (sequence_cache_bypass(q, len)) {
+    srsran_sequence_apply_c(in, out, len, seed);
+    return;
+  }
+
+  uint32_t       set = sequence_cache_set(q, seed);
+  const uint8_t* c   = sequence_cache_lock(q, set, seed, len);
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_SSE
+  for (; i + 16 <= len; i += 16) {
+    __m128i bits = _mm_cvtsi32_si128(c[i / 8] | (c[i / 8 + 1] << 8U));
+    __m128i sel  = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    __m128i mask = _mm_shuffle_epi8(bits, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+    mask         = _mm_cmpeq_epi8(_mm_and_si128(mask, sel), sel);
+
+    // Negates the lanes with the mask set: (v ^ -1) - (-1) = -v
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_sub_epi8(_mm_xor_si128(v, mask), mask);
+    _mm_storeu_si128((__m128i*)(out + i), v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; i < len; i++) {
+    out[i] = ((c[i / 8] >> (7U - i % 8U)) & 1U) ? -in[i] : in[i];
+  }
+
+  pthread_rwlock_unlock(&q->locks[set]);
+}
+
+void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                   uint32_t                 seed,
+                                   const int16_t*           in,
+                                   int16_t*                 out,
+                                   uint32_t                 len)
+{
+  if (sequence_cache_bypass(q, len)) {
+    srsran_sequence_apply_s(in, out, len, seed);
+    return;
+  }
+
+  uint32_t       set = sequence_cache_set(q, seed);
+  const uint8_t* c   = sequence_cache_lock(q, set, seed, len);
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_SSE
+  for (; i + 8 <= len; i += 8) {
+    __m128i sel  = _mm_setr_epi16(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    __m128i mask = _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(c[i / 8]), sel), sel);
+
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_sub_epi16(_mm_xor_si128(v, mask), mask);
+    _mm_storeu_si128((__m128i*)(out + i), v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; i < len; i++) {
+    out[i] = ((c[i / 8] >> (7U - i % 8U)) & 1U) ? -in[i] : in[i];
+  }
+
+  pthread_rwlock_unlock(&q->locks[set]);
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsran/common/test_common.h"
+#include "srsran/phy/common/sequence.h"
+#include "srsran/phy/common/sequence_cache.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
+
+#define MAX_LEN 4000
+#define NOF_ENTRIES 8
+#define BUF_LEN (MAX_LEN + 8)
+
+static uint8_t in_u8[BUF_LEN];
+static int8_t  in_c[BUF_LEN];
+static int16_t in_s[BUF_LEN];
+static uint8_t gold_u8[BUF_LEN];
+static uint8_t out_u8[BUF_LEN];
+static int8_t  gold_c[BUF_LEN];
+static int8_t  out_c[BUF_LEN];
+static int16_t gold_s[BUF_LEN];
+static int16_t out_s[BUF_LEN];
+
+// Every variant matches the sequence generated on the fly
+static int apply_test(srsran_sequence_cache_t* q, uint32_t seed, uint32_t len)
+{
+  srsran_sequence_apply_packed(in_u8, gold_u8, len, seed);
+  srsran_sequence_cache_apply_packed(q, seed, in_u8, out_u8, len);
+  TESTASSERT(memcmp(gold_u8, out_u8, (len + 7) / 8) == 0);
+
+  srsran_sequence_apply_bit(in_u8, gold_u8, len, seed);
+  srsran_sequence_cache_apply_bit(q, seed, in_u8, out_u8, len);
+  TESTASSERT(memcmp(gold_u8, out_u8, len) == 0);
+
+  srsran_sequence_apply_c(in_c, gold_c, len, seed);
+  srsran_sequence_cache_apply_c(q, seed, in_c, out_c, len);
+  TESTASSERT(memcmp(gold_c, out_c, len) == 0);
+
+  srsran_sequence_apply_s(in_s, gold_s, len, seed);
+  srsran_sequence_cache_apply_s(q, seed, in_s, out_s, len);
+  TESTASSERT(memcmp(gold_s, out_s, len * sizeof(int16_t)) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int hit_miss_test()
+{
+  srsran_sequence_cache_t         q       = {};
+  srsran_sequence_cache_metrics_t metrics = {};
+
+  TESTASSERT(srsran_sequence_cache_init(&q, NOF_ENTRIES, MAX_LEN) == SRSRAN_SUCCESS);
+
+  // The first request generates the sequence, the three other variants are served from the cache
+  TESTASSERT(apply_test(&q, 0x1234, 1000) == SRSRAN_SUCCESS);
+  srsran_sequence_cache_get_metrics(&q, &metrics);
+  TESTASSERT(metrics.nof_entries == NOF_ENTRIES);
+  TESTASSERT(metrics.nof_misses == 1);
+  TESTASSERT(metrics.nof_hits == 3);
+
+  // Shorter requests hit, longer requests regenerate the same entry
+  TESTASSERT(apply_test(&q, 0x1234, 999) == SRSRAN_SUCCESS);
+  TESTASSERT(apply_test(&q, 0x1234, 1001) == SRSRAN_SUCCESS);
+  srsran_sequence_cache_get_metrics(&q, &metrics);
+  TESTASSERT(metrics.nof_misses == 2);
+  TESTASSERT(metrics.nof_hits == 10);
+  TESTASSERT(metrics.nof_evicted == 0);
+
+  // Requests longer than the cache are served on the fly
+  TESTASSERT(apply_test(&q, 0x1234, MAX_LEN + 1) == SRSRAN_SUCCESS);
+  srsran_sequence_cache_get_metrics(&q, &metrics);
+  TESTASSERT(metrics.nof_bypass == 4);
+
+  // A NULL cache is valid
+  TESTASSERT(apply_test(NULL, 0x1234, 1000) == SRSRAN_SUCCESS);
+
+  // After a reset the sequences are generated again
+  srsran_sequence_cache_reset(&q);
+  TESTASSERT(apply_test(&q, 0x1234, 1000) == SRSRAN_SUCCESS);
+  srsran_sequence_cache_get_metrics(&q, &metrics);
+  TESTASSERT(metrics.nof_misses == 3);
+
+  srsran_sequence_cache_free(&q);
+  return SRSRAN_SUCCESS;
+}
+
+static int random_test()
+{
+  srsran_sequence_cache_t         q       = {};
+  srsran_sequence_cache_metrics_t metrics = {};
+  srsran_random_t                 random  = srsran_random_init(0);
+
+  TESTASSERT(srsran_sequence_cache_init(&q, NOF_ENTRIES, MAX_LEN) == SRSRAN_SUCCESS);
+
+  // More seeds than entries, so that sequences are evicted and regenerated
+  for (uint32_t i = 0; i < 1000; i++) {
+    uint32_t seed = (uint32_t)srsran_random_uniform_int_dist(random, 0, 4 * NOF_ENTRIES) << 14U;
+    uint32_t len  = (uint32_t)srsran_random_uniform_int_dist(random, 1, MAX_LEN);
+    TESTASSERT(apply_test(&q, seed, len) == SRSRAN_SUCCESS);
+  }
+
+  srsran_sequence_cache_get_metrics(&q, &metrics);
+  TESTASSERT(metrics.nof_hits + metrics.nof_misses == 4000);
+  TESTASSERT(metrics.nof_evicted > 0);
+
+  srsran_random_free(random);
+  srsran_sequence_cache_free(&q);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srsran_random_t random = srsran_random_init(1);
+  for (uint32_t i = 0; i < BUF_LEN; i++) {
+    in_u8[i] = (uint8_t)srsran_random_uniform_int_dist(random, 0, 255);
+    in_c[i]  = (int8_t)srsran_random_uniform_int_dist(random, -127, 127);
+    in_s[i]  = (int16_t)srsran_random_uniform_int_dist(random, -32767, 32767);
+  }
+  srsran_random_free(random);
+
+  TESTASSERT(hit_miss_test() == SRSRAN_SUCCESS);
+  TESTASSERT(random_test() == SRSRAN_SUCCESS);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -237,6 +237,46 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
   return 0;
 }
 
+int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t* plan,
+                                 const int          dft_points,
+                                 srsran_dft_dir_t   dir,
+                                 cf_t*              in_buffer,
+                                 cf_t*              out_buffer,
+                                 int                how_many,
+                                 int                idist,
+                                 int                odist,
+                                 int                nof_batches,
+                                 int                ibatch_dist,
+                                 int                obatch_dist)
+{
+  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+
+  const fftwf_iodim iodim           = {dft_points, 1, 1};
+  const fftwf_iodim howmany_dims[2] = {{nof_batches, ibatch_dist, obatch_dist}, {how_many, idist, odist}};
+
+  pthread_mutex_lock(&fft_mutex);
+
+  plan->p = fftwf_plan_guru_dft(1, &iodim, 2, howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  pthread_mutex_unlock(&fft_mutex);
+
+  if (!plan->p) {
+    return -1;
+  }
+
+  plan->size      = dft_points;
+  plan->init_size = plan->size;
+  plan->mode      = SRSRAN_DFT_COMPLEX;
+  plan->dir       = dir;
+  plan->forward   = (dir == SRSRAN_DFT_FORWARD) ? true : false;
+  plan->mirror    = false;
+  plan->db        = false;
+  plan->norm      = false;
+  plan->dc        = false;
+  plan->is_guru   = true;
+
+  return 0;
+}
+
 int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir)
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
@@ -723,3 +723,280 @@ int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
 
   return SRSRAN_SUCCESS;
 }
+
+static uint32_t ofdm_many_nof_symbols(const srsran_ofdm_t* ofdm)
+{
+  return ofdm->nof_symbols * SRSRAN_NOF_SLOTS_PER_SF;
+}
+
+// First time domain sample transformed for a port, after the first cyclic prefix and minus the DFT window offset
+static cf_t* ofdm_many_td_buffer(const srsran_ofdm_t* ofdm)
+{
+  uint32_t symbol_sz = ofdm->cfg.symbol_sz;
+  uint32_t cp1 = SRSRAN_CP_ISNORM(ofdm->cfg.cp) ? SRSRAN_CP_LEN_NORM(0, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+  if (ofdm->fft_plan.dir == SRSRAN_DFT_FORWARD) {
+    return ofdm->cfg.in_buffer + cp1 - ofdm->window_offset_n;
+  }
+  return ofdm->cfg.out_buffer + cp1;
+}
+
+int srsran_ofdm_many_set(srsran_ofdm_many_t* q, srsran_ofdm_t* ofdm, uint32_t nof_ports)
+{
+  if (q == NULL || ofdm == NULL || nof_ports == 0 || nof_ports > SRSRAN_MAX_PORTS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t         symbol_sz   = ofdm[0].cfg.symbol_sz;
+  uint32_t         nof_symbols = ofdm_many_nof_symbols(&ofdm[0]);
+  srsran_cp_t      cp          = ofdm[0].cfg.cp;
+  srsran_dft_dir_t dir         = ofdm[0].fft_plan.dir;
+
+  // All ports must share the transform geometry
+  for (uint32_t p = 1; p < nof_ports; p++) {
+    if (ofdm[p].cfg.symbol_sz != symbol_sz || ofdm[p].nof_re != ofdm[0].nof_re || ofdm[p].cfg.cp != cp ||
+        ofdm[p].fft_plan.dir != dir) {
+      ERROR("Port %d OFDM configuration does not match port 0", p);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // The work buffer holds a single port, ports are transformed one after another
+  uint32_t work_len = nof_symbols * symbol_sz;
+  if (work_len > q->work_len) {
+    if (q->work) {
+      free(q->work);
+    }
+    q->work = srsran_vec_cf_malloc(work_len);
+    if (q->work == NULL) {
+      q->work_len = 0;
+      return SRSRAN_ERROR;
+    }
+    q->work_len = work_len;
+  }
+
+  for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    if (q->plan[p].size) {
+      srsran_dft_plan_free(&q->plan[p]);
+    }
+    q->td_buffer[p] = NULL;
+  }
+  q->ofdm      = ofdm;
+  q->nof_ports = 0;
+
+  // Symbols are spaced by the symbol and the cyclic prefix of the second symbol in the time domain and by the symbol
+  // in the work buffer. The first symbol of each slot is offset by the longer first cyclic prefix.
+  uint32_t cp2              = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(1, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  uint32_t nof_symbols_slot = ofdm[0].nof_symbols;
+  int      slot_sz          = (int)ofdm[0].slot_sz;
+  int      td_dist          = (int)(symbol_sz + cp2);
+  int      fd_dist          = (int)symbol_sz;
+  int      fd_slot_dist     = (int)(nof_symbols_slot * symbol_sz);
+
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    cf_t* td_buffer = ofdm_many_td_buffer(&ofdm[p]);
+    int   err;
+    if (dir == SRSRAN_DFT_FORWARD) {
+      err = srsran_dft_plan_guru_batch_c(&q->plan[p],
+                                         symbol_sz,
+                                         dir,
+                                         td_buffer,
+                                         q->work,
+                                         nof_symbols_slot,
+                                         td_dist,
+                                         fd_dist,
+                                         SRSRAN_NOF_SLOTS_PER_SF,
+                                         slot_sz,
+                                         fd_slot_dist);
+    } else {
+      err = srsran_dft_plan_guru_batch_c(&q->plan[p],
+                                         symbol_sz,
+                                         dir,
+                                         q->work,
+                                         td_buffer,
+                                         nof_symbols_slot,
+                                         fd_dist,
+                                         td_dist,
+                                         SRSRAN_NOF_SLOTS_PER_SF,
+                                         fd_slot_dist,
+                                         slot_sz);
+    }
+    if (err) {
+      ERROR("Creating batched DFT plan (port %d)", p);
+      return SRSRAN_ERROR;
+    }
+    q->td_buffer[p] = td_buffer;
+  }
+
+  // Planning may overwrite the buffers and the guard subcarriers must be zero for the Tx
+  srsran_vec_cf_zero(q->work, work_len);
+
+  q->symbol_sz   = symbol_sz;
+  q->nof_symbols = nof_symbols;
+  q->nof_re      = ofdm[0].nof_re;
+  q->nof_ports   = nof_ports;
+  q->dir         = dir;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ofdm_many_free(srsran_ofdm_many_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    srsran_dft_plan_free(&q->plan[p]);
+  }
+  if (q->work) {
+    free(q->work);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_ofdm_many_t, 1);
+}
+
+// The plans can be used only if the ports were not reconfigured since they were created
+static bool ofdm_many_is_ready(const srsran_ofdm_many_t* q, srsran_dft_dir_t dir)
+{
+  if (q->nof_ports == 0 || q->dir != dir) {
+    return false;
+  }
+  for (uint32_t p = 0; p < q->nof_ports; p++) {
+    const srsran_ofdm_t* ofdm = &q->ofdm[p];
+    if (ofdm->cfg.symbol_sz != q->symbol_sz || ofdm->nof_re != q->nof_re ||
+        ofdm_many_nof_symbols(ofdm) != q->nof_symbols || ofdm_many_td_buffer(ofdm) != q->td_buffer[p] ||
+        ofdm->mbsfn_subframe) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Gathers the per symbol phase compensation and normalization of a port in a single complex factor
+static cf_t ofdm_many_symbol_scale(const srsran_ofdm_t* ofdm, uint32_t l, float amplitude)
+{
+  cf_t scale = amplitude;
+  if (isnormal(ofdm->cfg.phase_compensation_hz)) {
+    scale *= (ofdm->fft_plan.dir == SRSRAN_DFT_FORWARD) ? conjf(ofdm->phase_compensation[l])
+                                                        : ofdm->phase_compensation[l];
+  }
+  if (ofdm->fft_plan.norm) {
+    scale *= 1.0f / sqrtf(ofdm->cfg.symbol_sz);
+  }
+  return scale;
+}
+
+static void ofdm_many_scale_copy(const cf_t* x, cf_t scale, cf_t* y, uint32_t len)
+{
+  if (scale == 1.0f) {
+    if (x != y) {
+      srsran_vec_cf_copy(y, x, len);
+    }
+  } else if (cimagf(scale) == 0.0f) {
+    srsran_vec_sc_prod_cfc(x, crealf(scale), y, len);
+  } else {
+    srsran_vec_sc_prod_ccc(x, scale, y, len);
+  }
+}
+
+void srsran_ofdm_many_tx_sf(srsran_ofdm_many_t* q, float amplitude)
+{
+  if (!ofdm_many_is_ready(q, SRSRAN_DFT_BACKWARD)) {
+    for (uint32_t p = 0; p < q->nof_ports; p++) {
+      srsran_ofdm_t* ofdm = &q->ofdm[p];
+      if (amplitude != 1.0f) {
+        uint32_t nof_re = ofdm_many_nof_symbols(ofdm) * ofdm->nof_re;
+        srsran_vec_sc_prod_cfc(ofdm->cfg.in_buffer, amplitude, ofdm->cfg.in_buffer, nof_re);
+      }
+      srsran_ofdm_tx_sf(ofdm);
+    }
+    return;
+  }
+
+  uint32_t symbol_sz = q->symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+
+  for (uint32_t p = 0; p < q->nof_ports; p++) {
+    srsran_ofdm_t* ofdm  = &q->ofdm[p];
+    srsran_cp_t    cp    = ofdm->cfg.cp;
+    uint32_t       dc    = (ofdm->fft_plan.dc) ? 1 : 0;
+    cf_t*          input = ofdm->cfg.in_buffer;
+    cf_t*          work  = q->work;
+
+    // Map the resource grid onto the DFT bins, scaling each symbol on the way
+    for (uint32_t l = 0; l < q->nof_symbols; l++) {
+      cf_t scale = ofdm_many_symbol_scale(ofdm, l, amplitude);
+      work[0]    = 0.0f;
+      ofdm_many_scale_copy(&input[nof_re / 2], scale, &work[dc], nof_re / 2);
+      ofdm_many_scale_copy(&input[0], scale, &work[symbol_sz - nof_re / 2], nof_re / 2);
+      input += nof_re;
+      work += symbol_sz;
+    }
+
+    // Transform all the symbols straight into their place in the subframe
+    srsran_dft_run_guru_c(&q->plan[p]);
+
+    // Insert the cyclic prefixes
+    cf_t* output = ofdm->cfg.out_buffer;
+    for (uint32_t l = 0; l < q->nof_symbols; l++) {
+      uint32_t i      = l % ofdm->nof_symbols;
+      uint32_t cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+      // CFR: Process the time-domain signal without the CP
+      if (ofdm->cfg.cfr_tx_cfg.cfr_enable) {
+        srsran_cfr_process(&ofdm->tx_cfr, output + cp_len, output + cp_len);
+      }
+
+      srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+      output += symbol_sz + cp_len;
+    }
+
+    if (isnormal(ofdm->cfg.freq_shift_f)) {
+      srsran_vec_prod_ccc(ofdm->cfg.out_buffer, ofdm->shift_buffer, ofdm->cfg.out_buffer, ofdm->sf_sz);
+    }
+  }
+}
+
+void srsran_ofdm_many_rx_sf(srsran_ofdm_many_t* q)
+{
+  if (!ofdm_many_is_ready(q, SRSRAN_DFT_FORWARD)) {
+    for (uint32_t p = 0; p < q->nof_ports; p++) {
+      srsran_ofdm_rx_sf(&q->ofdm[p]);
+    }
+    return;
+  }
+
+  uint32_t symbol_sz = q->symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+
+  for (uint32_t p = 0; p < q->nof_ports; p++) {
+    srsran_ofdm_t* ofdm   = &q->ofdm[p];
+    uint32_t       dc     = (ofdm->fft_plan.dc) ? 1 : 0;
+    cf_t*          output = ofdm->cfg.out_buffer;
+    cf_t*          work   = q->work;
+
+    if (isnormal(ofdm->cfg.freq_shift_f)) {
+      srsran_vec_prod_ccc(ofdm->cfg.in_buffer, ofdm->shift_buffer, ofdm->cfg.in_buffer, ofdm->sf_sz);
+    }
+
+    // Transform all the symbols straight from their place in the subframe, skipping the cyclic prefixes
+    srsran_dft_run_guru_c(&q->plan[p]);
+
+    // Extract the resource grid, undoing the window offset and applying the per symbol scaling on the way
+    for (uint32_t l = 0; l < q->nof_symbols; l++) {
+      cf_t scale = ofdm_many_symbol_scale(ofdm, l, 1.0f);
+
+      if (ofdm->window_offset_n) {
+        const cf_t* w = ofdm->window_offset_buffer;
+        srsran_vec_prod_ccc(&work[symbol_sz - nof_re / 2], &w[symbol_sz - nof_re / 2], output, nof_re / 2);
+        srsran_vec_prod_ccc(&work[dc], &w[dc], &output[nof_re / 2], nof_re / 2);
+        ofdm_many_scale_copy(output, scale, output, nof_re);
+      } else {
+        ofdm_many_scale_copy(&work[symbol_sz - nof_re / 2], scale, output, nof_re / 2);
+        ofdm_many_scale_copy(&work[dc], scale, &output[nof_re / 2], nof_re / 2);
+      }
+
+      output += nof_re;
+      work += symbol_sz;
+    }
+  }
+}
@@ -0,0 +1,279 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+/*!
+ * \file ofdm_many_bench.c
+ * \brief Throughput benchmark and equivalence test for the batched ("many") OFDM engine.
+ *
+ * A subframe of random resource grids is modulated for every antenna port with srsran_ofdm_tx_sf() on each port and
+ * with srsran_ofdm_many_tx_sf() on all of them. The resulting baseband signals are demodulated the same two ways. The
+ * test fails if the batched engine output differs from the per port output. Then, the throughput of both is reported.
+ *
+ * Synopsis: **ofdm_many_bench [options]**
+ *
+ * Options:
+ *  - **-n \<number\>** Number of resource blocks (Default 100).
+ *  - **-N \<number\>** Force symbol size, 0 for auto (Default 0).
+ *  - **-a \<number\>** Number of antenna ports (Default 4).
+ *  - **-e** Extended cyclic prefix (Default normal).
+ *  - **-s \<number\>** Frequency shift, normalised with the subcarrier spacing (Default 0.0).
+ *  - **-o \<number\>** Rx window offset, portion of the CP length (Default 0.0).
+ *  - **-p \<number\>** Phase compensation carrier frequency in Hz (Default 0.0).
+ *  - **-R \<number\>** Number of repetitions of each benchmark (Default 1000).
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static uint32_t    nof_prb               = 100;
+static uint32_t    force_symbol_sz       = 0;
+static uint32_t    nof_ports             = 4;
+static srsran_cp_t cp                    = SRSRAN_CP_NORM;
+static float       freq_shift_f          = 0.0f;
+static float       rx_window_offset      = 0.0f;
+static double      phase_compensation_hz = 0.0;
+static uint32_t    nof_repetitions       = 1000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nNaesopR]\n", prog);
+  printf("\t-n Number of resource blocks [Default %d]\n", nof_prb);
+  printf("\t-N Force symbol size, 0 for auto [Default %d]\n", force_symbol_sz);
+  printf("\t-a Number of antenna ports [Default %d]\n", nof_ports);
+  printf("\t-e Extended cyclic prefix [Default Normal]\n");
+  printf("\t-s Frequency shift (normalised with the subcarrier spacing) [Default %.1f]\n", freq_shift_f);
+  printf("\t-o Rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
+  printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-R Number of repetitions [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:N:a:es:o:p:R:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'N':
+        force_symbol_sz = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'a':
+        nof_ports = SRSRAN_MIN(SRSRAN_MAX_PORTS, SRSRAN_MAX(1, (uint32_t)strtol(optarg, NULL, 10)));
+        break;
+      case 'e':
+        cp = SRSRAN_CP_EXT;
+        break;
+      case 's':
+        freq_shift_f = strtof(optarg, NULL);
+        break;
+      case 'o':
+        rx_window_offset = SRSRAN_MIN(1.0f, SRSRAN_MAX(0.0f, strtof(optarg, NULL)));
+        break;
+      case 'p':
+        phase_compensation_hz = strtod(optarg, NULL);
+        break;
+      case 'R':
+        nof_repetitions = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(const struct timeval* start, const struct timeval* end)
+{
+  return (double)(end->tv_sec - start->tv_sec) * 1e6 + (double)(end->tv_usec - start->tv_usec);
+}
+
+// Root mean square error of a against b, relative to the power of b
+static float relative_error(const cf_t* a, const cf_t* b, cf_t* tmp, uint32_t len)
+{
+  srsran_vec_sub_ccc(a, b, tmp, len);
+  return sqrtf(srsran_vec_avg_power_cf(tmp, len) / srsran_vec_avg_power_cf(b, len));
+}
+
+static void print_throughput(const char* name, uint32_t nof_samples, double time_us)
+{
+  printf("  %-12s %8.2f us/sf %8.1f Msps\n",
+         name,
+         time_us / nof_repetitions,
+         (double)nof_samples * nof_repetitions / time_us);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran_random_t    random_gen                = srsran_random_init(1234);
+  srsran_ofdm_t      ifft[SRSRAN_MAX_PORTS]    = {};
+  srsran_ofdm_t      fft[SRSRAN_MAX_PORTS]     = {};
+  srsran_ofdm_many_t ifft_many                 = {};
+  srsran_ofdm_many_t fft_many                  = {};
+  cf_t*              grid[SRSRAN_MAX_PORTS]    = {};
+  cf_t*              grid_tx[SRSRAN_MAX_PORTS] = {};
+  cf_t*              td[SRSRAN_MAX_PORTS]      = {};
+  cf_t*              td_ref[SRSRAN_MAX_PORTS]  = {};
+  cf_t*              rx[SRSRAN_MAX_PORTS]      = {};
+  cf_t*              rx_ref[SRSRAN_MAX_PORTS]  = {};
+  struct timeval     start, end;
+
+  uint32_t symbol_sz = (force_symbol_sz) ? force_symbol_sz : (uint32_t)srsran_symbol_sz(nof_prb);
+  uint32_t nof_re    = SRSRAN_SF_LEN_RE(nof_prb, cp);
+  uint32_t sf_len    = SRSRAN_SF_LEN(symbol_sz);
+  cf_t*    tmp       = srsran_vec_cf_malloc(sf_len);
+  TESTASSERT(tmp != NULL);
+
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    grid[p]    = srsran_vec_cf_malloc(nof_re);
+    grid_tx[p] = srsran_vec_cf_malloc(nof_re);
+    td[p]      = srsran_vec_cf_malloc(sf_len);
+    td_ref[p]  = srsran_vec_cf_malloc(sf_len);
+    rx[p]      = srsran_vec_cf_malloc(nof_re);
+    rx_ref[p]  = srsran_vec_cf_malloc(nof_re);
+    TESTASSERT(grid[p] && grid_tx[p] && td[p] && td_ref[p] && rx[p] && rx_ref[p]);
+    srsran_random_uniform_complex_dist_vector(random_gen, grid[p], nof_re, -1.0f, +1.0f);
+
+    srsran_ofdm_cfg_t cfg     = {};
+    cfg.cp                    = cp;
+    cfg.nof_prb               = nof_prb;
+    cfg.symbol_sz             = symbol_sz;
+    cfg.normalize             = true;
+    cfg.freq_shift_f          = freq_shift_f;
+    cfg.phase_compensation_hz = phase_compensation_hz;
+    cfg.in_buffer             = grid_tx[p];
+    cfg.out_buffer            = td[p];
+    TESTASSERT(srsran_ofdm_tx_init_cfg(&ifft[p], &cfg) == SRSRAN_SUCCESS);
+
+    cfg.freq_shift_f     = -freq_shift_f;
+    cfg.rx_window_offset = rx_window_offset;
+    cfg.in_buffer        = td[p];
+    cfg.out_buffer       = rx[p];
+    TESTASSERT(srsran_ofdm_rx_init_cfg(&fft[p], &cfg) == SRSRAN_SUCCESS);
+  }
+  TESTASSERT(srsran_ofdm_many_set(&ifft_many, ifft, nof_ports) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_ofdm_many_set(&fft_many, fft, nof_ports) == SRSRAN_SUCCESS);
+
+  printf("%d PRB, symbol size %d, %d ports, %s CP\n",
+         nof_prb,
+         symbol_sz,
+         nof_ports,
+         SRSRAN_CP_ISNORM(cp) ? "normal" : "extended");
+
+  // Reference modulation, one port after another
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_vec_cf_copy(grid_tx[p], grid[p], nof_re);
+    srsran_ofdm_tx_sf(&ifft[p]);
+    srsran_vec_cf_copy(td_ref[p], td[p], sf_len);
+  }
+
+  // Batched modulation
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_vec_cf_copy(grid_tx[p], grid[p], nof_re);
+  }
+  srsran_ofdm_many_tx_sf(&ifft_many, 1.0f);
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    float err = relative_error(td[p], td_ref[p], tmp, sf_len);
+    printf("  port %d Tx error %.2e\n", p, err);
+    TESTASSERT(err < 1e-5f);
+  }
+
+  // Reference demodulation, the frequency shift is applied in place so the input is restored afterwards
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_ofdm_rx_sf(&fft[p]);
+    srsran_vec_cf_copy(rx_ref[p], rx[p], nof_re);
+    srsran_vec_cf_copy(td[p], td_ref[p], sf_len);
+  }
+
+  // Batched demodulation, it must recover the transmitted grid as well
+  srsran_ofdm_many_rx_sf(&fft_many);
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    float err     = relative_error(rx[p], rx_ref[p], tmp, nof_re);
+    float err_grd = relative_error(rx[p], grid[p], tmp, nof_re);
+    printf("  port %d Rx error %.2e, grid error %.2e\n", p, err, err_grd);
+    TESTASSERT(err < 1e-5f);
+    TESTASSERT(err_grd < 1e-3f);
+  }
+
+  // Benchmark
+  if (nof_repetitions > 0) {
+    uint32_t nof_samples = sf_len * nof_ports;
+
+    gettimeofday(&start, NULL);
+    for (uint32_t r = 0; r < nof_repetitions; r++) {
+      for (uint32_t p = 0; p < nof_ports; p++) {
+        srsran_ofdm_tx_sf(&ifft[p]);
+      }
+    }
+    gettimeofday(&end, NULL);
+    print_throughput("Tx per port", nof_samples, elapsed_us(&start, &end));
+
+    gettimeofday(&start, NULL);
+    for (uint32_t r = 0; r < nof_repetitions; r++) {
+      srsran_ofdm_many_tx_sf(&ifft_many, 1.0f);
+    }
+    gettimeofday(&end, NULL);
+    print_throughput("Tx batched", nof_samples, elapsed_us(&start, &end));
+
+    gettimeofday(&start, NULL);
+    for (uint32_t r = 0; r < nof_repetitions; r++) {
+      for (uint32_t p = 0; p < nof_ports; p++) {
+        srsran_ofdm_rx_sf(&fft[p]);
+      }
+    }
+    gettimeofday(&end, NULL);
+    print_throughput("Rx per port", nof_samples, elapsed_us(&start, &end));
+
+    gettimeofday(&start, NULL);
+    for (uint32_t r = 0; r < nof_repetitions; r++) {
+      srsran_ofdm_many_rx_sf(&fft_many);
+    }
+    gettimeofday(&end, NULL);
+    print_throughput("Rx batched", nof_samples, elapsed_us(&start, &end));
+  }
+
+  srsran_ofdm_many_free(&ifft_many);
+  srsran_ofdm_many_free(&fft_many);
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_ofdm_tx_free(&ifft[p]);
+    srsran_ofdm_rx_free(&fft[p]);
+    free(grid[p]);
+    free(grid_tx[p]);
+    free(td[p]);
+    free(td_ref[p]);
+    free(rx[p]);
+    free(rx_ref[p]);
+  }
+  free(tmp);
+  srsran_random_free(random_gen);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -124,6 +124,7 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
       srsran_ofdm_tx_free(&q->ifft[i]);
     }
     srsran_ofdm_tx_free(&q->ifft_mbsfn);
+    srsran_ofdm_many_free(&q->ifft_many);
     srsran_regs_free(&q->regs);
     srsran_pbch_free(&q->pbch);
     srsran_pcfich_free(&q->pcfich);
@@ -176,6 +177,10 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
           return SRSRAN_ERROR;
         }
       }
+      if (srsran_ofdm_many_set(&q->ifft_many, q->ifft, q->cell.nof_ports)) {
+        ERROR("Error planning batched iFFT");
+        return SRSRAN_ERROR;
+      }
 
       if (srsran_ofdm_tx_set_prb(&q->ifft_mbsfn, SRSRAN_CP_EXT, q->cell.nof_prb)) {
         ERROR("Error re-planning ifft_mbsfn");
@@ -264,6 +269,15 @@ int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr)
   return SRSRAN_SUCCESS;
 }
 
+void srsran_enb_dl_set_sequence_cache(srsran_enb_dl_t* q, srsran_sequence_cache_t* cache)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->pdsch.sequence_cache = cache;
+}
+
 #ifdef resolve
 void srsran_enb_dl_apply_power_allocation(srsran_enb_dl_t* q)
 {
@@ -455,13 +469,7 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                            SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
     srsran_ofdm_tx_sf(&q->ifft_mbsfn);
   } else {
-    for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sc_prod_cfc(q->ifft[i].cfg.in_buffer,
-                             norm_factor,
-                             q->ifft[i].cfg.in_buffer,
-                             SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
-      srsran_ofdm_tx_sf(&q->ifft[i]);
-    }
+    srsran_ofdm_many_tx_sf(&q->ifft_many, norm_factor);
   }
 }
 
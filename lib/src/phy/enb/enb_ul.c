@@ -76,15 +76,63 @@ clean_exit:
   return ret;
 }
 
+int srsran_enb_ul_init_shared(srsran_enb_ul_t* q, const srsran_enb_ul_t* parent, uint32_t max_prb)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q != NULL && parent != NULL && parent->sf_symbols != NULL) {
+    ret = SRSRAN_ERROR;
+
+    bzero(q, sizeof(srsran_enb_ul_t));
+
+    q->sf_symbols  = parent->sf_symbols;
+    q->shared_grid = true;
+
+    q->chest_res.ce = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
+    if (!q->chest_res.ce) {
+      perror("malloc");
+      goto clean_exit;
+    }
+
+    if (srsran_pucch_init_enb(&q->pucch)) {
+      ERROR("Error creating PUCCH object");
+      goto clean_exit;
+    }
+
+    if (srsran_pusch_init_enb(&q->pusch, max_prb)) {
+      ERROR("Error creating PUSCH object");
+      goto clean_exit;
+    }
+
+    if (srsran_chest_ul_init(&q->chest, max_prb)) {
+      ERROR("Error initiating channel estimator");
+      goto clean_exit;
+    }
+
+    ret = SRSRAN_SUCCESS;
+
+  } else {
+    ERROR("Invalid parameters");
+  }
+
+clean_exit:
+  if (ret == SRSRAN_ERROR) {
+    srsran_enb_ul_free(q);
+  }
+  return ret;
+}
+
 void srsran_enb_ul_free(srsran_enb_ul_t* q)
 {
   if (q) {
-    srsran_ofdm_rx_free(&q->fft);
+    if (!q->shared_grid) {
+      srsran_ofdm_rx_free(&q->fft);
+    }
     srsran_pucch_free(&q->pucch);
     srsran_pusch_free(&q->pusch);
     srsran_chest_ul_free(&q->chest);
 
-    if (q->sf_symbols) {
+    if (q->sf_symbols && !q->shared_grid) {
       free(q->sf_symbols);
     }
     if (q->chest_res.ce) {
@@ -105,21 +153,24 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
     if (cell.id != q->cell.id || q->cell.nof_prb == 0) {
       q->cell = cell;
 
-      srsran_ofdm_cfg_t ofdm_cfg = {};
-      ofdm_cfg.nof_prb           = q->cell.nof_prb;
-      ofdm_cfg.in_buffer         = q->in_buffer;
-      ofdm_cfg.out_buffer        = q->sf_symbols;
-      ofdm_cfg.cp                = q->cell.cp;
-      ofdm_cfg.freq_shift_f      = -0.5f;
-      ofdm_cfg.normalize         = false;
-      ofdm_cfg.rx_window_offset  = 0.5f;
-      if (srsran_ofdm_rx_init_cfg(&q->fft, &ofdm_cfg)) {
-        ERROR("Error initiating FFT");
-        return SRSRAN_ERROR;
-      }
-      if (srsran_ofdm_rx_set_prb(&q->fft, q->cell.cp, q->cell.nof_prb)) {
-        ERROR("Error initiating FFT");
-        return SRSRAN_ERROR;
+      // Objects sharing the resource grid of another one do not run the FFT
+      if (!q->shared_grid) {
+        srsran_ofdm_cfg_t ofdm_cfg = {};
+        ofdm_cfg.nof_prb           = q->cell.nof_prb;
+        ofdm_cfg.in_buffer         = q->in_buffer;
+        ofdm_cfg.out_buffer        = q->sf_symbols;
+        ofdm_cfg.cp                = q->cell.cp;
+        ofdm_cfg.freq_shift_f      = -0.5f;
+        ofdm_cfg.normalize         = false;
+        ofdm_cfg.rx_window_offset  = 0.5f;
+        if (srsran_ofdm_rx_init_cfg(&q->fft, &ofdm_cfg)) {
+          ERROR("Error initiating FFT");
+          return SRSRAN_ERROR;
+        }
+        if (srsran_ofdm_rx_set_prb(&q->fft, q->cell.cp, q->cell.nof_prb)) {
+          ERROR("Error initiating FFT");
+          return SRSRAN_ERROR;
+        }
       }
 
       if (srsran_pucch_set_cell(&q->pucch, q->cell)) {
@@ -148,6 +199,15 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
   return ret;
 }
 
+void srsran_enb_ul_set_sequence_cache(srsran_enb_ul_t* q, srsran_sequence_cache_t* cache)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->pusch.sequence_cache = cache;
+}
+
 void srsran_enb_ul_fft(srsran_enb_ul_t* q)
 {
   srsran_ofdm_rx_sf(&q->fft);
@@ -272,12 +332,25 @@ int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_enb_ul_estimate_pusch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pusch_cfg_t* cfg)
+{
+  return srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res);
+}
+
+int srsran_enb_ul_decode_pusch(srsran_enb_ul_t*    q,
+                               srsran_ul_sf_cfg_t* ul_sf,
+                               srsran_pusch_cfg_t* cfg,
+                               srsran_pusch_res_t* res)
+{
+  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
+}
+
 int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                             srsran_ul_sf_cfg_t* ul_sf,
                             srsran_pusch_cfg_t* cfg,
                             srsran_pusch_res_t* res)
 {
-  srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res);
+  srsran_enb_ul_estimate_pusch(q, ul_sf, cfg);
 
-  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
+  return srsran_enb_ul_decode_pusch(q, ul_sf, cfg, res);
 }
@@ -23,10 +23,27 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 
+#include <string.h>
+
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
 #endif // LV_HAVE_SSE
 
+#if defined(LV_HAVE_SSE) && defined(LV_HAVE_PCLMUL)
+#define CRC_CLMUL_ENABLED 1
+#include <cpuid.h>
+
+// The engine is built without -mpclmul, its functions enable the instruction locally and are only called once the CPU
+// has been found to support it
+#define CRC_CLMUL_TARGET __attribute__((target("pclmul")))
+#endif // LV_HAVE_SSE && LV_HAVE_PCLMUL
+
+/*
+ * Number of packed bytes from which the carry-less multiply engine is used. Below it the per-byte table lookup is as
+ * fast and avoids the final reduction.
+ */
+#define CRC_CLMUL_MIN_BYTES 32
+
 static void gen_crc_table(srsran_crc_t* h)
 {
   uint32_t pad        = (h->order < 8) ? (8 - h->order) : 0;
@@ -47,6 +64,160 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
+// Computes x^n modulo a degree 32 polynomial
+static uint64_t gen_crc_xpow_mod(uint32_t n, uint64_t poly)
+{
+  uint64_t r = 1;
+  for (uint32_t i = 0; i < n; i++) {
+    r <<= 1U;
+    if (r & (1ULL << 32U)) {
+      r ^= poly;
+    }
+  }
+  return r;
+}
+
+#ifdef CRC_CLMUL_ENABLED
+// Checks the CPUID PCLMULQDQ flag
+static bool crc_clmul_supported(void)
+{
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL);
+}
+#endif // CRC_CLMUL_ENABLED
+
+// Generates the constants used by the carry-less multiply engine
+static void gen_crc_fold(srsran_crc_t* h)
+{
+  bool clmul = false;
+#ifdef CRC_CLMUL_ENABLED
+  clmul = crc_clmul_supported();
+#endif // CRC_CLMUL_ENABLED
+
+  // Orders above 32 bits, and CPUs without carry-less multiply, are only served by the table
+  if (!clmul || h->order > 32) {
+    h->fold_poly = 0;
+    return;
+  }
+
+  // Scale the polynomial to degree 32, the CRC of order N is the degree 32 remainder shifted right by 32 - N bits
+  uint64_t poly = ((uint64_t)h->polynom & ((h->crcmask << 1U) | 1U)) << (32U - h->order);
+
+  h->fold_poly = poly;
+  h->fold_k[0] = gen_crc_xpow_mod(192, poly);
+  h->fold_k[1] = gen_crc_xpow_mod(128, poly);
+  h->fold_k[2] = gen_crc_xpow_mod(96, poly);
+  h->fold_k[3] = gen_crc_xpow_mod(64, poly);
+
+  // Long division of x^64 by the polynomial, the quotient has 33 bits
+  uint64_t rem = 1ULL << 32U;
+  uint64_t mu  = 0;
+  for (uint32_t i = 0; i < 33; i++) {
+    mu <<= 1U;
+    if (rem & (1ULL << 32U)) {
+      mu |= 1U;
+      rem ^= poly;
+    }
+    rem <<= 1U;
+  }
+  h->fold_mu = mu;
+}
+
+#ifdef CRC_CLMUL_ENABLED
+
+// Loads 16 bytes as a 128 bit polynomial, the first byte holds the highest degree coefficients
+CRC_CLMUL_TARGET static inline __m128i crc_clmul_load(const uint8_t* ptr)
+{
+  return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ptr),
+                          _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// Packs 128 unpacked bits and loads them as a 128 bit polynomial
+CRC_CLMUL_TARGET static inline __m128i crc_clmul_load_bits(const uint8_t* bits)
+{
+  // Reverses the bit order within each byte once the bits are gathered by the byte movemask
+  const __m128i reverse = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+  const __m128i zero    = _mm_setzero_si128();
+
+  uint16_t packed[8];
+  for (uint32_t i = 0; i < 8; i++) {
+    __m128i v = _mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)&bits[16 * i]), zero);
+    packed[i] = (uint16_t)_mm_movemask_epi8(_mm_shuffle_epi8(v, reverse));
+  }
+
+  return crc_clmul_load((const uint8_t*)packed);
+}
+
+// Multiplies the accumulator by x^128 and adds the next block, the result is congruent modulo the polynomial
+CRC_CLMUL_TARGET static inline __m128i crc_clmul_fold(__m128i acc, __m128i k, __m128i block)
+{
+  __m128i hi = _mm_clmulepi64_si128(acc, k, 0x01); // acc[127:64] * x^192
+  __m128i lo = _mm_clmulepi64_si128(acc, k, 0x10); // acc[63:0] * x^128
+  return _mm_xor_si128(_mm_xor_si128(hi, lo), block);
+}
+
+// Reduces the 128 bit accumulator A to A * x^32 modulo the polynomial and scales it back to the CRC order
+CRC_CLMUL_TARGET static inline uint32_t crc_clmul_reduce(const srsran_crc_t* h, __m128i acc)
+{
+  __m128i k = _mm_set_epi64x((long long)h->fold_k[3], (long long)h->fold_k[2]);
+
+  // 128 to 96 bits: A[127:64] * x^96 + A[63:0] * x^32
+  __m128i t = _mm_clmulepi64_si128(acc, k, 0x01);
+  t         = _mm_xor_si128(t, _mm_slli_si128(_mm_move_epi64(acc), 4));
+
+  // 96 to 64 bits: T[95:64] * x^64 + T[63:0]
+  __m128i u = _mm_clmulepi64_si128(_mm_srli_si128(t, 8), k, 0x10);
+  u         = _mm_xor_si128(u, _mm_move_epi64(t));
+
+  // Barrett reduction from 64 to 32 bits
+  __m128i c = _mm_set_epi64x((long long)h->fold_poly, (long long)h->fold_mu);
+  __m128i q = _mm_clmulepi64_si128(_mm_srli_epi64(u, 32), c, 0x00);
+  __m128i r = _mm_xor_si128(u, _mm_clmulepi64_si128(_mm_srli_epi64(q, 32), c, 0x10));
+
+  return (uint32_t)((uint32_t)_mm_cvtsi128_si32(r) >> (32U - h->order));
+}
+
+CRC_CLMUL_TARGET static uint32_t crc_clmul_checksum_byte(const srsran_crc_t* h, const uint8_t* data, uint32_t nbytes)
+{
+  __m128i k = _mm_set_epi64x((long long)h->fold_k[1], (long long)h->fold_k[0]);
+
+  // Leading zeros do not change the remainder, so the first partial block is zero padded from the left
+  uint8_t  block[16] = {0};
+  uint32_t first     = nbytes % 16;
+  if (first == 0) {
+    first = 16;
+  }
+  memcpy(&block[16 - first], data, first);
+  __m128i acc = crc_clmul_load(block);
+
+  for (uint32_t i = first; i < nbytes; i += 16) {
+    acc = crc_clmul_fold(acc, k, crc_clmul_load(&data[i]));
+  }
+
+  return crc_clmul_reduce(h, acc);
+}
+
+CRC_CLMUL_TARGET static uint32_t crc_clmul_checksum_bit(const srsran_crc_t* h, uint8_t* data, uint32_t nbytes)
+{
+  __m128i k = _mm_set_epi64x((long long)h->fold_k[1], (long long)h->fold_k[0]);
+
+  uint8_t  block[16] = {0};
+  uint32_t first     = nbytes % 16;
+  if (first == 0) {
+    first = 16;
+  }
+  srsran_bit_pack_vector(data, &block[16 - first], (int)first * 8);
+  __m128i acc = crc_clmul_load(block);
+
+  for (uint32_t i = first; i < nbytes; i += 16) {
+    acc = crc_clmul_fold(acc, k, crc_clmul_load_bits(&data[i * 8]));
+  }
+
+  return crc_clmul_reduce(h, acc);
+}
+
+#endif // CRC_CLMUL_ENABLED
+
 uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
 {
   uint64_t m, rmask = 0x1;
@@ -89,6 +260,9 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
   // generate lookup table
   gen_crc_table(h);
 
+  // generate carry-less multiply folding constants
+  gen_crc_fold(h);
+
   return 0;
 }
 
@@ -107,8 +281,17 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
     a = 1;
   }
 
+  i = 0;
+#ifdef CRC_CLMUL_ENABLED
+  if (h->fold_poly != 0 && len8 >= CRC_CLMUL_MIN_BYTES) {
+    // Fold all the complete bytes, the residual bits go through the table
+    h->crcinit = crc_clmul_checksum_bit(h, data, len8);
+    i          = len8;
+  }
+#endif // CRC_CLMUL_ENABLED
+
   // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
+  for (; i < len8 + a; i++) {
     pter = (uint8_t*)(data + 8 * i);
     uint8_t byte;
     if (i == len8) {
@@ -151,6 +334,14 @@ uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 
   srsran_crc_set_init(h, 0);
 
+#ifdef CRC_CLMUL_ENABLED
+  if (h->fold_poly != 0 && len / 8 >= CRC_CLMUL_MIN_BYTES) {
+    crc        = crc_clmul_checksum_byte(h, data, len / 8);
+    h->crcinit = crc;
+    return crc;
+  }
+#endif // CRC_CLMUL_ENABLED
+
   // Calculate CRC
   for (i = 0; i < len / 8; i++) {
     srsran_crc_checksum_put_byte(h, data[i]);
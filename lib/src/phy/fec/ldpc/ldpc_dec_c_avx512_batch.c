@@ -0,0 +1,545 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_dec_c_avx512_batch.c
+ * \brief Definition LDPC decoder inner functions working
+ *    with 8-bit integer-valued LLRs (AVX512 version, several code blocks per register).
+ *
+ * With small lifting sizes, most of the 64 lanes of an AVX512 register are idle. This version splits each register in
+ * slots of 8, 16 or 32 chars and decodes one code block in each slot, so that eight (LS <= 8), four (LS <= 16) or two
+ * (LS <= 32) code blocks with the same base graph and lifting size share every instruction. Slots of up to 16 chars
+ * never cross a 128-bit lane and are rotated with a single in-lane shuffle. Slots of 32 chars span two 128-bit lanes,
+ * the chars coming from the other lane are shuffled from a lane-swapped copy of the register.
+ *
+ * Each slot goes through exactly the same arithmetic as ldpc_dec_c_avx512.c, hence every code block is decoded
+ * bit-exactly as it would be by the single code block decoder.
+ *
+ * Even if the inner representation is based on 8 bits, check-to-variable and
+ * variable-to-check messages are actually represented with 7 bits, the
+ * remaining bit is used to represent infinity.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include "../utils_avx512.h"
+#include "ldpc_dec_all.h"
+#include "srsran/phy/fec/ldpc/base_graph.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ldpc_avx512_consts.h"
+
+#define F2I 65535 /*!< \brief Used for float to int conversion---float f is stored as (int)(f*F2I). */
+
+#define SLOT_SIZE_SHORT 8   /*!< \brief Slot size (in chars) for lifting sizes up to 8. */
+#define SLOT_SIZE_MEDIUM 16 /*!< \brief Slot size (in chars) for lifting sizes up to 16. */
+#define SLOT_SIZE_LONG 32   /*!< \brief Slot size (in chars) for lifting sizes up to 32. */
+
+/*!
+ * \brief Represents a node of the base factor graph.
+ */
+typedef union bg_node_avx512_t {
+  int8_t*  c; /*!< Each base node contains one slot of lifted nodes per code block. */
+  __m512i* v; /*!< All the lifted nodes of the current base node as a 512-bit line. */
+} bg_node_avx512_t;
+
+/*!
+ * \brief Maximum message magnitude.
+ * Messages use a 7-bit quantization. Soft bits use the remaining bit to denote infinity.
+ */
+static const int8_t infinity7 = (1U << 6U) - 1;
+
+/*!
+ * \brief Inner registers for the batched LDPC decoder that works with 8-bit integer-valued LLRs.
+ */
+struct ldpc_regs_c_avx512_batch {
+  __m512i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+
+  bg_node_avx512_t soft_bits;    /*!< \brief A-posteriori log-likelihood ratios. */
+  __m512i*         check_to_var; /*!< \brief Check-to-variable messages. */
+  __m512i*         var_to_check; /*!< \brief Variable-to-check messages. */
+  __m512i*         rotated_v2c;  /*!< \brief To store a rotated version of the variable-to-check messages. */
+
+  __m512i*   rotate_in_lane;    /*!< \brief Shuffle masks for the chars that stay in their 128-bit lane. */
+  __m512i*   rotate_cross_lane; /*!< \brief Shuffle masks for the chars that come from the other 128-bit lane. */
+  __mmask64* cross_lane_mask;   /*!< \brief Chars taken from rotate_cross_lane instead of rotate_in_lane. */
+
+  uint16_t ls;        /*!< \brief Lifting size. */
+  uint8_t  hrr;       /*!< \brief Number of variable nodes in the high-rate region (before lifting). */
+  uint8_t  bgM;       /*!< \brief Number of check nodes (before lifting). */
+  uint8_t  bgN;       /*!< \brief Number of variable nodes (before lifting). */
+  uint8_t  slot_size; /*!< \brief Number of chars reserved to each code block. */
+  uint8_t  nof_slots; /*!< \brief Number of code blocks per register. */
+};
+
+/*!
+ * Carries out the actual update of the variable-to-check messages. It basically
+ * consists in \f$ z = x - y \f$ (as vectors). However, first it checks whether
+ * \f$\lvert x[i] \rvert = 2^{7}-1 \f$ (our representation of infinity) to
+ * ensure it is properly propagated. Also, the subtraction is saturated between
+ * \f$- clip\f$ and \f$+ clip\f$.
+ * \param[in] x     Minuend: array we subtract from (in practice, the soft bits).
+ * \param[in] y     Subtrahend: array to be subtracted (in practice, the
+ *                  check-to-variable messages).
+ * \param[out] z    Resulting difference array(in practice, the updated
+ *                  variable-to-check messages).
+ * \param[in]  clip The saturation value.
+ * \param[in]  len  The length of the vectors.
+ */
+static void
+inner_var_to_check_c_avx512_batch(const __m512i* x, const __m512i* y, __m512i* z, uint8_t clip, uint32_t len);
+
+/*!
+ * Rotates every slot of \b a towards the right by \b shift chars, that is the i-th char of each slot takes the
+ * (i + shift) % ls char of the same slot. The chars beyond the lifting size are cleared.
+ * \param[in] vp    The decoder registers, holding the shuffle masks.
+ * \param[in] a     The register to rotate.
+ * \param[in] shift The order of the rotation in number of chars.
+ * \return The rotated register.
+ */
+static __m512i rotate_slots_right(const struct ldpc_regs_c_avx512_batch* vp, __m512i a, uint16_t shift);
+
+/*!
+ * Scale packed 8-bit integers in \b a by the scaling factor \b sf / #F2I.
+ * \param[in] a   Vector of packed 8-bit integers.
+ * \param[in] sf  Scaling factor.
+ * \return    Vector of packed 8-bit integers with the scaling result.
+ */
+static __m512i _mm512_scalei_epi8(__m512i a, __m512i sf);
+
+uint32_t get_max_nof_cbs_ldpc_dec_c_avx512_batch(uint16_t ls)
+{
+  if (ls <= SLOT_SIZE_SHORT) {
+    return SRSRAN_AVX512_B_SIZE / SLOT_SIZE_SHORT;
+  }
+  if (ls <= SLOT_SIZE_MEDIUM) {
+    return SRSRAN_AVX512_B_SIZE / SLOT_SIZE_MEDIUM;
+  }
+  if (ls <= SLOT_SIZE_LONG) {
+    return SRSRAN_AVX512_B_SIZE / SLOT_SIZE_LONG;
+  }
+  return 0;
+}
+
+void* create_ldpc_dec_c_avx512_batch(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+{
+  struct ldpc_regs_c_avx512_batch* vp = NULL;
+
+  uint8_t  bgK = bgN - bgM;
+  uint16_t hrr = bgK + 4;
+
+  uint32_t nof_slots = get_max_nof_cbs_ldpc_dec_c_avx512_batch(ls);
+  if (nof_slots < 2) {
+    return NULL;
+  }
+
+  if ((vp = SRSRAN_MEM_ALLOC(struct ldpc_regs_c_avx512_batch, 1)) == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(vp, struct ldpc_regs_c_avx512_batch, 1);
+
+  if ((vp->soft_bits.v = SRSRAN_MEM_ALLOC(__m512i, bgN)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->check_to_var = SRSRAN_MEM_ALLOC(__m512i, (hrr + 1) * (uint32_t)bgM)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->var_to_check = SRSRAN_MEM_ALLOC(__m512i, hrr + 1)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->rotated_v2c = SRSRAN_MEM_ALLOC(__m512i, hrr + 1)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->rotate_in_lane = SRSRAN_MEM_ALLOC(__m512i, ls)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->rotate_cross_lane = SRSRAN_MEM_ALLOC(__m512i, ls)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->cross_lane_mask = SRSRAN_MEM_ALLOC(__mmask64, ls)) == NULL) {
+    delete_ldpc_dec_c_avx512_batch(vp);
+    return NULL;
+  }
+
+  vp->bgM       = bgM;
+  vp->bgN       = bgN;
+  vp->hrr       = hrr;
+  vp->ls        = ls;
+  vp->nof_slots = nof_slots;
+  vp->slot_size = SRSRAN_AVX512_B_SIZE / nof_slots;
+
+  // Shuffle masks: inside each slot, the i-th output char takes the (i + shift) % ls input char, the chars beyond the
+  // lifting size are cleared. The in-lane shuffle only reaches the chars of the same 128-bit lane, the chars of the
+  // other lane of a 32-char slot are shuffled from a copy of the register with the 128-bit lanes swapped.
+  for (uint16_t shift = 0; shift < ls; shift++) {
+    int8_t*  in_lane    = (int8_t*)&vp->rotate_in_lane[shift];
+    int8_t*  cross_lane = (int8_t*)&vp->rotate_cross_lane[shift];
+    uint64_t cross_mask = 0;
+    for (uint32_t i = 0; i < SRSRAN_AVX512_B_SIZE; i++) {
+      uint32_t base = i - i % vp->slot_size;
+      uint32_t j    = i % vp->slot_size;
+
+      in_lane[i]    = (int8_t)0x80;
+      cross_lane[i] = (int8_t)0x80;
+      if (j >= ls) {
+        continue;
+      }
+
+      uint32_t src = base + (j + shift) % ls;
+      if (src / 16 == i / 16) {
+        in_lane[i] = (int8_t)(src % 16);
+      } else {
+        cross_lane[i] = (int8_t)(src % 16);
+        cross_mask |= 1ULL << i;
+      }
+    }
+    vp->cross_lane_mask[shift] = cross_mask;
+  }
+
+  // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm512_scalei_epi8
+  vp->scaling_fctr = _mm512_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+
+  return vp;
+}
+
+void delete_ldpc_dec_c_avx512_batch(void* p)
+{
+  struct ldpc_regs_c_avx512_batch* vp = p;
+
+  if (vp == NULL) {
+    return;
+  }
+  if (vp->cross_lane_mask) {
+    free(vp->cross_lane_mask);
+  }
+  if (vp->rotate_cross_lane) {
+    free(vp->rotate_cross_lane);
+  }
+  if (vp->rotate_in_lane) {
+    free(vp->rotate_in_lane);
+  }
+  if (vp->rotated_v2c) {
+    free(vp->rotated_v2c);
+  }
+  if (vp->var_to_check) {
+    free(vp->var_to_check);
+  }
+  if (vp->check_to_var) {
+    free(vp->check_to_var);
+  }
+  if (vp->soft_bits.v) {
+    free(vp->soft_bits.v);
+  }
+  free(vp);
+}
+
+int init_ldpc_dec_c_avx512_batch(void* p, const int8_t* const* llrs, uint32_t nof_cbs, uint16_t ls)
+{
+  struct ldpc_regs_c_avx512_batch* vp = p;
+  int                              i  = 0;
+  int                              j  = 0;
+
+  if (p == NULL || nof_cbs > vp->nof_slots) {
+    return -1;
+  }
+
+  // the first 2 x LS bits of the codeword are not sent
+  vp->soft_bits.v[0] = _mm512_setzero_si512();
+  vp->soft_bits.v[1] = _mm512_setzero_si512();
+  for (i = 2; i < vp->bgN; i++) {
+    vp->soft_bits.v[i] = _mm512_setzero_si512();
+    for (uint32_t cb = 0; cb < nof_cbs; cb++) {
+      int8_t* slot = &vp->soft_bits.c[i * SRSRAN_AVX512_B_SIZE + cb * vp->slot_size];
+      for (j = 0; j < ls; j++) {
+        slot[j] = llrs[cb][(i - 2) * ls + j];
+      }
+    }
+  }
+
+  SRSRAN_MEM_ZERO(vp->check_to_var, __m512i, (vp->hrr + 1) * (uint32_t)vp->bgM);
+  SRSRAN_MEM_ZERO(vp->var_to_check, __m512i, vp->hrr + 1);
+  return 0;
+}
+
+int update_ldpc_var_to_check_c_avx512_batch(void* p, int i_layer)
+{
+  struct ldpc_regs_c_avx512_batch* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  __m512i* this_check_to_var = vp->check_to_var + i_layer * (vp->hrr + 1);
+
+  // Update the high-rate region.
+  inner_var_to_check_c_avx512_batch(vp->soft_bits.v, this_check_to_var, vp->var_to_check, infinity7, vp->hrr);
+
+  if (i_layer >= 4) {
+    // Update the extension region.
+    inner_var_to_check_c_avx512_batch(
+        vp->soft_bits.v + vp->hrr + i_layer - 4, this_check_to_var + vp->hrr, vp->var_to_check + vp->hrr, infinity7, 1);
+  }
+
+  return 0;
+}
+
+int update_ldpc_check_to_var_c_avx512_batch(void*           p,
+                                            int             i_layer,
+                                            const uint16_t* this_pcm,
+                                            const int8_t (*these_var_indices)[MAX_CNCT])
+{
+  struct ldpc_regs_c_avx512_batch* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  int i = 0;
+
+  uint16_t shift      = 0;
+  int      i_v2c_base = 0;
+
+  __m512i* this_rotated_v2c = NULL;
+
+  __m512i this_abs_v2c_epi8;
+
+  __mmask64 mask_min_epi8;
+  __m512i   help_min_epi8;
+  __m512i   min_ix_epi8 = _mm512_setzero_si512();
+  __m512i   current_ix_epi8;
+
+  __m512i minp_v2c_epi8 = _mm512_set1_epi8(INT8_MAX);
+  __m512i mins_v2c_epi8 = _mm512_set1_epi8(INT8_MAX);
+  __m512i prod_v2c_epi8 = _mm512_setzero_si512();
+
+  int8_t current_var_index = (*these_var_indices)[0];
+
+  for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
+    shift      = this_pcm[current_var_index];
+    i_v2c_base = (current_var_index <= vp->hrr) ? current_var_index : vp->hrr;
+
+    current_ix_epi8 = _mm512_set1_epi8((int8_t)i);
+
+    this_rotated_v2c  = vp->rotated_v2c + i;
+    *this_rotated_v2c = rotate_slots_right(vp, vp->var_to_check[i_v2c_base], shift);
+
+    prod_v2c_epi8 = _mm512_xor_si512(prod_v2c_epi8, *this_rotated_v2c);
+
+    this_abs_v2c_epi8 = _mm512_abs_epi8(*this_rotated_v2c);
+    // mask_min is 1 if this_abs_v2c is strictly smaller tha minp_v2c
+    mask_min_epi8 = _mm512_cmpgt_epi8_mask(minp_v2c_epi8, this_abs_v2c_epi8);
+    help_min_epi8 = _mm512_mask_blend_epi8(mask_min_epi8, this_abs_v2c_epi8, minp_v2c_epi8);
+    minp_v2c_epi8 = _mm512_mask_blend_epi8(mask_min_epi8, minp_v2c_epi8, this_abs_v2c_epi8);
+    min_ix_epi8   = _mm512_mask_blend_epi8(mask_min_epi8, min_ix_epi8, current_ix_epi8);
+
+    // mask_min is 1 if this_abs_v2c is strictly smaller tha mins_v2c
+    mask_min_epi8 = _mm512_cmpgt_epi8_mask(mins_v2c_epi8, this_abs_v2c_epi8);
+    mins_v2c_epi8 = _mm512_mask_blend_epi8(mask_min_epi8, mins_v2c_epi8, help_min_epi8);
+
+    current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
+  }
+
+  __m512i* this_check_to_var = vp->check_to_var + i_layer * (vp->hrr + 1);
+  current_var_index          = (*these_var_indices)[0];
+
+  __mmask64 mask_is_min_epi8;
+  __m512i   this_c2v_epi8;
+  __m512i   final_sign_epi8;
+
+  for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
+    shift      = this_pcm[current_var_index];
+    i_v2c_base = (current_var_index <= vp->hrr) ? current_var_index : vp->hrr;
+
+    this_rotated_v2c = vp->rotated_v2c + i;
+
+    final_sign_epi8 = _mm512_xor_si512(*this_rotated_v2c, prod_v2c_epi8);
+
+    current_ix_epi8  = _mm512_set1_epi8((int8_t)i);
+    mask_is_min_epi8 = _mm512_cmpeq_epi8_mask(current_ix_epi8, min_ix_epi8);
+    this_c2v_epi8    = _mm512_mask_blend_epi8(mask_is_min_epi8, minp_v2c_epi8, mins_v2c_epi8);
+    this_c2v_epi8    = _mm512_scalei_epi8(this_c2v_epi8, vp->scaling_fctr);
+
+    // does *not* do anything special for signs[i] == 0, just negative / non-negative
+    __mmask64 negmask = _mm512_movepi8_mask(final_sign_epi8);
+
+    this_c2v_epi8 = _mm512_mask_sub_epi8(this_c2v_epi8, negmask, _mm512_setzero_si512(), this_c2v_epi8);
+
+    // rotating right LS - shift positions is the same as rotating left shift positions
+    this_check_to_var[i_v2c_base] = rotate_slots_right(vp, this_c2v_epi8, (vp->ls - shift) % vp->ls);
+
+    current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
+  }
+
+  return 0;
+}
+
+int update_ldpc_soft_bits_c_avx512_batch(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
+{
+  struct ldpc_regs_c_avx512_batch* vp = p;
+  if (p == NULL) {
+    return -1;
+  }
+
+  __m512i* this_check_to_var = vp->check_to_var + i_layer * (vp->hrr + 1);
+
+  int i_bit_tmp_base = 0;
+
+  __m512i   tmp_epi8;
+  __mmask64 mask_epi8;
+
+  int8_t current_var_index = (*these_var_indices)[0];
+
+  for (int i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
+    i_bit_tmp_base = (current_var_index <= vp->hrr) ? current_var_index : vp->hrr;
+
+    tmp_epi8 = _mm512_adds_epi8(this_check_to_var[i_bit_tmp_base], vp->var_to_check[i_bit_tmp_base]);
+
+    mask_epi8 = _mm512_cmpgt_epi8_mask(tmp_epi8, _mm512_infty7_epi8);
+    tmp_epi8  = _mm512_mask_blend_epi8(mask_epi8, tmp_epi8, _mm512_infty8_epi8);
+
+    mask_epi8 = _mm512_cmpgt_epi8_mask(_mm512_neg_infty7_epi8, tmp_epi8);
+
+    vp->soft_bits.v[current_var_index] = _mm512_mask_blend_epi8(mask_epi8, tmp_epi8, _mm512_neg_infty8_epi8);
+
+    current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
+  }
+
+  return 0;
+}
+
+int extract_ldpc_message_c_avx512_batch(void* p, uint32_t cb_idx, uint8_t* message, uint16_t liftK)
+{
+  if (p == NULL) {
+    return -1;
+  }
+
+  struct ldpc_regs_c_avx512_batch* vp = p;
+
+  if (cb_idx >= vp->nof_slots) {
+    return -1;
+  }
+
+  int j = 0;
+
+  for (int i = 0; i < liftK / vp->ls; i++) {
+    const int8_t* slot = &vp->soft_bits.c[i * SRSRAN_AVX512_B_SIZE + cb_idx * vp->slot_size];
+    for (j = 0; j < vp->ls; j++) {
+      int8_t soft_bit = slot[j];
+      if (soft_bit == 0) {
+        memset(message, 1, liftK);
+        return -1;
+      }
+      message[i * vp->ls + j] = (soft_bit < 0);
+    }
+  }
+
+  return 0;
+}
+
+static void inner_var_to_check_c_avx512_batch(const __m512i* x,
+                                              const __m512i* y,
+                                              __m512i*       z,
+                                              const uint8_t  clip,
+                                              const uint32_t len)
+{
+  unsigned i = 0;
+
+  __m512i   x_epi8;
+  __m512i   y_epi8;
+  __m512i   z_epi8;
+  __mmask64 mask_epi8;
+  __m512i   help_sub_epi8;
+  __m512i   clip_epi8     = _mm512_set1_epi8(clip);
+  __m512i   neg_clip_epi8 = _mm512_set1_epi8((char)(-clip));
+
+  for (i = 0; i < len; i++) {
+    x_epi8 = x[i];
+    y_epi8 = y[i];
+
+    // z = (x-y > clip) ? clip : x-y
+    help_sub_epi8 = _mm512_subs_epi8(x_epi8, y_epi8);
+    mask_epi8     = _mm512_cmpgt_epi8_mask(help_sub_epi8, clip_epi8);
+    z_epi8        = _mm512_mask_blend_epi8(mask_epi8, help_sub_epi8, clip_epi8);
+
+    // z = (z < -clip) ? -clip : z
+    mask_epi8 = _mm512_cmpgt_epi8_mask(neg_clip_epi8, z_epi8);
+    z_epi8    = _mm512_mask_blend_epi8(mask_epi8, z_epi8, neg_clip_epi8);
+
+    // ensure that x = +/- infinity => z = +/- infinity
+    // z = (x < infinity) ? z : infinity
+    mask_epi8 = _mm512_cmpgt_epi8_mask(_mm512_infty8_epi8, x_epi8);
+    z_epi8    = _mm512_mask_blend_epi8(mask_epi8, _mm512_infty8_epi8, z_epi8);
+
+    // z = (x > - infinity) ? z : - infinity
+    mask_epi8 = _mm512_cmpgt_epi8_mask(x_epi8, _mm512_neg_infty8_epi8);
+    z[i]      = _mm512_mask_blend_epi8(mask_epi8, _mm512_neg_infty8_epi8, z_epi8);
+  }
+}
+
+static __m512i rotate_slots_right(const struct ldpc_regs_c_avx512_batch* vp, __m512i a, uint16_t shift)
+{
+  __m512i out = _mm512_shuffle_epi8(a, vp->rotate_in_lane[shift]);
+
+  if (vp->slot_size > SLOT_SIZE_MEDIUM) {
+    // Swap the two 128-bit lanes of each 256-bit half and take the chars that come from the other lane
+    __m512i swapped = _mm512_shuffle_i64x2(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+    out             = _mm512_mask_shuffle_epi8(out, vp->cross_lane_mask[shift], swapped, vp->rotate_cross_lane[shift]);
+  }
+
+  return out;
+}
+
+static __m512i _mm512_scalei_epi8(__m512i a, __m512i sf)
+{
+  __m512i even_epi16 = _mm512_and_si512(a, _mm512_mask_even_epi8);
+  __m512i odd_epi16  = _mm512_srli_epi16(a, 8);
+
+  __m512i p_even_epi16 = _mm512_mulhi_epu16(even_epi16, sf);
+  __m512i p_odd_epi16  = _mm512_mulhi_epu16(odd_epi16, sf);
+
+  p_odd_epi16 = _mm512_slli_epi16(p_odd_epi16, 8);
+
+  return _mm512_xor_si512(p_even_epi16, p_odd_epi16);
+}
+
+#endif // LV_HAVE_AVX512
@@ -169,6 +169,102 @@
     return q->max_nof_iter;                                                                                            \
   }
 
+/*!
+ * Computes the number of layers processed by the decoder for a rate-matched codeword of the given length, applying
+ * the same length adjustments as the decoding templates above.
+ */
+static uint8_t ldpc_decoder_nof_layers(const srsran_ldpc_decoder_t* q, uint32_t cdwd_rm_length)
+{
+  if (cdwd_rm_length > q->liftN - 2 * q->ls) {
+    cdwd_rm_length = q->liftN - 2 * q->ls;
+  }
+  if (cdwd_rm_length < (q->bgK + 2) * q->ls) {
+    cdwd_rm_length = (q->bgK + 2) * q->ls;
+  }
+  if (cdwd_rm_length % q->ls) {
+    cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;
+  }
+  return cdwd_rm_length / q->ls - q->bgK + 2;
+}
+
+/*!
+ * Decodes a batch of code blocks in lockstep. All the code blocks must span the same number of layers. Each code block
+ * stops being checked as soon as its CRC matches, so that its message and number of iterations are the same as if it
+ * had been decoded alone.
+ */
+#define LDPC_DECODER_BATCH_TEMPLATE(LLR_TYPE, SUFFIX)                                                                  \
+  static int decode_batch_##SUFFIX(void*                  o,                                                           \
+                                   const LLR_TYPE* const* llrs,                                                        \
+                                   uint8_t* const*        message,                                                     \
+                                   uint32_t               cdwd_rm_length,                                              \
+                                   uint32_t               nof_cbs,                                                     \
+                                   srsran_crc_t*          crc,                                                         \
+                                   int*                   nof_iter)                                                    \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+                                                                                                                       \
+    if (init_ldpc_dec_##SUFFIX(q->ptr_batch, llrs, nof_cbs, q->ls) < 0) {                                              \
+      return -1;                                                                                                       \
+    }                                                                                                                  \
+                                                                                                                       \
+    uint16_t* this_pcm                    = NULL;                                                                      \
+    int8_t (*these_var_indices)[MAX_CNCT] = NULL;                                                                      \
+                                                                                                                       \
+    uint8_t n_layers = ldpc_decoder_nof_layers(q, cdwd_rm_length);                                                     \
+                                                                                                                       \
+    bool     pending[SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE];                                                              \
+    uint32_t nof_pending = nof_cbs;                                                                                    \
+    for (uint32_t cb = 0; cb < nof_cbs; cb++) {                                                                        \
+      pending[cb]  = true;                                                                                             \
+      nof_iter[cb] = 0;                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    for (int i_iteration = 0; i_iteration < q->max_nof_iter; i_iteration++) {                                          \
+      for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
+        update_ldpc_var_to_check_##SUFFIX(q->ptr_batch, i_layer);                                                      \
+                                                                                                                       \
+        this_pcm          = q->pcm + i_layer * q->bgN;                                                                 \
+        these_var_indices = q->var_indices + i_layer;                                                                  \
+                                                                                                                       \
+        update_ldpc_check_to_var_##SUFFIX(q->ptr_batch, i_layer, this_pcm, these_var_indices);                         \
+                                                                                                                       \
+        update_ldpc_soft_bits_##SUFFIX(q->ptr_batch, i_layer, these_var_indices);                                      \
+      }                                                                                                                \
+                                                                                                                       \
+      if (crc != NULL) {                                                                                               \
+        for (uint32_t cb = 0; cb < nof_cbs; cb++) {                                                                    \
+          if (!pending[cb]) {                                                                                          \
+            continue;                                                                                                  \
+          }                                                                                                            \
+          if (extract_ldpc_message_##SUFFIX(q->ptr_batch, cb, message[cb], q->liftK) < 0) {                            \
+            continue;                                                                                                  \
+          }                                                                                                            \
+          if (srsran_crc_match(crc, message[cb], q->liftK - crc->order)) {                                             \
+            nof_iter[cb] = i_iteration + 1;                                                                            \
+            pending[cb]  = false;                                                                                      \
+            nof_pending--;                                                                                             \
+          }                                                                                                            \
+        }                                                                                                              \
+                                                                                                                       \
+        if (nof_pending == 0) {                                                                                        \
+          return 0;                                                                                                    \
+        }                                                                                                              \
+      }                                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* If reached here, and CRC is being checked, the pending code blocks have failed */                               \
+    if (crc != NULL) {                                                                                                 \
+      return 0;                                                                                                        \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* Without CRC, extract messages and return the maximum number of iterations */                                    \
+    for (uint32_t cb = 0; cb < nof_cbs; cb++) {                                                                        \
+      extract_ldpc_message_##SUFFIX(q->ptr_batch, cb, message[cb], q->liftK);                                          \
+      nof_iter[cb] = q->max_nof_iter;                                                                                  \
+    }                                                                                                                  \
+    return 0;                                                                                                          \
+  }
+
 /*! Carries out the actual destruction of the memory allocated to the decoder, float-LLR case. */
 static void free_dec_f(void* o)
 {
@@ -309,11 +405,16 @@ static void free_dec_c_avx2(void* o)
     free(q->pcm);
   }
   delete_ldpc_dec_c_avx2(q->ptr);
+  delete_ldpc_dec_c_avx2_batch(q->ptr_batch);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx2);
 
+/*! Carries out the decoding of a batch of code blocks with 8-bit integer-valued LLRs, sharing the lanes of the AVX2
+ * registers (AVX2 implementation). */
+LDPC_DECODER_BATCH_TEMPLATE(int8_t, c_avx2_batch)
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation). */
 static int init_c_avx2(srsran_ldpc_decoder_t* q)
 {
@@ -327,6 +428,19 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx2;
 
+  // Decode several code blocks in the same registers if the lifting size leaves enough idle lanes
+  q->max_batch_size = SRSRAN_MIN(q->max_batch_size, get_max_nof_cbs_ldpc_dec_c_avx2_batch(q->ls));
+  if (q->max_batch_size > 1) {
+    if ((q->ptr_batch = create_ldpc_dec_c_avx2_batch(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+      ERROR("Create_ldpc_dec failed");
+      free_dec_c_avx2(q);
+      return -1;
+    }
+    q->decode_batch_c = decode_batch_c_avx2_batch;
+  } else {
+    q->max_batch_size = 1;
+  }
+
   return 0;
 }
 
@@ -448,11 +562,16 @@ static void free_dec_c_avx512(void* o)
     free(q->pcm);
   }
   delete_ldpc_dec_c_avx512(q->ptr);
+  delete_ldpc_dec_c_avx512_batch(q->ptr_batch);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx512)
 
+/*! Carries out the decoding of a batch of code blocks with 8-bit integer-valued LLRs, sharing the lanes of the AVX512
+ * registers (AVX512 implementation). */
+LDPC_DECODER_BATCH_TEMPLATE(int8_t, c_avx512_batch)
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX512 implementation). */
 static int init_c_avx512(srsran_ldpc_decoder_t* q)
 {
@@ -466,6 +585,19 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx512;
 
+  // Decode several code blocks in the same registers if the lifting size leaves enough idle lanes
+  q->max_batch_size = SRSRAN_MIN(q->max_batch_size, get_max_nof_cbs_ldpc_dec_c_avx512_batch(q->ls));
+  if (q->max_batch_size > 1) {
+    if ((q->ptr_batch = create_ldpc_dec_c_avx512_batch(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+      ERROR("Create_ldpc_dec failed");
+      free_dec_c_avx512(q);
+      return -1;
+    }
+    q->decode_batch_c = decode_batch_c_avx512_batch;
+  } else {
+    q->max_batch_size = 1;
+  }
+
   return 0;
 }
 
@@ -580,6 +712,11 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
 
   q->max_nof_iter = (args->max_nof_iter == 0) ? LDPC_DECODER_DEFAULT_MAX_NOF_ITER : args->max_nof_iter;
 
+  // Batched decoding is only enabled by the implementations that support it
+  q->max_batch_size = SRSRAN_MIN(SRSRAN_MAX(args->max_batch_size, 1), SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE);
+  q->ptr_batch      = NULL;
+  q->decode_batch_c = NULL;
+
   q->pcm = srsran_vec_u16_malloc(q->bgM * q->bgN);
   if (!q->pcm) {
     perror("malloc");
@@ -685,3 +822,43 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_decode_batch_c(srsran_ldpc_decoder_t* q,
+                                       const int8_t* const*   llrs,
+                                       uint8_t* const*        message,
+                                       const uint32_t*        cdwd_rm_length,
+                                       uint32_t               nof_cbs,
+                                       srsran_crc_t*          crc,
+                                       int*                   nof_iter)
+{
+  if (q == NULL || llrs == NULL || message == NULL || cdwd_rm_length == NULL || nof_iter == NULL) {
+    return -1;
+  }
+
+  uint32_t i = 0;
+  while (i < nof_cbs) {
+    // Group consecutive code blocks spanning the same number of layers
+    uint32_t n = 1;
+    if (q->decode_batch_c != NULL) {
+      uint8_t n_layers = ldpc_decoder_nof_layers(q, cdwd_rm_length[i]);
+      while (i + n < nof_cbs && n < q->max_batch_size &&
+             ldpc_decoder_nof_layers(q, cdwd_rm_length[i + n]) == n_layers) {
+        n++;
+      }
+    }
+
+    if (n > 1) {
+      if (q->decode_batch_c(q, llrs + i, message + i, cdwd_rm_length[i], n, crc, nof_iter + i) < 0) {
+        return -1;
+      }
+    } else {
+      nof_iter[i] = q->decode_c(q, llrs[i], message[i], cdwd_rm_length[i], crc);
+      if (nof_iter[i] < 0) {
+        return -1;
+      }
+    }
+    i += n;
+  }
+
+  return 0;
+}
@@ -0,0 +1,368 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_dec_batch_test.c
+ * \brief Throughput benchmark and bit-exactness test for the batched LDPC decoder.
+ *
+ * A number of code blocks carrying a CRC24B are randomly generated, encoded, 2-PAM modulated, sent over an AWGN channel
+ * and quantized to 8-bit LLRs. They are then decoded by an AVX2 decoder one by one and by an AVX2 decoder with batched
+ * decoding enabled, and likewise with the AVX512 decoders if available. The test fails if the single and batched
+ * decoders do not produce exactly the same messages and numbers of iterations. The throughput of all the decoders is
+ * reported.
+ *
+ * Synopsis: **ldpc_dec_batch_test [options]**
+ *
+ * Options:
+ *  - **-b \<number\>** Base Graph (1 or 2. Default 1).
+ *  - **-l \<number\>** Lifting Size (according to 5GNR standard. Default 8).
+ *  - **-e \<number\>** Codeword length after rate matching (set to 0 [default] for full rate).
+ *  - **-s \<number\>** SNR in dB (Default 1 dB).
+ *  - **-B \<number\>** Maximum number of code blocks decoded together (Default 8).
+ *  - **-C \<number\>** Number of code blocks decoded in each call (Default 8).
+ *  - **-R \<number\>** Number of repetitions (Default 100).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX2
+
+#define MAX_NOF_CBS 64  /*!< \brief Maximum number of code blocks decoded in each call. */
+#define MS_SF 0.8f      /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+#define CRC_LEN 24      /*!< \brief Length of the code block CRC. */
+
+static srsran_basegraph_t base_graph = BG1;  /*!< \brief Base Graph (BG1 or BG2). */
+static int                lift_size  = 8;    /*!< \brief Lifting Size. */
+static int                rm_length  = 0;    /*!< \brief Codeword length after rate matching. */
+static float              snr        = 1.0f; /*!< \brief Signal-to-Noise Ratio [dB]. */
+static int                batch_size = 8;    /*!< \brief Maximum number of code blocks decoded together. */
+static int                nof_cbs    = 8;    /*!< \brief Number of code blocks decoded in each call. */
+static int                nof_reps   = 100;  /*!< \brief Number of repetitions. */
+
+/*!
+ * \brief Prints test help when wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX] [-CX] [-RX]\n", prog);
+  printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
+  printf("\t-l Lifting Size [Default %d]\n", lift_size);
+  printf("\t-e Word length after rate matching [Default %d (no rate matching)]\n", rm_length);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr);
+  printf("\t-B Maximum number of code blocks decoded together [Default %d]\n", batch_size);
+  printf("\t-C Number of code blocks decoded in each call [Default %d]\n", nof_cbs);
+  printf("\t-R Number of repetitions [Default %d]\n", nof_reps);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "b:l:e:s:B:C:R:")) != -1) {
+    switch (opt) {
+      case 'b':
+        base_graph = (int)strtol(optarg, NULL, 10) - 1;
+        break;
+      case 'l':
+        lift_size = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'e':
+        rm_length = (int)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr = (float)strtod(optarg, NULL);
+        break;
+      case 'B':
+        batch_size = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'C':
+        nof_cbs = SRSRAN_MIN((int)strtol(optarg, NULL, 10), MAX_NOF_CBS);
+        break;
+      case 'R':
+        nof_reps = (int)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Prints the throughput of a decoder.
+ */
+static void print_decoder(const char* title, double elapsed_time, int finalK)
+{
+  double nof_bits = (double)nof_reps * nof_cbs * finalK;
+  printf("  %-24s %8.1f us/call, %8.1f Mbps\n", title, 1e6 * elapsed_time / nof_reps, nof_bits / elapsed_time / 1e6);
+}
+
+/*!
+ * \brief Decodes all the code blocks one by one and in batches, reports the throughput of both decoders and checks that
+ * they agree bit by bit.
+ */
+static int run_decoders(const char*            title,
+                        srsran_ldpc_decoder_t* decoder_single,
+                        srsran_ldpc_decoder_t* decoder_batch,
+                        const int8_t* const*   llr_ptrs,
+                        uint8_t* const*        sngl_ptrs,
+                        uint8_t* const*        batch_ptrs,
+                        const uint32_t*        lengths,
+                        srsran_crc_t*          crc,
+                        int                    finalK)
+{
+  int iter_sngl[MAX_NOF_CBS];
+  int iter_batch[MAX_NOF_CBS];
+
+  struct timeval t[3];
+
+  // Decode one code block at a time
+  gettimeofday(&t[1], NULL);
+  for (int rep = 0; rep < nof_reps; rep++) {
+    for (int cb = 0; cb < nof_cbs; cb++) {
+      iter_sngl[cb] = srsran_ldpc_decoder_decode_crc_c(decoder_single, llr_ptrs[cb], sngl_ptrs[cb], lengths[cb], crc);
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_sngl = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+  // Decode all code blocks at once
+  gettimeofday(&t[1], NULL);
+  for (int rep = 0; rep < nof_reps; rep++) {
+    if (srsran_ldpc_decoder_decode_batch_c(decoder_batch, llr_ptrs, batch_ptrs, lengths, nof_cbs, crc, iter_batch) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error in %s batch decoder", title);
+      return SRSRAN_ERROR;
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_batch = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+  char batch_title[32];
+  snprintf(batch_title, sizeof(batch_title), "%s batch (up to %d)", title, decoder_batch->max_batch_size);
+  print_decoder(title, elapsed_sngl, finalK);
+  print_decoder(batch_title, elapsed_batch, finalK);
+
+  // Both decoders must agree bit by bit
+  int nof_crc_ok = 0;
+  for (int cb = 0; cb < nof_cbs; cb++) {
+    if (iter_sngl[cb] != iter_batch[cb]) {
+      ERROR("%s CB %d: iterations do not match (%d != %d)", title, cb, iter_sngl[cb], iter_batch[cb]);
+      return SRSRAN_ERROR;
+    }
+    if (memcmp(sngl_ptrs[cb], batch_ptrs[cb], finalK) != 0) {
+      ERROR("%s CB %d: messages do not match", title, cb);
+      return SRSRAN_ERROR;
+    }
+    nof_crc_ok += (iter_batch[cb] > 0);
+  }
+  printf("  %d/%d code blocks passed the CRC\n", nof_crc_ok, nof_cbs);
+
+  return SRSRAN_SUCCESS;
+}
+
+/*!
+ * \brief Main test function.
+ */
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_ldpc_encoder_t encoder = {};
+  if (srsran_ldpc_encoder_init(&encoder, SRSRAN_LDPC_ENCODER_AVX2, base_graph, lift_size) != 0) {
+    ERROR("Error initialising encoder");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_ldpc_decoder_args_t decoder_args = {};
+  decoder_args.type                       = SRSRAN_LDPC_DECODER_C_AVX2;
+  decoder_args.bg                         = base_graph;
+  decoder_args.ls                         = lift_size;
+  decoder_args.scaling_fctr               = MS_SF;
+
+  srsran_ldpc_decoder_t decoder_single = {};
+  if (srsran_ldpc_decoder_init(&decoder_single, &decoder_args) != 0) {
+    ERROR("Error initialising decoder");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_ldpc_decoder_t decoder_batch = {};
+  decoder_args.max_batch_size         = batch_size;
+  if (srsran_ldpc_decoder_init(&decoder_batch, &decoder_args) != 0) {
+    ERROR("Error initialising batch decoder");
+    return SRSRAN_ERROR;
+  }
+
+#ifdef LV_HAVE_AVX512
+  srsran_ldpc_decoder_t decoder_avx512 = {};
+  decoder_args.type                    = SRSRAN_LDPC_DECODER_C_AVX512;
+  decoder_args.max_batch_size          = 0;
+  if (srsran_ldpc_decoder_init(&decoder_avx512, &decoder_args) != 0) {
+    ERROR("Error initialising AVX512 decoder");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_ldpc_decoder_t decoder_avx512_batch = {};
+  decoder_args.max_batch_size                = batch_size;
+  if (srsran_ldpc_decoder_init(&decoder_avx512_batch, &decoder_args) != 0) {
+    ERROR("Error initialising AVX512 batch decoder");
+    return SRSRAN_ERROR;
+  }
+#endif // LV_HAVE_AVX512
+
+  srsran_crc_t crc = {};
+  if (srsran_crc_init(&crc, SRSRAN_LTE_CRC24B, CRC_LEN) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising CRC");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0);
+  srsran_channel_awgn_t awgn = {};
+  if (srsran_channel_awgn_init(&awgn, 1234) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising AWGN channel");
+    return SRSRAN_ERROR;
+  }
+  srsran_channel_awgn_set_n0(&awgn, -snr);
+
+  int finalK = encoder.liftK;
+  int finalN = encoder.liftN - 2 * lift_size;
+  if (finalK <= CRC_LEN) {
+    ERROR("The lifting size is too small to carry a %d-bit CRC", CRC_LEN);
+    return SRSRAN_ERROR;
+  }
+  if (rm_length == 0 || rm_length > finalN) {
+    rm_length = finalN;
+  }
+
+  printf("Test LDPC batch decoder:\n");
+  printf("  Base Graph      -> BG%d\n", encoder.bg + 1);
+  printf("  Lifting Size    -> %d\n", encoder.ls);
+  printf("  Codeword length -> E = %d (K = %d)\n", rm_length, finalK);
+  printf("  Code blocks     -> %d per call\n", nof_cbs);
+  printf("  SNR             -> %.2f dB\n", snr);
+
+  uint8_t* messages_true  = srsran_vec_u8_malloc(finalK * nof_cbs);
+  uint8_t* messages_sngl  = srsran_vec_u8_malloc(finalK * nof_cbs);
+  uint8_t* messages_batch = srsran_vec_u8_malloc(finalK * nof_cbs);
+  uint8_t* codewords      = srsran_vec_u8_malloc(finalN * nof_cbs);
+  float*   symbols        = srsran_vec_f_malloc(finalN * nof_cbs);
+  int8_t*  llrs           = srsran_vec_i8_malloc(finalN * nof_cbs);
+  if (!messages_true || !messages_sngl || !messages_batch || !codewords || !symbols || !llrs) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  const int8_t* llr_ptrs[MAX_NOF_CBS];
+  uint8_t*      sngl_ptrs[MAX_NOF_CBS];
+  uint8_t*      batch_ptrs[MAX_NOF_CBS];
+  uint32_t      lengths[MAX_NOF_CBS];
+  for (int cb = 0; cb < nof_cbs; cb++) {
+    llr_ptrs[cb]   = llrs + cb * finalN;
+    sngl_ptrs[cb]  = messages_sngl + cb * finalK;
+    batch_ptrs[cb] = messages_batch + cb * finalK;
+    lengths[cb]    = rm_length;
+  }
+
+  // Generate, encode, modulate and quantize the code blocks
+  for (int cb = 0; cb < nof_cbs; cb++) {
+    uint8_t* msg = messages_true + cb * finalK;
+    for (int j = 0; j < finalK - CRC_LEN; j++) {
+      msg[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_crc_attach(&crc, msg, finalK - CRC_LEN);
+    srsran_ldpc_encoder_encode(&encoder, msg, codewords + cb * finalN, finalK);
+  }
+  for (int i = 0; i < finalN * nof_cbs; i++) {
+    symbols[i] = 1.0f - 2.0f * codewords[i];
+  }
+  srsran_channel_awgn_run_f(&awgn, symbols, symbols, finalN * nof_cbs);
+  float   noise_std_dev = srsran_convert_dB_to_amplitude(-snr);
+  int8_t  inf7          = (1U << 6U) - 1;
+  float   gain_c        = inf7 * noise_std_dev / 8 / (1 / noise_std_dev + 2);
+  srsran_vec_quant_fc(symbols, llrs, gain_c, 0, inf7, finalN * nof_cbs);
+
+  printf("\nResults:\n");
+
+  // Decode one code block at a time, then all code blocks at once
+  if (run_decoders("AVX2", &decoder_single, &decoder_batch, llr_ptrs, sngl_ptrs, batch_ptrs, lengths, &crc, finalK) <
+      SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+#ifdef LV_HAVE_AVX512
+  if (run_decoders(
+          "AVX512", &decoder_avx512, &decoder_avx512_batch, llr_ptrs, sngl_ptrs, batch_ptrs, lengths, &crc, finalK) <
+      SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+#endif // LV_HAVE_AVX512
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  free(llrs);
+  free(symbols);
+  free(codewords);
+  free(messages_batch);
+  free(messages_sngl);
+  free(messages_true);
+  srsran_channel_awgn_free(&awgn);
+  srsran_random_free(random_gen);
+#ifdef LV_HAVE_AVX512
+  srsran_ldpc_decoder_free(&decoder_avx512_batch);
+  srsran_ldpc_decoder_free(&decoder_avx512);
+#endif // LV_HAVE_AVX512
+  srsran_ldpc_decoder_free(&decoder_batch);
+  srsran_ldpc_decoder_free(&decoder_single);
+  srsran_ldpc_encoder_free(&encoder);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
+
+#else // LV_HAVE_AVX2
+
+int main(int argc, char** argv)
+{
+  printf("AVX2 not available, skipping test\n");
+  return 0;
+}
+
+#endif // LV_HAVE_AVX2
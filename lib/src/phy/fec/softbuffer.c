@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 
 #include "srsran/phy/common/phy_common.h"
@@ -109,9 +110,43 @@ clean_exit:
   return ret;
 }
 
+int srsran_softbuffer_rx_init_pool(srsran_softbuffer_rx_t* q, srsran_softbuffer_pool_t* pool, uint32_t max_cb)
+{
+  // Protect pointers
+  if (!q || !pool) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Initialise object
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
+
+  // Set internal attributes, code-block buffers are leased on demand
+  q->max_cb      = max_cb;
+  q->max_cb_size = pool->max_cb_size;
+
+  q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
+  q->data     = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  q->cb_crc   = SRSRAN_MEM_ALLOC(bool, q->max_cb);
+  if (!q->buffer_f || !q->data || !q->cb_crc) {
+    perror("malloc");
+    srsran_softbuffer_rx_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->data, uint8_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
+
+  q->pool = pool;
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
+    // Leased code blocks go back to the pool, leaving only the pointer arrays to free
+    srsran_softbuffer_rx_release(q);
+
     if (q->buffer_f) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_f[i]) {
@@ -136,20 +171,32 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
   }
 }
 
-void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
+int srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 {
   uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
-  srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(nof_cb, q->max_cb));
+  return srsran_softbuffer_rx_reset_cb(q, SRSRAN_MIN(nof_cb, q->max_cb));
 }
 
 void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
 {
+  // A pool soft-buffer does not need any code block until the next transport block is known
+  if (q->pool) {
+    srsran_softbuffer_rx_release(q);
+    return;
+  }
+
   srsran_softbuffer_rx_reset_cb(q, q->max_cb);
 }
 
-void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+int srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
-  if (q->buffer_f) {
+  int ret = SRSRAN_SUCCESS;
+
+  if (q->pool) {
+    // Swap the code blocks of the previous transport block for zeroed ones
+    srsran_softbuffer_pool_release(q->pool, q->max_cb, q->buffer_f, q->data);
+    ret = srsran_softbuffer_pool_lease(q->pool, SRSRAN_MIN(nof_cb, q->max_cb), q->buffer_f, q->data);
+  } else if (q->buffer_f) {
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
@@ -166,6 +213,36 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
     SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
   }
   q->tb_crc = false;
+
+  return ret;
+}
+
+void srsran_softbuffer_rx_release(srsran_softbuffer_rx_t* q)
+{
+  if (q == NULL || q->pool == NULL || q->buffer_f == NULL) {
+    return;
+  }
+
+  srsran_softbuffer_pool_release(q->pool, q->max_cb, q->buffer_f, q->data);
+
+  // Without code blocks no CB can be considered decoded
+  SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
+  q->tb_crc = false;
+}
+
+bool srsran_softbuffer_rx_is_ready(const srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+{
+  if (q == NULL || q->buffer_f == NULL || q->data == NULL || nof_cb > q->max_cb) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    if (q->buffer_f[i] == NULL || q->data[i] == NULL) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
@@ -263,3 +340,156 @@ void srsran_softbuffer_tx_reset_cb(srsran_softbuffer_tx_t* q, uint32_t nof_cb)
     }
   }
 }
+
+int srsran_softbuffer_pool_init(srsran_softbuffer_pool_t* q,
+                                uint32_t                  nof_cb,
+                                uint32_t                  max_cb_size,
+                                srsran_softbuffer_llr_t   llr_type)
+{
+  // Protect pointer
+  if (!q || nof_cb == 0 || max_cb_size == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Initialise object
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_pool_t, 1);
+
+  // Set internal attributes
+  q->nof_cb      = nof_cb;
+  q->max_cb_size = max_cb_size;
+  q->llr_type    = llr_type;
+  q->cb_nbytes   = (llr_type == SRSRAN_SOFTBUFFER_LLR_8BIT) ? max_cb_size : max_cb_size * (uint32_t)sizeof(int16_t);
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    perror("pthread_mutex_init");
+    return SRSRAN_ERROR;
+  }
+
+  q->buffer_f      = SRSRAN_MEM_ALLOC(int16_t*, q->nof_cb);
+  q->data          = SRSRAN_MEM_ALLOC(uint8_t*, q->nof_cb);
+  q->free_buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->nof_cb);
+  q->free_data     = SRSRAN_MEM_ALLOC(uint8_t*, q->nof_cb);
+  if (!q->buffer_f || !q->data || !q->free_buffer_f || !q->free_data) {
+    perror("malloc");
+    srsran_softbuffer_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->nof_cb);
+  SRSRAN_MEM_ZERO(q->data, uint8_t*, q->nof_cb);
+
+  for (uint32_t i = 0; i < q->nof_cb; i++) {
+    q->buffer_f[i] = srsran_vec_malloc(q->cb_nbytes);
+    q->data[i]     = srsran_vec_u8_malloc(q->max_cb_size / 8);
+    if (!q->buffer_f[i] || !q->data[i]) {
+      perror("malloc");
+      srsran_softbuffer_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    // All code blocks start free
+    q->free_buffer_f[i] = q->buffer_f[i];
+    q->free_data[i]     = q->data[i];
+  }
+  q->nof_free = q->nof_cb;
+
+  q->metrics.nof_cb    = q->nof_cb;
+  q->metrics.nof_bytes = (uint64_t)q->nof_cb * (q->cb_nbytes + q->max_cb_size / 8);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_softbuffer_pool_free(srsran_softbuffer_pool_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->nof_cb; i++) {
+    if (q->buffer_f && q->buffer_f[i]) {
+      free(q->buffer_f[i]);
+    }
+    if (q->data && q->data[i]) {
+      free(q->data[i]);
+    }
+  }
+  if (q->buffer_f) {
+    free(q->buffer_f);
+  }
+  if (q->data) {
+    free(q->data);
+  }
+  if (q->free_buffer_f) {
+    free(q->free_buffer_f);
+  }
+  if (q->free_data) {
+    free(q->free_data);
+  }
+  pthread_mutex_destroy(&q->mutex);
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_pool_t, 1);
+}
+
+int srsran_softbuffer_pool_lease(srsran_softbuffer_pool_t* q, uint32_t nof_cb, int16_t** buffer_f, uint8_t** data)
+{
+  if (q == NULL || buffer_f == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  if (nof_cb > q->nof_free) {
+    q->metrics.nof_lease_fail++;
+    pthread_mutex_unlock(&q->mutex);
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    q->nof_free--;
+    buffer_f[i] = q->free_buffer_f[q->nof_free];
+    data[i]     = q->free_data[q->nof_free];
+  }
+  q->metrics.nof_cb_used    = q->nof_cb - q->nof_free;
+  q->metrics.nof_cb_peak    = SRSRAN_MAX(q->metrics.nof_cb_peak, q->metrics.nof_cb_used);
+  q->metrics.nof_bytes_used = (uint64_t)q->metrics.nof_cb_used * (q->cb_nbytes + q->max_cb_size / 8);
+  q->metrics.nof_leases++;
+  pthread_mutex_unlock(&q->mutex);
+
+  // Zero the buffers outside the critical section, they are owned by the caller now
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    memset(buffer_f[i], 0, q->cb_nbytes);
+    srsran_vec_u8_zero(data[i], q->max_cb_size / 8);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_softbuffer_pool_release(srsran_softbuffer_pool_t* q, uint32_t nof_cb, int16_t** buffer_f, uint8_t** data)
+{
+  if (q == NULL || buffer_f == NULL || data == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    if (buffer_f[i] == NULL || data[i] == NULL) {
+      continue;
+    }
+    q->free_buffer_f[q->nof_free] = buffer_f[i];
+    q->free_data[q->nof_free]     = data[i];
+    q->nof_free++;
+    buffer_f[i] = NULL;
+    data[i]     = NULL;
+  }
+  q->metrics.nof_cb_used    = q->nof_cb - q->nof_free;
+  q->metrics.nof_bytes_used = (uint64_t)q->metrics.nof_cb_used * (q->cb_nbytes + q->max_cb_size / 8);
+  pthread_mutex_unlock(&q->mutex);
+}
+
+void srsran_softbuffer_pool_get_metrics(srsran_softbuffer_pool_t* q, srsran_softbuffer_pool_metrics_t* m)
+{
+  if (q == NULL || m == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  *m = q->metrics;
+  pthread_mutex_unlock(&q->mutex);
+}
@@ -0,0 +1,240 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+/*!
+ * \file crc_bench.c
+ * \brief Throughput benchmark and bit-exactness test for the CRC engines.
+ *
+ * The checksums computed by srsran_crc_checksum() (unpacked bits) and srsran_crc_checksum_byte() (packed bytes) are
+ * compared against a bit-serial reference for every message length up to a given number of bits. The test fails if any
+ * of them differ. Then, the throughput of both functions and of the plain table lookup is reported for a number of
+ * transport block sizes.
+ *
+ * Synopsis: **crc_bench [options]**
+ *
+ * Options:
+ *  - **-l \<number\>** CRC length (Default 24).
+ *  - **-p \<hex\>** CRC polynomial (Default 0x1864CFB, CRC24A).
+ *  - **-n \<number\>** Maximum message length checked bit by bit (Default 2048).
+ *  - **-R \<number\>** Number of repetitions of each benchmark (Default 1000).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static int      crc_length = 24;        /*!< \brief CRC length. */
+static uint32_t crc_poly   = 0x1864CFB; /*!< \brief CRC polynomial. */
+static int      max_bits   = 2048;      /*!< \brief Maximum message length checked bit by bit. */
+static int      nof_reps   = 1000;      /*!< \brief Number of repetitions. */
+
+/*!
+ * \brief Message lengths of the throughput benchmark, from small control messages to the largest code blocks.
+ */
+static const int bench_lengths[] = {40, 256, 1024, 6144, 8448, 32768, 75376};
+
+/*!
+ * \brief Prints test help when wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-lX] [-pX] [-nX] [-RX]\n", prog);
+  printf("\t-l CRC length [Default %d]\n", crc_length);
+  printf("\t-p CRC polynomial (Hex) [Default 0x%x]\n", crc_poly);
+  printf("\t-n Maximum message length checked bit by bit [Default %d]\n", max_bits);
+  printf("\t-R Number of repetitions [Default %d]\n", nof_reps);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "l:p:n:R:")) != -1) {
+    switch (opt) {
+      case 'l':
+        crc_length = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'p':
+        crc_poly = (uint32_t)strtoul(optarg, NULL, 16);
+        break;
+      case 'n':
+        max_bits = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'R':
+        nof_reps = (int)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Bit-serial CRC, used as reference.
+ */
+static uint32_t crc_reference(const uint8_t* bits, int len)
+{
+  uint64_t mask = (1ULL << crc_length) - 1;
+  uint64_t crc  = 0;
+  for (int i = 0; i < len; i++) {
+    uint64_t feedback = ((crc >> (crc_length - 1)) & 1U) ^ (bits[i] & 1U);
+    crc               = (crc << 1U) & mask;
+    if (feedback) {
+      crc ^= crc_poly & mask;
+    }
+  }
+  return (uint32_t)crc;
+}
+
+/*!
+ * \brief Plain table lookup over packed bytes, used as throughput baseline.
+ */
+static uint32_t crc_table(srsran_crc_t* h, const uint8_t* data, int len)
+{
+  srsran_crc_set_init(h, 0);
+  for (int i = 0; i < len / 8; i++) {
+    srsran_crc_checksum_put_byte(h, data[i]);
+  }
+  return (uint32_t)srsran_crc_checksum_get(h);
+}
+
+/*!
+ * \brief Prints the throughput of a CRC function.
+ */
+static void print_bench(const char* title, double elapsed_time, int len)
+{
+  double nof_bits = (double)nof_reps * len;
+  printf("  %-12s %8.2f us/call, %8.1f Mbps\n", title, 1e6 * elapsed_time / nof_reps, nof_bits / elapsed_time / 1e6);
+}
+
+/*!
+ * \brief Returns the elapsed time in seconds between t[1] and t[2].
+ */
+static double elapsed_time(struct timeval t[3])
+{
+  get_time_interval(t);
+  return (double)t[0].tv_sec + 1e-6 * (double)t[0].tv_usec;
+}
+
+/*!
+ * \brief Main test function.
+ */
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_crc_t crc = {};
+  if (srsran_crc_init(&crc, crc_poly, crc_length) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising CRC");
+    return SRSRAN_ERROR;
+  }
+
+  int max_len = max_bits;
+  for (uint32_t i = 0; i < sizeof(bench_lengths) / sizeof(bench_lengths[0]); i++) {
+    max_len = SRSRAN_MAX(max_len, bench_lengths[i]);
+  }
+
+  uint8_t* bits  = srsran_vec_u8_malloc(max_len);
+  uint8_t* bytes = srsran_vec_u8_malloc(max_len / 8 + 1);
+  if (bits == NULL || bytes == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0);
+  for (int i = 0; i < max_len; i++) {
+    bits[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+  }
+  srsran_random_free(random_gen);
+  srsran_bit_pack_vector(bits, bytes, max_len);
+
+  // Bit-exactness against the reference for every length
+  for (int len = 1; len <= max_bits; len++) {
+    uint32_t expected = crc_reference(bits, len);
+    uint32_t checksum = srsran_crc_checksum(&crc, bits, len);
+    if (checksum != expected) {
+      ERROR("CRC%d mismatch for %d bits: 0x%x != 0x%x (expected)", crc_length, len, checksum, expected);
+      goto clean_exit;
+    }
+    if (len % 8 == 0) {
+      checksum = srsran_crc_checksum_byte(&crc, bytes, len);
+      if (checksum != expected) {
+        ERROR("CRC%d byte mismatch for %d bits: 0x%x != 0x%x (expected)", crc_length, len, checksum, expected);
+        goto clean_exit;
+      }
+    }
+  }
+  printf("CRC%d (0x%x): bit-exact for lengths 1 to %d\n", crc_length, crc_poly, max_bits);
+
+  // Throughput
+  for (uint32_t i = 0; i < sizeof(bench_lengths) / sizeof(bench_lengths[0]); i++) {
+    int            len = bench_lengths[i];
+    struct timeval t[3];
+
+    // Accumulates the checksums so that the calls are not optimised out
+    volatile uint32_t checksum = 0;
+
+    printf("Message length %d bits:\n", len);
+
+    gettimeofday(&t[1], NULL);
+    for (int r = 0; r < nof_reps; r++) {
+      checksum ^= crc_table(&crc, bytes, len);
+    }
+    gettimeofday(&t[2], NULL);
+    print_bench("table", elapsed_time(t), len);
+
+    gettimeofday(&t[1], NULL);
+    for (int r = 0; r < nof_reps; r++) {
+      checksum ^= srsran_crc_checksum_byte(&crc, bytes, len);
+    }
+    gettimeofday(&t[2], NULL);
+    print_bench("packed", elapsed_time(t), len);
+
+    gettimeofday(&t[1], NULL);
+    for (int r = 0; r < nof_reps; r++) {
+      checksum ^= srsran_crc_checksum(&crc, bits, len);
+    }
+    gettimeofday(&t[2], NULL);
+    print_bench("unpacked", elapsed_time(t), len);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (bits) {
+    free(bits);
+  }
+  if (bytes) {
+    free(bytes);
+  }
+  return ret;
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsran/common/test_common.h"
+#include "srsran/phy/fec/softbuffer.h"
+#include "srsran/phy/fec/turbo/turbodecoder_gen.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
+
+#define POOL_NOF_CB 8
+#define MAX_CB 5
+
+static int pool_lease_release_test(srsran_softbuffer_llr_t llr_type)
+{
+  srsran_softbuffer_pool_t         pool    = {};
+  srsran_softbuffer_rx_t           sb[2]   = {};
+  srsran_softbuffer_pool_metrics_t metrics = {};
+
+  TESTASSERT(srsran_softbuffer_pool_init(&pool, POOL_NOF_CB, SOFTBUFFER_SIZE, llr_type) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_rx_init_pool(&sb[0], &pool, MAX_CB) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_rx_init_pool(&sb[1], &pool, MAX_CB) == SRSRAN_SUCCESS);
+
+  // Nothing is leased until a transport block is known
+  srsran_softbuffer_pool_get_metrics(&pool, &metrics);
+  TESTASSERT(metrics.nof_cb == POOL_NOF_CB);
+  TESTASSERT(metrics.nof_cb_used == 0);
+  TESTASSERT(metrics.nof_bytes_used == 0);
+  TESTASSERT(!srsran_softbuffer_rx_is_ready(&sb[0], 1));
+
+  // A 3-CB transport block leases exactly 3 zeroed code blocks
+  uint32_t tbs = 3 * (SRSRAN_TCOD_MAX_LEN_CB - 24) - 48;
+  TESTASSERT(srsran_softbuffer_rx_reset_tbs(&sb[0], tbs) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_rx_is_ready(&sb[0], 3));
+  TESTASSERT(!srsran_softbuffer_rx_is_ready(&sb[0], 4));
+  uint32_t cb_nbytes = (llr_type == SRSRAN_SOFTBUFFER_LLR_8BIT) ? SOFTBUFFER_SIZE : SOFTBUFFER_SIZE * 2;
+  for (uint32_t i = 0; i < 3; i++) {
+    uint8_t* llr = (uint8_t*)sb[0].buffer_f[i];
+    for (uint32_t j = 0; j < cb_nbytes; j++) {
+      TESTASSERT(llr[j] == 0);
+    }
+    // Dirty the buffer so the next lease has to clean it
+    memset(llr, 0x55, cb_nbytes);
+    sb[0].cb_crc[i] = true;
+  }
+  srsran_softbuffer_pool_get_metrics(&pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 3);
+  TESTASSERT(metrics.nof_bytes_used == 3 * (cb_nbytes + SOFTBUFFER_SIZE / 8));
+
+  // A second soft-buffer takes the rest of the pool, the number of code blocks is limited to its maximum
+  TESTASSERT(srsran_softbuffer_rx_reset_cb(&sb[1], MAX_CB + 1) == SRSRAN_SUCCESS);
+  srsran_softbuffer_pool_get_metrics(&pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == POOL_NOF_CB);
+  TESTASSERT(metrics.nof_cb_peak == POOL_NOF_CB);
+
+  // A new transport block that does not fit is refused as a whole
+  TESTASSERT(srsran_softbuffer_rx_reset_cb(&sb[0], MAX_CB) == SRSRAN_ERROR);
+  TESTASSERT(!srsran_softbuffer_rx_is_ready(&sb[0], 1));
+  srsran_softbuffer_pool_get_metrics(&pool, &metrics);
+  TESTASSERT(metrics.nof_lease_fail == 1);
+  TESTASSERT(metrics.nof_cb_used == MAX_CB);
+  TESTASSERT(srsran_softbuffer_rx_reset_cb(&sb[1], 1) == SRSRAN_SUCCESS);
+
+  // Buffers handed back are zeroed again when leased and the CB CRC flags start cleared
+  TESTASSERT(srsran_softbuffer_rx_reset_cb(&sb[0], 3) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < 3; i++) {
+    uint8_t* llr = (uint8_t*)sb[0].buffer_f[i];
+    for (uint32_t j = 0; j < cb_nbytes; j++) {
+      TESTASSERT(llr[j] == 0);
+    }
+    TESTASSERT(!sb[0].cb_crc[i]);
+  }
+
+  // Releasing a decoded transport block returns its code blocks
+  srsran_softbuffer_rx_release(&sb[0]);
+  TESTASSERT(!srsran_softbuffer_rx_is_ready(&sb[0], 1));
+  srsran_softbuffer_rx_reset(&sb[1]);
+  srsran_softbuffer_pool_get_metrics(&pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 0);
+  TESTASSERT(metrics.nof_bytes_used == 0);
+
+  // Freeing a soft-buffer holding code blocks returns them too
+  TESTASSERT(srsran_softbuffer_rx_reset_cb(&sb[0], MAX_CB) == SRSRAN_SUCCESS);
+  srsran_softbuffer_rx_free(&sb[0]);
+  srsran_softbuffer_rx_free(&sb[1]);
+  srsran_softbuffer_pool_get_metrics(&pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 0);
+  TESTASSERT(metrics.nof_leases == 5);
+
+  srsran_softbuffer_pool_free(&pool);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  TESTASSERT(pool_lease_release_test(SRSRAN_SOFTBUFFER_LLR_16BIT) == SRSRAN_SUCCESS);
+  TESTASSERT(pool_lease_release_test(SRSRAN_SOFTBUFFER_LLR_8BIT) == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
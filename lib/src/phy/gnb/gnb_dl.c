@@ -93,6 +93,11 @@ int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const
     srsran_ofdm_tx_init_cfg(&q->fft[i], &fft_cfg);
   }
 
+  if (srsran_ofdm_many_set(&q->fft_many, q->fft, q->nof_tx_antennas) < SRSRAN_SUCCESS) {
+    ERROR("Error planning batched OFDM");
+    return SRSRAN_ERROR;
+  }
+
   if (srsran_dmrs_sch_init(&q->dmrs, false) < SRSRAN_SUCCESS) {
     ERROR("Error DMRS");
     return SRSRAN_ERROR;
@@ -128,6 +133,7 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
       free(q->sf_symbols[i]);
     }
   }
+  srsran_ofdm_many_free(&q->fft_many);
 
   srsran_pdsch_nr_free(&q->pdsch);
   srsran_dmrs_sch_free(&q->dmrs);
@@ -165,6 +171,11 @@ int srsran_gnb_dl_set_carrier(srsran_gnb_dl_t* q, const srsran_carrier_nr_t* car
       fft_cfg.in_buffer = q->sf_symbols[i];
       srsran_ofdm_tx_init_cfg(&q->fft[i], &fft_cfg);
     }
+
+    if (srsran_ofdm_many_set(&q->fft_many, q->fft, q->nof_tx_antennas) < SRSRAN_SUCCESS) {
+      ERROR("Error planning batched OFDM");
+      return SRSRAN_ERROR;
+    }
   }
 
   q->carrier = *carrier;
@@ -225,6 +236,15 @@ int srsran_gnb_dl_set_pdcch_config(srsran_gnb_dl_t*             q,
   return SRSRAN_SUCCESS;
 }
 
+void srsran_gnb_dl_set_sequence_cache(srsran_gnb_dl_t* q, srsran_sequence_cache_t* cache)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->pdsch.sequence_cache = cache;
+}
+
 void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
 {
   if (q == NULL) {
@@ -233,11 +253,7 @@ void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
 
   float norm_factor = gnb_dl_get_norm_factor(q->pdsch.carrier.nof_prb);
 
-  for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
-    srsran_ofdm_tx_sf(&q->fft[i]);
-
-    srsran_vec_sc_prod_cfc(q->fft[i].cfg.out_buffer, norm_factor, q->fft[i].cfg.out_buffer, (uint32_t)q->fft[i].sf_sz);
-  }
+  srsran_ofdm_many_tx_sf(&q->fft_many, norm_factor);
 }
 
 float srsran_gnb_dl_get_maximum_signal_power_dBfs(uint32_t nof_prb)
@@ -164,6 +164,15 @@ int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrier_nr_t* car
   return SRSRAN_SUCCESS;
 }
 
+void srsran_gnb_ul_set_sequence_cache(srsran_gnb_ul_t* q, srsran_sequence_cache_t* cache)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->pusch.sequence_cache = cache;
+}
+
 int srsran_gnb_ul_fft(srsran_gnb_ul_t* q)
 {
   if (q == NULL) {
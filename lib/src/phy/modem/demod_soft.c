@@ -20,6 +20,8 @@
  */
 
 #include <complex.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <strings.h>
 
@@ -76,15 +78,600 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
 #define SCALE_SHORT_CONV_QAM256 1000
+#define SCALE_SHORT_CONV_QAM1024 1300
 
 #define SCALE_BYTE_CONV_QPSK 20
 #define SCALE_BYTE_CONV_QAM16 30
 #define SCALE_BYTE_CONV_QAM64 40
 #define SCALE_BYTE_CONV_QAM256 50
+#define SCALE_BYTE_CONV_QAM1024 60
+/*
+ * Square QAM demodulator for any number of bits per dimension. The first LLR of each dimension is the negated
+ * amplitude and every following one folds the previous around the next decision threshold, which yields the same
+ * piecewise-linear approximation as the 16QAM and 64QAM demodulators above. The scale is applied to the amplitude and
+ * the thresholds, so that the folds work directly on the scaled LLRs.
+ */
+#define DEMOD_SQQAM_MAX_BITS_X_DIM 5 // Up to 1024QAM
+
+static void demod_sqqam_thresholds(uint32_t nbits_x_dim, float scale, float* thresholds)
+{
+  float norm = sqrtf((float)(2 * ((1U << (2 * nbits_x_dim)) - 1) / 3));
+  for (uint32_t l = 1; l < nbits_x_dim; l++) {
+    thresholds[l] = scale * ((float)(1U << (nbits_x_dim - l)) / norm);
+  }
+}
+
+static inline int16_t demod_sqqam_f2s(float x)
+{
+  x = (x < INT16_MAX) ? x : INT16_MAX;
+  x = (x > INT16_MIN) ? x : INT16_MIN;
+  return (int16_t)x;
+}
+
+static inline int8_t demod_sqqam_f2b(float x)
+{
+  x = (x < INT8_MAX) ? x : INT8_MAX;
+  x = (x > INT8_MIN) ? x : INT8_MIN;
+  return (int8_t)x;
+}
+
+static void demod_sqqam(const cf_t* symbols, float* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  float thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_thresholds(nbits_x_dim, scale, thresholds);
+
+  for (int i = 0; i < nsymbols; i++) {
+    float real = -scale * __real__ symbols[i];
+    float imag = -scale * __imag__ symbols[i];
+    *(llr++)   = real;
+    *(llr++)   = imag;
+    for (uint32_t l = 1; l < nbits_x_dim; l++) {
+      real     = fabsf(real) - thresholds[l];
+      imag     = fabsf(imag) - thresholds[l];
+      *(llr++) = real;
+      *(llr++) = imag;
+    }
+  }
+}
+
+static void demod_sqqam_s(const cf_t* symbols, short* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  float thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_thresholds(nbits_x_dim, scale, thresholds);
+
+  for (int i = 0; i < nsymbols; i++) {
+    float real = -scale * __real__ symbols[i];
+    float imag = -scale * __imag__ symbols[i];
+    *(llr++)   = demod_sqqam_f2s(real);
+    *(llr++)   = demod_sqqam_f2s(imag);
+    for (uint32_t l = 1; l < nbits_x_dim; l++) {
+      real     = fabsf(real) - thresholds[l];
+      imag     = fabsf(imag) - thresholds[l];
+      *(llr++) = demod_sqqam_f2s(real);
+      *(llr++) = demod_sqqam_f2s(imag);
+    }
+  }
+}
+
+static void demod_sqqam_b(const cf_t* symbols, int8_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  float thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_thresholds(nbits_x_dim, scale, thresholds);
+
+  for (int i = 0; i < nsymbols; i++) {
+    float real = -scale * __real__ symbols[i];
+    float imag = -scale * __imag__ symbols[i];
+    *(llr++)   = demod_sqqam_f2b(real);
+    *(llr++)   = demod_sqqam_f2b(imag);
+    for (uint32_t l = 1; l < nbits_x_dim; l++) {
+      real     = fabsf(real) - thresholds[l];
+      imag     = fabsf(imag) - thresholds[l];
+      *(llr++) = demod_sqqam_f2b(real);
+      *(llr++) = demod_sqqam_f2b(imag);
+    }
+  }
+}
+
+/*
+ * The SIMD square QAM demodulators fold a whole register of symbols at a time, one register per LLR level, and then
+ * transpose the (real, imaginary) pairs of all levels into the output order.
+ */
+#if defined(LV_HAVE_SSE) && !defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512)
+
+/*
+ * Demodulates 2 symbols into nbits_x_dim registers of LLRs in output order. The pairs of the first symbol are followed
+ * by the ones of the second, so for an odd number of levels one register straddles both symbols.
+ */
+static inline void
+demod_sqqam_sse(const float* in, __m128 scale, const __m128* thresholds, uint32_t nbits_x_dim, __m128* out)
+{
+  __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  __m128 l[DEMOD_SQQAM_MAX_BITS_X_DIM];
+
+  l[0] = _mm_mul_ps(_mm_loadu_ps(in), scale);
+  for (uint32_t i = 1; i < nbits_x_dim; i++) {
+    l[i] = _mm_sub_ps(_mm_and_ps(l[i - 1], abs_mask), thresholds[i]);
+  }
+
+  switch (nbits_x_dim) {
+    case 1:
+      out[0] = l[0];
+      break;
+    case 2:
+      out[0] = _mm_castpd_ps(_mm_unpacklo_pd(_mm_castps_pd(l[0]), _mm_castps_pd(l[1])));
+      out[1] = _mm_castpd_ps(_mm_unpackhi_pd(_mm_castps_pd(l[0]), _mm_castps_pd(l[1])));
+      break;
+    case 3:
+      out[0] = _mm_castpd_ps(_mm_unpacklo_pd(_mm_castps_pd(l[0]), _mm_castps_pd(l[1])));
+      out[1] = _mm_castpd_ps(_mm_shuffle_pd(_mm_castps_pd(l[2]), _mm_castps_pd(l[0]), 0x2));
+      out[2] = _mm_castpd_ps(_mm_unpackhi_pd(_mm_castps_pd(l[1]), _mm_castps_pd(l[2])));
+      break;
+    case 4:
+      out[0] = _mm_castpd_ps(_mm_unpacklo_pd(_mm_castps_pd(l[0]), _mm_castps_pd(l[1])));
+      out[1] = _mm_castpd_ps(_mm_unpacklo_pd(_mm_castps_pd(l[2]), _mm_castps_pd(l[3])));
+      out[2] = _mm_castpd_ps(_mm_unpackhi_pd(_mm_castps_pd(l[0]), _mm_castps_pd(l[1])));
+      out[3] = _mm_castpd_ps(_mm_unpackhi_pd(_mm_castps_pd(l[2]), _mm_castps_pd(l[3])));
+      break;
+    case 5:
+      out[0] = _mm_castpd_ps(_mm_unpacklo_pd(_mm_castps_pd(l[0]), _mm_castps_pd(l[1])));
+      out[1] = _mm_castpd_ps(_mm_unpacklo_pd(_mm_castps_pd(l[2]), _mm_castps_pd(l[3])));
+      out[2] = _mm_castpd_ps(_mm_shuffle_pd(_mm_castps_pd(l[4]), _mm_castps_pd(l[0]), 0x2));
+      out[3] = _mm_castpd_ps(_mm_unpackhi_pd(_mm_castps_pd(l[1]), _mm_castps_pd(l[2])));
+      out[4] = _mm_castpd_ps(_mm_unpackhi_pd(_mm_castps_pd(l[3]), _mm_castps_pd(l[4])));
+      break;
+    default:; // Do nothing
+  }
+}
+
+static inline void demod_sqqam_sse_init(uint32_t nbits_x_dim, float scale, __m128* scale_v, __m128* thresholds)
+{
+  float t[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_thresholds(nbits_x_dim, scale, t);
+  for (uint32_t i = 1; i < nbits_x_dim; i++) {
+    thresholds[i] = _mm_set1_ps(t[i]);
+  }
+  *scale_v = _mm_set1_ps(-scale);
+}
+
+/*
+ * Converts to integer after clamping to the LLR range, out of range values would otherwise turn into INT32_MIN
+ */
+static inline __m128i demod_sqqam_sse_cvt(__m128 x, __m128 llr_min, __m128 llr_max)
+{
+  return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(x, llr_min), llr_max));
+}
+
+static int demod_sqqam_sse_s(const cf_t* symbols, int16_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m128 llr_min = _mm_set1_ps(INT16_MIN);
+  __m128 llr_max = _mm_set1_ps(INT16_MAX);
+  __m128 scale_v, thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_sse_init(nbits_x_dim, scale, &scale_v, thresholds);
+
+  int i = 0;
+  for (; i < nsymbols - 3; i += 4) {
+    __m128 out[2 * DEMOD_SQQAM_MAX_BITS_X_DIM];
+    demod_sqqam_sse((const float*)&symbols[i], scale_v, thresholds, nbits_x_dim, &out[0]);
+    demod_sqqam_sse((const float*)&symbols[i + 2], scale_v, thresholds, nbits_x_dim, &out[nbits_x_dim]);
+
+    for (uint32_t j = 0; j < 2 * nbits_x_dim; j += 2) {
+      __m128i s0 = demod_sqqam_sse_cvt(out[j], llr_min, llr_max);
+      __m128i s1 = demod_sqqam_sse_cvt(out[j + 1], llr_min, llr_max);
+      __m128i s  = _mm_packs_epi32(s0, s1);
+      _mm_storeu_si128((__m128i*)llr, s);
+      llr += 8;
+    }
+  }
+
+  return i;
+}
+
+static int demod_sqqam_sse_b(const cf_t* symbols, int8_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m128 llr_min = _mm_set1_ps(INT8_MIN);
+  __m128 llr_max = _mm_set1_ps(INT8_MAX);
+  __m128 scale_v, thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_sse_init(nbits_x_dim, scale, &scale_v, thresholds);
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m128 out[4 * DEMOD_SQQAM_MAX_BITS_X_DIM];
+    for (uint32_t j = 0; j < 4; j++) {
+      demod_sqqam_sse((const float*)&symbols[i + 2 * j], scale_v, thresholds, nbits_x_dim, &out[j * nbits_x_dim]);
+    }
+
+    for (uint32_t j = 0; j < 4 * nbits_x_dim; j += 4) {
+      __m128i s0  = demod_sqqam_sse_cvt(out[j], llr_min, llr_max);
+      __m128i s1  = demod_sqqam_sse_cvt(out[j + 1], llr_min, llr_max);
+      __m128i s2  = demod_sqqam_sse_cvt(out[j + 2], llr_min, llr_max);
+      __m128i s3  = demod_sqqam_sse_cvt(out[j + 3], llr_min, llr_max);
+      __m128i s01 = _mm_packs_epi32(s0, s1);
+      __m128i s23 = _mm_packs_epi32(s2, s3);
+      _mm_storeu_si128((__m128i*)llr, _mm_packs_epi16(s01, s23));
+      llr += 16;
+    }
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_SSE && !LV_HAVE_AVX2 && !LV_HAVE_AVX512 */
+
+#if defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512)
+
+/*
+ * Demodulates 4 symbols into nbits_x_dim registers of LLRs in output order. Each 128-bit lane holds two symbols, so
+ * the pairs are first interleaved within the lanes and then the lanes are rearranged.
+ */
+static inline void
+demod_sqqam_avx2(const float* in, __m256 scale, const __m256* thresholds, uint32_t nbits_x_dim, __m256* out)
+{
+  __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 l[DEMOD_SQQAM_MAX_BITS_X_DIM];
+
+  l[0] = _mm256_mul_ps(_mm256_loadu_ps(in), scale);
+  for (uint32_t i = 1; i < nbits_x_dim; i++) {
+    l[i] = _mm256_sub_ps(_mm256_and_ps(l[i - 1], abs_mask), thresholds[i]);
+  }
+
+  __m256d a, b, c, d, e;
+  switch (nbits_x_dim) {
+    case 1:
+      out[0] = l[0];
+      break;
+    case 2:
+      a      = _mm256_unpacklo_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      b      = _mm256_unpackhi_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      out[0] = _mm256_castpd_ps(_mm256_permute2f128_pd(a, b, 0x20));
+      out[1] = _mm256_castpd_ps(_mm256_permute2f128_pd(a, b, 0x31));
+      break;
+    case 3:
+      a      = _mm256_unpacklo_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      b      = _mm256_unpackhi_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      c      = _mm256_unpacklo_pd(_mm256_castps_pd(l[2]), b);
+      d      = _mm256_unpackhi_pd(b, _mm256_castps_pd(l[2]));
+      out[0] = _mm256_castpd_ps(_mm256_permute2f128_pd(a, c, 0x20));
+      out[1] = _mm256_castpd_ps(_mm256_permute2f128_pd(d, a, 0x30));
+      out[2] = _mm256_castpd_ps(_mm256_permute2f128_pd(c, d, 0x31));
+      break;
+    case 4:
+      a      = _mm256_unpacklo_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      b      = _mm256_unpackhi_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      c      = _mm256_unpacklo_pd(_mm256_castps_pd(l[2]), _mm256_castps_pd(l[3]));
+      d      = _mm256_unpackhi_pd(_mm256_castps_pd(l[2]), _mm256_castps_pd(l[3]));
+      out[0] = _mm256_castpd_ps(_mm256_permute2f128_pd(a, c, 0x20));
+      out[1] = _mm256_castpd_ps(_mm256_permute2f128_pd(b, d, 0x20));
+      out[2] = _mm256_castpd_ps(_mm256_permute2f128_pd(a, c, 0x31));
+      out[3] = _mm256_castpd_ps(_mm256_permute2f128_pd(b, d, 0x31));
+      break;
+    case 5:
+      a      = _mm256_unpacklo_pd(_mm256_castps_pd(l[0]), _mm256_castps_pd(l[1]));
+      b      = _mm256_unpacklo_pd(_mm256_castps_pd(l[2]), _mm256_castps_pd(l[3]));
+      c      = _mm256_shuffle_pd(_mm256_castps_pd(l[4]), _mm256_castps_pd(l[0]), 0xa);
+      d      = _mm256_unpackhi_pd(_mm256_castps_pd(l[1]), _mm256_castps_pd(l[2]));
+      e      = _mm256_unpackhi_pd(_mm256_castps_pd(l[3]), _mm256_castps_pd(l[4]));
+      out[0] = _mm256_castpd_ps(_mm256_permute2f128_pd(a, b, 0x20));
+      out[1] = _mm256_castpd_ps(_mm256_permute2f128_pd(c, d, 0x20));
+      out[2] = _mm256_castpd_ps(_mm256_permute2f128_pd(e, a, 0x30));
+      out[3] = _mm256_castpd_ps(_mm256_permute2f128_pd(b, c, 0x31));
+      out[4] = _mm256_castpd_ps(_mm256_permute2f128_pd(d, e, 0x31));
+      break;
+    default:; // Do nothing
+  }
+}
+
+static inline void demod_sqqam_avx2_init(uint32_t nbits_x_dim, float scale, __m256* scale_v, __m256* thresholds)
+{
+  float t[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_thresholds(nbits_x_dim, scale, t);
+  for (uint32_t i = 1; i < nbits_x_dim; i++) {
+    thresholds[i] = _mm256_set1_ps(t[i]);
+  }
+  *scale_v = _mm256_set1_ps(-scale);
+}
+
+/*
+ * Converts to integer after clamping to the LLR range, out of range values would otherwise turn into INT32_MIN
+ */
+static inline __m256i demod_sqqam_avx2_cvt(__m256 x, __m256 llr_min, __m256 llr_max)
+{
+  return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(x, llr_min), llr_max));
+}
+
+static int demod_sqqam_avx2_f(const cf_t* symbols, float* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m256 scale_v, thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_avx2_init(nbits_x_dim, scale, &scale_v, thresholds);
+
+  int i = 0;
+  for (; i < nsymbols - 3; i += 4) {
+    __m256 out[DEMOD_SQQAM_MAX_BITS_X_DIM];
+    demod_sqqam_avx2((const float*)&symbols[i], scale_v, thresholds, nbits_x_dim, out);
+    // A constant trip count keeps the LLRs in registers, otherwise the stores are turned into a memcpy
+    for (uint32_t j = 0; j < DEMOD_SQQAM_MAX_BITS_X_DIM; j++) {
+      if (j < nbits_x_dim) {
+        _mm256_storeu_ps(&llr[8 * j], out[j]);
+      }
+    }
+    llr += 8 * nbits_x_dim;
+  }
+
+  return i;
+}
+
+static int demod_sqqam_avx2_s(const cf_t* symbols, int16_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m256 llr_min = _mm256_set1_ps(INT16_MIN);
+  __m256 llr_max = _mm256_set1_ps(INT16_MAX);
+  __m256 scale_v, thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_avx2_init(nbits_x_dim, scale, &scale_v, thresholds);
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m256 out[2 * DEMOD_SQQAM_MAX_BITS_X_DIM];
+    demod_sqqam_avx2((const float*)&symbols[i], scale_v, thresholds, nbits_x_dim, &out[0]);
+    demod_sqqam_avx2((const float*)&symbols[i + 4], scale_v, thresholds, nbits_x_dim, &out[nbits_x_dim]);
+
+    // Saturate to 16 bit and undo the interleaving of 128-bit lanes
+    for (uint32_t j = 0; j < 2 * nbits_x_dim; j += 2) {
+      __m256i s0 = demod_sqqam_avx2_cvt(out[j], llr_min, llr_max);
+      __m256i s1 = demod_sqqam_avx2_cvt(out[j + 1], llr_min, llr_max);
+      __m256i s  = _mm256_packs_epi32(s0, s1);
+      _mm256_storeu_si256((__m256i*)llr, _mm256_permute4x64_epi64(s, 0xd8));
+      llr += 16;
+    }
+  }
+
+  return i;
+}
+
+static int demod_sqqam_avx2_b(const cf_t* symbols, int8_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m256  llr_min = _mm256_set1_ps(INT8_MIN);
+  __m256  llr_max = _mm256_set1_ps(INT8_MAX);
+  __m256  scale_v, thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  __m256i perm = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  demod_sqqam_avx2_init(nbits_x_dim, scale, &scale_v, thresholds);
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m256 out[4 * DEMOD_SQQAM_MAX_BITS_X_DIM];
+    for (uint32_t j = 0; j < 4; j++) {
+      demod_sqqam_avx2((const float*)&symbols[i + 4 * j], scale_v, thresholds, nbits_x_dim, &out[j * nbits_x_dim]);
+    }
+
+    // Saturate to 8 bit and undo the interleaving of 128-bit lanes
+    for (uint32_t j = 0; j < 4 * nbits_x_dim; j += 4) {
+      __m256i s0  = demod_sqqam_avx2_cvt(out[j], llr_min, llr_max);
+      __m256i s1  = demod_sqqam_avx2_cvt(out[j + 1], llr_min, llr_max);
+      __m256i s2  = demod_sqqam_avx2_cvt(out[j + 2], llr_min, llr_max);
+      __m256i s3  = demod_sqqam_avx2_cvt(out[j + 3], llr_min, llr_max);
+      __m256i s01 = _mm256_packs_epi32(s0, s1);
+      __m256i s23 = _mm256_packs_epi32(s2, s3);
+      _mm256_storeu_si256((__m256i*)llr, _mm256_permutevar8x32_epi32(_mm256_packs_epi16(s01, s23), perm));
+      llr += 32;
+    }
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 && !LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX512
+
+/*
+ * Each output register takes 8 (real, imaginary) pairs from up to 5 level registers. Two-source permutations gather
+ * them from pairs of levels and masked blends merge the results.
+ */
+#define DEMOD_SQQAM_AVX512_MAX_SRC ((DEMOD_SQQAM_MAX_BITS_X_DIM + 1) / 2)
+
+typedef struct {
+  __m512   scale;
+  __m512   thresholds[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  __m512i  idx[DEMOD_SQQAM_MAX_BITS_X_DIM][DEMOD_SQQAM_AVX512_MAX_SRC];
+  __mmask8 mask[DEMOD_SQQAM_MAX_BITS_X_DIM][DEMOD_SQQAM_AVX512_MAX_SRC];
+  uint32_t nof_src;
+} demod_sqqam_avx512_t;
+
+static void demod_sqqam_avx512_init(demod_sqqam_avx512_t* q, uint32_t nbits_x_dim, float scale)
+{
+  float t[DEMOD_SQQAM_MAX_BITS_X_DIM];
+  demod_sqqam_thresholds(nbits_x_dim, scale, t);
+  for (uint32_t i = 1; i < nbits_x_dim; i++) {
+    q->thresholds[i] = _mm512_set1_ps(t[i]);
+  }
+  q->scale   = _mm512_set1_ps(-scale);
+  q->nof_src = (nbits_x_dim + 1) / 2;
+
+  for (uint32_t m = 0; m < nbits_x_dim; m++) {
+    int64_t idx[DEMOD_SQQAM_AVX512_MAX_SRC][8] = {};
+    for (uint32_t s = 0; s < q->nof_src; s++) {
+      q->mask[m][s] = 0;
+    }
+    for (uint32_t j = 0; j < 8; j++) {
+      uint32_t pair     = 8 * m + j;
+      uint32_t level    = pair % nbits_x_dim;
+      idx[level / 2][j] = (int64_t)((level % 2) * 8 + pair / nbits_x_dim);
+      q->mask[m][level / 2] |= (__mmask8)(1U << j);
+    }
+    for (uint32_t s = 0; s < q->nof_src; s++) {
+      q->idx[m][s] = _mm512_loadu_si512(idx[s]);
+    }
+  }
+}
+
+/*
+ * Converts to integer after clamping to the LLR range, out of range values would otherwise turn into INT32_MIN
+ */
+static inline __m512i demod_sqqam_avx512_cvt(__m512 x, __m512 llr_min, __m512 llr_max)
+{
+  return _mm512_cvttps_epi32(_mm512_min_ps(_mm512_max_ps(x, llr_min), llr_max));
+}
+
+/*
+ * Demodulates 8 symbols into nbits_x_dim registers of LLRs in output order.
+ */
+static inline void demod_sqqam_avx512(const demod_sqqam_avx512_t* q, const float* in, uint32_t nbits_x_dim, __m512* out)
+{
+  __m512d l[2 * DEMOD_SQQAM_AVX512_MAX_SRC];
+
+  __m512 x = _mm512_mul_ps(_mm512_loadu_ps(in), q->scale);
+  l[0]     = _mm512_castps_pd(x);
+  for (uint32_t i = 1; i < nbits_x_dim; i++) {
+    x    = _mm512_sub_ps(_mm512_abs_ps(x), q->thresholds[i]);
+    l[i] = _mm512_castps_pd(x);
+  }
+  l[nbits_x_dim] = l[nbits_x_dim - 1];
+
+  for (uint32_t m = 0; m < nbits_x_dim; m++) {
+    __m512d y = _mm512_permutex2var_pd(l[0], q->idx[m][0], l[1]);
+    for (uint32_t s = 1; s < q->nof_src; s++) {
+      y = _mm512_mask_mov_pd(y, q->mask[m][s], _mm512_permutex2var_pd(l[2 * s], q->idx[m][s], l[2 * s + 1]));
+    }
+    out[m] = _mm512_castpd_ps(y);
+  }
+}
+
+static int demod_sqqam_avx512_f(const cf_t* symbols, float* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  demod_sqqam_avx512_t q;
+  demod_sqqam_avx512_init(&q, nbits_x_dim, scale);
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m512 out[DEMOD_SQQAM_MAX_BITS_X_DIM];
+    demod_sqqam_avx512(&q, (const float*)&symbols[i], nbits_x_dim, out);
+    // A constant trip count keeps the LLRs in registers, otherwise the stores are turned into a memcpy
+    for (uint32_t j = 0; j < DEMOD_SQQAM_MAX_BITS_X_DIM; j++) {
+      if (j < nbits_x_dim) {
+        _mm512_storeu_ps(&llr[16 * j], out[j]);
+      }
+    }
+    llr += 16 * nbits_x_dim;
+  }
+
+  return i;
+}
+
+static int demod_sqqam_avx512_s(const cf_t* symbols, int16_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m512               llr_min = _mm512_set1_ps(INT16_MIN);
+  __m512               llr_max = _mm512_set1_ps(INT16_MAX);
+  demod_sqqam_avx512_t q;
+  __m512i              perm = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+  demod_sqqam_avx512_init(&q, nbits_x_dim, scale);
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m512 out[2 * DEMOD_SQQAM_MAX_BITS_X_DIM];
+    demod_sqqam_avx512(&q, (const float*)&symbols[i], nbits_x_dim, &out[0]);
+    demod_sqqam_avx512(&q, (const float*)&symbols[i + 8], nbits_x_dim, &out[nbits_x_dim]);
+
+    // Saturate to 16 bit and undo the interleaving of 128-bit lanes
+    for (uint32_t j = 0; j < 2 * nbits_x_dim; j += 2) {
+      __m512i s0 = demod_sqqam_avx512_cvt(out[j], llr_min, llr_max);
+      __m512i s1 = demod_sqqam_avx512_cvt(out[j + 1], llr_min, llr_max);
+      __m512i s  = _mm512_packs_epi32(s0, s1);
+      _mm512_storeu_si512(llr, _mm512_permutexvar_epi64(perm, s));
+      llr += 32;
+    }
+  }
+
+  return i;
+}
+
+static int demod_sqqam_avx512_b(const cf_t* symbols, int8_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  __m512               llr_min = _mm512_set1_ps(INT8_MIN);
+  __m512               llr_max = _mm512_set1_ps(INT8_MAX);
+  demod_sqqam_avx512_t q;
+  __m512i              perm = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  demod_sqqam_avx512_init(&q, nbits_x_dim, scale);
+
+  int i = 0;
+  for (; i < nsymbols - 31; i += 32) {
+    __m512 out[4 * DEMOD_SQQAM_MAX_BITS_X_DIM];
+    for (uint32_t j = 0; j < 4; j++) {
+      demod_sqqam_avx512(&q, (const float*)&symbols[i + 8 * j], nbits_x_dim, &out[j * nbits_x_dim]);
+    }
+
+    // Saturate to 8 bit and undo the interleaving of 128-bit lanes
+    for (uint32_t j = 0; j < 4 * nbits_x_dim; j += 4) {
+      __m512i s0  = demod_sqqam_avx512_cvt(out[j], llr_min, llr_max);
+      __m512i s1  = demod_sqqam_avx512_cvt(out[j + 1], llr_min, llr_max);
+      __m512i s2  = demod_sqqam_avx512_cvt(out[j + 2], llr_min, llr_max);
+      __m512i s3  = demod_sqqam_avx512_cvt(out[j + 3], llr_min, llr_max);
+      __m512i s01 = _mm512_packs_epi32(s0, s1);
+      __m512i s23 = _mm512_packs_epi32(s2, s3);
+      _mm512_storeu_si512(llr, _mm512_permutexvar_epi32(perm, _mm512_packs_epi16(s01, s23)));
+      llr += 64;
+    }
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
+/*
+ * Square QAM dispatchers: the widest SIMD implementation available demodulates as many symbols as it can and the
+ * generic one takes the remainder. There is no SSE float demodulator, the compiler vectorizes the generic one as well.
+ */
+static void demod_sqqam_lte(const cf_t* symbols, float* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i = demod_sqqam_avx512_f(symbols, llr, nsymbols, nbits_x_dim, scale);
+#else
+#ifdef LV_HAVE_AVX2
+  i = demod_sqqam_avx2_f(symbols, llr, nsymbols, nbits_x_dim, scale);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+  demod_sqqam(&symbols[i], &llr[2 * nbits_x_dim * i], nsymbols - i, nbits_x_dim, scale);
+}
+
+static void demod_sqqam_lte_s(const cf_t* symbols, short* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i = demod_sqqam_avx512_s(symbols, llr, nsymbols, nbits_x_dim, scale);
+#else
+#ifdef LV_HAVE_AVX2
+  i = demod_sqqam_avx2_s(symbols, llr, nsymbols, nbits_x_dim, scale);
+#else
+#ifdef LV_HAVE_SSE
+  i = demod_sqqam_sse_s(symbols, llr, nsymbols, nbits_x_dim, scale);
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+  demod_sqqam_s(&symbols[i], &llr[2 * nbits_x_dim * i], nsymbols - i, nbits_x_dim, scale);
+}
+
+static void demod_sqqam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols, uint32_t nbits_x_dim, float scale)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i = demod_sqqam_avx512_b(symbols, llr, nsymbols, nbits_x_dim, scale);
+#else
+#ifdef LV_HAVE_AVX2
+  i = demod_sqqam_avx2_b(symbols, llr, nsymbols, nbits_x_dim, scale);
+#else
+#ifdef LV_HAVE_SSE
+  i = demod_sqqam_sse_b(symbols, llr, nsymbols, nbits_x_dim, scale);
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+  demod_sqqam_b(&symbols[i], &llr[2 * nbits_x_dim * i], nsymbols - i, nbits_x_dim, scale);
+}
 
 void demod_bpsk_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
@@ -107,6 +694,27 @@ void demod_bpsk_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
+static void demod_bpsk_lte_scaled(const cf_t* symbols, float* llr, int nsymbols, float scale)
+{
+  for (int i = 0; i < nsymbols; i++) {
+    llr[i] = -scale * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2;
+  }
+}
+
+static void demod_bpsk_lte_scaled_s(const cf_t* symbols, short* llr, int nsymbols, float scale)
+{
+  for (int i = 0; i < nsymbols; i++) {
+    llr[i] = demod_sqqam_f2s(-scale * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
+  }
+}
+
+static void demod_bpsk_lte_scaled_b(const cf_t* symbols, int8_t* llr, int nsymbols, float scale)
+{
+  for (int i = 0; i < nsymbols; i++) {
+    llr[i] = demod_sqqam_f2b(-scale * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
+  }
+}
+
 void demod_qpsk_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   srsran_vec_convert_fb((const float*)symbols, -SCALE_BYTE_CONV_QPSK * M_SQRT2, llr, nsymbols * 2);
@@ -779,68 +1387,32 @@ void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
-    float real = -__real__ symbols[i];
-    float imag = -__imag__ symbols[i];
-    *(llr++)   = real;
-    *(llr++)   = imag;
-    real       = fabsf(real) - 8.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = real;
-    *(llr++)   = imag;
-    real       = fabsf(real) - 4.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = real;
-    *(llr++)   = imag;
-    real       = fabsf(real) - 2.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = real;
-    *(llr++)   = imag;
-  }
+  demod_sqqam_lte(symbols, llr, nsymbols, 4, 1.0f);
 }
 
 void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
-    float real = -__real__ symbols[i];
-    float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 8.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 4.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 2.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-  }
+  demod_sqqam_lte_b(symbols, llr, nsymbols, 4, SCALE_BYTE_CONV_QAM256);
 }
 
 void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
-    float real = -__real__ symbols[i];
-    float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-    real       = fabsf(real) - 8.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-    real       = fabsf(real) - 4.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-    real       = fabsf(real) - 2.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-  }
+  demod_sqqam_lte_s(symbols, llr, nsymbols, 4, SCALE_SHORT_CONV_QAM256);
+}
+
+void demod_1024qam_nr(const cf_t* symbols, float* llr, int nsymbols)
+{
+  demod_sqqam_lte(symbols, llr, nsymbols, 5, 1.0f);
+}
+
+void demod_1024qam_nr_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  demod_sqqam_lte_b(symbols, llr, nsymbols, 5, SCALE_BYTE_CONV_QAM1024);
+}
+
+void demod_1024qam_nr_s(const cf_t* symbols, short* llr, int nsymbols)
+{
+  demod_sqqam_lte_s(symbols, llr, nsymbols, 5, SCALE_SHORT_CONV_QAM1024);
 }
 
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
@@ -861,6 +1433,9 @@ int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, f
     case SRSRAN_MOD_256QAM:
       demod_256qam_lte(symbols, llr, nsymbols);
       break;
+    case SRSRAN_MOD_1024QAM:
+      demod_1024qam_nr(symbols, llr, nsymbols);
+      break;
     default:
       ERROR("Invalid modulation %d", modulation);
       return -1;
@@ -886,6 +1461,9 @@ int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_t* symbols,
     case SRSRAN_MOD_256QAM:
       demod_256qam_lte_s(symbols, llr, nsymbols);
       break;
+    case SRSRAN_MOD_1024QAM:
+      demod_1024qam_nr_s(symbols, llr, nsymbols);
+      break;
     default:
       ERROR("Invalid modulation %d", modulation);
       return -1;
@@ -911,6 +1489,126 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
     case SRSRAN_MOD_256QAM:
       demod_256qam_lte_b(symbols, llr, nsymbols);
       break;
+    case SRSRAN_MOD_1024QAM:
+      demod_1024qam_nr_b(symbols, llr, nsymbols);
+      break;
+    default:
+      ERROR("Invalid modulation %d", modulation);
+      return -1;
+  }
+  return 0;
+}
+
+static bool demod_soft_nvar_isvalid(float noise_var)
+{
+  if (!isnormal(noise_var) || noise_var < 0.0f) {
+    ERROR("Invalid noise variance %f", noise_var);
+    return false;
+  }
+  return true;
+}
+
+int srsran_demod_soft_demodulate_nvar(srsran_mod_t modulation,
+                                      const cf_t*  symbols,
+                                      float*       llr,
+                                      int          nsymbols,
+                                      float        noise_var)
+{
+  if (!demod_soft_nvar_isvalid(noise_var)) {
+    return -1;
+  }
+
+  switch (modulation) {
+    case SRSRAN_MOD_BPSK:
+      demod_bpsk_lte_scaled(symbols, llr, nsymbols, 1.0f / noise_var);
+      break;
+    case SRSRAN_MOD_QPSK:
+      demod_sqqam_lte(symbols, llr, nsymbols, 1, M_SQRT2 / noise_var);
+      break;
+    case SRSRAN_MOD_16QAM:
+      demod_sqqam_lte(symbols, llr, nsymbols, 2, 1.0f / noise_var);
+      break;
+    case SRSRAN_MOD_64QAM:
+      demod_sqqam_lte(symbols, llr, nsymbols, 3, 1.0f / noise_var);
+      break;
+    case SRSRAN_MOD_256QAM:
+      demod_sqqam_lte(symbols, llr, nsymbols, 4, 1.0f / noise_var);
+      break;
+    case SRSRAN_MOD_1024QAM:
+      demod_sqqam_lte(symbols, llr, nsymbols, 5, 1.0f / noise_var);
+      break;
+    default:
+      ERROR("Invalid modulation %d", modulation);
+      return -1;
+  }
+  return 0;
+}
+
+int srsran_demod_soft_demodulate_nvar_s(srsran_mod_t modulation,
+                                        const cf_t*  symbols,
+                                        short*       llr,
+                                        int          nsymbols,
+                                        float        noise_var)
+{
+  if (!demod_soft_nvar_isvalid(noise_var)) {
+    return -1;
+  }
+
+  switch (modulation) {
+    case SRSRAN_MOD_BPSK:
+      demod_bpsk_lte_scaled_s(symbols, llr, nsymbols, SCALE_SHORT_CONV_QPSK / noise_var);
+      break;
+    case SRSRAN_MOD_QPSK:
+      demod_sqqam_lte_s(symbols, llr, nsymbols, 1, SCALE_SHORT_CONV_QPSK * M_SQRT2 / noise_var);
+      break;
+    case SRSRAN_MOD_16QAM:
+      demod_sqqam_lte_s(symbols, llr, nsymbols, 2, SCALE_SHORT_CONV_QAM16 / noise_var);
+      break;
+    case SRSRAN_MOD_64QAM:
+      demod_sqqam_lte_s(symbols, llr, nsymbols, 3, SCALE_SHORT_CONV_QAM64 / noise_var);
+      break;
+    case SRSRAN_MOD_256QAM:
+      demod_sqqam_lte_s(symbols, llr, nsymbols, 4, SCALE_SHORT_CONV_QAM256 / noise_var);
+      break;
+    case SRSRAN_MOD_1024QAM:
+      demod_sqqam_lte_s(symbols, llr, nsymbols, 5, SCALE_SHORT_CONV_QAM1024 / noise_var);
+      break;
+    default:
+      ERROR("Invalid modulation %d", modulation);
+      return -1;
+  }
+  return 0;
+}
+
+int srsran_demod_soft_demodulate_nvar_b(srsran_mod_t modulation,
+                                        const cf_t*  symbols,
+                                        int8_t*      llr,
+                                        int          nsymbols,
+                                        float        noise_var)
+{
+  if (!demod_soft_nvar_isvalid(noise_var)) {
+    return -1;
+  }
+
+  switch (modulation) {
+    case SRSRAN_MOD_BPSK:
+      demod_bpsk_lte_scaled_b(symbols, llr, nsymbols, SCALE_BYTE_CONV_QPSK / noise_var);
+      break;
+    case SRSRAN_MOD_QPSK:
+      demod_sqqam_lte_b(symbols, llr, nsymbols, 1, SCALE_BYTE_CONV_QPSK * M_SQRT2 / noise_var);
+      break;
+    case SRSRAN_MOD_16QAM:
+      demod_sqqam_lte_b(symbols, llr, nsymbols, 2, SCALE_BYTE_CONV_QAM16 / noise_var);
+      break;
+    case SRSRAN_MOD_64QAM:
+      demod_sqqam_lte_b(symbols, llr, nsymbols, 3, SCALE_BYTE_CONV_QAM64 / noise_var);
+      break;
+    case SRSRAN_MOD_256QAM:
+      demod_sqqam_lte_b(symbols, llr, nsymbols, 4, SCALE_BYTE_CONV_QAM256 / noise_var);
+      break;
+    case SRSRAN_MOD_1024QAM:
+      demod_sqqam_lte_b(symbols, llr, nsymbols, 5, SCALE_BYTE_CONV_QAM1024 / noise_var);
+      break;
     default:
       ERROR("Invalid modulation %d", modulation);
       return -1;
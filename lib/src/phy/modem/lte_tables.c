@@ -158,16 +158,15 @@ void set_64QAMtable(cf_t* table)
 }
 
 /**
- * Set the 256QAM modulation table */
-void set_256QAMtable(cf_t* table)
+ * Generates a square QAM table of 2^(2 * nbits_x_dim) symbols. Even bits select the imaginary part and odd bits the
+ * real part, the most significant pair selects the quadrant. */
+static void set_sqQAMtable(cf_t* table, uint32_t nbits_x_dim, float norm)
 {
-  // LTE-256QAM constellation:
-  // see [3GPP TS 36.211 version 10.5.0 Release 10, Section 7.1.5]
-  for (uint32_t i = 0; i < 256; i++) {
+  for (uint32_t i = 0; i < (1U << (2 * nbits_x_dim)); i++) {
     float offset = -1;
     float real   = 0;
     float imag   = 0;
-    for (uint32_t j = 0; j < 4; j++) {
+    for (uint32_t j = 0; j < nbits_x_dim; j++) {
       real += offset;
       imag += offset;
       offset *= 2;
@@ -175,7 +174,25 @@ void set_256QAMtable(cf_t* table)
       real *= ((i & (1 << (2 * j + 1)))) ? +1 : -1;
       imag *= ((i & (1 << (2 * j + 0)))) ? +1 : -1;
     }
-    __real__ table[i] = real / sqrtf(170);
-    __imag__ table[i] = imag / sqrtf(170);
+    __real__ table[i] = real / norm;
+    __imag__ table[i] = imag / norm;
   }
 }
+
+/**
+ * Set the 256QAM modulation table */
+void set_256QAMtable(cf_t* table)
+{
+  // LTE-256QAM constellation:
+  // see [3GPP TS 36.211 version 10.5.0 Release 10, Section 7.1.5]
+  set_sqQAMtable(table, 4, sqrtf(170));
+}
+
+/**
+ * Set the 1024QAM modulation table */
+void set_1024QAMtable(cf_t* table)
+{
+  // NR-1024QAM constellation:
+  // see [3GPP TS 38.211 version 17.1.0 Release 17, Section 5.1.7]
+  set_sqQAMtable(table, 5, sqrtf(682));
+}
@@ -131,6 +131,30 @@ static void mod_256qam_bytes(const srsran_modem_table_t* q, const uint8_t* bits,
   }
 }
 
+static void mod_1024qam_bytes(const srsran_modem_table_t* q, const uint8_t* bits, cf_t* symbols, uint32_t nbits)
+{
+  // Every 5 bytes carry 4 symbols
+  for (int i = 0; i < nbits / 40; i++) {
+    uint64_t in40 = 0;
+    for (int j = 0; j < 5; j++) {
+      in40 = (in40 << 8) | bits[5 * i + j];
+    }
+    for (int j = 0; j < 4; j++) {
+      symbols[4 * i + j] = q->symbol_table[(in40 >> (30 - 10 * j)) & 0x3ff];
+    }
+  }
+
+  // Encode the remaining symbols, if any
+  uint32_t offset = 40 * (nbits / 40);
+  for (uint32_t i = offset; i < nbits; i += 10) {
+    uint32_t idx = 0;
+    for (uint32_t j = i; j < i + 10; j++) {
+      idx = (idx << 1) | ((bits[j / 8] >> (7 - j % 8)) & 1);
+    }
+    symbols[i / 10] = q->symbol_table[idx];
+  }
+}
+
 /* Assumes packet bits as input */
 int srsran_mod_modulate_bytes(const srsran_modem_table_t* q, const uint8_t* bits, cf_t* symbols, uint32_t nbits)
 {
@@ -158,8 +182,11 @@ int srsran_mod_modulate_bytes(const srsran_modem_table_t* q, const uint8_t* bits
     case 8:
       mod_256qam_bytes(q, bits, symbols, nbits);
       break;
+    case 10:
+      mod_1024qam_bytes(q, bits, symbols, nbits);
+      break;
     default:
-      ERROR("srsran_mod_modulate_bytes() accepts QPSK/16QAM/64QAM modulations only");
+      ERROR("srsran_mod_modulate_bytes() accepts BPSK/QPSK/16QAM/64QAM/256QAM/1024QAM modulations only");
       return SRSRAN_ERROR;
   }
   return nbits / q->nbits_x_symbol;
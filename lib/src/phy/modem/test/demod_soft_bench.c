@@ -0,0 +1,362 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+/*!
+ * \file demod_soft_bench.c
+ * \brief Throughput benchmark and accuracy test for the soft demodulators.
+ *
+ * Random symbols of every modulation (or only the selected one) go through an AWGN channel and are soft-demodulated
+ * into float, 16-bit and 8-bit LLRs, with and without noise variance scaling. The LLRs are compared against a scalar
+ * reference of the piecewise-linear approximation and the test fails if any of them is off. Then, the throughput of
+ * each demodulator is reported.
+ *
+ * Synopsis: **demod_soft_bench [options]**
+ *
+ * Options:
+ *  - **-m \<number\>** Modulation order: 1, 2, 4, 6, 8 or 10 (Default all).
+ *  - **-n \<number\>** Number of symbols (Default 45864, a 273 PRB NR slot).
+ *  - **-N \<number\>** Noise variance (Default 0.01).
+ *  - **-R \<number\>** Number of repetitions of each benchmark (Default 100).
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/modem/demod_soft.h"
+#include "srsran/phy/modem/mod.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static srsran_mod_t modulation  = SRSRAN_MOD_NITEMS; /*!< \brief Modulation, all of them if SRSRAN_MOD_NITEMS. */
+static int          nof_symbols = 45864;             /*!< \brief Number of symbols. */
+static float        noise_var   = 0.01f;             /*!< \brief Noise variance. */
+static int          nof_reps    = 100;               /*!< \brief Number of repetitions. */
+
+/*!
+ * \brief Maximum deviation of the fixed-point LLRs from the reference. The SSE and NEON demodulators quantize the
+ * symbols before folding them, which adds up to one unit of error per fold. For the same reason, they are not checked
+ * for symbols out of the fixed-point range, where they do not saturate.
+ */
+#define MAX_ERROR_FIXED_POINT 3
+
+/*!
+ * \brief Noise variance and symbol amplitude of the saturation check, which take the LLRs far beyond the fixed-point
+ * range and beyond the range of 32-bit integers.
+ */
+#define SATURATION_NOISE_VAR 1e-8f
+#define SATURATION_AMPLITUDE 1e10f
+
+/*!
+ * \brief Fixed-point scale of each modulation, as defined in demod_soft.c.
+ */
+static const float scale_s[SRSRAN_MOD_NITEMS] = {100, 100, 400, 700, 1000, 1300};
+static const float scale_b[SRSRAN_MOD_NITEMS] = {20, 20, 30, 40, 50, 60};
+
+/*!
+ * \brief Prints test help when wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-mX] [-nX] [-NX] [-RX]\n", prog);
+  printf("\t-m Modulation order (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256, 10: QAM1024) [Default all]\n");
+  printf("\t-n Number of symbols [Default %d]\n", nof_symbols);
+  printf("\t-N Noise variance [Default %.3f]\n", noise_var);
+  printf("\t-R Number of repetitions [Default %d]\n", nof_reps);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "m:n:N:R:")) != -1) {
+    switch (opt) {
+      case 'm':
+        for (modulation = SRSRAN_MOD_BPSK; modulation < SRSRAN_MOD_NITEMS; modulation++) {
+          if (srsran_mod_bits_x_symbol(modulation) == (uint32_t)strtol(optarg, NULL, 10)) {
+            break;
+          }
+        }
+        if (modulation == SRSRAN_MOD_NITEMS) {
+          usage(argv[0]);
+          exit(-1);
+        }
+        break;
+      case 'n':
+        nof_symbols = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'N':
+        noise_var = strtof(optarg, NULL);
+        break;
+      case 'R':
+        nof_reps = (int)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Unscaled float LLR of a bit, used as reference.
+ */
+static float demod_reference(srsran_mod_t mod, cf_t symbol, uint32_t bit)
+{
+  if (mod == SRSRAN_MOD_BPSK) {
+    return -(crealf(symbol) + cimagf(symbol)) * M_SQRT1_2;
+  }
+
+  float y = (bit % 2) ? cimagf(symbol) : crealf(symbol);
+  if (mod == SRSRAN_MOD_QPSK) {
+    return -y * M_SQRT2;
+  }
+
+  uint32_t nbits_x_dim = srsran_mod_bits_x_symbol(mod) / 2;
+  float    norm        = sqrtf((float)(2 * ((1U << (2 * nbits_x_dim)) - 1) / 3));
+  float    llr         = -y;
+  for (uint32_t l = 1; l <= bit / 2; l++) {
+    llr = fabsf(llr) - (float)(1U << (nbits_x_dim - l)) / norm;
+  }
+  return llr;
+}
+
+/*!
+ * \brief Compares the LLRs against the reference, scaled by the given factor and saturated to the LLR type range.
+ * Optionally, symbols and LLRs which exceed the range once scaled are skipped.
+ */
+static int check_llr(srsran_mod_t mod,
+                     const char*  title,
+                     const cf_t*  symbols,
+                     const void*  llr,
+                     int          type_sz,
+                     float        scale,
+                     float        max_error,
+                     bool         skip_saturated)
+{
+  uint32_t qm        = srsran_mod_bits_x_symbol(mod);
+  float    max_value = (type_sz == sizeof(int16_t)) ? INT16_MAX : INT8_MAX;
+  for (int i = 0; i < nof_symbols * (int)qm; i++) {
+    const cf_t symbol   = symbols[i / qm];
+    float      expected = scale * demod_reference(mod, symbol, i % qm);
+    if (skip_saturated && SRSRAN_MAX(fabsf(scale * crealf(symbol)), fabsf(scale * cimagf(symbol))) > max_value) {
+      continue;
+    }
+    if (skip_saturated && fabsf(expected) > max_value) {
+      continue;
+    }
+
+    // Float LLRs are compared with a relative error, fixed-point ones with an absolute error plus the float rounding
+    // of the scaled thresholds. Fixed-point LLRs must saturate to the bound of the allowed interval, so that LLRs far
+    // out of range only pass if they keep their sign.
+    float value = 0.0f;
+    float lower = 0.0f;
+    float upper = 0.0f;
+    if (type_sz == sizeof(float)) {
+      float tolerance = max_error * SRSRAN_MAX(1.0f, fabsf(expected));
+      value           = ((const float*)llr)[i];
+      lower           = expected - tolerance;
+      upper           = expected + tolerance;
+    } else {
+      float tolerance = max_error + 1e-5f * scale;
+      float min_value = -max_value - 1.0f;
+      value           = (type_sz == sizeof(int16_t)) ? ((const int16_t*)llr)[i] : ((const int8_t*)llr)[i];
+      lower           = SRSRAN_MAX(SRSRAN_MIN(expected - tolerance, max_value), min_value);
+      upper           = SRSRAN_MAX(SRSRAN_MIN(expected + tolerance, max_value), min_value);
+    }
+    if (!(value >= lower && value <= upper)) {
+      ERROR("%s %s: LLR %d is %f, expected %f", srsran_mod_string(mod), title, i, value, expected);
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*!
+ * \brief Prints the throughput of a demodulator.
+ */
+static void print_bench(const char* title, double elapsed_time, uint32_t qm)
+{
+  double nof_bits = (double)nof_reps * nof_symbols * qm;
+  printf("  %-8s %8.2f us/call, %8.1f Mbps\n", title, 1e6 * elapsed_time / nof_reps, nof_bits / elapsed_time / 1e6);
+}
+
+/*!
+ * \brief Returns the elapsed time in seconds between t[1] and t[2].
+ */
+static double elapsed_time(struct timeval t[3])
+{
+  get_time_interval(t);
+  return (double)t[0].tv_sec + 1e-6 * (double)t[0].tv_usec;
+}
+
+/*!
+ * \brief Checks and benchmarks all demodulators of a modulation.
+ */
+static int test_modulation(srsran_mod_t    mod,
+                           srsran_random_t random_gen,
+                           cf_t*           symbols,
+                           float*          llr,
+                           int16_t*        llr_s,
+                           int8_t*         llr_b)
+{
+  srsran_modem_table_t table = {};
+  if (srsran_modem_table_lte(&table, mod) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising modem table");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t qm = srsran_mod_bits_x_symbol(mod);
+  for (int i = 0; i < nof_symbols; i++) {
+    symbols[i] = table.symbol_table[srsran_random_uniform_int_dist(random_gen, 0, (int)table.nsymbols - 1)];
+  }
+  srsran_modem_table_free(&table);
+  srsran_ch_awgn_c(symbols, symbols, noise_var, nof_symbols);
+
+  // Accuracy
+  srsran_demod_soft_demodulate(mod, symbols, llr, nof_symbols);
+  srsran_demod_soft_demodulate_s(mod, symbols, llr_s, nof_symbols);
+  srsran_demod_soft_demodulate_b(mod, symbols, llr_b, nof_symbols);
+  if (check_llr(mod, "llr", symbols, llr, sizeof(float), 1.0f, 1e-5f, false) ||
+      check_llr(mod, "llr_s", symbols, llr_s, sizeof(int16_t), scale_s[mod], MAX_ERROR_FIXED_POINT, true) ||
+      check_llr(mod, "llr_b", symbols, llr_b, sizeof(int8_t), scale_b[mod], MAX_ERROR_FIXED_POINT, true)) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_demod_soft_demodulate_nvar(mod, symbols, llr, nof_symbols, noise_var);
+  srsran_demod_soft_demodulate_nvar_s(mod, symbols, llr_s, nof_symbols, noise_var);
+  srsran_demod_soft_demodulate_nvar_b(mod, symbols, llr_b, nof_symbols, noise_var);
+  if (check_llr(mod, "nvar llr", symbols, llr, sizeof(float), 1.0f / noise_var, 1e-5f, false) ||
+      check_llr(mod, "nvar llr_s", symbols, llr_s, sizeof(int16_t), scale_s[mod] / noise_var, 1, false) ||
+      check_llr(mod, "nvar llr_b", symbols, llr_b, sizeof(int8_t), scale_b[mod] / noise_var, 1, false)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Throughput
+  struct timeval t[3];
+  printf("%s, %d symbols:\n", srsran_mod_string(mod), nof_symbols);
+
+  gettimeofday(&t[1], NULL);
+  for (int r = 0; r < nof_reps; r++) {
+    srsran_demod_soft_demodulate(mod, symbols, llr, nof_symbols);
+  }
+  gettimeofday(&t[2], NULL);
+  print_bench("llr", elapsed_time(t), qm);
+
+  gettimeofday(&t[1], NULL);
+  for (int r = 0; r < nof_reps; r++) {
+    srsran_demod_soft_demodulate_s(mod, symbols, llr_s, nof_symbols);
+  }
+  gettimeofday(&t[2], NULL);
+  print_bench("llr_s", elapsed_time(t), qm);
+
+  gettimeofday(&t[1], NULL);
+  for (int r = 0; r < nof_reps; r++) {
+    srsran_demod_soft_demodulate_b(mod, symbols, llr_b, nof_symbols);
+  }
+  gettimeofday(&t[2], NULL);
+  print_bench("llr_b", elapsed_time(t), qm);
+
+  gettimeofday(&t[1], NULL);
+  for (int r = 0; r < nof_reps; r++) {
+    srsran_demod_soft_demodulate_nvar_b(mod, symbols, llr_b, nof_symbols, noise_var);
+  }
+  gettimeofday(&t[2], NULL);
+  print_bench("nvar_b", elapsed_time(t), qm);
+
+  // Saturation, the fixed-point LLRs must keep the sign of the reference
+  float sat_scale_s = scale_s[mod] / SATURATION_NOISE_VAR;
+  float sat_scale_b = scale_b[mod] / SATURATION_NOISE_VAR;
+  srsran_demod_soft_demodulate_nvar_s(mod, symbols, llr_s, nof_symbols, SATURATION_NOISE_VAR);
+  srsran_demod_soft_demodulate_nvar_b(mod, symbols, llr_b, nof_symbols, SATURATION_NOISE_VAR);
+  if (check_llr(mod, "sat nvar llr_s", symbols, llr_s, sizeof(int16_t), sat_scale_s, 1, false) ||
+      check_llr(mod, "sat nvar llr_b", symbols, llr_b, sizeof(int8_t), sat_scale_b, 1, false)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Only the square QAM demodulators saturate without noise variance, see MAX_ERROR_FIXED_POINT
+  if (mod == SRSRAN_MOD_256QAM || mod == SRSRAN_MOD_1024QAM) {
+    srsran_vec_sc_prod_cfc(symbols, SATURATION_AMPLITUDE, symbols, nof_symbols);
+    srsran_demod_soft_demodulate_s(mod, symbols, llr_s, nof_symbols);
+    srsran_demod_soft_demodulate_b(mod, symbols, llr_b, nof_symbols);
+    if (check_llr(mod, "sat llr_s", symbols, llr_s, sizeof(int16_t), scale_s[mod], 1, false) ||
+        check_llr(mod, "sat llr_b", symbols, llr_b, sizeof(int8_t), scale_b[mod], 1, false)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/*!
+ * \brief Main test function.
+ */
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t        max_qm     = srsran_mod_bits_x_symbol(SRSRAN_MOD_1024QAM);
+  srsran_random_t random_gen = srsran_random_init(0);
+  cf_t*           symbols    = srsran_vec_cf_malloc(nof_symbols);
+  float*          llr        = srsran_vec_f_malloc(nof_symbols * max_qm);
+  int16_t*        llr_s      = srsran_vec_i16_malloc(nof_symbols * max_qm);
+  int8_t*         llr_b      = srsran_vec_i8_malloc(nof_symbols * max_qm);
+  if (symbols == NULL || llr == NULL || llr_s == NULL || llr_b == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  for (srsran_mod_t mod = SRSRAN_MOD_BPSK; mod < SRSRAN_MOD_NITEMS; mod++) {
+    if (modulation != SRSRAN_MOD_NITEMS && mod != modulation) {
+      continue;
+    }
+    if (test_modulation(mod, random_gen, symbols, llr, llr_s, llr_b) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  if (symbols) {
+    free(symbols);
+  }
+  if (llr) {
+    free(llr);
+  }
+  if (llr_s) {
+    free(llr_s);
+  }
+  if (llr_b) {
+    free(llr_b);
+  }
+  return ret;
+}
@@ -45,11 +45,12 @@ const static float pdsch_cfg_cell_specific_ratio_table[2][4] = {
     /* One antenna port         */ {1.0f / 1.0f, 4.0f / 5.0f, 3.0f / 5.0f, 2.0f / 5.0f},
     /* Two or more antenna port */ {5.0f / 4.0f, 1.0f / 1.0f, 3.0f / 4.0f, 1.0f / 2.0f}};
 
-const static srsran_mod_t modulations[5] = {SRSRAN_MOD_BPSK,
-                                            SRSRAN_MOD_QPSK,
-                                            SRSRAN_MOD_16QAM,
-                                            SRSRAN_MOD_64QAM,
-                                            SRSRAN_MOD_256QAM};
+const static srsran_mod_t modulations[SRSRAN_MOD_NITEMS] = {SRSRAN_MOD_BPSK,
+                                                            SRSRAN_MOD_QPSK,
+                                                            SRSRAN_MOD_16QAM,
+                                                            SRSRAN_MOD_64QAM,
+                                                            SRSRAN_MOD_256QAM,
+                                                            SRSRAN_MOD_1024QAM};
 
 typedef struct {
   /* Thread identifier: they must set before thread creation */
@@ -714,22 +715,14 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
     }
 
     /* Bit scrambling */
+    uint32_t seed =
+        srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
     if (q->llr_is_8bit) {
-      srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_cache_apply_c(
+          q->sequence_cache, seed, q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
     } else {
-      srsran_sequence_pdsch_apply_s(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_cache_apply_s(
+          q->sequence_cache, seed, q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
     }
 
     if (cfg->csi_enable) {
@@ -995,13 +988,12 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
     }
 
     /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
+    srsran_sequence_cache_apply_packed(
+        q->sequence_cache,
+        srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id),
+        (uint8_t*)q->e[codeword_idx],
+        (uint8_t*)q->e[codeword_idx],
+        cfg->grant.tb[tb_idx].nof_bits);
 
     /* Bit mapping */
     srsran_mod_modulate_bytes(
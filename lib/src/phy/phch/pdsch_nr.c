@@ -337,7 +337,7 @@ static inline int pdsch_nr_encode_codeword(srsran_pdsch_nr_t*         q,
 
   // 7.3.1.1 Scrambling
   uint32_t cinit = pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits, cinit);
+  srsran_sequence_cache_apply_bit(q->sequence_cache, cinit, q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits);
 
   // 7.3.1.2 Modulation
   srsran_mod_modulate(&q->modem_tables[tb->mod], q->b[tb->cw_idx], q->d[tb->cw_idx], tb->nof_bits);
@@ -467,7 +467,8 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
   srsran_vec_neg_bb(llr, llr, tb->nof_bits);
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, tb->nof_bits, pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  srsran_sequence_cache_apply_c(
+      q->sequence_cache, pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx), llr, llr, tb->nof_bits);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
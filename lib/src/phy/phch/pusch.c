@@ -305,12 +305,12 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
     uint32_t nof_ri_ack_bits = (uint32_t)ret;
 
     // Run scrambling
-    srsran_sequence_pusch_apply_pack((uint8_t*)q->q,
-                                     (uint8_t*)q->q,
-                                     cfg->rnti,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb.nof_bits);
+    srsran_sequence_cache_apply_packed(
+        q->sequence_cache,
+        srsran_sequence_pusch_seed(cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id),
+        (uint8_t*)q->q,
+        (uint8_t*)q->q,
+        cfg->grant.tb.nof_bits);
 
     // Correct UCI placeholder/repetition bits
     uint8_t* d = q->q;
@@ -433,18 +433,17 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     }
 
     // Descrambling
+    uint32_t seed = srsran_sequence_pusch_seed(cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
     if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_cache_apply_c(q->sequence_cache, seed, q->q, q->q, cfg->grant.tb.nof_bits);
     } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_cache_apply_s(q->sequence_cache, seed, q->q, q->q, cfg->grant.tb.nof_bits);
     }
 
     // Generate packed sequence for UCI decoder
     uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    srsran_vec_u8_zero(c, cfg->grant.tb.nof_bits);
+    srsran_sequence_cache_apply_bit(q->sequence_cache, seed, c, c, cfg->grant.tb.nof_bits);
 
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
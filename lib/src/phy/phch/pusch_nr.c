@@ -678,7 +678,7 @@ static inline int pusch_nr_encode_codeword(srsran_pusch_nr_t*           q,
 
   // 7.3.1.1 Scrambling
   uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(b, q->b[tb->cw_idx], nof_bits, cinit);
+  srsran_sequence_cache_apply_bit(q->sequence_cache, cinit, b, q->b[tb->cw_idx], nof_bits);
 
   // Special Scrambling condition
   if (cfg->uci.ack.count <= 2) {
@@ -852,7 +852,8 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
   }
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, nof_bits, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  srsran_sequence_cache_apply_c(
+      q->sequence_cache, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx), llr, llr, nof_bits);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -25,6 +25,8 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -200,6 +202,7 @@ clean:
 
 void srsran_sch_free(srsran_sch_t* q)
 {
+  srsran_sch_disable_cb_coworkers(q);
   srsran_rm_turbo_free_tables();
 
   if (q->cb_in) {
@@ -368,109 +371,327 @@ static int encode_tb(srsran_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
-bool decode_tb_cb(srsran_sch_t*           q,
-                  srsran_softbuffer_rx_t* softbuffer,
-                  srsran_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/* Parameters of the code blocks being decoded, shared by all the code block workers */
+typedef struct {
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t*        cb_segm;
+  uint32_t                Qm;
+  uint32_t                rv;
+  uint32_t                nof_e_bits;
+  void*                   e_bits;
+  uint8_t*                data;
+} sch_cb_job_t;
+
+typedef struct {
+  /* Thread identifier: they must set before thread creation */
+  pthread_t     pthread;
+  srsran_sch_t* sch_ptr;
+  uint32_t      worker_idx;
+
+  /* Decoder private to this coworker */
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_tb;
+  srsran_crc_t  crc_cb;
+  uint8_t*      cb_out;
+
+  /* Code blocks to decode: they must be set before posting start semaphore */
+  const sch_cb_job_t* job;
+
+  /* Execution status */
+  uint32_t nof_iterations;
+  bool     rm_error;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool started;
+  bool quit;
+} sch_cb_coworker_t;
+
+/* Decodes one code block with the given decoder and CRC instances. Returns false on rate matching error.
+ * The decoder writes the code block CRC after the code block payload. If cb_out is not NULL, the code block is decoded
+ * in cb_out and only the payload is copied to the TB, so that code blocks can be decoded in any order. */
+static bool decode_cb(srsran_sch_t*       q,
+                      srsran_tdec_t*      decoder,
+                      srsran_crc_t*       crc_cb,
+                      srsran_crc_t*       crc_tb,
+                      uint8_t*            cb_out,
+                      const sch_cb_job_t* job,
+                      uint32_t            cb_idx,
+                      uint32_t*           nof_iterations)
 {
-  int8_t*  e_bits_b = e_bits;
-  int16_t* e_bits_s = e_bits;
+  srsran_softbuffer_rx_t* softbuffer = job->softbuffer;
+  srsran_cbsegm_t*        cb_segm    = job->cb_segm;
+  uint32_t                Qm         = job->Qm;
+  uint8_t*                data       = job->data;
+  int8_t*                 e_bits_b   = job->e_bits;
+  int16_t*                e_bits_s   = job->e_bits;
+
+  /* Do not process blocks with CRC Ok */
+  if (softbuffer->cb_crc[cb_idx] == false) {
+    uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+    uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+
+    uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+    uint32_t Gp    = job->nof_e_bits / Qm;
+    uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+    uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+    uint32_t rp   = cb_idx * n_e;
+    uint32_t n_e2 = n_e;
+
+    if (cb_idx > cb_segm->C - gamma) {
+      n_e2 = n_e + Qm;
+      rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+    }
 
-  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
-    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
-    return false;
-  }
+    if (q->llr_is_8bit) {
+      if (srsran_rm_turbo_rx_lut_8bit(
+              &e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, job->rv)) {
+        ERROR("Error in rate matching");
+        return false;
+      }
+    } else {
+      if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, job->rv)) {
+        ERROR("Error in rate matching");
+        return false;
+      }
+    }
 
-  q->avg_iterations = 0;
+    srsran_tdec_new_cb(decoder, cb_len);
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+    uint8_t* output = cb_out ? cb_out : &data[cb_idx * rlen / 8];
 
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
+    // Run iterations and use CRC for early stopping
+    bool     early_stop = false;
+    uint32_t cb_noi     = 0;
+    do {
+      if (q->llr_is_8bit) {
+        srsran_tdec_iteration_8bit(decoder, (int8_t*)softbuffer->buffer_f[cb_idx], output);
+      } else {
+        srsran_tdec_iteration(decoder, softbuffer->buffer_f[cb_idx], output);
+      }
+      cb_noi++;
 
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
+      uint32_t      len_crc;
+      srsran_crc_t* crc_ptr;
 
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+      if (cb_segm->C > 1) {
+        len_crc = cb_len;
+        crc_ptr = crc_cb;
+      } else {
+        len_crc = cb_segm->tbs + 24;
+        crc_ptr = crc_tb;
       }
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
+      // CRC is OK and ran the minimum number of iterations
+      if (!srsran_crc_checksum_byte(crc_ptr, output, len_crc) &&
+          (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+        softbuffer->cb_crc[cb_idx] = true;
+        early_stop                 = true;
+
+        // CRC is error and exceeded maximum iterations for this CB.
+        // Early stop the whole transport block.
       }
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+    } while (cb_noi < q->max_iterations && !early_stop);
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+    if (cb_out) {
+      memcpy(&data[cb_idx * rlen / 8], cb_out, rlen / 8 * sizeof(uint8_t));
+    }
+    *nof_iterations += cb_noi;
+
+    INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+         cb_idx,
+         rp,
+         n_e2,
+         cb_len,
+         early_stop ? "OK" : "KO",
+         rlen,
+         cb_noi,
+         q->max_iterations);
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+  } else {
+    // Copy decoded data from previous transmissions
+    uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+    uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+    memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+  }
+  return true;
+}
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+/* Decodes code blocks first_cb, first_cb + step, first_cb + 2 * step... Returns false on rate matching error */
+static bool decode_cb_range(srsran_sch_t*       q,
+                            srsran_tdec_t*      decoder,
+                            srsran_crc_t*       crc_cb,
+                            srsran_crc_t*       crc_tb,
+                            uint8_t*            cb_out,
+                            const sch_cb_job_t* job,
+                            uint32_t            first_cb,
+                            uint32_t            step,
+                            uint32_t*           nof_iterations)
+{
+  bool ret = true;
+  for (uint32_t cb_idx = first_cb; cb_idx < job->cb_segm->C && ret; cb_idx += step) {
+    ret = decode_cb(q, decoder, crc_cb, crc_tb, cb_out, job, cb_idx, nof_iterations);
+  }
+  return ret;
+}
 
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+static void* sch_cb_decode_thread(void* arg)
+{
+  sch_cb_coworker_t* h = (sch_cb_coworker_t*)arg;
+
+  sem_wait(&h->start);
+  while (!h->quit) {
+    srsran_sch_t* q   = h->sch_ptr;
+    h->nof_iterations = 0;
+    h->rm_error       = !decode_cb_range(q,
+                                   &h->decoder,
+                                   &h->crc_cb,
+                                   &h->crc_tb,
+                                   h->cb_out,
+                                   h->job,
+                                   h->worker_idx,
+                                   q->nof_cb_coworkers + 1,
+                                   &h->nof_iterations);
+
+    /* Post finish semaphore */
+    sem_post(&h->finish);
+
+    /* Wait for next loop */
+    sem_wait(&h->start);
+  }
+  sem_post(&h->finish);
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+  pthread_exit(NULL);
+  return h;
+}
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+void srsran_sch_disable_cb_coworkers(srsran_sch_t* q)
+{
+  sch_cb_coworker_t* coworkers = (sch_cb_coworker_t*)q->cb_coworkers_ptr;
+  if (coworkers == NULL) {
+    return;
+  }
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+  for (uint32_t i = 0; i < q->nof_cb_coworkers; i++) {
+    sch_cb_coworker_t* h = &coworkers[i];
+    if (h->started) {
+      /* Stop threads */
+      h->quit = true;
+      sem_post(&h->start);
+      pthread_join(h->pthread, NULL);
+      sem_destroy(&h->start);
+      sem_destroy(&h->finish);
+    }
+    srsran_tdec_free(&h->decoder);
+    if (h->cb_out) {
+      free(h->cb_out);
+    }
+  }
 
-    } else {
-      // Copy decoded data from previous transmissions
-      uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+  free(coworkers);
+  q->cb_coworkers_ptr = NULL;
+  q->nof_cb_coworkers = 0;
+}
+
+int srsran_sch_enable_cb_coworkers(srsran_sch_t* q, uint32_t nof_coworkers)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_sch_disable_cb_coworkers(q);
+  if (nof_coworkers == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  sch_cb_coworker_t* coworkers = calloc(nof_coworkers, sizeof(sch_cb_coworker_t));
+  if (coworkers == NULL) {
+    ERROR("Allocating code block coworkers");
+    return SRSRAN_ERROR;
+  }
+  q->cb_coworkers_ptr = coworkers;
+  q->nof_cb_coworkers = nof_coworkers;
+
+  for (uint32_t i = 0; i < nof_coworkers; i++) {
+    sch_cb_coworker_t* h = &coworkers[i];
+    h->sch_ptr           = q;
+    h->worker_idx        = i + 1;
+
+    if (srsran_tdec_init(&h->decoder, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating Turbo Decoder");
+      goto clean;
     }
+    h->cb_out = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+    if (!h->cb_out) {
+      goto clean;
+    }
+    if (srsran_crc_init(&h->crc_tb, SRSRAN_LTE_CRC24A, 24) || srsran_crc_init(&h->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      goto clean;
+    }
+    if (sem_init(&h->start, 0, 0) || sem_init(&h->finish, 0, 0)) {
+      ERROR("Creating semaphores");
+      goto clean;
+    }
+    if (pthread_create(&h->pthread, NULL, sch_cb_decode_thread, (void*)h)) {
+      ERROR("Creating code block coworker thread");
+      goto clean;
+    }
+    h->started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+
+clean:
+  srsran_sch_disable_cb_coworkers(q);
+  return SRSRAN_ERROR;
+}
+
+bool decode_tb_cb(srsran_sch_t*           q,
+                  srsran_softbuffer_rx_t* softbuffer,
+                  srsran_cbsegm_t*        cb_segm,
+                  uint32_t                Qm,
+                  uint32_t                rv,
+                  uint32_t                nof_e_bits,
+                  void*                   e_bits,
+                  uint8_t*                data)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
+
+  sch_cb_job_t job = {softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data};
+
+  // Code blocks are interleaved across the calling thread and the coworkers, if there is more than one
+  sch_cb_coworker_t* coworkers     = (sch_cb_coworker_t*)q->cb_coworkers_ptr;
+  uint32_t           nof_coworkers = SRSRAN_MIN(q->nof_cb_coworkers, cb_segm->C - 1);
+  for (uint32_t i = 0; i < nof_coworkers; i++) {
+    coworkers[i].job = &job;
+    sem_post(&coworkers[i].start);
+  }
+
+  // The encoder input buffer is not in use while decoding, use it as code block output when running in parallel
+  uint8_t* cb_out         = nof_coworkers > 0 ? q->cb_in : NULL;
+  uint32_t nof_iterations = 0;
+  bool     rm_ok =
+      decode_cb_range(q, &q->decoder, &q->crc_cb, &q->crc_tb, cb_out, &job, 0, nof_coworkers + 1, &nof_iterations);
+
+  // Wait for the coworkers before checking the TB CRC
+  for (uint32_t i = 0; i < nof_coworkers; i++) {
+    sem_wait(&coworkers[i].finish);
+    nof_iterations += coworkers[i].nof_iterations;
+    rm_ok = rm_ok && !coworkers[i].rm_error;
+  }
+  q->avg_iterations = (float)nof_iterations;
+
+  if (!rm_ok) {
+    return false;
   }
 
   softbuffer->tb_crc = true;
@@ -544,6 +765,16 @@ static int decode_tb(srsran_sch_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  // Soft-buffers leasing from a pool may not hold the code blocks, or hold them as 8-bit soft bits
+  if (!srsran_softbuffer_rx_is_ready(softbuffer, cb_segm->C)) {
+    ERROR("Error soft buffer does not hold storage for %d CBs", cb_segm->C);
+    return SRSRAN_ERROR;
+  }
+  if (softbuffer->pool != NULL && softbuffer->pool->llr_type == SRSRAN_SOFTBUFFER_LLR_8BIT && !q->llr_is_8bit) {
+    ERROR("Error 8-bit soft buffer cannot be used with 16-bit LLR");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
   // Process Codeblocks
   bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
 
@@ -207,7 +207,7 @@ static inline int sch_nr_init_common(srsran_sch_nr_t* q)
   }
 
   if (!q->temp_cb) {
-    q->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8);
+    q->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8 * SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE);
     if (!q->temp_cb) {
       return SRSRAN_ERROR;
     }
@@ -323,6 +323,7 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     decoder_args.ls                         = ls;
     decoder_args.scaling_fctr               = scaling_factor;
     decoder_args.max_nof_iter               = args->max_nof_iter;
+    decoder_args.max_batch_size             = SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE;
 
     q->decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
     if (!q->decoder_bg1[ls]) {
@@ -551,6 +552,68 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Decodes a batch of rate-dematched code blocks of the same transport block, updates the soft-buffer CRC flags
+ * and packs the code blocks that match the CRC
+ */
+static int sch_nr_decode_cb_batch(srsran_sch_nr_t*               q,
+                                  const srsran_sch_nr_tb_info_t* cfg,
+                                  const srsran_sch_tb_t*         tb,
+                                  srsran_ldpc_decoder_t*         decoder,
+                                  const int8_t* const*           llr,
+                                  const uint32_t*                n_llr,
+                                  const uint32_t*                cb_idx,
+                                  uint32_t                       nof_cbs,
+                                  uint32_t*                      cb_ok,
+                                  uint32_t*                      nof_iter_sum)
+{
+  uint8_t* message[SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE];
+  int      ret[SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE];
+  for (uint32_t i = 0; i < nof_cbs; i++) {
+    message[i] = &q->temp_cb[i * SRSRAN_LDPC_MAX_LEN_CB * 8];
+  }
+
+  // Select CB or TB early stop CRC
+  srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+  if (cfg->L_cb) {
+    crc = &q->crc_cb;
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  if (srsran_ldpc_decoder_decode_batch_c(decoder, llr, message, n_llr, nof_cbs, crc, ret) < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_cbs; i++) {
+    uint32_t r = cb_idx[i];
+
+    // Compute number of iterations
+    uint32_t n_iter_cb = (ret[i] == 0) ? decoder->max_nof_iter : (uint32_t)ret[i];
+    *nof_iter_sum += n_iter_cb;
+
+    // Check if CB is all zeros
+    uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+    tb->softbuffer.rx->cb_crc[r] = (ret[i] != 0);
+    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+
+    // CB Debug trace
+    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+      DEBUG("CB %d/%d:", r, cfg->C);
+      srsran_vec_fprint_hex(stdout, message[i], cb_len);
+    }
+
+    // Pack and count CRC OK only if CRC is match
+    if (tb->softbuffer.rx->cb_crc[r]) {
+      srsran_bit_pack_vector(message[i], tb->softbuffer.rx->data[r], cb_len);
+      (*cb_ok)++;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static int sch_nr_decode(srsran_sch_nr_t*        q,
                          const srsran_sch_cfg_t* sch_cfg,
                          const srsran_sch_tb_t*  tb,
@@ -607,6 +670,12 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t cb_ok = 0;
   res->crc       = false;
 
+  // Code blocks waiting to be decoded together
+  const int8_t* batch_llr[SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE] = {};
+  uint32_t      batch_len[SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE] = {};
+  uint32_t      batch_idx[SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE] = {};
+  uint32_t      batch_count                                   = 0;
+
   // For each code block...
   uint32_t j = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
@@ -654,43 +723,34 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       return SRSRAN_ERROR;
     }
 
-    // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
-      crc = &q->crc_cb;
-    }
+    // Queue CB for decoding
+    batch_llr[batch_count] = rm_buffer;
+    batch_len[batch_count] = (uint32_t)n_llr;
+    batch_idx[batch_count] = r;
+    batch_count++;
 
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
-      return SRSRAN_ERROR;
+    // Decode the queued CBs as soon as the batch is full
+    if (batch_count == SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE) {
+      int ret = sch_nr_decode_cb_batch(
+          q, &cfg, tb, decoder, batch_llr, batch_len, batch_idx, batch_count, &cb_ok, &nof_iter_sum);
+      if (ret < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      batch_count = 0;
     }
 
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
-    nof_iter_sum += n_iter_cb;
-
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
-
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
-    }
+    input_ptr += E;
+  }
 
-    // Pack and count CRC OK only if CRC is match
-    if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
-      cb_ok++;
+  // Decode the remaining queued CBs
+  if (batch_count > 0) {
+    int ret = sch_nr_decode_cb_batch(
+        q, &cfg, tb, decoder, batch_llr, batch_len, batch_idx, batch_count, &cb_ok, &nof_iter_sum);
+    if (ret < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
     }
-
-    input_ptr += E;
   }
+
   // Set average number of iterations
   res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
 
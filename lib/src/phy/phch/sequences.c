@@ -64,6 +64,11 @@ static inline uint32_t sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot,
   return (rnti << 14) + (q << 13) + ((nslot / 2) << 9) + cell_id;
 }
 
+uint32_t srsran_sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id)
+{
+  return sequence_pdsch_seed(rnti, q, nslot, cell_id);
+}
+
 int srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id, uint32_t len)
 {
   return srsran_sequence_LTE_pr(seq, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
@@ -121,6 +126,11 @@ static inline uint32_t sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32
   return (rnti << 14) + ((nslot / 2) << 9) + cell_id;
 }
 
+uint32_t srsran_sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id)
+{
+  return sequence_pusch_seed(rnti, nslot, cell_id);
+}
+
 int srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len)
 {
   return srsran_sequence_LTE_pr(seq, len, sequence_pusch_seed(rnti, nslot, cell_id));
@@ -29,6 +29,7 @@
 #include <srsran/phy/utils/vector.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 
 typedef struct {
@@ -59,6 +60,12 @@ typedef struct {
   // Rx timestamp
   uint64_t next_rx_ts;
 
+  // Real-time pacing of the reception, as if the samples came from a radio
+  bool            rx_realtime;
+  bool            rx_started;
+  struct timespec rx_start_time;
+  uint64_t        rx_start_ts;
+
   pthread_mutex_t tx_config_mutex;
   pthread_mutex_t rx_config_mutex;
   pthread_mutex_t decim_mutex;
@@ -71,6 +78,15 @@ typedef struct {
 
 static void update_rates(rf_file_handler_t* handler, double srate);
 
+static int rf_file_open_internal(void**         h,
+                                 FILE**         rx_files,
+                                 FILE**         tx_files,
+                                 uint32_t       nof_channels,
+                                 uint32_t       base_srate,
+                                 rf_file_opts_t rx_opts,
+                                 rf_file_opts_t tx_opts,
+                                 bool           rx_realtime);
+
 void rf_file_info(char* id, const char* format, ...)
 {
 #if VERBOSE
@@ -96,6 +112,49 @@ void rf_file_error(char* id, const char* format, ...)
   va_end(args);
 }
 
+static bool parse_bool(char* args, const char* config_arg_base, bool* value)
+{
+  char tmp[RF_PARAM_LEN] = {};
+  if (parse_string(args, config_arg_base, -1, tmp) != SRSRAN_SUCCESS) {
+    return false;
+  }
+  *value = (strcmp(tmp, "true") == 0 || strcmp(tmp, "yes") == 0 || strcmp(tmp, "1") == 0);
+  return true;
+}
+
+static int parse_format(char* args, const char* config_arg_base, rf_file_format_t* format)
+{
+  char tmp[RF_PARAM_LEN] = {};
+  if (parse_string(args, config_arg_base, -1, tmp) == SRSRAN_SUCCESS) {
+    if (!strcmp(tmp, "sc16")) {
+      *format = FILERF_TYPE_SC16;
+    } else if (!strcmp(tmp, "fc32")) {
+      *format = FILERF_TYPE_FC32;
+    } else {
+      fprintf(stderr, "[file] Error: Unsupported sample format %s\n", tmp);
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Sleeps until a radio would have received the samples up to rx_ts
+static void wait_realtime(rf_file_handler_t* handler, uint64_t rx_ts)
+{
+  uint64_t nsamples = rx_ts - handler->rx_start_ts;
+
+  struct timespec deadline = handler->rx_start_time;
+  deadline.tv_sec += (time_t)(nsamples / handler->base_srate);
+  deadline.tv_nsec += (long)((nsamples % handler->base_srate) * 1000000000ULL / handler->base_srate);
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+  }
+}
+
 static inline int update_ts(void* h, uint64_t* ts, int nsamples, const char* dir)
 {
   int ret = SRSRAN_ERROR;
@@ -179,21 +238,49 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
   FILE* tx_files[SRSRAN_MAX_CHANNELS] = {NULL};
 
   if (h && nof_channels <= SRSRAN_MAX_CHANNELS) {
-    uint32_t base_srate = FILE_BASERATE_DEFAULT_HZ;
+    uint32_t       base_srate           = FILE_BASERATE_DEFAULT_HZ;
+    rf_file_opts_t rx_opts              = {};
+    rf_file_opts_t tx_opts              = {};
+    bool           rx_interleaved       = false;
+    bool           faster_than_realtime = false;
+    rx_opts.sample_format               = FILERF_TYPE_FC32;
+    tx_opts.sample_format               = FILERF_TYPE_FC32;
 
     // parse args
     if (args && strlen(args)) {
       // base_srate
       parse_uint32(args, "base_srate", -1, &base_srate);
+
+      // rx_format, tx_format
+      if (parse_format(args, "rx_format", &rx_opts.sample_format) != SRSRAN_SUCCESS ||
+          parse_format(args, "tx_format", &tx_opts.sample_format) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+
+      // rx_mmap, rx_interleaved, faster_than_realtime
+      parse_bool(args, "rx_mmap", &rx_opts.use_mmap);
+      parse_bool(args, "rx_interleaved", &rx_interleaved);
+      parse_bool(args, "faster_than_realtime", &faster_than_realtime);
+      if (rx_interleaved && !rx_opts.use_mmap) {
+        fprintf(stderr, "[file] Error: rx_interleaved requires rx_mmap\n");
+        goto clean_exit;
+      }
     } else {
       fprintf(stderr, "[file] Error: RF device args are required for file-based no-RF module\n");
       goto clean_exit;
     }
 
+    char first_rx_file[RF_PARAM_LEN] = {};
     for (int i = 0; i < nof_channels; i++) {
       // rx_file
       char rx_file[RF_PARAM_LEN] = {};
       parse_string(args, "rx_file", i, rx_file);
+      if (i == 0) {
+        memcpy(first_rx_file, rx_file, RF_PARAM_LEN);
+      } else if (rx_interleaved && strlen(rx_file) == 0) {
+        // All channels are read from the same file
+        memcpy(rx_file, first_rx_file, RF_PARAM_LEN);
+      }
 
       // tx_file
       char tx_file[RF_PARAM_LEN] = {};
@@ -218,8 +305,19 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
       }
     }
 
+    if (rx_interleaved) {
+      rx_opts.nof_interleaved = nof_channels;
+    }
+
     // defer further initialization to open_file method
-    ret = rf_file_open_file(h, rx_files, tx_files, nof_channels, base_srate);
+    ret = rf_file_open_internal(h,
+                                rx_files,
+                                tx_files,
+                                nof_channels,
+                                base_srate,
+                                rx_opts,
+                                tx_opts,
+                                rx_opts.use_mmap && !faster_than_realtime);
     if (ret != SRSRAN_SUCCESS) {
       goto clean_exit;
     }
@@ -243,6 +341,22 @@ clean_exit:
 }
 
 int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_channels, uint32_t base_srate)
+{
+  rf_file_opts_t rx_opts = {};
+  rf_file_opts_t tx_opts = {};
+  rx_opts.sample_format  = FILERF_TYPE_FC32;
+  tx_opts.sample_format  = FILERF_TYPE_FC32;
+  return rf_file_open_internal(h, rx_files, tx_files, nof_channels, base_srate, rx_opts, tx_opts, false);
+}
+
+static int rf_file_open_internal(void**         h,
+                                 FILE**         rx_files,
+                                 FILE**         tx_files,
+                                 uint32_t       nof_channels,
+                                 uint32_t       base_srate,
+                                 rf_file_opts_t rx_opts,
+                                 rf_file_opts_t tx_opts,
+                                 bool           rx_realtime)
 {
   int ret = SRSRAN_ERROR;
 
@@ -262,12 +376,11 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
     handler->info.max_tx_gain = FILE_MAX_GAIN_DB;
     handler->info.min_tx_gain = FILE_MIN_GAIN_DB;
     handler->nof_channels     = nof_channels;
+    handler->rx_realtime      = rx_realtime;
     strcpy(handler->id, "file\0");
 
-    rf_file_opts_t rx_opts = {};
-    rf_file_opts_t tx_opts = {};
-    tx_opts.id             = handler->id;
-    rx_opts.id             = handler->id;
+    tx_opts.id = handler->id;
+    rx_opts.id = handler->id;
 
     if (pthread_mutex_init(&handler->tx_config_mutex, NULL)) {
       fprintf(stderr, "Mutex init: %s\n", strerror(errno));
@@ -289,17 +402,13 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
     // id
     // TODO: set some meaningful ID in handler->id
 
-    // rx_format, tx_format
-    // TODO: add other formats
-    rx_opts.sample_format = FILERF_TYPE_FC32;
-    tx_opts.sample_format = FILERF_TYPE_FC32;
-
     update_rates(handler, 1.92e6);
 
     // Create channels
     for (int i = 0; i < handler->nof_channels; i++) {
       if (rx_files != NULL && rx_files[i] != NULL) {
-        rx_opts.file = rx_files[i];
+        rx_opts.file            = rx_files[i];
+        rx_opts.interleaved_idx = (rx_opts.nof_interleaved > 1) ? i : 0;
         if (rf_file_rx_open(&handler->receiver[i], rx_opts) != SRSRAN_SUCCESS) {
           fprintf(stderr, "[file] Error: opening receiver\n");
           goto clean_exit;
@@ -628,6 +737,15 @@ int rf_file_recv_with_time_multi(void*    h,
       }
     }
 
+    // Gain, which shall also incorporate decim_factor
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+    scale = scale / decim_factor;
+
+    // Memory-mapped receivers without decimation write the scaled samples straight into the output buffers
+    bool scaled[SRSRAN_MAX_CHANNELS] = {};
+
     // copy from rx buffer as many samples as requested into provided buffer
     bool    completed                  = false;
     int32_t count[SRSRAN_MAX_CHANNELS] = {};
@@ -641,7 +759,16 @@ int rf_file_recv_with_time_multi(void*    h,
         // Completed condition
         if (count[i] < nsamples_baserate && handler->receiver[i].running) {
           // Keep receiving
-          int32_t n = rf_file_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate - count[i]);
+          int32_t n = 0;
+          if (handler->receiver[i].use_mmap) {
+            scaled[i]  = (decim_factor == 1);
+            cf_t* dst  = scaled[i] ? buffers[i] : ptr;
+            float gain = scaled[i] ? scale : 1.0f;
+            n          = rf_file_rx_baseband_mmap(
+                &handler->receiver[i], dst ? &dst[count[i]] : NULL, nsamples_baserate - count[i], gain);
+          } else {
+            n = rf_file_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate - count[i]);
+          }
           if (n > 0) {
             // No error
             count[i] += n;
@@ -691,17 +818,22 @@ int rf_file_recv_with_time_multi(void*    h,
     }
 
     // Set gain
-    pthread_mutex_lock(&handler->rx_gain_mutex);
-    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
-    pthread_mutex_unlock(&handler->rx_gain_mutex);
-    // scale shall also incorporate decim_factor
-    scale = scale / decim_factor;
     for (uint32_t c = 0; c < handler->nof_channels; c++) {
-      if (buffers[c]) {
+      if (buffers[c] && !scaled[c]) {
         srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
       }
     }
 
+    // Do not deliver the samples before a radio would
+    if (handler->rx_realtime) {
+      if (!handler->rx_started) {
+        clock_gettime(CLOCK_MONOTONIC, &handler->rx_start_time);
+        handler->rx_start_ts = handler->next_rx_ts;
+        handler->rx_started  = true;
+      }
+      wait_realtime(handler, handler->next_rx_ts + nsamples_baserate);
+    }
+
     // update rx time
     update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
   }
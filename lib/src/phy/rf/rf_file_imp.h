@@ -64,14 +64,22 @@ SRSRAN_API void rf_file_register_error_handler(void* h, srsran_rf_error_handler_
 SRSRAN_API int rf_file_open(char* args, void** h);
 
 /**
- * @brief This function is not supported for file-based RF abstraction
+ * @brief Opens the file-based RF abstraction, taking the files and options from the device arguments
  *
- * Use @c rf_file_open_file() to open this device
+ * Supported arguments:
+ * - rx_file[N], tx_file[N]: files read/written by channel N
+ * - base_srate: sample rate of the files
+ * - rx_format, tx_format: sample format of the files, "fc32" (default) or "sc16"
+ * - rx_mmap: if true, rx files are memory-mapped and samples are converted straight from the mapping into the
+ *   receive buffers. Reception is paced to base_srate, as with a radio, unless faster_than_realtime is true
+ * - rx_interleaved: if true, all channels are read from rx_file, which holds one sample of each channel in turn.
+ *   Requires rx_mmap
+ * - faster_than_realtime: if true, a memory-mapped capture is delivered as fast as it is consumed
  *
- * @param args not used
- * @param h not used
- * @param nof_channels not used
- * @return SRSRAN_ERROR_INVALID_COMMAND
+ * @param args device arguments
+ * @param h resulting object handle
+ * @param nof_channels number of channels per direction
+ * @return SRSRAN_SUCCESS on success, otherwise error code
  */
 SRSRAN_API int rf_file_open_multi(char* args, void** h, uint32_t nof_channels);
 
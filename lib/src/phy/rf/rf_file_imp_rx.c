@@ -20,9 +20,46 @@
  */
 
 #include "rf_file_imp_trx.h"
+#include <errno.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint32_t rf_file_rx_sample_size(const rf_file_rx_t* q)
+{
+  return (q->sample_format == FILERF_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+}
+
+static int rf_file_rx_map(rf_file_rx_t* q)
+{
+  struct stat st = {};
+  if (fstat(fileno(q->file), &st) < 0) {
+    fprintf(stderr, "Error: getting rx file size: %s\n", strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  q->map_size     = (size_t)st.st_size;
+  q->map_nsamples = q->map_size / ((uint64_t)rf_file_rx_sample_size(q) * q->nof_interleaved);
+  if (q->map_size == 0) {
+    // Nothing to map, the first read returns EOF
+    return SRSRAN_SUCCESS;
+  }
+
+  void* map = mmap(NULL, q->map_size, PROT_READ, MAP_PRIVATE, fileno(q->file), 0);
+  if (map == MAP_FAILED) {
+    fprintf(stderr, "Error: mapping rx file: %s\n", strerror(errno));
+    return SRSRAN_ERROR;
+  }
+  q->map = (uint8_t*)map;
+
+  // The file is read once, from start to end
+  madvise(q->map, q->map_size, MADV_SEQUENTIAL);
+
+  return SRSRAN_SUCCESS;
+}
 
 int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
 {
@@ -43,6 +80,22 @@ int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
     q->sample_format = opts.sample_format;
     q->frequency_mhz = opts.frequency_mhz;
 
+    // Memory-mapped mode does not need intermediate buffers
+    if (opts.use_mmap) {
+      q->use_mmap        = true;
+      q->nof_interleaved = SRSRAN_MAX(opts.nof_interleaved, 1);
+      q->interleaved_idx = opts.interleaved_idx;
+      if (q->interleaved_idx >= q->nof_interleaved) {
+        fprintf(stderr, "Error: invalid interleaved channel index %d\n", q->interleaved_idx);
+        goto clean_exit;
+      }
+      if (rf_file_rx_map(q) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+      q->running = true;
+      return SRSRAN_SUCCESS;
+    }
+
     q->temp_buffer = srsran_vec_malloc(FILE_MAX_BUFFER_SIZE);
     if (!q->temp_buffer) {
       fprintf(stderr, "Error: allocating rx buffer\n");
@@ -71,16 +124,66 @@ clean_exit:
 
 int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  uint32_t sample_sz = sizeof(cf_t);
+  uint32_t sample_sz = rf_file_rx_sample_size(q);
+  void*    buf       = (q->sample_format == FILERF_TYPE_SC16) ? q->temp_buffer_convert : buffer;
 
-  int ret = fread(buffer, sample_sz, nsamples, q->file);
+  int ret = fread(buf, sample_sz, nsamples, q->file);
   if (ret > 0) {
+    if (q->sample_format == FILERF_TYPE_SC16) {
+      srsran_vec_convert_if((int16_t*)q->temp_buffer_convert, INT16_MAX, (float*)buffer, 2 * ret);
+    }
     return ret;
   } else {
     return SRSRAN_ERROR_RX_EOF;
   }
 }
 
+int rf_file_rx_baseband_mmap(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples, float scale)
+{
+  if (q->map_pos >= q->map_nsamples) {
+    return SRSRAN_ERROR_RX_EOF;
+  }
+  nsamples = (uint32_t)SRSRAN_MIN((uint64_t)nsamples, q->map_nsamples - q->map_pos);
+
+  // Index of the first sample in the file, counting the samples of all interleaved channels
+  uint64_t first = q->map_pos * q->nof_interleaved + q->interleaved_idx;
+  if (buffer != NULL) {
+    if (q->sample_format == FILERF_TYPE_SC16) {
+      const int16_t* src = (const int16_t*)q->map + 2 * first;
+      if (q->nof_interleaved == 1) {
+        srsran_vec_convert_if(src, INT16_MAX / scale, (float*)buffer, 2 * nsamples);
+      } else {
+        float gain = scale / INT16_MAX;
+        for (uint32_t i = 0; i < nsamples; i++, src += 2 * q->nof_interleaved) {
+          __real__ buffer[i] = src[0] * gain;
+          __imag__ buffer[i] = src[1] * gain;
+        }
+      }
+    } else {
+      const cf_t* src = (const cf_t*)q->map + first;
+      if (q->nof_interleaved == 1) {
+        srsran_vec_sc_prod_cfc(src, scale, buffer, nsamples);
+      } else {
+        for (uint32_t i = 0; i < nsamples; i++, src += q->nof_interleaved) {
+          buffer[i] = *src * scale;
+        }
+      }
+    }
+  }
+  q->map_pos += nsamples;
+
+  // Release the pages already consumed, so that long captures do not keep growing the resident memory
+  size_t consumed = (size_t)(q->map_pos * q->nof_interleaved * rf_file_rx_sample_size(q));
+  if (consumed - q->map_released >= FILE_MMAP_RELEASE_BYTES) {
+    size_t page_sz = (size_t)sysconf(_SC_PAGESIZE);
+    size_t release = (consumed / page_sz) * page_sz;
+    madvise(q->map + q->map_released, release - q->map_released, MADV_DONTNEED);
+    q->map_released = release;
+  }
+
+  return (int)nsamples;
+}
+
 bool rf_file_rx_match_freq(rf_file_rx_t* q, uint32_t freq_hz)
 {
   bool ret = false;
@@ -103,5 +206,10 @@ void rf_file_rx_close(rf_file_rx_t* q)
     free(q->temp_buffer_convert);
   }
 
+  if (q->map) {
+    munmap(q->map, q->map_size);
+    q->map = NULL;
+  }
+
   // not touching q->file as we don't know if we need to close it ourselves
 }
@@ -39,6 +39,7 @@
 #define FILE_ID_STRLEN 16
 #define FILE_MAX_GAIN_DB (30.0f)
 #define FILE_MIN_GAIN_DB (0.0f)
+#define FILE_MMAP_RELEASE_BYTES (64 * 1024 * 1024) // consumed bytes of a mapped rx file before releasing its pages
 
 typedef enum { FILERF_TYPE_FC32 = 0, FILERF_TYPE_SC16 } rf_file_format_t;
 
@@ -66,6 +67,16 @@ typedef struct {
   cf_t*            temp_buffer;
   void*            temp_buffer_convert;
   uint32_t         frequency_mhz;
+
+  // Memory-mapped mode: samples are read straight from the file mapping (no fread, no intermediate buffers)
+  bool     use_mmap;
+  uint8_t* map;
+  size_t   map_size;
+  uint64_t map_nsamples;    // number of samples of this channel in the file
+  uint64_t map_pos;         // next sample of this channel to read
+  size_t   map_released;    // bytes at the start of the mapping whose pages were already released
+  uint32_t nof_interleaved; // number of channels interleaved sample by sample in the file
+  uint32_t interleaved_idx; // position of this channel in an interleaved sample
 } rf_file_rx_t;
 
 typedef struct {
@@ -73,6 +84,9 @@ typedef struct {
   rf_file_format_t sample_format;
   FILE*            file;
   uint32_t         frequency_mhz;
+  bool             use_mmap;
+  uint32_t         nof_interleaved;
+  uint32_t         interleaved_idx;
 } rf_file_opts_t;
 
 /*
@@ -108,6 +122,13 @@ SRSRAN_API int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts);
 
 SRSRAN_API int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples);
 
+/**
+ * Reads up to nsamples from a memory-mapped receiver, converting and scaling them directly from the file mapping into
+ * buffer. If buffer is NULL, the samples are skipped.
+ * @return number of samples read, or SRSRAN_ERROR_RX_EOF at the end of the file
+ */
+SRSRAN_API int rf_file_rx_baseband_mmap(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples, float scale);
+
 SRSRAN_API bool rf_file_rx_match_freq(rf_file_rx_t* q, uint32_t freq_hz);
 
 SRSRAN_API void rf_file_rx_close(rf_file_rx_t* q);
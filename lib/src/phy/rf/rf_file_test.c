@@ -28,10 +28,12 @@
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
+#include <time.h>
 
 #define PRINT_SAMPLES 0
 #define COMPARE_BITS 0
 #define COMPARE_EPSILON (1e-6f)
+#define COMPARE_EPSILON_SC16 (1e-4f)
 #define NOF_RX_ANT 4
 #define NUM_SF (500)
 #define SF_LEN (1920)
@@ -149,7 +151,7 @@ void enb_tx_function(const char* tx_args, bool timed_tx)
   srsran_rf_close(&enb_radio);
 }
 
-int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx, float epsilon)
 {
   int ret = SRSRAN_ERROR;
 
@@ -200,7 +202,7 @@ int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
                          &ue_rx_buffer[c][sf_offet + i * SF_LEN],
                          SF_LEN);
       uint32_t max_ix = srsran_vec_max_abs_ci(&ue_rx_buffer[c][sf_offet + i * SF_LEN], SF_LEN);
-      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > COMPARE_EPSILON) {
+      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > epsilon) {
         fprintf(stderr, "data mismatch in subframe %d\n", i);
         goto exit;
       }
@@ -231,6 +233,74 @@ int param_test(const char* args_param, const int num_channels)
   return SRSRAN_SUCCESS;
 }
 
+// Reads a file holding the 4 channels interleaved sample by sample, as written by some capture tools
+int interleaved_test(void)
+{
+  // write interleaved sc16 file
+  FILE* f = fopen("rx_file_interleaved", "wb");
+  for (int i = 0; i < RF_BUFFER_SIZE; i++) {
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      enb_tx_buffer[c][i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+      int16_t iq[2]       = {(int16_t)(crealf(enb_tx_buffer[c][i]) * INT16_MAX),
+                             (int16_t)(cimagf(enb_tx_buffer[c][i]) * INT16_MAX)};
+      fwrite(iq, sizeof(int16_t), 2, f);
+    }
+  }
+  fclose(f);
+
+  ue_rx_thread_function((void*)"rx_file=rx_file_interleaved,rx_interleaved=true,rx_mmap=true,rx_format=sc16,"
+                        "faster_than_realtime=true,base_srate=1.92e6");
+
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    srsran_vec_sub_ccc(ue_rx_buffer[c], enb_tx_buffer[c], ue_rx_buffer[c], RF_BUFFER_SIZE);
+    uint32_t max_ix = srsran_vec_max_abs_ci(ue_rx_buffer[c], RF_BUFFER_SIZE);
+    if (cabsf(ue_rx_buffer[c][max_ix]) > COMPARE_EPSILON_SC16) {
+      fprintf(stderr, "data mismatch in channel %d, sample %d\n", c, max_ix);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  remove("rx_file_interleaved");
+  return SRSRAN_SUCCESS;
+}
+
+// A memory-mapped capture is not delivered faster than real-time, unless requested
+int realtime_test(void)
+{
+  const uint32_t nof_sf = 50;
+  FILE*          f      = fopen("rx_file_realtime", "wb");
+  srsran_vec_zero(ue_rx_buffer[0], SF_LEN * nof_sf);
+  fwrite(ue_rx_buffer[0], sizeof(cf_t), SF_LEN * nof_sf, f);
+  fclose(f);
+
+  char rf_args[RF_PARAM_LEN] = "rx_file=rx_file_realtime,rx_mmap=true,base_srate=1.92e6";
+  if (srsran_rf_open_devname(&ue_radio, "file", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (uint32_t i = 0; i < nof_sf; ++i) {
+    void* data_ptr[SRSRAN_MAX_PORTS] = {ue_rx_buffer[0]};
+    if (srsran_rf_recv_with_time_multi(&ue_radio, data_ptr, SF_LEN, true, NULL, NULL) != SF_LEN) {
+      fprintf(stderr, "Error receiving\n");
+      return SRSRAN_ERROR;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  srsran_rf_close(&ue_radio);
+  remove("rx_file_realtime");
+
+  double elapsed_ms = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+  printf("received %d ms of samples in %.1f ms\n", nof_sf, elapsed_ms);
+  if (elapsed_ms < nof_sf - 1) {
+    fprintf(stderr, "Samples were delivered faster than real-time\n");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 void create_file(const char* filename)
 {
   FILE* f = fopen(filename, "w");
@@ -290,7 +360,8 @@ int main()
 
 #if NOF_RX_ANT == 1
   // single tx, single rx with continuous transmissions (no decimation, no timed tx)
-  if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false) != SRSRAN_SUCCESS) {
+  if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false, COMPARE_EPSILON) !=
+      SRSRAN_SUCCESS) {
     fprintf(stderr, "Single tx, single rx test failed (no decimation, no timed tx)!\n");
     return -1;
   }
@@ -299,7 +370,8 @@ int main()
   // up to 4 trx radios with continous tx (no decimation, no timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed (no decimation, no timed tx)!\n");
     return -1;
   }
@@ -307,7 +379,8 @@ int main()
   // up to 4 trx radios with continous tx (with decimation, no timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed (with decimation, no timed tx)!\n");
     return -1;
   }
@@ -315,11 +388,59 @@ int main()
   // up to 4 trx radios with continous tx (with decimation, timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
-               true) != SRSRAN_SUCCESS) {
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Two TRx radio test failed (with decimation, timed tx)!\n");
     return -1;
   }
 
+  // up to 4 trx radios, memory-mapped rx (no decimation, no timed tx)
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6,"
+               "rx_mmap=true,faster_than_realtime=true",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6",
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (memory-mapped, no decimation, no timed tx)!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios, memory-mapped rx (with decimation, timed tx)
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,rx_mmap=true,"
+               "faster_than_realtime=true",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (memory-mapped, with decimation, timed tx)!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios, sc16 files, read with fread and memory-mapped
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,rx_format=sc16",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,tx_format=sc16",
+               false,
+               COMPARE_EPSILON_SC16) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (sc16)!\n");
+    return -1;
+  }
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,rx_format=sc16,base_srate=1.92e6,"
+               "rx_mmap=true,faster_than_realtime=true",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,tx_format=sc16,base_srate=1.92e6",
+               false,
+               COMPARE_EPSILON_SC16) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (sc16, memory-mapped)!\n");
+    return -1;
+  }
+
+  if (interleaved_test() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Interleaved rx file test failed!\n");
+    return -1;
+  }
+
+  if (realtime_test() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Real-time rx test failed!\n");
+    return -1;
+  }
+
   // clean workspace
   remove_file("rx_file0");
   remove_file("rx_file1");
@@ -0,0 +1,297 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <inttypes.h>
+#include "srsran/phy/rf/rf.h"
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Reserves a reader slot in the ring, reusing the slot of a process that died without releasing it */
+static int rf_shm_rx_claim_slot(rf_shm_rx_t* q, rf_shm_ring_t* ring, uint32_t* slot_idx)
+{
+  int32_t pid = (int32_t)getpid();
+
+  for (uint32_t pass = 0; pass < 2; pass++) {
+    for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+      rf_shm_reader_slot_t* slot = &ring->hdr->readers[i];
+      int32_t               cur  = __atomic_load_n(&slot->pid, __ATOMIC_ACQUIRE);
+
+      // First pass only takes free slots, the second one also takes over stale ones
+      if (cur != 0 && (pass == 0 || rf_shm_pid_is_alive(cur))) {
+        continue;
+      }
+      if (__atomic_compare_exchange_n(&slot->pid, &cur, pid, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&slot->active, 0, __ATOMIC_RELEASE);
+        *slot_idx = i;
+        return SRSRAN_SUCCESS;
+      }
+    }
+  }
+
+  rf_shm_error(q->id, "Error: %s has no free reader slots (max. %d)\n", ring->name, SHM_MAX_READERS);
+  return SRSRAN_ERROR;
+}
+
+/* Copies nsamples from one ring at the current Rx timestamp, missing or overwritten samples are returned as zeros */
+static int rf_shm_rx_read_ring(rf_shm_rx_t* q, uint32_t ring_idx, cf_t* buffer, uint32_t nsamples, float scale)
+{
+  rf_shm_ring_t*        ring      = &q->rings[ring_idx];
+  rf_shm_reader_slot_t* slot      = &ring->hdr->readers[q->slots[ring_idx]];
+  uint64_t              capacity  = (uint64_t)ring->mask + 1;
+  uint32_t              max_chunk = (uint32_t)(capacity / 2);
+  uint64_t              read_ts   = q->nsamples;
+
+  for (uint32_t count = 0; count < nsamples;) {
+    uint32_t n = SRSRAN_MIN(nsamples - count, max_chunk);
+
+    // The transmitter stops waiting for readers that are too slow, resume from where we are
+    if (!__atomic_load_n(&slot->active, __ATOMIC_ACQUIRE)) {
+      __atomic_store_n(&slot->read_ts, read_ts, __ATOMIC_RELEASE);
+      __atomic_store_n(&slot->active, 1, __ATOMIC_RELEASE);
+    }
+
+    // Wait for the transmitter, if there is any, to reach the end of this chunk
+    uint64_t write_ts = rf_shm_ring_get_write_ts(ring);
+    uint64_t t0       = 0;
+    uint32_t nof_try  = 0;
+    while (write_ts < read_ts + n && write_ts != q->stalled_ts[ring_idx] && rf_shm_ring_has_writer(ring)) {
+      if (t0 == 0) {
+        t0 = rf_shm_now_ms();
+      } else if (rf_shm_now_ms() - t0 > q->trx_timeout_ms) {
+        if (q->log_trx_timeout) {
+          fprintf(stderr, "Error: timeout receiving samples from %s after %dms\n", ring->name, q->trx_timeout_ms);
+        }
+
+        // Forget a transmitter that died without releasing the ring
+        int32_t pid = __atomic_load_n(&ring->hdr->writer_pid, __ATOMIC_ACQUIRE);
+        if (pid != 0 && !rf_shm_pid_is_alive(pid)) {
+          __atomic_compare_exchange_n(&ring->hdr->writer_pid, &pid, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        }
+
+        if (q->fail_on_disconnect) {
+          return SRSRAN_ERROR_TIMEOUT;
+        }
+        q->stalled_ts[ring_idx] = write_ts;
+        break;
+      }
+      rf_shm_backoff(&nof_try);
+      write_ts = rf_shm_ring_get_write_ts(ring);
+    }
+
+    // Copy what is available in up to two segments, the rest of the chunk is silence
+    uint32_t avail = (write_ts > read_ts) ? (uint32_t)SRSRAN_MIN(write_ts - read_ts, n) : 0;
+    uint32_t idx   = (uint32_t)(read_ts & ring->mask);
+    for (uint32_t done = 0; done < avail;) {
+      uint32_t    len = SRSRAN_MIN(avail - done, ring->mask + 1 - idx);
+      const cf_t* src = &ring->samples[idx];
+      if (scale == 1.0f) {
+        srsran_vec_cf_copy(&buffer[count + done], src, len);
+      } else {
+        srsran_vec_sc_prod_cfc(src, scale, &buffer[count + done], len);
+      }
+      done += len;
+      idx = 0;
+    }
+    if (avail < n) {
+      srsran_vec_cf_zero(&buffer[count + avail], n - avail);
+    }
+
+    // Samples the transmitter overwrote while they were being copied are lost
+    write_ts = rf_shm_ring_get_write_ts(ring);
+    if (write_ts > capacity && write_ts - capacity > read_ts) {
+      uint32_t lost = (uint32_t)SRSRAN_MIN(write_ts - capacity - read_ts, avail);
+      srsran_vec_cf_zero(&buffer[count], lost);
+      rf_shm_info(q->id, " - Overrun of %d samples in %s\n", lost, ring->name);
+    }
+
+    read_ts += n;
+    count += n;
+    __atomic_store_n(&slot->read_ts, read_ts, __ATOMIC_RELEASE);
+  }
+
+  return (int)nsamples;
+}
+
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* port)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    bzero(q, sizeof(rf_shm_rx_t));
+
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    q->frequency_mhz      = opts.frequency_mhz;
+    q->fail_on_disconnect = opts.fail_on_disconnect;
+    q->trx_timeout_ms     = opts.trx_timeout_ms;
+    q->log_trx_timeout    = opts.log_trx_timeout;
+    for (uint32_t i = 0; i < SHM_MAX_SOURCES; i++) {
+      q->stalled_ts[i] = UINT64_MAX;
+    }
+
+    // Open every ring listed in the port, their samples are summed
+    char  ports[RF_PARAM_LEN] = {};
+    char* saveptr             = NULL;
+    strncpy(ports, port, RF_PARAM_LEN - 1);
+    for (char* name = strtok_r(ports, "+", &saveptr); name != NULL; name = strtok_r(NULL, "+", &saveptr)) {
+      if (q->nof_rings == SHM_MAX_SOURCES) {
+        rf_shm_error(q->id, "Error: a receiver can sum up to %d rings\n", SHM_MAX_SOURCES);
+        goto clean_exit;
+      }
+
+      rf_shm_ring_t* ring = &q->rings[q->nof_rings];
+      if (rf_shm_ring_open(ring, name, &opts) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+      if (rf_shm_rx_claim_slot(q, ring, &q->slots[q->nof_rings]) != SRSRAN_SUCCESS) {
+        rf_shm_ring_close(ring);
+        goto clean_exit;
+      }
+      q->nof_rings++;
+
+      rf_shm_info(q->id, "Receiving from %s\n", ring->name);
+    }
+
+    if (q->nof_rings == 0) {
+      rf_shm_error(q->id, "Error: invalid rx port '%s'\n", port);
+      goto clean_exit;
+    }
+
+    if (q->nof_rings > 1) {
+      q->temp_buffer = srsran_vec_malloc(SHM_MAX_BUFFER_SIZE);
+      if (!q->temp_buffer) {
+        fprintf(stderr, "Error: allocating rx buffer\n");
+        goto clean_exit;
+      }
+    }
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (ret != SRSRAN_SUCCESS && q) {
+    rf_shm_rx_close(q);
+  }
+  return ret;
+}
+
+int rf_shm_rx_start(rf_shm_rx_t* q, uint64_t ts)
+{
+  q->nsamples = ts;
+
+  // Publish the read position before the transmitters start taking it into account
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    rf_shm_reader_slot_t* slot = &q->rings[i].hdr->readers[q->slots[i]];
+    __atomic_store_n(&slot->read_ts, ts, __ATOMIC_RELEASE);
+    __atomic_store_n(&slot->active, 1, __ATOMIC_RELEASE);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples, float scale)
+{
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    cf_t* dst = (i == 0) ? buffer : q->temp_buffer;
+
+    int n = rf_shm_rx_read_ring(q, i, dst, nsamples, scale);
+    if (n < SRSRAN_SUCCESS) {
+      return n;
+    }
+
+    if (i > 0) {
+      srsran_vec_sum_ccc(buffer, q->temp_buffer, buffer, nsamples);
+    }
+  }
+
+  q->nsamples += nsamples;
+
+  return (int)nsamples;
+}
+
+bool rf_shm_rx_has_writer(rf_shm_rx_t* q)
+{
+  bool ret = false;
+  if (q && q->running) {
+    for (uint32_t i = 0; i < q->nof_rings; i++) {
+      ret |= rf_shm_ring_has_writer(&q->rings[i]) && rf_shm_ring_get_write_ts(&q->rings[i]) != q->stalled_ts[i];
+    }
+  }
+  return ret;
+}
+
+uint64_t rf_shm_rx_get_write_ts(rf_shm_rx_t* q)
+{
+  uint64_t ret = 0;
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    ret = SRSRAN_MAX(ret, rf_shm_ring_get_write_ts(&q->rings[i]));
+  }
+  return ret;
+}
+
+bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  rf_shm_info(q->id, "Closing ...\n");
+
+  q->running = false;
+
+  // Release the reader slots so the transmitters stop waiting for us
+  int32_t pid = (int32_t)getpid();
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    if (q->rings[i].hdr) {
+      rf_shm_reader_slot_t* slot = &q->rings[i].hdr->readers[q->slots[i]];
+      int32_t               cur  = pid;
+      __atomic_store_n(&slot->active, 0, __ATOMIC_RELEASE);
+      __atomic_compare_exchange_n(&slot->pid, &cur, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    }
+    rf_shm_ring_close(&q->rings[i]);
+  }
+  q->nof_rings = 0;
+
+  if (q->temp_buffer) {
+    free(q->temp_buffer);
+    q->temp_buffer = NULL;
+  }
+}
+
+bool rf_shm_rx_is_running(rf_shm_rx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return q->running;
+}
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Definitions */
+#define VERBOSE (0)
+#define NSAMPLES2NBYTES(X) (((uint32_t)(X)) * sizeof(cf_t))
+#define NBYTES2NSAMPLES(X) ((X) / sizeof(cf_t))
+#define SHM_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_RING_SIZE_DEFAULT (1U << 21) // ring capacity in samples, ~91 ms at the default base rate
+#define SHM_ID_STRLEN 16
+#define SHM_NAME_STRLEN 64
+#define SHM_NAME_PREFIX "/srsran_"
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+#define SHM_MAX_READERS 16 // processes that can receive from the same ring (e.g. UEs listening to one eNB)
+#define SHM_MAX_SOURCES 8  // rings that can be summed into a single receive channel (e.g. UEs sending to one eNB)
+#define SHM_MAGIC (0x5352534dU)
+#define SHM_VERSION (1)
+#define SHM_CACHE_LINE (64)
+
+/*
+ * Shared-memory ring layout
+ *
+ * Every ring is a POSIX shared-memory object holding a header followed by a power-of-two array of fc32 samples. The
+ * ring has a single writer and up to SHM_MAX_READERS readers. The position of every sample in the stream is its
+ * timestamp in samples at the base rate, so the write and read counters double as the Tx and Rx timestamps of the
+ * processes attached to the ring. The writer publishes samples by advancing write_ts with release semantics and never
+ * overwrites samples that an attached reader has not consumed yet, which lets the processes run faster than real time
+ * while staying sample-aligned.
+ */
+typedef struct {
+  int32_t  pid;    // owner process, 0 when the slot is free
+  uint32_t active; // set once read_ts is valid
+  uint64_t read_ts;
+  uint8_t  padding[SHM_CACHE_LINE - 16];
+} rf_shm_reader_slot_t;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t state; // 0: uninitialised, 1: being initialised, 2: ready
+  uint32_t capacity;
+  uint32_t base_srate;
+  uint8_t  padding0[SHM_CACHE_LINE - 20];
+
+  uint64_t write_ts;
+  int32_t  writer_pid; // 0 when no process is transmitting into the ring
+  uint8_t  padding1[SHM_CACHE_LINE - 12];
+
+  rf_shm_reader_slot_t readers[SHM_MAX_READERS];
+} rf_shm_ring_hdr_t;
+
+typedef struct {
+  char               name[SHM_NAME_STRLEN];
+  rf_shm_ring_hdr_t* hdr;
+  cf_t*              samples;
+  size_t             map_size;
+  uint32_t           mask;
+} rf_shm_ring_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  rf_shm_ring_t   ring;
+  uint64_t        nsamples;
+  bool            running;
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  uint32_t        trx_timeout_ms;
+} rf_shm_tx_t;
+
+typedef struct {
+  char          id[SHM_ID_STRLEN];
+  rf_shm_ring_t rings[SHM_MAX_SOURCES];
+  uint32_t      slots[SHM_MAX_SOURCES];
+  uint64_t      stalled_ts[SHM_MAX_SOURCES]; // write_ts of a transmitter that timed out, not waited for again
+  uint32_t      nof_rings;
+  uint64_t      nsamples;
+  bool          running;
+  cf_t*         temp_buffer;
+  uint32_t      frequency_mhz;
+  bool          fail_on_disconnect;
+  uint32_t      trx_timeout_ms;
+  bool          log_trx_timeout;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char* id;
+  uint32_t    base_srate;
+  uint32_t    ring_size; ///< ring capacity in samples, rounded up to a power of two
+  uint32_t    frequency_mhz;
+  bool        fail_on_disconnect;
+  uint32_t    trx_timeout_ms;
+  bool        log_trx_timeout;
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(const char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(const char* id, const char* format, ...);
+
+SRSRAN_API int rf_shm_ring_open(rf_shm_ring_t* ring, const char* port, rf_shm_opts_t* opts);
+
+SRSRAN_API uint64_t rf_shm_ring_get_write_ts(rf_shm_ring_t* ring);
+
+SRSRAN_API bool rf_shm_ring_has_writer(rf_shm_ring_t* ring);
+
+SRSRAN_API bool rf_shm_pid_is_alive(pid_t pid);
+
+SRSRAN_API uint64_t rf_shm_now_ms(void);
+
+SRSRAN_API void rf_shm_backoff(uint32_t* nof_tries);
+
+SRSRAN_API void rf_shm_ring_close(rf_shm_ring_t* ring);
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, char* port);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples, float scale);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* port);
+
+SRSRAN_API int rf_shm_rx_start(rf_shm_rx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples, float scale);
+
+SRSRAN_API bool rf_shm_rx_has_writer(rf_shm_rx_t* q);
+
+SRSRAN_API uint64_t rf_shm_rx_get_write_ts(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
@@ -0,0 +1,255 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <inttypes.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Waits until nsamples can be written without overwriting samples that an attached reader has not consumed yet */
+static void rf_shm_tx_wait_space(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  rf_shm_ring_hdr_t* hdr      = q->ring.hdr;
+  uint64_t           capacity = (uint64_t)q->ring.mask + 1;
+
+  if (q->nsamples + nsamples <= capacity) {
+    return;
+  }
+  uint64_t min_read_ts = q->nsamples + nsamples - capacity;
+
+  uint64_t t0      = 0;
+  uint32_t nof_try = 0;
+  while (true) {
+    bool blocked = false;
+    for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+      rf_shm_reader_slot_t* slot = &hdr->readers[i];
+      if (__atomic_load_n(&slot->active, __ATOMIC_ACQUIRE) &&
+          __atomic_load_n(&slot->read_ts, __ATOMIC_ACQUIRE) < min_read_ts) {
+        blocked = true;
+      }
+    }
+
+    if (!blocked) {
+      return;
+    }
+
+    if (t0 == 0) {
+      t0 = rf_shm_now_ms();
+    } else if (rf_shm_now_ms() - t0 > q->trx_timeout_ms) {
+      // Stop waiting for the stuck readers: the slots of dead processes are released and the live ones are
+      // deactivated until they read again, losing the samples they did not read in time
+      for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+        rf_shm_reader_slot_t* slot = &hdr->readers[i];
+        int32_t               pid  = __atomic_load_n(&slot->pid, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->active, __ATOMIC_ACQUIRE) &&
+            __atomic_load_n(&slot->read_ts, __ATOMIC_ACQUIRE) < min_read_ts) {
+          __atomic_store_n(&slot->active, 0, __ATOMIC_RELEASE);
+          if (!rf_shm_pid_is_alive(pid)) {
+            __atomic_compare_exchange_n(&slot->pid, &pid, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+          } else {
+            rf_shm_error(q->id, "Warning: process %d is not reading from %s, overwriting\n", pid, q->ring.name);
+          }
+        }
+      }
+      return;
+    }
+
+    rf_shm_backoff(&nof_try);
+  }
+}
+
+/* Copies (or zeroes if buffer is NULL) the samples into the ring and publishes them */
+static void _rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, uint32_t nsamples, float scale)
+{
+  // Keep every write well below the ring capacity so it never waits for a reader to consume its own samples
+  uint32_t max_chunk = (q->ring.mask + 1) / 2;
+
+  while (nsamples > 0) {
+    uint32_t n = SRSRAN_MIN(nsamples, max_chunk);
+    rf_shm_tx_wait_space(q, n);
+
+    // Copy in up to two segments, the second one after wrapping around the end of the ring
+    uint32_t idx   = (uint32_t)(q->nsamples & q->ring.mask);
+    uint32_t count = 0;
+    while (count < n) {
+      uint32_t len = SRSRAN_MIN(n - count, q->ring.mask + 1 - idx);
+      cf_t*    dst = &q->ring.samples[idx];
+      if (buffer == NULL) {
+        srsran_vec_cf_zero(dst, len);
+      } else if (scale == 1.0f) {
+        srsran_vec_cf_copy(dst, &buffer[count], len);
+      } else {
+        srsran_vec_sc_prod_cfc(&buffer[count], scale, dst, len);
+      }
+      count += len;
+      idx = 0;
+    }
+
+    q->nsamples += n;
+    __atomic_store_n(&q->ring.hdr->write_ts, q->nsamples, __ATOMIC_RELEASE);
+
+    if (buffer != NULL) {
+      buffer += n;
+    }
+    nsamples -= n;
+  }
+}
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, char* port)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    bzero(q, sizeof(rf_shm_tx_t));
+
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    if (rf_shm_ring_open(&q->ring, port, &opts) != SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+
+    // Claim the ring, there can only be one transmitter. Take over from a process that died without closing it
+    int32_t pid = (int32_t)getpid();
+    int32_t cur = __atomic_load_n(&q->ring.hdr->writer_pid, __ATOMIC_ACQUIRE);
+    while (cur != pid) {
+      if (cur != 0 && rf_shm_pid_is_alive(cur)) {
+        rf_shm_error(q->id, "Error: process %d is already transmitting into %s\n", cur, q->ring.name);
+        goto clean_exit;
+      }
+      if (__atomic_compare_exchange_n(&q->ring.hdr->writer_pid, &cur, pid, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        cur = pid;
+      }
+    }
+
+    q->nsamples       = rf_shm_ring_get_write_ts(&q->ring);
+    q->frequency_mhz  = opts.frequency_mhz;
+    q->trx_timeout_ms = opts.trx_timeout_ms;
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    rf_shm_info(q->id, "Transmitting into %s from sample %" PRIu64 "\n", q->ring.name, q->nsamples);
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (ret != SRSRAN_SUCCESS && q && q->ring.hdr) {
+    int32_t pid = (int32_t)getpid();
+    __atomic_compare_exchange_n(&q->ring.hdr->writer_pid, &pid, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    rf_shm_ring_close(&q->ring);
+  }
+  return ret;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  int64_t nsamples = (int64_t)ts - (int64_t)q->nsamples;
+
+  if (nsamples > (int64_t)q->ring.mask) {
+    // The whole ring would be zeros, clear it and jump straight to the new timestamp
+    rf_shm_info(q->id, " - Detected Tx gap of %" PRId64 " samples, skipping.\n", nsamples);
+    srsran_vec_cf_zero(q->ring.samples, q->ring.mask + 1);
+    q->nsamples = ts;
+    __atomic_store_n(&q->ring.hdr->write_ts, q->nsamples, __ATOMIC_RELEASE);
+  } else if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %" PRId64 " samples.\n", nsamples);
+    _rf_shm_tx_baseband(q, NULL, (uint32_t)nsamples, 1.0f);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)SRSRAN_MIN(SRSRAN_MAX(nsamples, INT32_MIN), INT32_MAX);
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples, float scale)
+{
+  pthread_mutex_lock(&q->mutex);
+  _rf_shm_tx_baseband(q, buffer, nsamples, scale);
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint64_t ret = q->nsamples;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  rf_shm_info(q->id, " - Tx %d Zeros.\n", nsamples);
+  _rf_shm_tx_baseband(q, NULL, nsamples, 1.0f);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  if (!q->running) {
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+
+  // Release the ring so the receivers stop waiting for our samples and another process can transmit into it
+  int32_t pid = (int32_t)getpid();
+  __atomic_compare_exchange_n(&q->ring.hdr->writer_pid, &pid, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+  rf_shm_ring_close(&q->ring);
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return q->running;
+}
@@ -0,0 +1,319 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define COMPARE_EPSILON (1e-5f)
+#define NOF_CHANNELS 2
+#define MAX_UES 2
+#define NUM_SF (200)
+#define SF_LEN (1920)
+#define SRATE (1.92e6)
+#define TX_OFFSET_SF (4)
+#define STREAM_LEN (SF_LEN * (2 * NUM_SF + 2 * TX_OFFSET_SF))
+
+// Every sample sent and received, indexed by its timestamp
+static cf_t enb_tx_stream[NOF_CHANNELS][STREAM_LEN];
+static cf_t enb_rx_stream[NOF_CHANNELS][STREAM_LEN];
+static cf_t ue_tx_stream[MAX_UES][NOF_CHANNELS][STREAM_LEN];
+static cf_t ue_rx_stream[MAX_UES][NOF_CHANNELS][STREAM_LEN];
+
+typedef struct {
+  srsran_rf_t radio;
+  char        args[RF_PARAM_LEN];
+  cf_t (*tx_stream)[STREAM_LEN];
+  cf_t (*rx_stream)[STREAM_LEN];
+  uint32_t nof_sf;
+  uint32_t wait_sf;  // do not start until the eNB has processed this many subframes
+  uint64_t first_ts; // first received sample
+  uint64_t last_ts;  // last received sample + 1
+  int      ret;
+} trx_args_t;
+
+static pthread_mutex_t progress_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  progress_cvar  = PTHREAD_COND_INITIALIZER;
+static uint32_t        enb_progress_sf;
+static char            prefix[32];
+
+// Behaves like a PHY: receives a subframe and answers TX_OFFSET_SF subframes later
+static void* trx_thread(void* arg)
+{
+  trx_args_t* t      = (trx_args_t*)arg;
+  bool        is_enb = (t->tx_stream == enb_tx_stream);
+  t->ret             = SRSRAN_ERROR;
+  t->first_ts        = UINT64_MAX;
+  t->last_ts         = 0;
+
+  pthread_mutex_lock(&progress_mutex);
+  while (enb_progress_sf < t->wait_sf) {
+    pthread_cond_wait(&progress_cvar, &progress_mutex);
+  }
+  pthread_mutex_unlock(&progress_mutex);
+
+  if (t->wait_sf > 0) {
+    // Joining late, open the radio now
+    if (srsran_rf_open_devname(&t->radio, "shm", t->args, NOF_CHANNELS)) {
+      fprintf(stderr, "Error opening rf\n");
+      return NULL;
+    }
+  }
+  srsran_rf_set_rx_srate(&t->radio, SRATE);
+  srsran_rf_set_tx_srate(&t->radio, SRATE);
+
+  for (uint32_t sf = 0; sf < t->nof_sf; sf++) {
+    // Receive one subframe
+    srsran_timestamp_t rx_time                  = {};
+    void*              rx_ptr[SRSRAN_MAX_PORTS] = {};
+    cf_t               rx_buffer[NOF_CHANNELS][SF_LEN];
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      rx_ptr[c] = rx_buffer[c];
+    }
+    if (srsran_rf_recv_with_time_multi(&t->radio, rx_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs) !=
+        SF_LEN) {
+      fprintf(stderr, "Error receiving\n");
+      return NULL;
+    }
+    uint64_t rx_ts = srsran_timestamp_uint64(&rx_time, SRATE);
+    if (rx_ts + (TX_OFFSET_SF + 1) * SF_LEN > STREAM_LEN) {
+      fprintf(stderr, "Unexpected timestamp %" PRIu64 "\n", rx_ts);
+      return NULL;
+    }
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      srsran_vec_cf_copy(&t->rx_stream[c][rx_ts], rx_buffer[c], SF_LEN);
+    }
+    t->first_ts = SRSRAN_MIN(t->first_ts, rx_ts);
+    t->last_ts  = rx_ts + SF_LEN;
+
+    // Answer with random samples
+    uint64_t tx_ts                    = rx_ts + TX_OFFSET_SF * SF_LEN;
+    void*    tx_ptr[SRSRAN_MAX_PORTS] = {};
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        t->tx_stream[c][tx_ts + i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+      }
+      tx_ptr[c] = &t->tx_stream[c][tx_ts];
+    }
+    srsran_timestamp_t tx_time = {};
+    srsran_timestamp_init_uint64(&tx_time, tx_ts, SRATE);
+    if (srsran_rf_send_timed_multi(
+            &t->radio, tx_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending\n");
+      return NULL;
+    }
+
+    if (is_enb) {
+      pthread_mutex_lock(&progress_mutex);
+      enb_progress_sf = sf + 1;
+      pthread_cond_broadcast(&progress_cvar);
+      pthread_mutex_unlock(&progress_mutex);
+    }
+  }
+
+  srsran_rf_close(&t->radio);
+  t->ret = SRSRAN_SUCCESS;
+  return NULL;
+}
+
+static int compare(const char* what, cf_t* rx, cf_t* expected, uint64_t first_ts, uint64_t last_ts)
+{
+  for (uint64_t ts = first_ts; ts < last_ts; ts++) {
+    if (cabsf(rx[ts] - expected[ts]) > COMPARE_EPSILON) {
+      fprintf(stderr, "%s: data mismatch at sample %" PRIu64 "\n", what, ts);
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static void remove_rings(void)
+{
+  const char* suffixes[] = {"dl0", "dl1", "ul00", "ul01", "ul10", "ul11"};
+  for (uint32_t i = 0; i < sizeof(suffixes) / sizeof(suffixes[0]); i++) {
+    char name[64];
+    snprintf(name, sizeof(name), "/srsran_%s%s", prefix, suffixes[i]);
+    shm_unlink(name);
+  }
+}
+
+/*
+ * One eNB with two channels and nof_ues UEs. Every UE receives the eNB channels and the eNB receives the sum of the
+ * UEs on each channel. The last UE can join once the eNB has already processed join_sf subframes.
+ */
+static int run_test(uint32_t nof_ues, const char* extra_args, uint32_t join_sf)
+{
+  static trx_args_t enb         = {};
+  static trx_args_t ue[MAX_UES] = {};
+  pthread_t         threads[MAX_UES + 1];
+
+  remove_rings();
+  bzero(enb_tx_stream, sizeof(enb_tx_stream));
+  bzero(enb_rx_stream, sizeof(enb_rx_stream));
+  bzero(ue_tx_stream, sizeof(ue_tx_stream));
+  bzero(ue_rx_stream, sizeof(ue_rx_stream));
+  enb_progress_sf = 0;
+
+  // the eNB sums the uplink of every UE on each channel
+  char rx_ports[NOF_CHANNELS][64] = {};
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    for (uint32_t u = 0; u < nof_ues; u++) {
+      size_t len = strlen(rx_ports[c]);
+      snprintf(&rx_ports[c][len], sizeof(rx_ports[c]) - len, "%s%sul%d%d", u ? "+" : "", prefix, u, c);
+    }
+  }
+  snprintf(enb.args,
+           RF_PARAM_LEN,
+           "id=enb,tx_port0=%sdl0,tx_port1=%sdl1,rx_port0=%s,rx_port1=%s,%s",
+           prefix,
+           prefix,
+           rx_ports[0],
+           rx_ports[1],
+           extra_args);
+  enb.tx_stream = enb_tx_stream;
+  enb.rx_stream = enb_rx_stream;
+  enb.nof_sf    = NUM_SF;
+  enb.wait_sf   = 0;
+  if (srsran_rf_open_devname(&enb.radio, "shm", enb.args, NOF_CHANNELS)) {
+    fprintf(stderr, "Error opening eNB rf\n");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t u = 0; u < nof_ues; u++) {
+    snprintf(ue[u].args,
+             RF_PARAM_LEN,
+             "id=ue%d,rx_port0=%sdl0,rx_port1=%sdl1,tx_port0=%sul%d0,tx_port1=%sul%d1,%s",
+             u,
+             prefix,
+             prefix,
+             prefix,
+             u,
+             prefix,
+             u,
+             extra_args);
+    ue[u].tx_stream = ue_tx_stream[u];
+    ue[u].rx_stream = ue_rx_stream[u];
+    ue[u].nof_sf    = NUM_SF;
+    ue[u].wait_sf   = (u == nof_ues - 1) ? join_sf : 0;
+    if (ue[u].wait_sf == 0 && srsran_rf_open_devname(&ue[u].radio, "shm", ue[u].args, NOF_CHANNELS)) {
+      fprintf(stderr, "Error opening UE rf\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  pthread_create(&threads[0], NULL, trx_thread, &enb);
+  for (uint32_t u = 0; u < nof_ues; u++) {
+    pthread_create(&threads[u + 1], NULL, trx_thread, &ue[u]);
+  }
+  for (uint32_t u = 0; u < nof_ues + 1; u++) {
+    pthread_join(threads[u], NULL);
+  }
+  remove_rings();
+
+  if (enb.ret != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t u = 0; u < nof_ues; u++) {
+    if (ue[u].ret != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // The UE that joined late shall be aligned with the time of the eNB
+  if (join_sf > 0 && ue[nof_ues - 1].first_ts < join_sf * SF_LEN) {
+    fprintf(stderr, "Late UE started at sample %" PRIu64 "\n", ue[nof_ues - 1].first_ts);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    // Every UE receives exactly what the eNB sent, at the same timestamp
+    for (uint32_t u = 0; u < nof_ues; u++) {
+      if (compare("DL", ue_rx_stream[u][c], enb_tx_stream[c], ue[u].first_ts, ue[u].last_ts)) {
+        return SRSRAN_ERROR;
+      }
+    }
+
+    // The eNB receives the sum of the UEs
+    for (uint32_t u = 1; u < nof_ues; u++) {
+      srsran_vec_sum_ccc(ue_tx_stream[0][c], ue_tx_stream[u][c], ue_tx_stream[0][c], STREAM_LEN);
+    }
+    if (compare("UL", enb_rx_stream[c], ue_tx_stream[0][c], enb.first_ts, enb.last_ts)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Make sure the comparison was not made against silence
+  if (cabsf(enb_rx_stream[0][enb.last_ts - 1]) == 0.0f || cabsf(ue_rx_stream[0][0][ue[0].last_ts - 1]) == 0.0f) {
+    fprintf(stderr, "No samples were exchanged\n");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  snprintf(prefix, sizeof(prefix), "test%d_", (int)getpid());
+
+  // one UE, no decimation
+  if (run_test(1, "base_srate=1.92e6", 0) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Single UE test failed (no decimation)!\n");
+    return SRSRAN_ERROR;
+  }
+
+  // one UE, with decimation
+  if (run_test(1, "base_srate=23.04e6", 0) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Single UE test failed (with decimation)!\n");
+    return SRSRAN_ERROR;
+  }
+
+  // two UEs sharing the eNB with a ring that wraps around every few subframes
+  if (run_test(2, "base_srate=1.92e6,ring_size=16384", 0) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Two UE test failed!\n");
+    return SRSRAN_ERROR;
+  }
+
+  // two UEs, the second one joins while the eNB is running
+  if (run_test(2, "base_srate=1.92e6", 50) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Late UE test failed!\n");
+    return SRSRAN_ERROR;
+  }
+
+  // a device without ports must not open, otherwise auto mode would pick it
+  srsran_rf_t radio              = {};
+  char        args[RF_PARAM_LEN] = "base_srate=1.92e6";
+  if (srsran_rf_open_devname(&radio, "shm", args, NOF_CHANNELS) == SRSRAN_SUCCESS) {
+    fprintf(stderr, "Device without ports opened!\n");
+    return SRSRAN_ERROR;
+  }
+
+  fprintf(stdout, "Test passed!\n");
+
+  return SRSRAN_SUCCESS;
+}
@@ -100,6 +100,10 @@ int srsran_ue_dl_init(srsran_ue_dl_t* q, cf_t* in_buffer[SRSRAN_MAX_PORTS], uint
         goto clean_exit;
       }
     }
+    if (srsran_ofdm_many_set(&q->fft_many, q->fft, nof_rx_antennas)) {
+      ERROR("Error planning batched FFT");
+      goto clean_exit;
+    }
 
     ofdm_cfg.in_buffer  = in_buffer[0];
     ofdm_cfg.out_buffer = q->sf_symbols[0];
@@ -161,6 +165,7 @@ void srsran_ue_dl_free(srsran_ue_dl_t* q)
       srsran_ofdm_rx_free(&q->fft[port]);
     }
     srsran_ofdm_rx_free(&q->fft_mbsfn);
+    srsran_ofdm_many_free(&q->fft_many);
     srsran_chest_dl_free(&q->chest);
     srsran_chest_dl_res_free(&q->chest_res);
     for (int i = 0; i < SRSRAN_MI_NOF_REGS; i++) {
@@ -206,6 +211,10 @@ int srsran_ue_dl_set_cell(srsran_ue_dl_t* q, srsran_cell_t cell)
           return SRSRAN_ERROR;
         }
       }
+      if (srsran_ofdm_many_set(&q->fft_many, q->fft, q->nof_rx_antennas)) {
+        ERROR("Error planning batched FFT");
+        return SRSRAN_ERROR;
+      }
 
       // In TDD, initialize PDCCH and PHICH for the worst case: max ncces and phich groupds respectively
       uint32_t pdcch_init_reg = 0;
@@ -350,12 +359,12 @@ int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf,
 {
   if (q) {
     /* Run FFT for all subframe data */
-    for (int j = 0; j < q->nof_rx_antennas; j++) {
-      if (sf->sf_type == SRSRAN_SF_MBSFN) {
+    if (sf->sf_type == SRSRAN_SF_MBSFN) {
+      for (int j = 0; j < q->nof_rx_antennas; j++) {
         srsran_ofdm_rx_sf(&q->fft_mbsfn);
-      } else {
-        srsran_ofdm_rx_sf(&q->fft[j]);
       }
+    } else {
+      srsran_ofdm_many_rx_sf(&q->fft_many);
     }
     return estimate_pdcch_pcfich(q, sf, cfg);
   } else {
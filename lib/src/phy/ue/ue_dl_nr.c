@@ -106,6 +106,11 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     srsran_ofdm_rx_init_cfg(&q->fft[i], &fft_cfg);
   }
 
+  if (srsran_ofdm_many_set(&q->fft_many, q->fft, q->nof_rx_antennas) < SRSRAN_SUCCESS) {
+    ERROR("Error planning batched OFDM");
+    return SRSRAN_ERROR;
+  }
+
   if (srsran_dmrs_sch_init(&q->dmrs_pdsch, true) < SRSRAN_SUCCESS) {
     ERROR("Error DMRS");
     return SRSRAN_ERROR;
@@ -133,6 +138,7 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
       free(q->sf_symbols[i]);
     }
   }
+  srsran_ofdm_many_free(&q->fft_many);
 
   srsran_chest_dl_res_free(&q->chest);
   srsran_pdsch_nr_free(&q->pdsch);
@@ -178,6 +184,11 @@ int srsran_ue_dl_nr_set_carrier(srsran_ue_dl_nr_t* q, const srsran_carrier_nr_t*
 
       srsran_ofdm_rx_init_cfg(&q->fft[i], &cfg);
     }
+
+    if (srsran_ofdm_many_set(&q->fft_many, q->fft, q->nof_rx_antennas) < SRSRAN_SUCCESS) {
+      ERROR("Error planning batched OFDM");
+      return SRSRAN_ERROR;
+    }
   }
 
   q->carrier = *carrier;
@@ -224,9 +235,7 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
   }
 
   // OFDM demodulation
-  for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
-    srsran_ofdm_rx_sf(&q->fft[i]);
-  }
+  srsran_ofdm_many_rx_sf(&q->fft_many);
 
   // Estimate PDCCH channel for every configured CORESET
   for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CORESET; i++) {
@@ -76,7 +76,7 @@ void rlc::reset_metrics()
     it->second->reset_metrics();
   }
 
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
+  for (rlc_mrb_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
     it->second->reset_metrics();
   }
 
@@ -88,7 +88,7 @@ void rlc::stop()
   for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
     it->second->stop();
   }
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
+  for (rlc_mrb_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
     it->second->stop();
   }
 }
@@ -118,7 +118,7 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
   }
 
   // Add multicast metrics
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
+  for (rlc_mrb_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
     rlc_bearer_metrics_t metrics = it->second->get_metrics();
     logger.debug("MCH_LCID=%d, rx_rate_mbps=%4.2f",
                  it->first,
@@ -136,7 +136,7 @@ void rlc::reestablish()
     it->second->reestablish();
   }
 
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
+  for (rlc_mrb_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
     it->second->reestablish();
   }
 
@@ -148,7 +148,7 @@ void rlc::reestablish(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
     logger.info("Reestablishing LCID %d", lcid);
-    rlc_array.at(lcid)->reestablish();
+    rlc_array[lcid]->reestablish();
   } else {
     logger.warning("RLC LCID %d doesn't exist.", lcid);
   }
@@ -190,7 +190,7 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
   }
 
   if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->write_sdu_s(std::move(sdu));
+    rlc_array[lcid]->write_sdu_s(std::move(sdu));
     update_bsr(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Deallocating SDU", lcid);
@@ -200,7 +200,7 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
 void rlc::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
   if (valid_lcid_mrb(lcid)) {
-    rlc_array_mrb.at(lcid)->write_sdu(std::move(sdu));
+    rlc_array_mrb[lcid]->write_sdu(std::move(sdu));
     update_bsr_mch(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Deallocating SDU", lcid);
@@ -212,9 +212,9 @@ bool rlc::rb_is_um(uint32_t lcid)
   bool ret = false;
 
   if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->get_mode() == rlc_mode_t::um;
+    ret = rlc_array[lcid]->get_mode() == rlc_mode_t::um;
   } else if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->get_mode() == rlc_mode_t::um;
+    ret = rlc_array_mrb[lcid]->get_mode() == rlc_mode_t::um;
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
   }
@@ -225,7 +225,7 @@ bool rlc::rb_is_um(uint32_t lcid)
 void rlc::discard_sdu(uint32_t lcid, uint32_t discard_sn)
 {
   if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->discard_sdu(discard_sn);
+    rlc_array[lcid]->discard_sdu(discard_sn);
     update_bsr(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Ignoring discard SDU", lcid);
@@ -235,9 +235,9 @@ void rlc::discard_sdu(uint32_t lcid, uint32_t discard_sn)
 bool rlc::sdu_queue_is_full(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
-    return rlc_array.at(lcid)->sdu_queue_is_full();
+    return rlc_array[lcid]->sdu_queue_is_full();
   } else if (valid_lcid_mrb(lcid)) {
-    return rlc_array_mrb.at(lcid)->sdu_queue_is_full();
+    return rlc_array_mrb[lcid]->sdu_queue_is_full();
   }
   logger.warning("RLC LCID %d doesn't exist. Ignoring queue check", lcid);
   return false;
@@ -256,11 +256,11 @@ void rlc::get_buffer_state(uint32_t lcid, uint32_t& tx_queue, uint32_t& prio_tx_
 {
   rwlock_read_guard lock(rwlock);
   if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->is_suspended()) {
+    if (rlc_array[lcid]->is_suspended()) {
       tx_queue      = 0;
       prio_tx_queue = 0;
     } else {
-      rlc_array.at(lcid)->get_buffer_state(tx_queue, prio_tx_queue);
+      rlc_array[lcid]->get_buffer_state(tx_queue, prio_tx_queue);
     }
   }
 }
@@ -278,7 +278,7 @@ uint32_t rlc::get_total_mch_buffer_state(uint32_t lcid)
 
   rwlock_read_guard lock(rwlock);
   if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->get_buffer_state();
+    ret = rlc_array_mrb[lcid]->get_buffer_state();
   }
 
   return ret;
@@ -290,7 +290,7 @@ uint32_t rlc::read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 
   rwlock_read_guard lock(rwlock);
   if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->read_pdu(payload, nof_bytes);
+    ret = rlc_array[lcid]->read_pdu(payload, nof_bytes);
     update_bsr(lcid);
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
@@ -307,7 +307,7 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 
   rwlock_read_guard lock(rwlock);
   if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->read_pdu(payload, nof_bytes);
+    ret = rlc_array_mrb[lcid]->read_pdu(payload, nof_bytes);
     update_bsr_mch(lcid);
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
@@ -322,7 +322,7 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->write_pdu_s(payload, nof_bytes);
+    rlc_array[lcid]->write_pdu_s(payload, nof_bytes);
     update_bsr(lcid);
   } else {
     logger.warning("LCID %d doesn't exist. Dropping PDU.", lcid);
@@ -361,7 +361,7 @@ void rlc::write_pdu_pcch(srsran::unique_byte_buffer_t pdu)
 void rlc::write_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   if (valid_lcid_mrb(lcid)) {
-    rlc_array_mrb.at(lcid)->write_pdu(payload, nof_bytes);
+    rlc_array_mrb[lcid]->write_pdu(payload, nof_bytes);
   }
 }
 
@@ -373,7 +373,7 @@ bool rlc::is_suspended(const uint32_t lcid)
   bool ret = false;
 
   if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->is_suspended();
+    ret = rlc_array[lcid]->is_suspended();
   }
 
   return ret;
@@ -384,7 +384,7 @@ bool rlc::has_data(uint32_t lcid)
   bool has_data = false;
 
   if (valid_lcid(lcid)) {
-    has_data = rlc_array.at(lcid)->has_data();
+    has_data = rlc_array[lcid]->has_data();
   }
 
   return has_data;
@@ -453,7 +453,7 @@ int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
 
   rlc_entity->set_bsr_callback(bsr_callback);
 
-  if (not rlc_array.emplace(lcid, std::move(rlc_entity)).second) {
+  if (not rlc_array.insert(lcid, std::move(rlc_entity))) {
     logger.error("Error inserting RLC entity in to array.");
     return SRSRAN_ERROR;
   }
@@ -475,8 +475,8 @@ int rlc::add_bearer_mrb(uint32_t lcid)
       return SRSRAN_ERROR;
     }
     rlc_entity->set_bsr_callback(bsr_callback);
-    if (rlc_array_mrb.count(lcid) == 0) {
-      if (not rlc_array_mrb.emplace(lcid, std::move(rlc_entity)).second) {
+    if (not rlc_array_mrb.contains(lcid)) {
+      if (not rlc_array_mrb.insert(lcid, std::move(rlc_entity))) {
         logger.error("Error inserting RLC entity in to array.");
         return SRSRAN_ERROR;
       }
@@ -508,7 +508,7 @@ void rlc::del_bearer_mrb(uint32_t lcid)
   rwlock_write_guard lock(rwlock);
 
   if (valid_lcid_mrb(lcid)) {
-    rlc_map_t::iterator it = rlc_array_mrb.find(lcid);
+    rlc_mrb_map_t::iterator it = rlc_array_mrb.find(lcid);
     it->second->stop();
     rlc_array_mrb.erase(it);
     logger.info("Deleted RLC MRB bearer with LCID %d", lcid);
@@ -526,7 +526,7 @@ void rlc::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
     // insert old rlc entity into new LCID
     rlc_map_t::iterator         it         = rlc_array.find(old_lcid);
     std::unique_ptr<rlc_common> rlc_entity = std::move(it->second);
-    if (not rlc_array.emplace(new_lcid, std::move(rlc_entity)).second) {
+    if (not rlc_array.insert(new_lcid, std::move(rlc_entity))) {
       logger.error("Error inserting RLC entity into array.");
       return;
     }
@@ -549,7 +549,7 @@ void rlc::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
 void rlc::suspend_bearer(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->suspend()) {
+    if (rlc_array[lcid]->suspend()) {
       logger.info("Suspended radio bearer with LCID %d", lcid);
     } else {
       logger.error("Error suspending RLC entity: bearer already suspended.");
@@ -563,7 +563,7 @@ void rlc::resume_bearer(uint32_t lcid)
 {
   logger.info("Resuming radio LCID %d", lcid);
   if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->resume()) {
+    if (rlc_array[lcid]->resume()) {
       logger.info("Resumed radio LCID %d", lcid);
     } else {
       logger.error("Error resuming RLC entity: bearer not suspended.");
@@ -589,7 +589,7 @@ bool rlc::valid_lcid(uint32_t lcid)
     return false;
   }
 
-  if (rlc_array.find(lcid) == rlc_array.end()) {
+  if (not rlc_array.contains(lcid)) {
     return false;
   }
 
@@ -603,7 +603,7 @@ bool rlc::valid_lcid_mrb(uint32_t lcid)
     return false;
   }
 
-  if (rlc_array_mrb.find(lcid) == rlc_array_mrb.end()) {
+  if (not rlc_array_mrb.contains(lcid)) {
     return false;
   }
 
@@ -1490,7 +1490,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
       }
 
       if (rx_sdu->get_tailroom() >= len) {
-        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
+        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < rx_window[vr_r].buf->buffer_capacity) {
           if (rx_window[vr_r].buf->N_bytes < len) {
             RlcError("Dropping corrupted SN=%d", vr_r);
             rx_sdu.reset();
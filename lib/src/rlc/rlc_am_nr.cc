@@ -75,6 +75,7 @@ bool rlc_am_nr_tx::configure(const rlc_config_t& cfg_)
   }
 
   max_hdr_size = min_hdr_size + so_size;
+  retx_queue.resize(am_window_size(cfg.tx_sn_field_length));
 
   // make sure Tx queue is empty before attempting to resize
   empty_queue_no_lock();
@@ -452,19 +453,17 @@ uint32_t rlc_am_nr_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  rlc_amd_retx_nr_t& retx = retx_queue.front();
-
   // Sanity check - drop any retx SNs not present in tx_window
-  while (not tx_window->has_sn(retx.sn)) {
-    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx.sn);
+  while (not tx_window->has_sn(retx_queue.front().sn)) {
+    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue",
+            retx_queue.front().sn);
     retx_queue.pop();
-    if (!retx_queue.empty()) {
-      retx = retx_queue.front();
-    } else {
+    if (retx_queue.empty()) {
       RlcInfo("empty retx queue, cannot provide any retx PDU");
       return 0;
     }
   }
+  rlc_amd_retx_nr_t& retx = retx_queue.front();
 
   RlcDebug("RETX - SN=%d, is_segment=%s, current_so=%d, so_start=%d, segment_length=%d",
            retx.sn,
@@ -674,21 +673,22 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
     RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
     RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
   } else {
-    // Retx is already a segment
-    // Find current segment in segment list.
+    // Retx is already a segment, possibly coalesced from several ones.
+    // Find the segment in the segment list that contains the end of this PDU.
+    uint32_t                                            pdu_end_so = retx.current_so + retx_pdu_payload_size;
     std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator it;
     for (it = tx_pdu.segment_list.begin(); it != tx_pdu.segment_list.end(); ++it) {
-      if (it->so == retx.current_so) {
+      if (it->so < pdu_end_so && pdu_end_so < it->so + it->payload_len) {
         break;
       }
     }
     if (it != tx_pdu.segment_list.end()) {
       rlc_amd_tx_pdu_nr::pdu_segment seg1 = {};
       seg1.so                             = it->so;
-      seg1.payload_len                    = retx_pdu_payload_size;
+      seg1.payload_len                    = pdu_end_so - it->so;
       rlc_amd_tx_pdu_nr::pdu_segment seg2 = {};
-      seg2.so                             = it->so + retx_pdu_payload_size;
-      seg2.payload_len                    = it->payload_len - retx_pdu_payload_size;
+      seg2.so                             = pdu_end_so;
+      seg2.payload_len                    = it->payload_len - seg1.payload_len;
 
       std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator begin_it   = tx_pdu.segment_list.erase(it);
       std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it  = tx_pdu.segment_list.insert(begin_it, seg2);
@@ -697,7 +697,7 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
       RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
       RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
     } else {
-      RlcDebug("Could not find segment. SN=%d, SO=%d length=%d", retx.sn, retx.current_so, retx.segment_length);
+      RlcDebug("Segment boundary already present. SN=%d, SO=%d length=%d", retx.sn, pdu_end_so, retx.segment_length);
     }
   }
 
@@ -925,9 +925,20 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         bool segment_found = false;
         for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
           if (segm.so >= nack.so_start && segm.so <= nack.so_end) {
-            if (not retx_queue.has_sn(nack.nack_sn, segm.so)) {
-              rlc_amd_retx_nr_t& retx = retx_queue.push();
-              retx.sn                 = nack.nack_sn;
+            if (retx_queue.has_sn(nack.nack_sn, segm.so)) {
+              RlcInfo("Skip already scheduled RETX of SDU segment SN=%d, so_start=%d, segment_length=%d",
+                      nack.nack_sn,
+                      segm.so,
+                      segm.payload_len);
+            } else if (segment_found &&
+                       retx_queue.coalesce_segment(nack.nack_sn, segm.so, segm.payload_len, pdu.sdu_buf->N_bytes)) {
+              // All bytes of the NACK range are missing, so contiguous segments can be sent in one RETX PDU
+              RlcInfo("Coalesced RETX of SDU segment SN=%d, so_start=%d, segment_length=%d with previous segment",
+                      nack.nack_sn,
+                      segm.so,
+                      segm.payload_len);
+            } else {
+              rlc_amd_retx_nr_t& retx = retx_queue.push(nack.nack_sn);
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
@@ -937,11 +948,6 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
                       retx.sn,
                       retx.so_start,
                       retx.segment_length);
-            } else {
-              RlcInfo("Skip already scheduled RETX of SDU segment SN=%d, so_start=%d, segment_length=%d",
-                      nack.nack_sn,
-                      segm.so,
-                      segm.payload_len);
             }
             segment_found = true;
           }
@@ -961,8 +967,7 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         if (not retx_queue.has_sn(nack.nack_sn)) {
           // Have we segmented the SDU already?
           if ((*tx_window)[nack.nack_sn].segment_list.empty()) {
-            rlc_amd_retx_nr_t& retx = retx_queue.push();
-            retx.sn                 = nack.nack_sn;
+            rlc_amd_retx_nr_t& retx = retx_queue.push(nack.nack_sn);
             retx.is_segment         = false;
             retx.so_start           = 0;
             retx.current_so         = 0;
@@ -972,9 +977,12 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
           } else {
             RlcInfo("Scheduled RETX of SDU SN=%d", nack.nack_sn);
             retx_sn_set.insert(nack.nack_sn);
-            for (auto segm : (*tx_window)[nack.nack_sn].segment_list) {
-              rlc_amd_retx_nr_t& retx = retx_queue.push();
-              retx.sn                 = nack.nack_sn;
+            for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
+              if (retx_queue.coalesce_segment(nack.nack_sn, segm.so, segm.payload_len, pdu.sdu_buf->N_bytes)) {
+                RlcInfo("Coalesced RETX of SDU Segment. SN=%d, SO=%d, len=%d", nack.nack_sn, segm.so, segm.payload_len);
+                continue;
+              }
+              rlc_amd_retx_nr_t& retx = retx_queue.push(nack.nack_sn);
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
@@ -1049,7 +1057,7 @@ void rlc_am_nr_tx::get_buffer_state(uint32_t& n_bytes_new, uint32_t& n_bytes_pri
   }
 
   // Bytes needed for retx
-  for (const rlc_amd_retx_nr_t& retx : retx_queue.get_inner_queue()) {
+  for (const rlc_amd_retx_nr_t& retx : retx_queue) {
     RlcDebug("buffer state - retx - SN=%d, Segment: %s, %d:%d",
              retx.sn,
              retx.is_segment ? "true" : "false",
@@ -1274,8 +1282,7 @@ void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
       // RETX first RLC SDU that has not been ACKed
       // or first SDU segment of the first RLC SDU
       // that has not been acked
-      rlc_amd_retx_nr_t& retx = retx_queue.push();
-      retx.sn                 = st.tx_next_ack;
+      rlc_amd_retx_nr_t& retx = retx_queue.push(st.tx_next_ack);
       if ((*tx_window)[st.tx_next_ack].segment_list.empty()) {
         // Full SDU
         retx.is_segment     = false;
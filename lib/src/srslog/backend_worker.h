@@ -90,6 +90,10 @@ private:
   /// Processes the log entry.
   void process_log_entry(detail::log_entry&& entry);
 
+  /// Processes the entries available in the queue, up to max_batch_size of
+  /// them. Returns the number of processed entries.
+  size_t process_entry_batch();
+
   /// Processes outstanding entries in the queue until it gets empty.
   void process_outstanding_entries();
 
@@ -111,6 +115,10 @@ private:
   void set_thread_priority(backend_priority priority) const;
 
 private:
+  /// Maximum number of entries processed between two checks of the running
+  /// flag and the queue occupancy.
+  static constexpr size_t max_batch_size = 64;
+
   detail::work_queue<detail::log_entry>& queue;
   detail::dyn_arg_store_pool&            arg_pool;
   detail::shared_variable<bool>          running_flag;
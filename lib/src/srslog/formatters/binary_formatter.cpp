@@ -0,0 +1,684 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "binary_formatter.h"
+#include <cstring>
+
+using namespace srslog;
+using namespace srslog::binary_log;
+
+/// Format string of the entries with arguments that had to be formatted by the
+/// encoder.
+static const char* const fallback_fmtstring = "%s";
+
+static void put_u8(fmt::memory_buffer& buffer, uint8_t v)
+{
+  buffer.push_back(static_cast<char>(v));
+}
+
+static void put_varint(fmt::memory_buffer& buffer, uint64_t v)
+{
+  while (v >= 0x80) {
+    buffer.push_back(static_cast<char>((v & 0x7f) | 0x80));
+    v >>= 7;
+  }
+  buffer.push_back(static_cast<char>(v));
+}
+
+static void put_svarint(fmt::memory_buffer& buffer, int64_t v)
+{
+  put_varint(buffer, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+static void put_raw(fmt::memory_buffer& buffer, const void* data, size_t len)
+{
+  const char* p = static_cast<const char*>(data);
+  buffer.append(p, p + len);
+}
+
+static void put_string(fmt::memory_buffer& buffer, fmt::string_view str)
+{
+  put_varint(buffer, str.size());
+  put_raw(buffer, str.data(), str.size());
+}
+
+namespace {
+
+/// Serializes the value of a format argument. Returns false for the types that
+/// can not be stored raw.
+struct arg_encoder {
+  fmt::memory_buffer& buffer;
+
+  bool operator()(int v) { return put_signed(arg_type::int_arg, v); }
+  bool operator()(unsigned v) { return put_unsigned(arg_type::uint_arg, v); }
+  bool operator()(long long v) { return put_signed(arg_type::long_long_arg, v); }
+  bool operator()(unsigned long long v) { return put_unsigned(arg_type::ulong_long_arg, v); }
+  bool operator()(bool v) { return put_bytes(arg_type::bool_arg, &v, 1); }
+  bool operator()(char v) { return put_bytes(arg_type::char_arg, &v, 1); }
+  bool operator()(float v) { return put_bytes(arg_type::float_arg, &v, sizeof(v)); }
+  bool operator()(double v) { return put_bytes(arg_type::double_arg, &v, sizeof(v)); }
+  bool operator()(long double v) { return put_bytes(arg_type::long_double_arg, &v, sizeof(v)); }
+  bool operator()(const char* v) { return (*this)(fmt::string_view(v)); }
+  bool operator()(fmt::string_view v)
+  {
+    put_u8(buffer, static_cast<uint8_t>(arg_type::string_arg));
+    put_string(buffer, v);
+    return true;
+  }
+  bool operator()(const void* v)
+  {
+    return put_unsigned(arg_type::pointer_arg, reinterpret_cast<uintptr_t>(v));
+  }
+  /// Custom and 128 bit types.
+  template <typename T>
+  bool operator()(T)
+  {
+    return false;
+  }
+
+  bool put_signed(arg_type type, int64_t v)
+  {
+    put_u8(buffer, static_cast<uint8_t>(type));
+    put_svarint(buffer, v);
+    return true;
+  }
+  bool put_unsigned(arg_type type, uint64_t v)
+  {
+    put_u8(buffer, static_cast<uint8_t>(type));
+    put_varint(buffer, v);
+    return true;
+  }
+  bool put_bytes(arg_type type, const void* v, size_t len)
+  {
+    put_u8(buffer, static_cast<uint8_t>(type));
+    put_raw(buffer, v, len);
+    return true;
+  }
+};
+
+} // namespace
+
+std::unique_ptr<log_formatter> binary_formatter::clone() const
+{
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
+void binary_formatter::write_record_type(record_type type, fmt::memory_buffer& buffer)
+{
+  if (!header_written) {
+    put_raw(buffer, binary_log_magic, binary_log_magic_size);
+    header_written = true;
+  }
+  put_u8(buffer, static_cast<uint8_t>(type));
+}
+
+uint32_t binary_formatter::define_string(fmt::string_view str, fmt::memory_buffer& buffer)
+{
+  strings.emplace_back(str.data(), str.size());
+  uint32_t id = strings.size();
+
+  write_record_type(record_type::string_def, buffer);
+  put_varint(buffer, id);
+  put_string(buffer, str);
+
+  return id;
+}
+
+uint32_t binary_formatter::get_fmtstring_id(const char* str, fmt::memory_buffer& buffer)
+{
+  if (!str) {
+    return 0;
+  }
+
+  // Format strings are usually literals, so look them up by address. The contents are checked as well in case the
+  // address gets reused by a different string.
+  auto it = fmtstring_ids.find(str);
+  if (it != fmtstring_ids.end() && std::strcmp(strings[it->second - 1].c_str(), str) == 0) {
+    return it->second;
+  }
+
+  uint32_t id        = define_string(str, buffer);
+  fmtstring_ids[str] = id;
+  return id;
+}
+
+uint32_t binary_formatter::get_string_id(fmt::string_view str, fmt::memory_buffer& buffer)
+{
+  if (str.size() == 0) {
+    return 0;
+  }
+
+  string_key.assign(str.data(), str.size());
+  auto it = string_ids.find(string_key);
+  if (it != string_ids.end()) {
+    return it->second;
+  }
+
+  uint32_t id            = define_string(str, buffer);
+  string_ids[string_key] = id;
+  return id;
+}
+
+void binary_formatter::write_metadata(record_type type, const detail::log_entry_metadata& md, fmt::memory_buffer& buffer)
+{
+  // Encode the arguments first, as the fall back path needs a different format string.
+  const char* fmtstring = md.fmtstring;
+  uint32_t    nof_args  = 0;
+  arg_buffer.clear();
+  if (md.fmtstring && md.store) {
+    fmt::basic_format_args<fmt::printf_context> args(*md.store);
+    bool                                        encoded = true;
+    for (int i = 0; encoded; ++i) {
+      auto arg = args.get(i);
+      if (!arg) {
+        break;
+      }
+      encoded = fmt::visit_format_arg(arg_encoder{arg_buffer}, arg);
+      ++nof_args;
+    }
+
+    if (!encoded) {
+      // Format the message now and store it as a string argument.
+      fallback_msg.clear();
+      try {
+        fmt::vprintf(fallback_msg, fmt::to_string_view(md.fmtstring), args);
+      } catch (...) {
+        fmt::format_to(fallback_msg, "{} -> srsLog error - Invalid format string", md.fmtstring);
+      }
+      arg_buffer.clear();
+      arg_encoder{arg_buffer}(fmt::string_view(fallback_msg.data(), fallback_msg.size()));
+      fmtstring = fallback_fmtstring;
+      nof_args  = 1;
+    }
+  }
+
+  // Strings have to be defined before the record that uses them.
+  uint32_t fmt_id  = get_fmtstring_id(fmtstring, buffer);
+  uint32_t name_id = get_string_id(md.log_name, buffer);
+
+  write_record_type(type, buffer);
+
+  int64_t ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(md.tp.time_since_epoch()).count();
+  put_svarint(buffer, ts_ns - last_ts_ns);
+  last_ts_ns = ts_ns;
+
+  put_varint(buffer, fmt_id);
+  put_varint(buffer, name_id);
+  put_u8(buffer, md.log_tag);
+  put_u8(buffer,
+         (md.context.enabled ? metadata_flag_context : 0) | (md.store ? metadata_flag_store : 0) |
+             (md.hex_dump.empty() ? 0 : metadata_flag_hex_dump));
+  if (md.context.enabled) {
+    put_varint(buffer, md.context.value);
+  }
+  if (md.store) {
+    put_varint(buffer, nof_args);
+    put_raw(buffer, arg_buffer.data(), arg_buffer.size());
+  }
+  if (!md.hex_dump.empty()) {
+    put_varint(buffer, md.hex_dump.size());
+    put_raw(buffer, md.hex_dump.data(), md.hex_dump.size());
+  }
+}
+
+void binary_formatter::format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer)
+{
+  write_metadata(record_type::entry, metadata, buffer);
+}
+
+void binary_formatter::format_context_begin(const detail::log_entry_metadata& md,
+                                            fmt::string_view                  ctx_name,
+                                            unsigned                          size,
+                                            fmt::memory_buffer&               buffer)
+{
+  uint32_t name_id = get_string_id(ctx_name, buffer);
+  write_metadata(record_type::ctx_begin, md, buffer);
+  put_varint(buffer, name_id);
+  put_varint(buffer, size);
+}
+
+void binary_formatter::format_context_end(const detail::log_entry_metadata& md,
+                                          fmt::string_view                  ctx_name,
+                                          fmt::memory_buffer&               buffer)
+{
+  uint32_t name_id = get_string_id(ctx_name, buffer);
+  write_record_type(record_type::ctx_end, buffer);
+  put_varint(buffer, name_id);
+}
+
+void binary_formatter::format_metric_set_begin(fmt::string_view    set_name,
+                                               unsigned            size,
+                                               unsigned            level,
+                                               fmt::memory_buffer& buffer)
+{
+  uint32_t name_id = get_string_id(set_name, buffer);
+  write_record_type(record_type::set_begin, buffer);
+  put_varint(buffer, name_id);
+  put_varint(buffer, size);
+  put_varint(buffer, level);
+}
+
+void binary_formatter::format_metric_set_end(fmt::string_view set_name, unsigned level, fmt::memory_buffer& buffer)
+{
+  uint32_t name_id = get_string_id(set_name, buffer);
+  write_record_type(record_type::set_end, buffer);
+  put_varint(buffer, name_id);
+  put_varint(buffer, level);
+}
+
+void binary_formatter::format_list_begin(fmt::string_view    list_name,
+                                         unsigned            size,
+                                         unsigned            level,
+                                         fmt::memory_buffer& buffer)
+{
+  uint32_t name_id = get_string_id(list_name, buffer);
+  write_record_type(record_type::list_begin, buffer);
+  put_varint(buffer, name_id);
+  put_varint(buffer, size);
+  put_varint(buffer, level);
+}
+
+void binary_formatter::format_list_end(fmt::string_view list_name, unsigned level, fmt::memory_buffer& buffer)
+{
+  uint32_t name_id = get_string_id(list_name, buffer);
+  write_record_type(record_type::list_end, buffer);
+  put_varint(buffer, name_id);
+  put_varint(buffer, level);
+}
+
+void binary_formatter::format_metric(fmt::string_view    metric_name,
+                                     fmt::string_view    metric_value,
+                                     fmt::string_view    metric_units,
+                                     metric_kind         kind,
+                                     unsigned            level,
+                                     fmt::memory_buffer& buffer)
+{
+  uint32_t name_id  = get_string_id(metric_name, buffer);
+  uint32_t units_id = get_string_id(metric_units, buffer);
+  write_record_type(record_type::metric, buffer);
+  put_varint(buffer, name_id);
+  put_string(buffer, metric_value);
+  put_varint(buffer, units_id);
+  put_u8(buffer, static_cast<uint8_t>(kind));
+  put_varint(buffer, level);
+}
+
+///
+/// Decoder implementation.
+///
+
+/// Bounds checked reader of the records of a binary log.
+class binary_log_decoder::reader
+{
+public:
+  reader(const uint8_t* begin, const uint8_t* end) : begin(begin), cur(begin), end(end) {}
+
+  /// Returns true when the input ended in the middle of a record.
+  bool is_truncated() const { return truncated; }
+  size_t consumed() const { return cur - begin; }
+  bool   at_end() const { return cur == end; }
+
+  bool u8(uint8_t& v)
+  {
+    if (cur == end) {
+      truncated = true;
+      return false;
+    }
+    v = *cur++;
+    return true;
+  }
+
+  bool varint(uint64_t& v)
+  {
+    v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!u8(byte)) {
+        return false;
+      }
+      v |= uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return true;
+      }
+    }
+    // Too many continuation bytes.
+    return false;
+  }
+
+  bool svarint(int64_t& v)
+  {
+    uint64_t u;
+    if (!varint(u)) {
+      return false;
+    }
+    v = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+    return true;
+  }
+
+  bool raw(void* data, size_t len)
+  {
+    if (size_t(end - cur) < len) {
+      truncated = true;
+      return false;
+    }
+    std::memcpy(data, cur, len);
+    cur += len;
+    return true;
+  }
+
+  bool string(std::string& str)
+  {
+    uint64_t len;
+    if (!varint(len)) {
+      return false;
+    }
+    if (size_t(end - cur) < len) {
+      truncated = true;
+      return false;
+    }
+    str.assign(reinterpret_cast<const char*>(cur), len);
+    cur += len;
+    return true;
+  }
+
+private:
+  const uint8_t* begin;
+  const uint8_t* cur;
+  const uint8_t* end;
+  bool           truncated = false;
+};
+
+int64_t binary_log_decoder::decode(const uint8_t* data, size_t len, fmt::memory_buffer& buffer)
+{
+  size_t pos = 0;
+  if (!header_read) {
+    if (len < binary_log_magic_size) {
+      return 0;
+    }
+    if (std::memcmp(data, binary_log_magic, binary_log_magic_size) != 0) {
+      return -1;
+    }
+    header_read = true;
+    pos         = binary_log_magic_size;
+  }
+
+  while (pos != len) {
+    reader r(data + pos, data + len);
+    size_t out_size = buffer.size();
+    if (!decode_record(r, buffer)) {
+      if (!r.is_truncated()) {
+        return -1;
+      }
+      // Wait for the rest of the record.
+      buffer.resize(out_size);
+      break;
+    }
+    pos += r.consumed();
+  }
+
+  return pos;
+}
+
+bool binary_log_decoder::read_string_id(reader& r, fmt::string_view& str)
+{
+  uint64_t id;
+  if (!r.varint(id) || id > strings.size()) {
+    return false;
+  }
+  str = (id == 0) ? fmt::string_view("") : fmt::string_view(strings[id - 1]);
+  return true;
+}
+
+bool binary_log_decoder::read_metadata(reader& r, int64_t& ts_ns)
+{
+  int64_t  ts_delta;
+  uint64_t fmt_id, name_id;
+  uint8_t  tag, flags;
+  if (!r.svarint(ts_delta) || !r.varint(fmt_id) || !r.varint(name_id) || !r.u8(tag) || !r.u8(flags)) {
+    return false;
+  }
+  if (fmt_id > strings.size() || name_id > strings.size()) {
+    return false;
+  }
+
+  ts_ns = last_ts_ns + ts_delta;
+  md    = {};
+  md.tp = std::chrono::high_resolution_clock::time_point(
+      std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(ts_ns)));
+  md.fmtstring = (fmt_id == 0) ? nullptr : strings[fmt_id - 1].c_str();
+  if (name_id != 0) {
+    md.log_name = strings[name_id - 1];
+  }
+  md.log_tag = static_cast<char>(tag);
+
+  if (flags & binary_formatter::metadata_flag_context) {
+    uint64_t value;
+    if (!r.varint(value)) {
+      return false;
+    }
+    md.context = {static_cast<uint32_t>(value), true};
+  }
+
+  store.clear();
+  if (flags & binary_formatter::metadata_flag_store) {
+    md.store = &store;
+    uint64_t nof_args;
+    if (!r.varint(nof_args)) {
+      return false;
+    }
+    for (uint64_t i = 0; i != nof_args; ++i) {
+      if (!read_arg(r)) {
+        return false;
+      }
+    }
+  }
+
+  if (flags & binary_formatter::metadata_flag_hex_dump) {
+    uint64_t hex_len;
+    if (!r.varint(hex_len)) {
+      return false;
+    }
+    if (hex_len > (1U << 30)) {
+      return false;
+    }
+    md.hex_dump.resize(hex_len);
+    if (!r.raw(md.hex_dump.data(), hex_len)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool binary_log_decoder::read_arg(reader& r)
+{
+  uint8_t type;
+  if (!r.u8(type)) {
+    return false;
+  }
+
+  uint64_t u;
+  int64_t  s;
+  switch (static_cast<arg_type>(type)) {
+    case arg_type::int_arg:
+      if (!r.svarint(s)) {
+        return false;
+      }
+      store.push_back(static_cast<int>(s));
+      return true;
+    case arg_type::uint_arg:
+      if (!r.varint(u)) {
+        return false;
+      }
+      store.push_back(static_cast<unsigned>(u));
+      return true;
+    case arg_type::long_long_arg:
+      if (!r.svarint(s)) {
+        return false;
+      }
+      store.push_back(static_cast<long long>(s));
+      return true;
+    case arg_type::ulong_long_arg:
+      if (!r.varint(u)) {
+        return false;
+      }
+      store.push_back(static_cast<unsigned long long>(u));
+      return true;
+    case arg_type::bool_arg: {
+      uint8_t v;
+      if (!r.u8(v)) {
+        return false;
+      }
+      store.push_back(v != 0);
+      return true;
+    }
+    case arg_type::char_arg: {
+      uint8_t v;
+      if (!r.u8(v)) {
+        return false;
+      }
+      store.push_back(static_cast<char>(v));
+      return true;
+    }
+    case arg_type::float_arg: {
+      float v;
+      if (!r.raw(&v, sizeof(v))) {
+        return false;
+      }
+      store.push_back(v);
+      return true;
+    }
+    case arg_type::double_arg: {
+      double v;
+      if (!r.raw(&v, sizeof(v))) {
+        return false;
+      }
+      store.push_back(v);
+      return true;
+    }
+    case arg_type::long_double_arg: {
+      long double v;
+      if (!r.raw(&v, sizeof(v))) {
+        return false;
+      }
+      store.push_back(v);
+      return true;
+    }
+    case arg_type::string_arg:
+      if (!r.string(tmp_string)) {
+        return false;
+      }
+      store.push_back(tmp_string);
+      return true;
+    case arg_type::pointer_arg:
+      if (!r.varint(u)) {
+        return false;
+      }
+      store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(u)));
+      return true;
+  }
+
+  // Unknown argument type.
+  return false;
+}
+
+bool binary_log_decoder::decode_record(reader& r, fmt::memory_buffer& buffer)
+{
+  uint8_t type;
+  if (!r.u8(type)) {
+    return false;
+  }
+
+  int64_t          ts_ns = last_ts_ns;
+  uint64_t         size, level;
+  fmt::string_view name;
+  switch (static_cast<record_type>(type)) {
+    case record_type::string_def: {
+      uint64_t id;
+      if (!r.varint(id) || !r.string(tmp_string)) {
+        return false;
+      }
+      // Strings are defined in order.
+      if (id != strings.size() + 1) {
+        return false;
+      }
+      strings.push_back(tmp_string);
+      return true;
+    }
+    case record_type::entry:
+      if (!read_metadata(r, ts_ns)) {
+        return false;
+      }
+      last_ts_ns = ts_ns;
+      formatter->format(std::move(md), buffer);
+      return true;
+    case record_type::ctx_begin:
+      if (!read_metadata(r, ts_ns) || !read_string_id(r, name) || !r.varint(size)) {
+        return false;
+      }
+      last_ts_ns = ts_ns;
+      formatter->format_context_begin(md, name, size, buffer);
+      return true;
+    case record_type::ctx_end:
+      if (!read_string_id(r, name)) {
+        return false;
+      }
+      formatter->format_context_end(md, name, buffer);
+      return true;
+    case record_type::set_begin:
+      if (!read_string_id(r, name) || !r.varint(size) || !r.varint(level)) {
+        return false;
+      }
+      formatter->format_metric_set_begin(name, size, level, buffer);
+      return true;
+    case record_type::set_end:
+      if (!read_string_id(r, name) || !r.varint(level)) {
+        return false;
+      }
+      formatter->format_metric_set_end(name, level, buffer);
+      return true;
+    case record_type::list_begin:
+      if (!read_string_id(r, name) || !r.varint(size) || !r.varint(level)) {
+        return false;
+      }
+      formatter->format_list_begin(name, size, level, buffer);
+      return true;
+    case record_type::list_end:
+      if (!read_string_id(r, name) || !r.varint(level)) {
+        return false;
+      }
+      formatter->format_list_end(name, level, buffer);
+      return true;
+    case record_type::metric: {
+      fmt::string_view units;
+      uint8_t          kind;
+      if (!read_string_id(r, name) || !r.string(tmp_string) || !read_string_id(r, units) || !r.u8(kind) ||
+          !r.varint(level)) {
+        return false;
+      }
+      formatter->format_metric(name, tmp_string, units, static_cast<metric_kind>(kind), level, buffer);
+      return true;
+    }
+  }
+
+  // Unknown record type.
+  return false;
+}
@@ -0,0 +1,188 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_BINARY_FORMATTER_H
+#define SRSLOG_BINARY_FORMATTER_H
+
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "srsran/srslog/formatter.h"
+#include <deque>
+#include <unordered_map>
+
+namespace srslog {
+
+/// Layout of the binary log format.
+/// A binary log starts with the 8 byte binary_log_magic followed by a sequence
+/// of records, each one beginning with a record type byte. Integers are encoded
+/// as LEB128 varints (zigzag mapped when signed), strings as a varint length
+/// followed by the characters. Format strings, log names and metric names are
+/// sent once in a string_def record and referred to by their id afterwards, id
+/// 0 meaning "no string". Timestamps are stored as the difference in
+/// nanoseconds with the timestamp of the previous entry.
+namespace binary_log {
+
+constexpr char   binary_log_magic[]    = "SRSLOGB1";
+constexpr size_t binary_log_magic_size = sizeof(binary_log_magic) - 1;
+
+enum class record_type : uint8_t {
+  string_def = 1, ///< id, string
+  entry,          ///< metadata, see binary_formatter::write_metadata()
+  ctx_begin,      ///< metadata, name id, size
+  ctx_end,        ///< name id
+  set_begin,      ///< name id, size, level
+  set_end,        ///< name id, level
+  list_begin,     ///< name id, size, level
+  list_end,       ///< name id, level
+  metric          ///< name id, value string, units id, kind, level
+};
+
+/// Type of each argument of a log entry, followed by its value.
+enum class arg_type : uint8_t {
+  int_arg = 1,     ///< zigzag varint
+  uint_arg,        ///< varint
+  long_long_arg,   ///< zigzag varint
+  ulong_long_arg,  ///< varint
+  bool_arg,        ///< 1 byte
+  char_arg,        ///< 1 byte
+  float_arg,       ///< raw 4 bytes
+  double_arg,      ///< raw 8 bytes
+  long_double_arg, ///< raw sizeof(long double) bytes
+  string_arg,      ///< string
+  pointer_arg      ///< varint
+};
+
+} // namespace binary_log
+
+/// Binary formatter class implementation.
+/// Serializes the log entries without formatting their messages: the format
+/// string id, the raw arguments of the dyn_arg_store and the timestamp are
+/// stored instead, so that the backend thread does the minimum amount of work.
+/// Entries with argument types that can not be stored raw (user defined types)
+/// are formatted and stored as a "%s" entry. Use binary_log_decoder to convert
+/// the resulting log back to text or JSON.
+/// NOTE: The formatter keeps the string tables of the log being written, a
+/// single instance must be used for each output file.
+class binary_formatter : public log_formatter
+{
+public:
+  /// Flags of the metadata of an entry, telling which optional fields follow.
+  static constexpr uint8_t metadata_flag_context  = 1U << 0;
+  static constexpr uint8_t metadata_flag_store    = 1U << 1;
+  static constexpr uint8_t metadata_flag_hex_dump = 1U << 2;
+
+  std::unique_ptr<log_formatter> clone() const override;
+
+  void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
+
+private:
+  void format_context_begin(const detail::log_entry_metadata& md,
+                            fmt::string_view                  ctx_name,
+                            unsigned                          size,
+                            fmt::memory_buffer&               buffer) override;
+
+  void format_context_end(const detail::log_entry_metadata& md,
+                          fmt::string_view                  ctx_name,
+                          fmt::memory_buffer&               buffer) override;
+
+  void format_metric_set_begin(fmt::string_view    set_name,
+                               unsigned            size,
+                               unsigned            level,
+                               fmt::memory_buffer& buffer) override;
+
+  void format_metric_set_end(fmt::string_view set_name, unsigned level, fmt::memory_buffer& buffer) override;
+
+  void
+  format_list_begin(fmt::string_view list_name, unsigned size, unsigned level, fmt::memory_buffer& buffer) override;
+
+  void format_list_end(fmt::string_view list_name, unsigned level, fmt::memory_buffer& buffer) override;
+
+  void format_metric(fmt::string_view    metric_name,
+                     fmt::string_view    metric_value,
+                     fmt::string_view    metric_units,
+                     metric_kind         kind,
+                     unsigned            level,
+                     fmt::memory_buffer& buffer) override;
+
+  /// Writes the record type, emitting the file header before the first record.
+  void write_record_type(binary_log::record_type type, fmt::memory_buffer& buffer);
+
+  /// Writes a record holding the metadata and the arguments of a log entry:
+  /// timestamp delta, format string id, log name id, tag, flags and then,
+  /// depending on the flags, the context value, the arguments and the hex dump.
+  void write_metadata(binary_log::record_type           type,
+                      const detail::log_entry_metadata& md,
+                      fmt::memory_buffer&               buffer);
+
+  /// Returns the id of the format string, defining it the first time it is seen.
+  uint32_t get_fmtstring_id(const char* str, fmt::memory_buffer& buffer);
+
+  /// Returns the id of a string compared by value, defining it the first time it is seen.
+  uint32_t get_string_id(fmt::string_view str, fmt::memory_buffer& buffer);
+
+  /// Writes a string_def record for the string and returns its id.
+  uint32_t define_string(fmt::string_view str, fmt::memory_buffer& buffer);
+
+private:
+  bool                                      header_written = false;
+  int64_t                                   last_ts_ns     = 0;
+  std::vector<std::string>                  strings; ///< Defined strings, indexed by id - 1.
+  std::unordered_map<const char*, uint32_t> fmtstring_ids;
+  std::unordered_map<std::string, uint32_t> string_ids;
+  std::string                               string_key;
+  fmt::memory_buffer                        arg_buffer;
+  fmt::memory_buffer                        fallback_msg;
+};
+
+/// Converts a binary log written by binary_formatter back to the layout of any
+/// other formatter (i.e. text or JSON), replaying every stored entry and
+/// context through it.
+class binary_log_decoder
+{
+public:
+  explicit binary_log_decoder(std::unique_ptr<log_formatter> f) : formatter(std::move(f)) {}
+
+  /// Decodes the complete records found in the input, appending the formatted
+  /// output to the buffer. Returns the number of consumed bytes, a trailing
+  /// incomplete record is left for the next call with more data. Returns -1 on
+  /// malformed input.
+  int64_t decode(const uint8_t* data, size_t len, fmt::memory_buffer& buffer);
+
+private:
+  class reader;
+
+  bool decode_record(reader& r, fmt::memory_buffer& buffer);
+  bool read_metadata(reader& r, int64_t& ts_ns);
+  bool read_arg(reader& r);
+  bool read_string_id(reader& r, fmt::string_view& str);
+
+private:
+  std::unique_ptr<log_formatter>                     formatter;
+  bool                                               header_read = false;
+  int64_t                                            last_ts_ns  = 0;
+  std::deque<std::string>                            strings;
+  std::string                                        tmp_string;
+  detail::log_entry_metadata                         md = {};
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMATTER_H
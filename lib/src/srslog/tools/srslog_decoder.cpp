@@ -0,0 +1,110 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Converts binary logs written by the srslog binary formatter to text or JSON.
+/// The files of a rotated log must be passed in the order they were written,
+/// as the later ones refer to the strings defined in the first one.
+
+#include "../formatters/binary_formatter.h"
+#include "../formatters/json_formatter.h"
+#include "../formatters/text_formatter.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+using namespace srslog;
+
+static void usage(const char* prog)
+{
+  fprintf(stderr, "Usage: %s [-j] file [file...]\n", prog);
+  fprintf(stderr, "\t-j Output JSON instead of plain text\n");
+}
+
+int main(int argc, char** argv)
+{
+  bool json = false;
+  int  opt;
+  while ((opt = getopt(argc, argv, "jh")) != -1) {
+    switch (opt) {
+      case 'j':
+        json = true;
+        break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? 0 : -1;
+    }
+  }
+  if (optind >= argc) {
+    usage(argv[0]);
+    return -1;
+  }
+
+  std::unique_ptr<log_formatter> formatter;
+  if (json) {
+    formatter = std::unique_ptr<log_formatter>(new json_formatter);
+  } else {
+    formatter = std::unique_ptr<log_formatter>(new text_formatter);
+  }
+  binary_log_decoder decoder(std::move(formatter));
+
+  const size_t         chunk_size = 1024 * 1024;
+  std::vector<uint8_t> data;
+  size_t               pending = 0;
+  fmt::memory_buffer   out;
+
+  for (int i = optind; i < argc; ++i) {
+    std::FILE* f = std::fopen(argv[i], "rb");
+    if (!f) {
+      fprintf(stderr, "Error opening %s: %s\n", argv[i], std::strerror(errno));
+      return -1;
+    }
+
+    // Records may be split between reads and files, keep the undecoded tail for the next read.
+    size_t nof_read;
+    do {
+      data.resize(pending + chunk_size);
+      nof_read = std::fread(data.data() + pending, 1, chunk_size, f);
+      pending += nof_read;
+
+      int64_t consumed = decoder.decode(data.data(), pending, out);
+      if (consumed < 0) {
+        fprintf(stderr, "Error decoding %s: malformed binary log\n", argv[i]);
+        std::fclose(f);
+        return -1;
+      }
+      std::memmove(data.data(), data.data() + consumed, pending - consumed);
+      pending -= consumed;
+
+      std::fwrite(out.data(), 1, out.size(), stdout);
+      out.clear();
+    } while (nof_read == chunk_size);
+
+    std::fclose(f);
+  }
+
+  if (pending) {
+    fprintf(stderr, "Warning: the log ends with an incomplete record of %zu bytes\n", pending);
+  }
+
+  return 0;
+}
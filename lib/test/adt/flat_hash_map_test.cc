@@ -0,0 +1,120 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <map>
+#include <random>
+
+namespace srsran {
+
+void test_flat_hash_map_basic()
+{
+  flat_hash_map<uint32_t, std::string> mymap;
+  TESTASSERT(mymap.size() == 0 and mymap.empty());
+  TESTASSERT(mymap.begin() == mymap.end());
+  TESTASSERT(not mymap.contains(0) and mymap.find(0) == mymap.end());
+
+  TESTASSERT(mymap.emplace(0, "obj0").second);
+  TESTASSERT(mymap.contains(0) and mymap.at(0) == "obj0");
+  TESTASSERT(not mymap.emplace(0, "obj1").second);
+  TESTASSERT(mymap.at(0) == "obj0");
+  TESTASSERT(mymap.insert(std::make_pair(5U, std::string("obj5"))).second);
+  mymap[7] = "obj7";
+  TESTASSERT(mymap.size() == 3 and mymap.count(7) == 1);
+  TESTASSERT(mymap.find(5)->second == "obj5");
+
+  size_t nof_elems = 0;
+  for (auto& e : mymap) {
+    TESTASSERT(e.second == "obj" + std::to_string(e.first));
+    nof_elems++;
+  }
+  TESTASSERT(nof_elems == 3);
+
+  TESTASSERT(mymap.erase(5) == 1);
+  TESTASSERT(mymap.erase(5) == 0);
+  TESTASSERT(not mymap.contains(5) and mymap.size() == 2);
+
+  mymap.clear();
+  TESTASSERT(mymap.empty() and mymap.begin() == mymap.end());
+}
+
+/// IPv4 addresses in network byte order only differ in their upper bits
+void test_flat_hash_map_ip_keys()
+{
+  flat_hash_map<uint32_t, uint32_t> ip_map;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    TESTASSERT(ip_map.emplace(htonl(0xac100002 + i), i).second);
+  }
+  TESTASSERT(ip_map.size() == 1000 and ip_map.capacity() >= 2000);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    auto it = ip_map.find(htonl(0xac100002 + i));
+    TESTASSERT(it != ip_map.end() and it->second == i);
+  }
+  TESTASSERT(not ip_map.contains(htonl(0xac100001)));
+}
+
+/// Random inserts/erases checked against std::map, to stress backward-shift deletion
+void test_flat_hash_map_random()
+{
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint16_t> key_dist(0, 511);
+  flat_hash_map<uint16_t, uint32_t>       map;
+  std::map<uint16_t, uint32_t>            ref;
+
+  for (uint32_t i = 0; i < 100000; ++i) {
+    uint16_t key = key_dist(rgen);
+    if (rgen() % 2 == 0) {
+      TESTASSERT(map.emplace(key, i).second == ref.emplace(key, i).second);
+    } else {
+      TESTASSERT(map.erase(key) == ref.erase(key));
+    }
+    TESTASSERT(map.size() == ref.size());
+  }
+  for (auto& e : ref) {
+    auto it = map.find(e.first);
+    TESTASSERT(it != map.end() and it->second == e.second);
+  }
+  size_t nof_elems = 0;
+  for (auto& e : map) {
+    TESTASSERT(ref.count(e.first) == 1);
+    nof_elems++;
+  }
+  TESTASSERT(nof_elems == ref.size());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_flat_hash_map_basic();
+  srsran::test_flat_hash_map_ip_keys();
+  srsran::test_flat_hash_map_random();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,241 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/ngap.h"
+#include "srsran/asn1/rrc_nr.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/config.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <new>
+
+/*
+ * Compares the decoding of S1AP, NGAP and NR RRC messages with the containers allocated from the heap against the
+ * same decoding with an unpack_arena that is reset after every message.
+ */
+
+static uint32_t nof_repetitions = 10000;
+
+static std::atomic<uint64_t> nof_heap_allocs = {0};
+
+void* operator new(std::size_t sz)
+{
+  nof_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = malloc(sz > 0 ? sz : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void* operator new[](std::size_t sz)
+{
+  return operator new(sz);
+}
+void operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+  free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  free(ptr);
+}
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n Number of repetitions [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// InitialContextSetupRequest with one E-RAB and a NAS Attach Accept
+static const uint8_t s1ap_msg[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+// PDUSessionResourceSetupRequest with one PDU session
+static const uint8_t ngap_msg[] = {
+    0x00, 0x1d, 0x00, 0x6c, 0x00, 0x00, 0x04, 0x00, 0x0a, 0x00, 0x02, 0x00, 0x01, 0x00, 0x55, 0x00, 0x02, 0x00, 0x01,
+    0x00, 0x26, 0x00, 0x2e, 0x2d, 0x7e, 0x00, 0x68, 0x01, 0x00, 0x25, 0x2e, 0x01, 0x00, 0xc2, 0x11, 0x00, 0x06, 0x01,
+    0x00, 0x03, 0x30, 0x01, 0x01, 0x06, 0x06, 0x03, 0xe8, 0x06, 0x03, 0xe8, 0x29, 0x05, 0x01, 0xc0, 0xa8, 0x0c, 0x7b,
+    0x25, 0x08, 0x07, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x12, 0x01, 0x00, 0x4a, 0x00, 0x27, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x21, 0x00, 0x00, 0x03, 0x00, 0x8b, 0x00, 0x0a, 0x01, 0xf0, 0xc0, 0xa8, 0x11, 0xd2, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x86, 0x00, 0x01, 0x10, 0x00, 0x88, 0x00, 0x07, 0x00, 0x01, 0x00, 0x00, 0x09, 0x00, 0x00};
+
+// RRCReconfiguration with a secondaryCellGroup for EN-DC
+static const uint8_t rrc_nr_msg[] = "\x08\x81\x7c\x5c\x40\xb1\xc0\x7d\x48\x3a\x04\xc0\x3e\x01\x04\x54"
+                                    "\x1e\xb5\x00\x02\xe8\x53\x98\xdf\x46\x93\x4b\x80\x04\xd2\x69\x34"
+                                    "\x00\x00\x08\xc9\x8d\x6d\x8c\xa2\x01\xff\x00\x00\x00\x00\x01\x1b"
+                                    "\x82\x21\x00\x00\x04\x04\x00\xd1\x14\x0e\x70\x00\x00\x08\xc9\xc6"
+                                    "\xb6\xc6\x44\xa0\x00\x1e\xb8\x95\x63\xe0\x24\x94\x22\x0d\xb8\x44"
+                                    "\x70\x0c\x02\x10\xb0\x1d\x80\x48\xf1\x18\x06\xea\x00\x08\x0e\x01"
+                                    "\x25\xc0\xc8\x80\x37\x08\x42\x00\x00\x88\x16\x50\x02\x0c\x82\x00"
+                                    "\x00\x20\x69\x81\x01\x45\x0a\x00\x0e\x48\x18\x00\x01\x33\x55\x64"
+                                    "\x84\x1c\x00\x10\x40\xc2\x05\x0c\x1c\x9c\x40\x91\x42\xc6\x0d\x1c"
+                                    "\x3c\x8e\x00\x00\x32\x21\x40\x30\x20\x01\x91\x4a\x01\x82\x00\x0c"
+                                    "\x8c\x50\x0c\x18\x00\x64\x42\x80\xe1\x00\x03\x22\x94\x07\x0a\x00"
+                                    "\x19\x18\xa0\x38\x60\x00\xc8\x85\x02\xc3\x80\x06\x45\x28\x16\x20"
+                                    "\x64\x00\x41\x6c\x48\x04\x62\x82\x18\xa0\x08\xc5\x04\xb1\x60\x11"
+                                    "\x8a\x0a\x63\x00\x23\x14\x16\xc6\x80\x46\x28\x31\x8e\x00\x8c\x50"
+                                    "\x6b\x1e\x01\x18\xa0\xe6\x40\x00\x32\x31\x40\xb2\x23\x10\x0a\x08"
+                                    "\x40\x90\x86\x05\x10\x43\xcc\x3b\x2a\x6e\x4d\x01\xa4\x92\x1e\x2e"
+                                    "\xe0\x0c\x10\xe0\x00\x00\x01\x8f\xfd\x29\x49\x8c\x63\x72\x81\x60"
+                                    "\x00\x02\x19\x70\x00\x00\x00\x00\x00\x00\x52\xf0\x0f\xa0\x84\x8a"
+                                    "\xd5\x45\x00\x47\x00\x18\x00\x08\x20\x00\xe2\x10\x02\x40\x80\x70"
+                                    "\x10\x10\x84\x00\x0e\x21\x00\x1c\xb0\x0e\x04\x02\x20\x80\x01\xc4"
+                                    "\x20\x03\x96\x01\xc0\xc0\x42\x10\x00\x38\x84\x00\x73\x00\x38\x20"
+                                    "\x08\x82\x00\x07\x10\x80\x0e\x60\x00\x40\x00\x00\x04\x10\xc0\x40"
+                                    "\x80\xc1\x00\xe0\xd0\x00\x0e\x48\x10\x00\x00\x02\x00\x40\x00\x80"
+                                    "\x60\x00\x80\x90\x02\x20\x0a\x40\x00\x02\x38\x90\x11\x31\xc8";
+
+static bool decode_s1ap()
+{
+  asn1::cbit_ref         bref(s1ap_msg, sizeof(s1ap_msg));
+  asn1::s1ap::s1ap_pdu_c pdu;
+  if (pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  return pdu.init_msg().value.init_context_setup_request()->erab_to_be_setup_list_ctxt_su_req.value.size() == 1;
+}
+
+static bool decode_ngap()
+{
+  asn1::cbit_ref         bref(ngap_msg, sizeof(ngap_msg));
+  asn1::ngap::ngap_pdu_c pdu;
+  if (pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  return pdu.init_msg().value.pdu_session_res_setup_request()->pdu_session_res_setup_list_su_req.value.size() == 1;
+}
+
+static bool decode_rrc_nr()
+{
+  asn1::cbit_ref                 bref(rrc_nr_msg, sizeof(rrc_nr_msg));
+  asn1::rrc_nr::rrc_recfg_s      rrc_recfg;
+  asn1::rrc_nr::cell_group_cfg_s cell_group_cfg;
+  if (rrc_recfg.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  const asn1::dyn_octstring& cell_group = rrc_recfg.crit_exts.rrc_recfg().secondary_cell_group;
+  asn1::cbit_ref             bref0(cell_group.data(), cell_group.size());
+  if (cell_group_cfg.unpack(bref0) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  return cell_group_cfg.rlc_bearer_to_add_mod_list.size() == 1;
+}
+
+template <typename F>
+static int run_benchmark(const char* name, F&& decode)
+{
+  // Heap: every container of the message is allocated and freed individually
+  uint64_t allocs_start = nof_heap_allocs.load(std::memory_order_relaxed);
+  auto     tp_start     = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    if (not decode()) {
+      printf("%s: failed to decode the message\n", name);
+      return SRSRAN_ERROR;
+    }
+  }
+  auto     tp_end      = std::chrono::steady_clock::now();
+  uint64_t heap_ns     = std::chrono::duration_cast<std::chrono::nanoseconds>(tp_end - tp_start).count();
+  uint64_t heap_allocs = nof_heap_allocs.load(std::memory_order_relaxed) - allocs_start;
+
+  // Arena: the message is destroyed at the end of decode(), before the arena is reset for the next one
+  asn1::unpack_arena arena;
+  allocs_start = nof_heap_allocs.load(std::memory_order_relaxed);
+  tp_start     = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    bool ret;
+    {
+      asn1::unpack_arena_scope scope(arena);
+      ret = decode();
+    }
+    arena.reset();
+    if (not ret) {
+      printf("%s: failed to decode the message with the arena\n", name);
+      return SRSRAN_ERROR;
+    }
+  }
+  tp_end                = std::chrono::steady_clock::now();
+  uint64_t arena_ns     = std::chrono::duration_cast<std::chrono::nanoseconds>(tp_end - tp_start).count();
+  uint64_t arena_allocs = nof_heap_allocs.load(std::memory_order_relaxed) - allocs_start;
+
+  printf("%-10s heap: %8.1f ns/msg %6.1f allocs/msg, arena: %8.1f ns/msg %6.1f allocs/msg, speedup: %.2f\n",
+         name,
+         (double)heap_ns / nof_repetitions,
+         (double)heap_allocs / nof_repetitions,
+         (double)arena_ns / nof_repetitions,
+         (double)arena_allocs / nof_repetitions,
+         (double)heap_ns / arena_ns);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Logs of the ASN.1 library are not wanted in the measurements
+  srslog::fetch_basic_logger("ASN1").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  int ret = run_benchmark("S1AP", decode_s1ap);
+  if (ret == SRSRAN_SUCCESS) {
+    ret = run_benchmark("NGAP", decode_ngap);
+  }
+  if (ret == SRSRAN_SUCCESS) {
+    ret = run_benchmark("RRC NR", decode_rrc_nr);
+  }
+
+  srslog::flush();
+  return ret;
+}
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/rrc/dl_dcch_msg.h"
+#include "srsran/asn1/rrc_nr.h"
+#include "srsran/config.h"
+#include "srsran/srslog/srslog.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+/*
+ * Measures the throughput of the asn1::bit_ref and cbit_ref primitives, and of the packing and unpacking of messages
+ * of the large generated codecs: an NR RRCReconfiguration with its CellGroupConfig (rrc_nr.cc), and an LTE
+ * RRCConnectionReconfiguration with a RadioResourceConfigDedicated (rr_ded.cc).
+ */
+
+static uint32_t nof_repetitions = 1000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n Number of repetitions [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// RRCReconfiguration with a secondaryCellGroup for EN-DC
+static const uint8_t rrc_nr_msg[] = "\x08\x81\x7c\x5c\x40\xb1\xc0\x7d\x48\x3a\x04\xc0\x3e\x01\x04\x54"
+                                    "\x1e\xb5\x00\x02\xe8\x53\x98\xdf\x46\x93\x4b\x80\x04\xd2\x69\x34"
+                                    "\x00\x00\x08\xc9\x8d\x6d\x8c\xa2\x01\xff\x00\x00\x00\x00\x01\x1b"
+                                    "\x82\x21\x00\x00\x04\x04\x00\xd1\x14\x0e\x70\x00\x00\x08\xc9\xc6"
+                                    "\xb6\xc6\x44\xa0\x00\x1e\xb8\x95\x63\xe0\x24\x94\x22\x0d\xb8\x44"
+                                    "\x70\x0c\x02\x10\xb0\x1d\x80\x48\xf1\x18\x06\xea\x00\x08\x0e\x01"
+                                    "\x25\xc0\xc8\x80\x37\x08\x42\x00\x00\x88\x16\x50\x02\x0c\x82\x00"
+                                    "\x00\x20\x69\x81\x01\x45\x0a\x00\x0e\x48\x18\x00\x01\x33\x55\x64"
+                                    "\x84\x1c\x00\x10\x40\xc2\x05\x0c\x1c\x9c\x40\x91\x42\xc6\x0d\x1c"
+                                    "\x3c\x8e\x00\x00\x32\x21\x40\x30\x20\x01\x91\x4a\x01\x82\x00\x0c"
+                                    "\x8c\x50\x0c\x18\x00\x64\x42\x80\xe1\x00\x03\x22\x94\x07\x0a\x00"
+                                    "\x19\x18\xa0\x38\x60\x00\xc8\x85\x02\xc3\x80\x06\x45\x28\x16\x20"
+                                    "\x64\x00\x41\x6c\x48\x04\x62\x82\x18\xa0\x08\xc5\x04\xb1\x60\x11"
+                                    "\x8a\x0a\x63\x00\x23\x14\x16\xc6\x80\x46\x28\x31\x8e\x00\x8c\x50"
+                                    "\x6b\x1e\x01\x18\xa0\xe6\x40\x00\x32\x31\x40\xb2\x23\x10\x0a\x08"
+                                    "\x40\x90\x86\x05\x10\x43\xcc\x3b\x2a\x6e\x4d\x01\xa4\x92\x1e\x2e"
+                                    "\xe0\x0c\x10\xe0\x00\x00\x01\x8f\xfd\x29\x49\x8c\x63\x72\x81\x60"
+                                    "\x00\x02\x19\x70\x00\x00\x00\x00\x00\x00\x52\xf0\x0f\xa0\x84\x8a"
+                                    "\xd5\x45\x00\x47\x00\x18\x00\x08\x20\x00\xe2\x10\x02\x40\x80\x70"
+                                    "\x10\x10\x84\x00\x0e\x21\x00\x1c\xb0\x0e\x04\x02\x20\x80\x01\xc4"
+                                    "\x20\x03\x96\x01\xc0\xc0\x42\x10\x00\x38\x84\x00\x73\x00\x38\x20"
+                                    "\x08\x82\x00\x07\x10\x80\x0e\x60\x00\x40\x00\x00\x04\x10\xc0\x40"
+                                    "\x80\xc1\x00\xe0\xd0\x00\x0e\x48\x10\x00\x00\x02\x00\x40\x00\x80"
+                                    "\x60\x00\x80\x90\x02\x20\x0a\x40\x00\x02\x38\x90\x11\x31\xc8";
+
+// RRCConnectionReconfiguration for a handover, with MobilityControlInfo and RadioResourceConfigDedicated
+static const uint8_t rrc_lte_msg[] = {
+    0x20, 0x1b, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x01, 0xa9, 0x08, 0x80, 0x00, 0x00, 0x29, 0x00, 0x97, 0x80, 0x00, 0x00,
+    0x00, 0x01, 0x04, 0x22, 0x14, 0x00, 0xf8, 0x02, 0x0a, 0xc0, 0x60, 0x00, 0xa0, 0x0c, 0x80, 0x42, 0x02, 0x9f, 0x43,
+    0x07, 0xda, 0xbc, 0xf8, 0x4b, 0x32, 0x18, 0x34, 0xc0, 0x00, 0x2d, 0x68, 0x08, 0x5e, 0x18, 0x00, 0x16, 0x80, 0x00};
+
+template <typename F>
+static bool run_benchmark(const char* name, uint32_t nof_bytes, F&& func)
+{
+  auto tp_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    if (not func()) {
+      printf("%s: failed\n", name);
+      return false;
+    }
+  }
+  auto     tp_end = std::chrono::steady_clock::now();
+  uint64_t nof_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp_end - tp_start).count();
+  printf("%-32s %10.1f ns/call %8.1f Mbps\n",
+         name,
+         (double)nof_ns / nof_repetitions,
+         (double)nof_bytes * 8 * nof_repetitions * 1000 / nof_ns);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("ASN1").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  // Fields of random widths, as the PER encoding of constrained integers, enums and presence flags
+  std::mt19937                            rand_gen(0);
+  std::uniform_int_distribution<uint32_t> width_dist(1, 32);
+  std::vector<uint32_t>                   widths(1000), vals(widths.size());
+  uint32_t                                nof_bits = 0;
+  for (uint32_t i = 0; i < widths.size(); ++i) {
+    widths[i] = width_dist(rand_gen);
+    vals[i]   = rand_gen() & (uint32_t)((1ULL << widths[i]) - 1);
+    nof_bits += widths[i];
+  }
+  std::vector<uint8_t> buf(nof_bits / 8 + 1024);
+
+  bool ok = run_benchmark("bit_ref::pack fields", nof_bits / 8, [&]() {
+    asn1::bit_ref bref(buf.data(), buf.size());
+    for (uint32_t i = 0; i < widths.size(); ++i) {
+      if (bref.pack(vals[i], widths[i]) != asn1::SRSASN_SUCCESS) {
+        return false;
+      }
+    }
+    return true;
+  });
+  ok = ok and run_benchmark("cbit_ref::unpack fields", nof_bits / 8, [&]() {
+         asn1::cbit_ref bref(buf.data(), buf.size());
+         for (uint32_t i = 0; i < widths.size(); ++i) {
+           uint32_t val;
+           if (bref.unpack(val, widths[i]) != asn1::SRSASN_SUCCESS or val != vals[i]) {
+             return false;
+           }
+         }
+         return true;
+       });
+
+  // Octet strings not aligned to a byte boundary, as the NAS PDUs and containers of the RRC messages
+  std::vector<uint8_t> octets(1000);
+  for (uint8_t& b : octets) {
+    b = rand_gen();
+  }
+  ok = ok and run_benchmark("bit_ref::pack_bytes unaligned", octets.size(), [&]() {
+         asn1::bit_ref bref(buf.data(), buf.size());
+         return bref.pack(0, 3) == asn1::SRSASN_SUCCESS and
+                bref.pack_bytes(octets.data(), octets.size()) == asn1::SRSASN_SUCCESS;
+       });
+  std::vector<uint8_t> octets2(octets.size());
+  ok = ok and run_benchmark("cbit_ref::unpack_bytes unaligned", octets.size(), [&]() {
+         asn1::cbit_ref bref(buf.data(), buf.size());
+         uint8_t        val;
+         return bref.unpack(val, 3) == asn1::SRSASN_SUCCESS and
+                bref.unpack_bytes(octets2.data(), octets2.size()) == asn1::SRSASN_SUCCESS and octets2 == octets;
+       });
+
+  // NR RRCReconfiguration and its CellGroupConfig
+  asn1::rrc_nr::rrc_recfg_s      rrc_recfg;
+  asn1::rrc_nr::cell_group_cfg_s cell_group_cfg;
+  ok = ok and run_benchmark("rrc_nr unpack RRCReconfiguration", sizeof(rrc_nr_msg), [&]() {
+         asn1::cbit_ref bref(rrc_nr_msg, sizeof(rrc_nr_msg));
+         if (rrc_recfg.unpack(bref) != asn1::SRSASN_SUCCESS) {
+           return false;
+         }
+         const asn1::dyn_octstring& cell_group = rrc_recfg.crit_exts.rrc_recfg().secondary_cell_group;
+         asn1::cbit_ref             bref0(cell_group.data(), cell_group.size());
+         return cell_group_cfg.unpack(bref0) == asn1::SRSASN_SUCCESS;
+       });
+  ok = ok and run_benchmark("rrc_nr pack RRCReconfiguration", sizeof(rrc_nr_msg), [&]() {
+         asn1::bit_ref bref(buf.data(), buf.size());
+         return cell_group_cfg.pack(bref) == asn1::SRSASN_SUCCESS and rrc_recfg.pack(bref) == asn1::SRSASN_SUCCESS;
+       });
+
+  // LTE RRCConnectionReconfiguration
+  asn1::rrc::dl_dcch_msg_s dl_dcch_msg;
+  ok = ok and run_benchmark("rrc unpack RRCConnReconfiguration", sizeof(rrc_lte_msg), [&]() {
+         asn1::cbit_ref bref(rrc_lte_msg, sizeof(rrc_lte_msg));
+         return dl_dcch_msg.unpack(bref) == asn1::SRSASN_SUCCESS;
+       });
+  ok = ok and run_benchmark("rrc pack RRCConnReconfiguration", sizeof(rrc_lte_msg), [&]() {
+         asn1::bit_ref bref(buf.data(), buf.size());
+         return dl_dcch_msg.pack(bref) == asn1::SRSASN_SUCCESS and
+                bref.distance_bytes() == (int)sizeof(rrc_lte_msg) and memcmp(buf.data(), rrc_lte_msg, 8) == 0;
+       });
+
+  srslog::flush();
+  return ok ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
@@ -177,6 +177,41 @@ int test_bit_ref()
     TESTASSERT(memcmp(buf2, buf3, nof_bytes) == 0);
   }
 
+  // fields of all widths at all offsets match the bit-by-bit encoding
+  {
+    uint8_t  buf2[1024];
+    bit_ref  bref(&buf[0], sizeof(buf)), bref2(&buf2[0], sizeof(buf2));
+    uint64_t vals[64];
+    for (uint32_t n_bits = 1; n_bits < 64; ++n_bits) {
+      vals[n_bits] = (0x0123456789abcdefULL * n_bits) & ((1ULL << n_bits) - 1);
+      TESTASSERT(bref.pack(vals[n_bits], n_bits) == SRSASN_SUCCESS);
+      for (uint32_t i = n_bits; i > 0; --i) {
+        TESTASSERT(bref2.pack((vals[n_bits] >> (i - 1)) & 1, 1) == SRSASN_SUCCESS);
+      }
+    }
+    TESTASSERT(bref.distance() == bref2.distance());
+    TESTASSERT(memcmp(buf, buf2, bref.distance_bytes()) == 0);
+    cbit_ref cbref(&buf[0], bref.distance_bytes());
+    for (uint32_t n_bits = 1; n_bits < 64; ++n_bits) {
+      uint64_t val;
+      TESTASSERT(cbref.unpack(val, n_bits) == SRSASN_SUCCESS);
+      TESTASSERT(val == vals[n_bits]);
+    }
+    TESTASSERT(cbref.distance() == bref.distance());
+  }
+
+  // packing zeroes the rest of the last byte written, and leaves the following bytes untouched
+  {
+    memset(buf, 0xff, 16);
+    bit_ref bref(&buf[0], sizeof(buf));
+    TESTASSERT(bref.pack(0, 3) == SRSASN_SUCCESS);
+    TESTASSERT(bref.pack(1, 6) == SRSASN_SUCCESS);
+    TESTASSERT(buf[0] == 0x00 and buf[1] == 0x80 and buf[2] == 0xff);
+    uint8_t bytes[] = {0xaa, 0xbb};
+    TESTASSERT(bref.pack_bytes(bytes, sizeof(bytes)) == SRSASN_SUCCESS);
+    TESTASSERT(buf[1] == 0xd5 and buf[2] == 0x5d and buf[3] == 0x80 and buf[4] == 0xff);
+  }
+
   // test advance bits
   {
     bit_ref bref(&buf[0], sizeof(buf));
@@ -480,6 +515,85 @@ int test_seq_of()
   return 0;
 }
 
+int test_unpack_arena()
+{
+  unpack_arena arena(256);
+  TESTASSERT(current_unpack_arena() == nullptr);
+
+  dyn_array<uint32_t> vec;
+  {
+    unpack_arena_scope scope(arena);
+    TESTASSERT(current_unpack_arena() == &arena);
+
+    // storage comes from the arena and the array still behaves as a vector
+    vec.resize(8);
+    TESTASSERT(arena.nof_bytes_allocated() == 8 * sizeof(uint32_t));
+    std::iota(vec.begin(), vec.end(), 0);
+    for (uint32_t i = 0; i < 100; ++i) {
+      vec.push_back(8 + i);
+    }
+    TESTASSERT(vec.size() == 108);
+    for (uint32_t i = 0; i < vec.size(); ++i) {
+      TESTASSERT(vec[i] == i);
+    }
+    TESTASSERT(vec.capacity() >= vec.size());
+    // allocations bigger than a block get a block of their own
+    TESTASSERT(arena.nof_blocks() > 1);
+
+    // non-trivial elements get constructed and destroyed in place
+    dyn_array<dyn_array<uint8_t> > nested(3);
+    nested[1].resize(10);
+    nested[2] = nested[1];
+    TESTASSERT(nested[2].size() == 10);
+
+    // nested scopes restore the previous arena
+    unpack_arena other_arena;
+    {
+      unpack_arena_scope scope2(other_arena);
+      TESTASSERT(current_unpack_arena() == &other_arena);
+    }
+    TESTASSERT(current_unpack_arena() == &arena);
+  }
+  TESTASSERT(current_unpack_arena() == nullptr);
+
+  // out of the scope, arena arrays are reallocated in the heap
+  uint32_t arena_cap = vec.capacity();
+  vec.resize(arena_cap + 1);
+  TESTASSERT(vec.size() == arena_cap + 1);
+  for (uint32_t i = 0; i < 108; ++i) {
+    TESTASSERT(vec[i] == i);
+  }
+
+  // reset() keeps the blocks for the next message
+  uint32_t nof_blocks = arena.nof_blocks();
+  arena.reset();
+  TESTASSERT(arena.nof_bytes_allocated() == 0);
+  {
+    unpack_arena_scope  scope(arena);
+    dyn_array<uint64_t> vec(16);
+    TESTASSERT(reinterpret_cast<uintptr_t>(vec.data()) % alignof(uint64_t) == 0);
+  }
+  TESTASSERT(arena.nof_blocks() == nof_blocks);
+
+  // unpack of a sequence of octet strings with the arena
+  dyn_seq_of<dyn_octstring, 0, 16> seq(dyn_array<dyn_octstring>(5)), seq2;
+  for (uint32_t i = 0; i < seq.size(); ++i) {
+    seq[i].resize(i + 1);
+    std::fill(seq[i].data(), seq[i].data() + seq[i].size(), i);
+  }
+  uint8_t buf[64] = {};
+  bit_ref bref(buf, sizeof(buf));
+  TESTASSERT(seq.pack(bref) == SRSASN_SUCCESS);
+  arena.reset();
+  cbit_ref cbref(buf, sizeof(buf));
+  TESTASSERT(unpack_with_arena(seq2, cbref, arena) == SRSASN_SUCCESS);
+  TESTASSERT(seq2 == seq);
+  TESTASSERT(arena.nof_bytes_allocated() >= 5 * sizeof(dyn_octstring) + 15);
+  TESTASSERT(current_unpack_arena() == nullptr);
+
+  return 0;
+}
+
 int test_copy_ptr()
 {
   typedef fixed_octstring<10> TestType;
@@ -693,6 +807,7 @@ int main()
   TESTASSERT(test_oct_string() == 0);
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
+  TESTASSERT(test_unpack_arena() == 0);
   TESTASSERT(test_copy_ptr() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
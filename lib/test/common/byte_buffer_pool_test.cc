@@ -0,0 +1,128 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/byte_buffer_queue.h"
+#include <thread>
+
+using namespace srsran;
+
+int test_byte_buffer_size_classes()
+{
+  // Size class is selected based on the payload size
+  TESTASSERT(byte_buffer_select_class(60) == byte_buffer_size_class::small);
+  TESTASSERT(byte_buffer_select_class(1500) == byte_buffer_size_class::medium);
+  TESTASSERT(byte_buffer_select_class(9000) == byte_buffer_size_class::large);
+
+  uint8_t payload[1500];
+  for (uint32_t i = 0; i < sizeof(payload); ++i) {
+    payload[i] = i;
+  }
+
+  unique_byte_buffer_t small = make_byte_buffer(payload, 60, __FUNCTION__);
+  TESTASSERT(small != nullptr);
+  TESTASSERT(small->N_bytes == 60);
+  TESTASSERT(memcmp(small->msg, payload, 60) == 0);
+  TESTASSERT(small->get_headroom() == SRSRAN_BUFFER_HEADER_OFFSET);
+  TESTASSERT(small->get_tailroom() == SRSRAN_BYTE_BUFFER_SMALL_PAYLOAD_SIZE - 60);
+
+  unique_byte_buffer_t medium = make_byte_buffer(payload, sizeof(payload), __FUNCTION__);
+  TESTASSERT(medium != nullptr);
+  TESTASSERT(medium->get_tailroom() == SRSRAN_BYTE_BUFFER_MEDIUM_PAYLOAD_SIZE - sizeof(payload));
+
+  unique_byte_buffer_t large = make_byte_buffer();
+  TESTASSERT(large != nullptr);
+  TESTASSERT(large->get_tailroom() == SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+
+  // Copy between size classes
+  *large = *small;
+  TESTASSERT(large->N_bytes == 60);
+  *small = *large;
+  TESTASSERT(small->N_bytes == 60);
+  TESTASSERT(memcmp(small->msg, payload, 60) == 0);
+
+  byte_buffer_pool_metrics_t metrics = get_byte_buffer_pool_metrics();
+  for (const auto& m : metrics.classes) {
+    TESTASSERT(m.nof_blocks > 0);
+    TESTASSERT(m.nof_free_blocks < m.nof_blocks);
+    TESTASSERT(m.block_size > m.payload_size);
+  }
+  TESTASSERT(metrics.classes[(size_t)byte_buffer_size_class::small].block_size <
+             metrics.classes[(size_t)byte_buffer_size_class::medium].block_size);
+  TESTASSERT(metrics.classes[(size_t)byte_buffer_size_class::medium].block_size <
+             metrics.classes[(size_t)byte_buffer_size_class::large].block_size);
+
+  small.reset();
+  medium.reset();
+  large.reset();
+  metrics = get_byte_buffer_pool_metrics();
+  for (const auto& m : metrics.classes) {
+    TESTASSERT(m.nof_free_blocks == m.nof_blocks);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// One thread allocates, the other deallocates. The deallocating thread must hand the blocks back to the allocator.
+int test_byte_buffer_producer_consumer()
+{
+  const uint32_t    nof_pdus = 100000;
+  byte_buffer_queue q;
+  bool              alloc_failed = false;
+
+  std::thread t([&q, &alloc_failed, nof_pdus]() {
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      unique_byte_buffer_t pdu = make_byte_buffer(byte_buffer_size_class::small);
+      uint32_t             nof_retries = 0;
+      while (pdu == nullptr) {
+        // consumer has not released the blocks yet
+        if (++nof_retries > 1000000) {
+          alloc_failed = true;
+          return;
+        }
+        std::this_thread::yield();
+        pdu = make_byte_buffer(byte_buffer_size_class::small);
+      }
+      memcpy(pdu->msg, &i, sizeof(i));
+      pdu->N_bytes = sizeof(i);
+      q.write(std::move(pdu));
+    }
+  });
+
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    unique_byte_buffer_t pdu = q.read();
+    uint32_t             r   = 0;
+    memcpy(&r, pdu->msg, sizeof(r));
+    TESTASSERT(r == i);
+  }
+  t.join();
+  TESTASSERT(not alloc_failed);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_byte_buffer_size_classes() == SRSRAN_SUCCESS);
+  TESTASSERT(test_byte_buffer_producer_consumer() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/latency_histogram.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+int test_bins()
+{
+  TESTASSERT(latency_hist_bin(0) == 0);
+  TESTASSERT(latency_hist_bin(1023) == 0);
+  TESTASSERT(latency_hist_bin(1024) == 1);
+  TESTASSERT(latency_hist_bin(1279) == 1);
+  TESTASSERT(latency_hist_bin(1280) == 2);
+  TESTASSERT(latency_hist_bin(2047) == 4);
+  TESTASSERT(latency_hist_bin(2048) == 5);
+  TESTASSERT(latency_hist_bin(1ULL << 40) == LATENCY_HIST_NOF_BINS - 1);
+
+  // Every bounded bin starts where the previous one ends
+  for (uint32_t bin = 0; bin + 1 < LATENCY_HIST_NOF_BINS; ++bin) {
+    uint64_t bin_max = latency_hist_bin_max_ns(bin);
+    TESTASSERT(latency_hist_bin(bin_max - 1) == bin);
+    TESTASSERT(latency_hist_bin(bin_max) == bin + 1);
+  }
+  // The last bounded bin covers the 1 ms deadlines with room to spare
+  TESTASSERT(latency_hist_bin_max_ns(LATENCY_HIST_NOF_BINS - 2) > 16000000);
+  return SRSRAN_SUCCESS;
+}
+
+int test_metrics()
+{
+  latency_histogram hist;
+  for (uint32_t i = 1; i <= 100; ++i) {
+    hist.record(std::chrono::microseconds(i));
+  }
+  hist.record(std::chrono::nanoseconds(-5));
+
+  latency_hist_metrics_t m = hist.read_metrics();
+  TESTASSERT(m.count == 101);
+  TESTASSERT(m.sum_ns == 5050 * 1000);
+  TESTASSERT(m.max_ns == 100000);
+  TESTASSERT(m.bins[0] == 1);
+  TESTASSERT(m.percentile_us(1.0) == 100.0);
+  // Percentiles are rounded up to the bin bounds, which are at most 25% apart
+  TESTASSERT(m.percentile_us(0.5) >= 50.0 and m.percentile_us(0.5) <= 50.0 * 1.25);
+  TESTASSERT(m.percentile_us(0.99) >= 99.0 and m.percentile_us(0.99) <= 100.0);
+
+  // Reading clears the histogram
+  m = hist.read_metrics();
+  TESTASSERT(m.count == 0);
+  TESTASSERT(m.max_ns == 0);
+  TESTASSERT(m.mean_us() == 0.0);
+  TESTASSERT(m.percentile_us(0.99) == 0.0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_concurrent_recording()
+{
+  const uint32_t nof_threads = latency_histogram::nof_shards + 4, nof_samples = 10000;
+
+  latency_histogram        hist;
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < nof_threads; ++t) {
+    threads.emplace_back([&hist, t]() {
+      for (uint32_t i = 0; i < nof_samples; ++i) {
+        hist.record(std::chrono::microseconds(t + 1));
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  latency_hist_metrics_t m = hist.read_metrics();
+  TESTASSERT(m.count == nof_threads * nof_samples);
+  TESTASSERT(m.max_ns == nof_threads * 1000);
+  uint64_t nof_binned = 0;
+  for (uint64_t n : m.bins) {
+    nof_binned += n;
+  }
+  TESTASSERT(nof_binned == m.count);
+  return SRSRAN_SUCCESS;
+}
+
+int test_tti_stages()
+{
+  get_tti_latency_metrics();
+  {
+    tti_latency_scope scope(tti_stage::fft);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  tti_latency_metrics_t m = get_tti_latency_metrics();
+  for (uint32_t i = 0; i < NOF_TTI_STAGES; ++i) {
+    TESTASSERT(m.stages[i].count == ((tti_stage)i == tti_stage::fft ? 1 : 0));
+  }
+  TESTASSERT(m.stages[(uint32_t)tti_stage::fft].max_ns >= 100000);
+  TESTASSERT(std::string(tti_stage_to_string(tti_stage::mac_sched)) == "mac_sched");
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_bins() == SRSRAN_SUCCESS);
+  TESTASSERT(test_metrics() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_recording() == SRSRAN_SUCCESS);
+  TESTASSERT(test_tti_stages() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
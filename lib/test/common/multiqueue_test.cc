@@ -26,6 +26,7 @@
 #include <iostream>
 #include <map>
 #include <random>
+#include <set>
 #include <thread>
 #include <unistd.h>
 
@@ -410,6 +411,96 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_work_stealing_pool()
+{
+  std::cout << "\n====== TEST work stealing pool test 1: start ======\n";
+  // Description: several external threads fork tasks that fork tasks themselves (like PHY workers splitting a TTI in
+  //              carriers and users). Every thread must see all its tasks finished when wait() returns.
+
+  uint32_t nof_workers = 3, nof_ext_threads = 2, nof_runs = 200, nof_carriers = 3, nof_users = 8;
+
+  work_stealing_pool pool(nof_workers, nof_ext_threads);
+  std::atomic<bool>  failed{false};
+
+  auto ext_thread = [&]() {
+    for (uint32_t run = 0; run < nof_runs; ++run) {
+      std::vector<std::atomic<uint32_t> > count(nof_carriers);
+      work_stealing_pool::task_group      carriers;
+      for (uint32_t cc = 0; cc < nof_carriers; ++cc) {
+        count[cc] = 0;
+        pool.push_task(carriers, [&pool, &count, cc, nof_users]() {
+          work_stealing_pool::task_group users;
+          for (uint32_t u = 0; u < nof_users; ++u) {
+            pool.push_task(users, [&count, cc]() { count[cc]++; });
+          }
+          pool.wait(users);
+          // All users finished, mark the carrier as complete
+          count[cc] += 1000;
+        });
+      }
+      pool.wait(carriers);
+      if (carriers.nof_pending() != 0) {
+        failed = true;
+      }
+      for (uint32_t cc = 0; cc < nof_carriers; ++cc) {
+        if (count[cc] != 1000 + nof_users) {
+          failed = true;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < nof_ext_threads; ++i) {
+    threads.emplace_back(ext_thread);
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  std::cout << "stolen tasks: " << pool.nof_stolen_tasks() << "\n";
+  pool.stop();
+
+  TESTASSERT(not failed);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_work_stealing_pool2()
+{
+  std::cout << "\n====== TEST work stealing pool test 2: start ======\n";
+  // Description: a thread waiting for a group of long tasks must get them stolen by the idle pool threads
+
+  uint32_t nof_workers = 4;
+
+  work_stealing_pool             pool(nof_workers, 1);
+  work_stealing_pool::task_group group;
+  std::mutex                     mut;
+  std::set<std::thread::id>      thread_ids;
+  for (uint32_t i = 0; i < nof_workers + 1; ++i) {
+    pool.push_task(group, [&mut, &thread_ids]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+      std::lock_guard<std::mutex> lock(mut);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+  }
+  pool.wait(group);
+  TESTASSERT(group.nof_pending() == 0);
+  TESTASSERT(pool.nof_stolen_tasks() > 0);
+  TESTASSERT(thread_ids.size() > 1);
+
+  // Waiting on an empty group returns immediately
+  work_stealing_pool::task_group empty_group;
+  pool.wait(empty_group);
+
+  pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -504,5 +595,8 @@ int main()
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
 
+  TESTASSERT(test_work_stealing_pool() == 0);
+  TESTASSERT(test_work_stealing_pool2() == 0);
+
   TESTASSERT(test_inplace_task() == 0);
 }
@@ -130,6 +130,72 @@ int test_socket_handler()
   return 0;
 }
 
+int test_udp_burst_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  std::atomic<int>      counter   = {0};
+  std::atomic<uint32_t> nof_bytes = {0};
+  std::atomic<bool>     in_order  = {true};
+
+  srsran::unique_socket  server_socket, client_socket;
+  srsran::socket_manager sockhandler;
+  int                    server_port = 2152;
+  const char*            server_addr = "127.0.100.1";
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr(server_addr, server_port));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(client_socket.bind_addr("127.0.0.1", 0));
+
+  // register server Rx handler. The first byte of each datagram carries its index
+  auto burst_handler = [&logger, &counter, &nof_bytes, &in_order](srsran::rx_sdu_burst_t& burst) {
+    logger.info("Received burst of %zd datagrams", burst.size());
+    for (srsran::rx_sdu_t& rx_sdu : burst) {
+      if (rx_sdu.sdu->msg[0] != (uint8_t)counter) {
+        in_order = false;
+      }
+      nof_bytes += rx_sdu.sdu->N_bytes;
+      counter++;
+    }
+  };
+  rx_thread_tester rx_tester;
+  sockhandler.add_socket_handler(server_socket.fd(),
+                                 srsran::make_sdu_burst_handler(logger, rx_tester.task_queue, burst_handler));
+
+  // Send rounds of datagrams of all the byte buffer size classes. Each round fits in the socket receive buffer
+  std::vector<uint8_t> buf(4000);
+  int32_t              nof_rounds     = 10;
+  int32_t              nof_counts     = 10;
+  uint32_t             expected_bytes = 0;
+  sockaddr_in          server_addrin  = server_socket.get_addr_in();
+  for (int32_t round = 0; round < nof_rounds; ++round) {
+    for (int32_t i = round * nof_counts; i < (round + 1) * nof_counts; ++i) {
+      uint32_t len = 1 + (i * 397) % buf.size();
+      buf[0]       = i;
+      ssize_t n_sent =
+          sendto(client_socket.fd(), buf.data(), len, 0, (struct sockaddr*)&server_addrin, sizeof(server_addrin));
+      TESTASSERT(n_sent == len);
+      expected_bytes += len;
+    }
+
+    uint32_t time_elapsed = 0;
+    while (counter != (round + 1) * nof_counts) {
+      usleep(100);
+      time_elapsed += 100;
+      if (time_elapsed > 3000000) {
+        // too much time has passed
+        return -1;
+      }
+    }
+  }
+  TESTASSERT(in_order);
+  TESTASSERT(nof_bytes == expected_bytes);
+
+  return 0;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -157,6 +223,7 @@ int main()
   srslog::init();
 
   TESTASSERT(test_socket_handler() == 0);
+  TESTASSERT(test_udp_burst_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
   return 0;
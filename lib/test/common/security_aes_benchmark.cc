@@ -0,0 +1,147 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/common/security_aes.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+/*
+ * Compares the per-PDU 128-EEA2/128-EIA2 path, which expands the AES key for every PDU, against the cached key
+ * schedule and the burst API used by the PDCP entities.
+ */
+
+static uint32_t nof_repetitions = 200;
+static uint32_t pdu_len         = 1500;
+static uint32_t burst_size      = 32;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nsb]\n", prog);
+  printf("\t-n Number of repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s PDU size in bytes [Default %d]\n", pdu_len);
+  printf("\t-b Number of PDUs per burst [Default %d]\n", burst_size);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nsb")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        pdu_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        burst_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+template <typename F>
+static void run_benchmark(const char* name, F&& func)
+{
+  auto tp_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    func(i);
+  }
+  auto     tp_end  = std::chrono::steady_clock::now();
+  uint64_t nof_ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(tp_end - tp_start).count();
+  uint64_t nof_pdu = (uint64_t)nof_repetitions * burst_size;
+  printf("%-28s %8.1f ns/PDU %8.1f Mbps\n",
+         name,
+         (double)nof_ns / nof_pdu,
+         (double)nof_pdu * pdu_len * 8 * 1000 / nof_ns);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  std::mt19937                            rand_gen(0);
+  std::uniform_int_distribution<uint32_t> dist(0, 255);
+
+  uint8_t key[32];
+  for (uint8_t& b : key) {
+    b = dist(rand_gen);
+  }
+  std::vector<std::vector<uint8_t> > pdus(burst_size, std::vector<uint8_t>(pdu_len));
+  for (std::vector<uint8_t>& pdu : pdus) {
+    for (uint8_t& b : pdu) {
+      b = dist(rand_gen);
+    }
+  }
+  std::vector<uint8_t> out(pdu_len);
+  uint8_t              bearer    = 3;
+  uint8_t              direction = srsran::SECURITY_DIRECTION_DOWNLINK;
+  uint8_t              mac[4];
+
+  srsran::aes_128_key_schedule ks;
+  ks.set_key(&key[16]);
+
+  printf("AES backend: %s, PDU size: %d bytes, burst size: %d PDUs\n",
+         srsran::security_aes_backend_name(),
+         pdu_len,
+         burst_size);
+
+  run_benchmark("EEA2 key per PDU", [&](uint32_t rep) {
+    for (uint32_t i = 0; i < burst_size; i++) {
+      srsran::security_128_eea2(&key[16], rep * burst_size + i, bearer, direction, pdus[i].data(), pdu_len, out.data());
+    }
+  });
+
+  run_benchmark("EEA2 cached key schedule", [&](uint32_t rep) {
+    for (uint32_t i = 0; i < burst_size; i++) {
+      srsran::security_128_eea2(ks, rep * burst_size + i, bearer, direction, pdus[i].data(), pdu_len, pdus[i].data());
+    }
+  });
+
+  std::vector<srsran::cipher_burst_item_t> items(burst_size);
+  run_benchmark("EEA2 burst", [&](uint32_t rep) {
+    for (uint32_t i = 0; i < burst_size; i++) {
+      items[i] = {pdus[i].data(), pdus[i].data(), pdu_len, rep * burst_size + i};
+    }
+    srsran::security_128_eea2_burst(ks, bearer, direction, items);
+  });
+
+  run_benchmark("EIA2 key per PDU", [&](uint32_t rep) {
+    for (uint32_t i = 0; i < burst_size; i++) {
+      srsran::security_128_eia2(&key[16], rep * burst_size + i, bearer, direction, pdus[i].data(), pdu_len, mac);
+    }
+  });
+
+  run_benchmark("EIA2 cached key schedule", [&](uint32_t rep) {
+    for (uint32_t i = 0; i < burst_size; i++) {
+      srsran::security_128_eia2(ks, rep * burst_size + i, bearer, direction, pdus[i].data(), pdu_len, mac);
+    }
+  });
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/security_aes.h"
+#include "srsran/common/test_common.h"
+#include <random>
+#include <vector>
+
+/*
+ * Checks the 128-EEA2/128-EIA2 implementation with cached key schedules against the reference implementation in
+ * liblte_security. Document Reference: 33.401 V13.1.0 Annex C.1
+ */
+
+static std::mt19937 rand_gen(1234);
+
+static void random_bytes(uint8_t* buf, uint32_t len)
+{
+  std::uniform_int_distribution<uint32_t> dist(0, 255);
+  for (uint32_t i = 0; i < len; i++) {
+    buf[i] = (uint8_t)dist(rand_gen);
+  }
+}
+
+int test_eea2_test_set_1()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x15;
+  uint8_t  direction = 1;
+  uint8_t  msg[] = {0x98, 0x1b, 0xa6, 0x82, 0x4c, 0x1b, 0xfb, 0x1a, 0xb4, 0x85, 0x47, 0x20, 0x29, 0xb7, 0x1d, 0x80,
+                   0x8c, 0xe3, 0x3e, 0x2c, 0xc3, 0xc0, 0xb5, 0xfc, 0x1f, 0x3d, 0xe8, 0xa6, 0xdc, 0x66, 0xb1, 0xf0};
+  uint8_t  ct[]  = {0xe9, 0xfe, 0xd8, 0xa6, 0x3d, 0x15, 0x53, 0x04, 0xd7, 0x1d, 0xf2, 0x0b, 0xf3, 0xe8, 0x22, 0x14,
+                  0xb2, 0x0e, 0xd7, 0xda, 0xd2, 0xf2, 0x33, 0xdc, 0x3c, 0x22, 0xd7, 0xbd, 0xee, 0xed, 0x8e, 0x78};
+  uint8_t  out[sizeof(msg)];
+
+  srsran::aes_128_key_schedule ks;
+  ks.set_key(key);
+
+  // The test vector is 253 bits long, compare all complete bytes
+  TESTASSERT(srsran::security_128_eea2(ks, count, bearer, direction, msg, sizeof(msg), out) == SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(out, ct, sizeof(ct) - 1) == 0);
+
+  // Decryption in place
+  TESTASSERT(srsran::security_128_eea2(ks, count, bearer, direction, out, sizeof(msg), out) == SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(out, msg, sizeof(msg)) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eea2_vs_reference()
+{
+  const uint32_t       max_len = 1600;
+  std::vector<uint8_t> msg(max_len), ref(max_len), out(max_len);
+  uint8_t              key[16];
+
+  // The reference implementation does not support empty messages
+  srsran::aes_128_key_schedule ks;
+  for (uint32_t len = 1; len < max_len; len += (len < 64) ? 1 : 37) {
+    random_bytes(key, sizeof(key));
+    random_bytes(msg.data(), len);
+    uint32_t count     = rand_gen();
+    uint8_t  bearer    = rand_gen() & 0x1fU;
+    uint8_t  direction = rand_gen() & 0x1U;
+
+    ks.set_key(key);
+    liblte_security_encryption_eea2(key, count, bearer, direction, msg.data(), len * 8, ref.data());
+    TESTASSERT(srsran::security_128_eea2(ks, count, bearer, direction, msg.data(), len, out.data()) ==
+               SRSRAN_SUCCESS);
+    TESTASSERT(std::equal(ref.begin(), ref.begin() + len, out.begin()));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eea2_burst()
+{
+  const uint32_t nof_pdus = 37;
+  uint8_t        key[16];
+  random_bytes(key, sizeof(key));
+  srsran::aes_128_key_schedule ks;
+  ks.set_key(key);
+
+  std::vector<std::vector<uint8_t> >       msgs(nof_pdus), outs(nof_pdus);
+  std::vector<srsran::cipher_burst_item_t> items(nof_pdus);
+  std::uniform_int_distribution<uint32_t>  len_dist(1, 300);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    msgs[i].resize(len_dist(rand_gen));
+    random_bytes(msgs[i].data(), msgs[i].size());
+    outs[i] = msgs[i];
+    // Ciphering in place
+    items[i] = {outs[i].data(), outs[i].data(), (uint32_t)outs[i].size(), 1000 + i};
+  }
+
+  TESTASSERT(srsran::security_128_eea2_burst(ks, 3, 0, items) == SRSRAN_SUCCESS);
+
+  std::vector<uint8_t> ref(300);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    liblte_security_encryption_eea2(key, 1000 + i, 3, 0, msgs[i].data(), msgs[i].size() * 8, ref.data());
+    TESTASSERT(std::equal(outs[i].begin(), outs[i].end(), ref.begin()));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eia2_vs_reference()
+{
+  const uint32_t       max_len = 1600;
+  std::vector<uint8_t> msg(max_len);
+  uint8_t              key[16];
+  uint8_t              mac_ref[4], mac[4];
+
+  srsran::aes_128_key_schedule ks;
+  for (uint32_t len = 0; len < max_len; len += (len < 64) ? 1 : 37) {
+    random_bytes(key, sizeof(key));
+    random_bytes(msg.data(), len);
+    uint32_t count     = rand_gen();
+    uint8_t  bearer    = rand_gen() & 0x1fU;
+    uint8_t  direction = rand_gen() & 0x1U;
+
+    ks.set_key(key);
+    liblte_security_128_eia2(key, count, bearer, direction, msg.data(), len, mac_ref);
+    TESTASSERT(srsran::security_128_eia2(ks, count, bearer, direction, msg.data(), len, mac) == SRSRAN_SUCCESS);
+    TESTASSERT(memcmp(mac, mac_ref, sizeof(mac)) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_key_not_set()
+{
+  srsran::aes_128_key_schedule ks;
+  uint8_t                      msg[16] = {}, mac[4];
+  TESTASSERT(srsran::security_128_eea2(ks, 0, 0, 0, msg, sizeof(msg), msg) == SRSRAN_ERROR);
+  TESTASSERT(srsran::security_128_eia2(ks, 0, 0, 0, msg, sizeof(msg), mac) == SRSRAN_ERROR);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  printf("AES backend: %s\n", srsran::security_aes_backend_name());
+  TESTASSERT(test_eea2_test_set_1() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea2_vs_reference() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea2_burst() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eia2_vs_reference() == SRSRAN_SUCCESS);
+  TESTASSERT(test_key_not_set() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
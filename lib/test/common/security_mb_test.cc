@@ -0,0 +1,237 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/s3g.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include "srsran/common/zuc.h"
+#include <random>
+#include <vector>
+
+/*
+ * Checks the multi-buffer SNOW 3G/ZUC keystream generators, and the 128-EEA1/EEA3 bursts and word-parallel
+ * 128-EIA1/EIA3 built on them, against the reference implementations in s3g, zuc and liblte_security.
+ */
+
+static std::mt19937 rand_gen(4321);
+
+static void random_bytes(uint8_t* buf, uint32_t len)
+{
+  std::uniform_int_distribution<uint32_t> dist(0, 255);
+  for (uint32_t i = 0; i < len; i++) {
+    buf[i] = (uint8_t)dist(rand_gen);
+  }
+}
+
+int test_s3g_mb_keystream()
+{
+  const uint32_t nof_blocks = 3;
+  uint32_t       k[S3G_MB_NOF_LANES][4], iv[S3G_MB_NOF_LANES][4];
+  uint32_t       ks[S3G_MB_NOF_WORDS * S3G_MB_NOF_LANES];
+  uint32_t       ref[nof_blocks * S3G_MB_NOF_WORDS];
+  S3G_MB_STATE   mb_state = {};
+  S3G_STATE      state;
+
+  for (uint32_t l = 0; l < S3G_MB_NOF_LANES; l++) {
+    random_bytes((uint8_t*)k[l], sizeof(k[l]));
+    random_bytes((uint8_t*)iv[l], sizeof(iv[l]));
+    s3g_mb_initialize_lane(&mb_state, l, k[l], iv[l]);
+  }
+
+  std::vector<uint32_t> out(nof_blocks * S3G_MB_NOF_WORDS * S3G_MB_NOF_LANES);
+  for (uint32_t b = 0; b < nof_blocks; b++) {
+    s3g_mb_generate_keystream(&mb_state, 0xff, ks);
+    std::copy(std::begin(ks), std::end(ks), out.begin() + b * S3G_MB_NOF_WORDS * S3G_MB_NOF_LANES);
+  }
+
+  for (uint32_t l = 0; l < S3G_MB_NOF_LANES; l++) {
+    s3g_initialize(&state, k[l], iv[l]);
+    s3g_generate_keystream(&state, nof_blocks * S3G_MB_NOF_WORDS, ref);
+    s3g_deinitialize(&state);
+    for (uint32_t t = 0; t < nof_blocks * S3G_MB_NOF_WORDS; t++) {
+      TESTASSERT(out[t * S3G_MB_NOF_LANES + l] == ref[t]);
+    }
+  }
+
+  // Re-initializing a lane does not disturb the others
+  s3g_mb_initialize_lane(&mb_state, 3, k[0], iv[0]);
+  s3g_mb_generate_keystream(&mb_state, 0xff, ks);
+  s3g_initialize(&state, k[0], iv[0]);
+  s3g_generate_keystream(&state, S3G_MB_NOF_WORDS, ref);
+  s3g_deinitialize(&state);
+  for (uint32_t t = 0; t < S3G_MB_NOF_WORDS; t++) {
+    TESTASSERT(ks[t * S3G_MB_NOF_LANES + 3] == ref[t]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_zuc_mb_keystream()
+{
+  const uint32_t nof_blocks = 3;
+  uint8_t        k[ZUC_MB_NOF_LANES][16], iv[ZUC_MB_NOF_LANES][16];
+  uint32_t       ks[ZUC_MB_NOF_WORDS * ZUC_MB_NOF_LANES];
+  uint32_t       ref[nof_blocks * ZUC_MB_NOF_WORDS];
+  zuc_mb_state_t mb_state = {};
+  zuc_state_t    state;
+
+  for (uint32_t l = 0; l < ZUC_MB_NOF_LANES; l++) {
+    random_bytes(k[l], sizeof(k[l]));
+    random_bytes(iv[l], sizeof(iv[l]));
+    zuc_mb_initialize_lane(&mb_state, l, k[l], iv[l]);
+  }
+
+  std::vector<uint32_t> out(nof_blocks * ZUC_MB_NOF_WORDS * ZUC_MB_NOF_LANES);
+  for (uint32_t b = 0; b < nof_blocks; b++) {
+    zuc_mb_generate_keystream(&mb_state, 0xff, ks);
+    std::copy(std::begin(ks), std::end(ks), out.begin() + b * ZUC_MB_NOF_WORDS * ZUC_MB_NOF_LANES);
+  }
+
+  for (uint32_t l = 0; l < ZUC_MB_NOF_LANES; l++) {
+    zuc_initialize(&state, k[l], iv[l]);
+    zuc_generate_keystream(&state, nof_blocks * ZUC_MB_NOF_WORDS, ref);
+    for (uint32_t t = 0; t < nof_blocks * ZUC_MB_NOF_WORDS; t++) {
+      TESTASSERT(out[t * ZUC_MB_NOF_LANES + l] == ref[t]);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+typedef LIBLTE_ERROR_ENUM (*liblte_eea_func_t)(uint8*, uint32, uint8, uint8, uint8*, uint32, uint8*);
+typedef uint8_t (*eea_func_t)(uint8_t*, uint32_t, uint8_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+typedef int (*eea_burst_func_t)(const uint8_t*, uint8_t, uint8_t, srsran::span<const srsran::cipher_burst_item_t>);
+
+int test_eea_vs_reference(liblte_eea_func_t ref_func, eea_func_t func)
+{
+  const uint32_t       max_len = 1600;
+  std::vector<uint8_t> msg(max_len), ref(max_len), out(max_len);
+  uint8_t              key[16];
+
+  // The reference implementations do not support empty messages
+  for (uint32_t len = 1; len < max_len; len += (len < 80) ? 1 : 37) {
+    random_bytes(key, sizeof(key));
+    random_bytes(msg.data(), len);
+    uint32_t count     = rand_gen();
+    uint8_t  bearer    = rand_gen() & 0x1fU;
+    uint8_t  direction = rand_gen() & 0x1U;
+
+    ref_func(key, count, bearer, direction, msg.data(), len * 8, ref.data());
+    TESTASSERT(func(key, count, bearer, direction, msg.data(), len, out.data()) == SRSRAN_SUCCESS);
+    TESTASSERT(std::equal(ref.begin(), ref.begin() + len, out.begin()));
+
+    // Deciphering in place
+    TESTASSERT(func(key, count, bearer, direction, out.data(), len, out.data()) == SRSRAN_SUCCESS);
+    TESTASSERT(std::equal(msg.begin(), msg.begin() + len, out.begin()));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eea_burst(liblte_eea_func_t ref_func, eea_burst_func_t burst_func)
+{
+  const uint32_t nof_pdus = 53;
+  uint8_t        key[16];
+  random_bytes(key, sizeof(key));
+
+  // Mix of short and long PDUs, with some empty ones, so that lanes are re-initialized at different times
+  std::vector<std::vector<uint8_t> >       msgs(nof_pdus), outs(nof_pdus);
+  std::vector<srsran::cipher_burst_item_t> items(nof_pdus);
+  std::uniform_int_distribution<uint32_t>  len_dist(0, 1500);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    msgs[i].resize((i % 5 == 0) ? len_dist(rand_gen) : len_dist(rand_gen) / 20);
+    random_bytes(msgs[i].data(), msgs[i].size());
+    outs[i]  = msgs[i];
+    items[i] = {outs[i].data(), outs[i].data(), (uint32_t)outs[i].size(), 5000 + i};
+  }
+
+  TESTASSERT(burst_func(key, 7, 1, items) == SRSRAN_SUCCESS);
+
+  std::vector<uint8_t> ref(1500);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    if (msgs[i].empty()) {
+      continue;
+    }
+    ref_func(key, 5000 + i, 7, 1, msgs[i].data(), msgs[i].size() * 8, ref.data());
+    TESTASSERT(std::equal(outs[i].begin(), outs[i].end(), ref.begin()));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eia1_vs_reference()
+{
+  const uint32_t       max_len = 1600;
+  std::vector<uint8_t> msg(max_len);
+  uint8_t              key[16];
+  uint8_t              mac_ref[4], mac[4];
+
+  // The reference implementation does not support empty messages
+  for (uint32_t len = 1; len < max_len; len += (len < 80) ? 1 : 37) {
+    random_bytes(key, sizeof(key));
+    random_bytes(msg.data(), len);
+    uint32_t count     = rand_gen();
+    uint8_t  bearer    = rand_gen() & 0x1fU;
+    uint8_t  direction = rand_gen() & 0x1U;
+
+    liblte_security_128_eia1(key, count, bearer, direction, msg.data(), len, mac_ref);
+    TESTASSERT(srsran::security_128_eia1(key, count, bearer, direction, msg.data(), len, mac) == SRSRAN_SUCCESS);
+    TESTASSERT(memcmp(mac, mac_ref, sizeof(mac)) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_eia3_vs_reference()
+{
+  const uint32_t       max_len = 1600;
+  std::vector<uint8_t> msg(max_len);
+  uint8_t              key[16];
+  uint8_t              mac_ref[4], mac[4];
+
+  for (uint32_t len = 0; len < max_len; len += (len < 80) ? 1 : 37) {
+    random_bytes(key, sizeof(key));
+    random_bytes(msg.data(), len);
+    uint32_t count     = rand_gen();
+    uint8_t  bearer    = rand_gen() & 0x1fU;
+    uint8_t  direction = rand_gen() & 0x1U;
+
+    liblte_security_128_eia3(key, count, bearer, direction, msg.data(), len * 8, mac_ref);
+    TESTASSERT(srsran::security_128_eia3(key, count, bearer, direction, msg.data(), len, mac) == SRSRAN_SUCCESS);
+    TESTASSERT(memcmp(mac, mac_ref, sizeof(mac)) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  TESTASSERT(test_s3g_mb_keystream() == SRSRAN_SUCCESS);
+  TESTASSERT(test_zuc_mb_keystream() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea_vs_reference(liblte_security_encryption_eea1, srsran::security_128_eea1) == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea_vs_reference(liblte_security_encryption_eea3, srsran::security_128_eea3) == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea_burst(liblte_security_encryption_eea1, srsran::security_128_eea1_burst) == SRSRAN_SUCCESS);
+  TESTASSERT(test_eea_burst(liblte_security_encryption_eea3, srsran::security_128_eea3_burst) == SRSRAN_SUCCESS);
+  TESTASSERT(test_eia1_vs_reference() == SRSRAN_SUCCESS);
+  TESTASSERT(test_eia3_vs_reference() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
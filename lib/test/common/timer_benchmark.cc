@@ -0,0 +1,174 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+/*
+ * Measures the timer_handler maintenance cost per TTI with a large number of active timers, emulating the RLC/PDCP
+ * timer pattern: every TTI a fraction of the timers is restarted, a few are stopped, and the expired ones are
+ * restarted from their callback. The timer operations are done either from the thread calling step_all() or from a
+ * different thread.
+ */
+
+static uint32_t nof_ttis     = 10000;
+static uint32_t nof_timers   = 16384;
+static uint32_t max_duration = 500;
+static uint32_t restart_pct  = 10;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ntdr]\n", prog);
+  printf("\t-n Number of TTIs [Default %d]\n", nof_ttis);
+  printf("\t-t Number of timers [Default %d]\n", nof_timers);
+  printf("\t-d Maximum timer duration [Default %d]\n", max_duration);
+  printf("\t-r Percentage of timers restarted every TTI [Default %d]\n", restart_pct);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ntdr")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_ttis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_timers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        max_duration = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        restart_pct = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+struct timer_workload {
+  srsran::timer_handler             timers;
+  std::vector<srsran::unique_timer> timer_list;
+  std::mt19937                      rgen{1234};
+  uint64_t                          nof_expired = 0;
+  uint64_t                          nof_ops     = 0;
+
+  timer_workload() : timers(nof_timers)
+  {
+    std::uniform_int_distribution<uint32_t> dur_dist(1, max_duration);
+    for (uint32_t i = 0; i < nof_timers; ++i) {
+      timer_list.push_back(timers.get_unique_timer());
+      timer_list.back().set(dur_dist(rgen), [this](uint32_t tid) {
+        nof_expired++;
+        timer_list[tid].run();
+      });
+      timer_list.back().run();
+    }
+  }
+
+  /// Timer operations of one TTI
+  void run_tti_ops()
+  {
+    std::uniform_int_distribution<uint32_t> idx_dist(0, nof_timers - 1);
+    uint32_t                                nof_restarts = nof_timers * restart_pct / 100;
+    for (uint32_t i = 0; i < nof_restarts; ++i) {
+      timer_list[idx_dist(rgen)].run();
+    }
+    for (uint32_t i = 0; i < nof_restarts / 10; ++i) {
+      timer_list[idx_dist(rgen)].stop();
+    }
+    nof_ops += nof_restarts + nof_restarts / 10;
+  }
+};
+
+static void print_result(const char* name, std::chrono::steady_clock::duration elapsed, const timer_workload& w)
+{
+  uint64_t nof_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  printf("%-20s %10.1f ns/TTI %8.1f ns/op, %" PRIu64 " expiries, %u running timers\n",
+         name,
+         (double)nof_ns / nof_ttis,
+         (double)nof_ns / (w.nof_ops + w.nof_expired),
+         w.nof_expired,
+         w.timers.nof_running_timers());
+}
+
+/// Timers accessed from the thread stepping them
+static void benchmark_same_thread()
+{
+  timer_workload w;
+  auto           tp_start = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    w.run_tti_ops();
+    w.timers.step_all();
+  }
+  print_result("same thread", std::chrono::steady_clock::now() - tp_start, w);
+  TESTASSERT(w.nof_expired > 0);
+}
+
+/// Timers accessed from a thread that does not step them
+static void benchmark_other_thread()
+{
+  timer_workload        w;
+  std::atomic<uint32_t> ops_tti{0}, step_tti{0};
+
+  auto tp_start = std::chrono::steady_clock::now();
+
+  std::thread ops_thread([&]() {
+    for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+      while (step_tti.load(std::memory_order_acquire) != tti) {
+        std::this_thread::yield();
+      }
+      w.run_tti_ops();
+      ops_tti.store(tti + 1, std::memory_order_release);
+    }
+  });
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    while (ops_tti.load(std::memory_order_acquire) != tti + 1) {
+      std::this_thread::yield();
+    }
+    w.timers.step_all();
+    step_tti.store(tti + 1, std::memory_order_release);
+  }
+  ops_thread.join();
+
+  print_result("other thread", std::chrono::steady_clock::now() - tp_start, w);
+  TESTASSERT(w.nof_expired > 0);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  printf("%u timers, durations up to %u TTIs, %u%% restarted per TTI\n", nof_timers, max_duration, restart_pct);
+  benchmark_same_thread();
+  benchmark_other_thread();
+
+  return SRSRAN_SUCCESS;
+}
@@ -448,6 +448,65 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Description: Check that a timer of duration 1 restarted from its own callback expires at every step
+ */
+void timers_test8()
+{
+  timer_handler timers;
+  uint32_t      count = 0;
+
+  unique_timer t = timers.get_unique_timer();
+  t.set(1, [&t, &count](uint32_t tid) {
+    count++;
+    t.run();
+  });
+  t.run();
+  for (uint32_t i = 1; i <= 10; ++i) {
+    timers.step_all();
+    TESTASSERT(count == i);
+    TESTASSERT(t.is_running() and not t.is_expired());
+  }
+}
+
+/**
+ * Description: Check that the commands of other threads are applied safely when applying them releases a timer, which
+ * applies the commands requested in the meantime
+ */
+void timers_test9()
+{
+  timer_handler timers;
+  timers.step_all();
+
+  unique_timer t  = timers.get_unique_timer();
+  unique_timer t3 = timers.get_unique_timer();
+  t3.set(1);
+
+  // The first callback of t owns t2. When it gets replaced, t3 is run from another thread and t2 is released
+  std::shared_ptr<unique_timer> t2   = std::make_shared<unique_timer>(timers.get_unique_timer());
+  std::shared_ptr<void>         dtor = std::shared_ptr<void>(nullptr, [&t3, t2](void*) mutable {
+    std::thread([&t3]() { t3.run(); }).join();
+    t2.reset();
+  });
+  t.set(1, [dtor](uint32_t tid) {});
+  dtor.reset();
+  t2.reset();
+  TESTASSERT(timers.nof_timers() == 3);
+
+  uint32_t count = 0;
+  std::thread([&t, &count]() { t.set(1, [&count](uint32_t tid) { count++; }); }).join();
+  t.run();
+  timers.step_all();
+  TESTASSERT(timers.nof_timers() == 2);
+  TESTASSERT(count == 1 and t3.is_expired());
+
+  // None of the commands can be applied twice
+  std::thread([&t3]() { t3.run(); }).join();
+  t.run();
+  timers.step_all();
+  TESTASSERT(count == 2 and t3.is_expired());
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +516,8 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
+  timers_test9();
   printf("Success\n");
   return 0;
 }
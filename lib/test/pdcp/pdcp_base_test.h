@@ -66,15 +66,16 @@ public:
 
   bool is_suspended(uint32_t lcid) { return false; }
 
-  uint64_t rx_count      = 0;
-  uint64_t discard_count = 0;
+  uint64_t rx_count       = 0;
+  uint64_t discard_count  = 0;
+  uint64_t queue_capacity = UINT64_MAX; // Queue is reported full once rx_count reaches this value
 
 private:
   srslog::basic_logger&        logger;
   srsran::unique_byte_buffer_t last_pdcp_pdu;
 
   bool rb_is_um(uint32_t lcid) { return false; }
-  bool sdu_queue_is_full(uint32_t lcid) { return false; };
+  bool sdu_queue_is_full(uint32_t lcid) { return rx_count >= queue_capacity; };
 };
 
 class rrc_dummy : public srsue::rrc_interface_pdcp
@@ -72,6 +72,35 @@ public:
     TESTASSERT(compare_two_packets(pdu_act, pdu_exp) == 0);
     return 0;
   }
+
+  // Same as test_tx(), but SDUs are written in bursts of "burst_size" SDUs
+  int test_tx_burst(uint32_t                     n_packets,
+                    uint32_t                     burst_size,
+                    const pdcp_initial_state&    init_state,
+                    uint64_t                     n_pdus_exp,
+                    srsran::unique_byte_buffer_t pdu_exp)
+  {
+    pdcp_hlp_tx.set_pdcp_initial_state(init_state);
+
+    // Run test
+    std::vector<srsran::unique_byte_buffer_t> sdus;
+    for (uint32_t i = 0; i < n_packets; i += burst_size) {
+      sdus.resize(std::min(burst_size, n_packets - i));
+      for (srsran::unique_byte_buffer_t& sdu : sdus) {
+        // Test SDU
+        sdu = srsran::make_byte_buffer();
+        sdu->append_bytes(sdu1, sizeof(sdu1));
+      }
+      pdcp_hlp_tx.pdcp.write_sdus(sdus);
+    }
+
+    srsran::unique_byte_buffer_t pdu_act = srsran::make_byte_buffer();
+    pdcp_hlp_tx.rlc.get_last_sdu(pdu_act);
+
+    TESTASSERT(pdcp_hlp_tx.rlc.rx_count == n_pdus_exp);
+    TESTASSERT(compare_two_packets(pdu_act, pdu_exp) == 0);
+    return 0;
+  }
 };
 
 /*
@@ -111,6 +140,22 @@ int test_tx_all(srslog::basic_logger& logger)
     pdu_exp_count2048_len12->append_bytes(pdu1_count2048_snlen12, sizeof(pdu1_count2048_snlen12));
     TESTASSERT(tx_helper.test_tx(n_packets, normal_init_state, n_packets, std::move(pdu_exp_count2048_len12)) == 0);
   }
+  /*
+   * TX Test 2b: PDCP Entity with SN LEN = 12, SDUs written in bursts
+   * TX_NEXT = 2048.
+   * Input: {0x18, 0xE2}
+   * Output: {0x88, 0x00, 0x8d, 0x2c, 0xe5, 0x38, 0xc0, 0x42}
+   */
+  {
+    auto&                       test_logger = srslog::fetch_basic_logger("TESTER  ");
+    srsran::test_delimit_logger delimiter("TX COUNT 2048, 12 bit SN, SDU bursts");
+    test_tx_helper              tx_helper(srsran::PDCP_SN_LEN_12, logger);
+    n_packets                                            = 2049;
+    srsran::unique_byte_buffer_t pdu_exp_count2048_len12 = srsran::make_byte_buffer();
+    pdu_exp_count2048_len12->append_bytes(pdu1_count2048_snlen12, sizeof(pdu1_count2048_snlen12));
+    TESTASSERT(
+        tx_helper.test_tx_burst(n_packets, 40, normal_init_state, n_packets, std::move(pdu_exp_count2048_len12)) == 0);
+  }
   /*
    * TX Test 3: PDCP Entity with SN LEN = 12
    * TX_NEXT = 4096.
@@ -221,6 +266,41 @@ int test_tx_all(srslog::basic_logger& logger)
     tx_helper.pdcp_tx.notify_delivery({0});
     TESTASSERT(tx_helper.pdcp_tx.nof_discard_timers() == 0);
   }
+
+  /*
+   * TX Test 10: PDCP Entity with SN LEN = 12
+   * RLC queue fills up in the middle of a burst. The COUNTs of the dropped PDUs have to be reused.
+   */
+  {
+    auto&                       test_logger = srslog::fetch_basic_logger("TESTER  ");
+    srsran::test_delimit_logger delimiter("RLC queue full during burst, 12 bit SN");
+    test_tx_helper              tx_helper(srsran::PDCP_SN_LEN_12, logger);
+    tx_helper.pdcp_hlp_tx.set_pdcp_initial_state(normal_init_state);
+    tx_helper.rlc_tx.queue_capacity = 2;
+
+    std::vector<srsran::unique_byte_buffer_t> sdus(4);
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      sdu = srsran::make_byte_buffer();
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+    }
+    tx_helper.pdcp_tx.write_sdus(sdus);
+    TESTASSERT(tx_helper.rlc_tx.rx_count == 2);
+    TESTASSERT(tx_helper.pdcp_tx.get_tx_next() == 2);
+    TESTASSERT(tx_helper.pdcp_tx.nof_discard_timers() == 2);
+
+    // Next SDU is sent with the first dropped COUNT
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    sdu->append_bytes(sdu1, sizeof(sdu1));
+    srsran::unique_byte_buffer_t pdu_exp = gen_expected_pdu(sdu, 2, srsran::PDCP_SN_LEN_12, sec_cfg, logger);
+    tx_helper.rlc_tx.queue_capacity      = UINT64_MAX;
+    tx_helper.pdcp_tx.write_sdu(std::move(sdu));
+    TESTASSERT(tx_helper.rlc_tx.rx_count == 3);
+    TESTASSERT(tx_helper.pdcp_tx.get_tx_next() == 3);
+
+    srsran::unique_byte_buffer_t pdu_act = srsran::make_byte_buffer();
+    tx_helper.rlc_tx.get_last_sdu(pdu_act);
+    TESTASSERT(compare_two_packets(pdu_act, pdu_exp) == 0);
+  }
   return SRSRAN_SUCCESS;
 }
 
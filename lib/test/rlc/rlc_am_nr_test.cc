@@ -2835,7 +2835,8 @@ int rx_nack_range_no_so_test(rlc_am_nr_sn_size_t sn_size)
 
   rlc1.write_pdu(status_pdu.msg, status_pdu.N_bytes);
 
-  TESTASSERT_EQ(3 * pdu_size_first + 6 * pdu_size_continued, rlc1.get_buffer_state());
+  // The first and middle segments of each SDU are coalesced into a single RETX, the last one is kept apart
+  TESTASSERT_EQ(3 * (pdu_size_first + segment_size) + 3 * pdu_size_continued, rlc1.get_buffer_state());
   return SRSRAN_SUCCESS;
 }
 
@@ -2931,7 +2932,8 @@ int rx_nack_range_with_so_test(rlc_am_nr_sn_size_t sn_size)
 
   rlc1.write_pdu(status_pdu.msg, status_pdu.N_bytes);
 
-  TESTASSERT_EQ(2 * pdu_size_first + 3 * pdu_size_continued, rlc1.get_buffer_state());
+  // The first and middle segments of SN=2 are coalesced into a single RETX
+  TESTASSERT_EQ(2 * pdu_size_first + segment_size + 2 * pdu_size_continued, rlc1.get_buffer_state());
   return SRSRAN_SUCCESS;
 }
 
@@ -3038,7 +3040,8 @@ int rx_nack_range_with_so_starting_with_full_sdu_test(rlc_am_nr_sn_size_t sn_siz
 
   rlc1.write_pdu(status_pdu.msg, status_pdu.N_bytes);
 
-  TESTASSERT_EQ(pdu_size_whole + 2 * pdu_size_first + 2 * pdu_size_continued, rlc1.get_buffer_state());
+  // The first and middle segments of SN=2 are coalesced into a single RETX
+  TESTASSERT_EQ(pdu_size_whole + 2 * pdu_size_first + segment_size + pdu_size_continued, rlc1.get_buffer_state());
   return SRSRAN_SUCCESS;
 }
 
@@ -3145,7 +3148,8 @@ int rx_nack_range_with_so_ending_with_full_sdu_test(rlc_am_nr_sn_size_t sn_size)
 
   rlc1.write_pdu(status_pdu.msg, status_pdu.N_bytes);
 
-  TESTASSERT_EQ(1 * pdu_size_first + 3 * pdu_size_continued + pdu_size_whole, rlc1.get_buffer_state());
+  // The first and middle segments of SN=2 are coalesced into a single RETX
+  TESTASSERT_EQ(1 * pdu_size_first + segment_size + 2 * pdu_size_continued + pdu_size_whole, rlc1.get_buffer_state());
   return SRSRAN_SUCCESS;
 }
 
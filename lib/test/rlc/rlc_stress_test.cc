@@ -54,6 +54,7 @@ void mac_dummy::run_thread()
 
     // step timer
     timers->step_all();
+    tti++;
 
     if (pending_tasks.try_pop(&task)) {
       task();
@@ -122,13 +123,16 @@ void mac_dummy::run_rx_tti(srsue::rlc_interface_mac*                  tx_rlc,
   auto it          = pdu_list.begin(); // PDU iterator
   bool skip_action = false;            // Avoid discarding a duplicated or duplicating a discarded
 
+  // Drop everything sent by RLC1 during a burst. RLC2 keeps reporting the missing SNs to RLC1
+  bool in_drop_burst = is_dl && args.burst_drop_period > 0 && (tti % args.burst_drop_period) < args.burst_drop_len;
+
   while (it != pdu_list.end()) {
     // Get PDU unique buffer
     srsran::unique_byte_buffer_t& pdu = *it;
 
     // Drop
     float rnd = real_dist(mt19937);
-    if (std::isnan(rnd) || (((rnd > args.pdu_drop_rate) || skip_action) && pdu->N_bytes > 0)) {
+    if (not in_drop_burst && (std::isnan(rnd) || (((rnd > args.pdu_drop_rate) || skip_action) && pdu->N_bytes > 0))) {
       uint32_t pdu_len = pdu->N_bytes;
 
       // Cut
@@ -139,7 +143,14 @@ void mac_dummy::run_rx_tti(srsue::rlc_interface_mac*                  tx_rlc,
       }
 
       // Write PDU in RX
-      rx_rlc->write_pdu(lcid, pdu->msg, pdu_len);
+      if (is_dl) {
+        rx_rlc->write_pdu(lcid, pdu->msg, pdu_len);
+      } else {
+        auto t_start = std::chrono::steady_clock::now();
+        rx_rlc->write_pdu(lcid, pdu->msg, pdu_len);
+        ul_rx_time += std::chrono::steady_clock::now() - t_start;
+        nof_ul_rx_pdus++;
+      }
 
       // Write PCAP
       write_pdu_to_pcap(pcap_handle, is_dl, 4, pdu->msg, pdu_len); // Only handles NR rat
@@ -376,6 +387,10 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  printf("RLC1 handled %" PRIu64 " PDUs from RLC2 in %" PRIu64 " TTIs, %.2f us/PDU\n",
+         mac.get_nof_ul_rx_pdus(),
+         mac.get_nof_ttis(),
+         mac.get_avg_ul_rx_time_us());
 
   rlc2.get_metrics(metrics, 1);
   printf("RLC2 received %" PRIu64 " SDUs in %ds (%.2f/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
@@ -70,6 +70,8 @@ typedef struct {
   float       pdu_drop_rate;
   float       pdu_cut_rate;
   float       pdu_duplicate_rate;
+  uint32_t    burst_drop_period;
+  uint32_t    burst_drop_len;
   uint32_t    sdu_gen_delay_usec;
   uint32_t    pdu_tx_delay_usec;
   uint32_t    log_level;
@@ -111,6 +113,8 @@ void parse_args(stress_test_args_t* args, int argc, char* argv[])
       ("pdu_drop_rate", bpo::value<float>(&args->pdu_drop_rate)->default_value(0.1), "Rate at which RLC PDUs are dropped")
       ("pdu_cut_rate",  bpo::value<float>(&args->pdu_cut_rate)->default_value(0.0), "Rate at which RLC PDUs are chopped in length")
       ("pdu_duplicate_rate",  bpo::value<float>(&args->pdu_duplicate_rate)->default_value(0.0), "Rate at which RLC PDUs are duplicated")
+      ("burst_drop_period", bpo::value<uint32_t>(&args->burst_drop_period)->default_value(0), "Period (TTIs) of the bursts in which all RLC1 PDUs are dropped, producing NACK storms (0 disables the bursts)")
+      ("burst_drop_len", bpo::value<uint32_t>(&args->burst_drop_len)->default_value(10), "Duration (TTIs) of each burst in which all RLC1 PDUs are dropped")
       ("loglevel",      bpo::value<uint32_t>(&args->log_level)->default_value((int)srslog::basic_levels::debug), "Log level (1=Error,2=Warning,3=Info,4=Debug)")
       ("log_filename",  bpo::value<std::string>(&args->log_filename)->default_value("stdout"), "Filename to save log to")
       ("singletx",      bpo::value<bool>(&args->single_tx)->default_value(false), "If set to true, only one node is generating data")
@@ -187,6 +191,15 @@ public:
 
   void enqueue_task(srsran::move_task_t task) { pending_tasks.push(std::move(task)); }
 
+  uint64_t get_nof_ttis() const { return tti; }
+  uint64_t get_nof_ul_rx_pdus() const { return nof_ul_rx_pdus; }
+  /// Average time spent by RLC1 processing a PDU received from RLC2, which are mostly status PDUs when RLC2 is not
+  /// transmitting (singletx)
+  double get_avg_ul_rx_time_us() const
+  {
+    return nof_ul_rx_pdus > 0 ? ul_rx_time.count() / 1000.0 / nof_ul_rx_pdus : 0.0;
+  }
+
 private:
   void run_thread() final;
 
@@ -210,6 +223,10 @@ private:
   srslog::basic_logger&  logger;
   srsran::timer_handler* timers = nullptr;
 
+  uint64_t                 tti            = 0;
+  uint64_t                 nof_ul_rx_pdus = 0;
+  std::chrono::nanoseconds ul_rx_time     = {};
+
   srsran::block_queue<srsran::move_task_t> pending_tasks;
 
   std::mt19937                          mt19937;
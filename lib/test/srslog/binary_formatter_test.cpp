@@ -0,0 +1,260 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "src/srslog/formatters/binary_formatter.h"
+#include "src/srslog/formatters/json_formatter.h"
+#include "src/srslog/formatters/text_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "testing_helpers.h"
+#include <numeric>
+#include <ostream>
+
+using namespace srslog;
+
+namespace {
+
+/// User defined type that can not be stored raw in a binary log.
+struct custom_arg {
+  int value;
+};
+
+std::ostream& operator<<(std::ostream& os, const custom_arg& arg)
+{
+  return os << "custom(" << arg.value << ")";
+}
+
+} // namespace
+
+/// Helper to build a log entry.
+static detail::log_entry_metadata build_log_entry_metadata(fmt::dynamic_format_arg_store<fmt::printf_context>* store,
+                                                           const char* fmtstring = "Text %d")
+{
+  // Create a time point 50000us from epoch.
+  using tp_ty = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  tp_ty tp(std::chrono::microseconds(50000));
+
+  if (store) {
+    store->push_back(88);
+  }
+
+  return {tp, {10, true}, fmtstring, store, "ABC", 'Z'};
+}
+
+/// Makes a copy of the entry sharing the argument store.
+static detail::log_entry_metadata copy_entry(const detail::log_entry_metadata& md)
+{
+  return {md.tp, md.context, md.fmtstring, md.store, md.log_name, md.log_tag, md.hex_dump};
+}
+
+/// Decodes the whole binary log with the specified formatter.
+static std::string decode(const fmt::memory_buffer& bin, std::unique_ptr<log_formatter> f)
+{
+  binary_log_decoder decoder(std::move(f));
+  fmt::memory_buffer out;
+  int64_t            n = decoder.decode(reinterpret_cast<const uint8_t*>(bin.data()), bin.size(), out);
+  if (n != int64_t(bin.size())) {
+    return "decode error";
+  }
+  return fmt::to_string(out);
+}
+
+/// Checks that the entry decoded from the binary log matches the output of the text formatter.
+static bool check_text_roundtrip(detail::log_entry_metadata&& md)
+{
+  fmt::memory_buffer expected;
+  text_formatter{}.format(copy_entry(md), expected);
+
+  fmt::memory_buffer bin;
+  binary_formatter{}.format(std::move(md), bin);
+
+  ASSERT_EQ(decode(bin, std::unique_ptr<log_formatter>(new text_formatter)), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_log_entry_is_decoded_then_output_matches_text_formatter()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  ASSERT_EQ(check_text_roundtrip(build_log_entry_metadata(&store)), true);
+
+  return true;
+}
+
+static bool when_all_argument_types_are_used_then_they_are_decoded()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  auto entry = build_log_entry_metadata(&store, "%d %u %lld %llu %c %s %f %f %Lf %p %s");
+  store.push_back(4000000000U);
+  store.push_back(-1234567890123LL);
+  store.push_back(18446744073709551615ULL);
+  store.push_back('x');
+  store.push_back("a string");
+  store.push_back(1.5F);
+  store.push_back(-2.25);
+  store.push_back(3.125L);
+  store.push_back(static_cast<const void*>(&store));
+  store.push_back(std::string("another string"));
+
+  ASSERT_EQ(check_text_roundtrip(std::move(entry)), true);
+
+  return true;
+}
+
+static bool when_log_entry_has_no_arguments_and_hex_dump_then_they_are_decoded()
+{
+  auto entry = build_log_entry_metadata(nullptr, "Raw text %d");
+  entry.hex_dump.resize(40);
+  std::iota(entry.hex_dump.begin(), entry.hex_dump.end(), 0);
+  entry.context.enabled = false;
+
+  ASSERT_EQ(check_text_roundtrip(std::move(entry)), true);
+
+  return true;
+}
+
+static bool when_argument_can_not_be_stored_raw_then_message_is_preformatted()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  auto                                               entry = build_log_entry_metadata(&store, "%d %s");
+  store.push_back(custom_arg{7});
+
+  ASSERT_EQ(check_text_roundtrip(std::move(entry)), true);
+
+  return true;
+}
+
+static bool when_strings_repeat_then_they_are_defined_once()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  auto                                               entry = build_log_entry_metadata(&store);
+
+  binary_formatter   formatter;
+  fmt::memory_buffer bin;
+  formatter.format(copy_entry(entry), bin);
+  size_t first_size = bin.size();
+  formatter.format(copy_entry(entry), bin);
+  size_t second_size = bin.size() - first_size;
+
+  // Header, two string definitions and the entry itself.
+  ASSERT_EQ(first_size > second_size + binary_log::binary_log_magic_size + 2 * 5, true);
+
+  fmt::memory_buffer expected;
+  text_formatter{}.format(copy_entry(entry), expected);
+  text_formatter{}.format(copy_entry(entry), expected);
+  ASSERT_EQ(decode(bin, std::unique_ptr<log_formatter>(new text_formatter)), fmt::to_string(expected));
+
+  return true;
+}
+
+namespace {
+DECLARE_METRIC("SNR", snr_t, float, "dB");
+DECLARE_METRIC("PWR", pwr_t, int, "dBm");
+DECLARE_METRIC_SET("RF", myset1, snr_t, pwr_t);
+
+DECLARE_METRIC("Address", ip_addr_t, std::string, "");
+DECLARE_METRIC_SET("Network", myset2, ip_addr_t);
+DECLARE_METRIC_LIST("Networks", mylist_t, std::vector<myset2>);
+
+using ctx_t = srslog::build_context_type<myset1, mylist_t>;
+} // namespace
+
+static bool when_context_is_decoded_then_output_matches_json_formatter()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  auto                                               entry = build_log_entry_metadata(&store);
+  ctx_t                                              ctx("UL Context");
+
+  ctx.get<myset1>().write<snr_t>(-55.1);
+  ctx.get<myset1>().write<pwr_t>(-10);
+  ctx.get<mylist_t>().emplace_back();
+  ctx.get<mylist_t>().back().write<ip_addr_t>("192.168.1.0");
+  ctx.get<mylist_t>().emplace_back();
+  ctx.get<mylist_t>().back().write<ip_addr_t>("10.0.0.1");
+
+  fmt::memory_buffer expected_json, expected_text;
+  json_formatter{}.format_ctx(ctx, copy_entry(entry), expected_json);
+  text_formatter{}.format_ctx(ctx, copy_entry(entry), expected_text);
+
+  fmt::memory_buffer bin;
+  binary_formatter{}.format_ctx(ctx, std::move(entry), bin);
+
+  ASSERT_EQ(decode(bin, std::unique_ptr<log_formatter>(new json_formatter)), fmt::to_string(expected_json));
+  ASSERT_EQ(decode(bin, std::unique_ptr<log_formatter>(new text_formatter)), fmt::to_string(expected_text));
+
+  return true;
+}
+
+static bool when_input_is_split_then_records_are_decoded_once_complete()
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  auto                                               entry = build_log_entry_metadata(&store, "%d %s");
+  store.push_back("split");
+  entry.hex_dump.resize(20);
+
+  binary_formatter   formatter;
+  fmt::memory_buffer bin, expected;
+  for (unsigned i = 0; i != 3; ++i) {
+    entry.tp += std::chrono::microseconds(i * 1500);
+    formatter.format(copy_entry(entry), bin);
+    text_formatter{}.format(copy_entry(entry), expected);
+  }
+
+  // Feed the log byte by byte, the decoder keeps the incomplete records.
+  binary_log_decoder decoder(std::unique_ptr<log_formatter>(new text_formatter));
+  fmt::memory_buffer out;
+  const uint8_t*     data     = reinterpret_cast<const uint8_t*>(bin.data());
+  size_t             consumed = 0;
+  for (size_t end = 0; end <= bin.size(); ++end) {
+    int64_t n = decoder.decode(data + consumed, end - consumed, out);
+    ASSERT_EQ(n >= 0, true);
+    consumed += n;
+  }
+
+  ASSERT_EQ(consumed, bin.size());
+  ASSERT_EQ(fmt::to_string(out), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_input_is_not_a_binary_log_then_decoding_fails()
+{
+  const char         text[] = "00:00:00.050000 [ABC ] [Z] [   10] Text 88\n";
+  fmt::memory_buffer out;
+  binary_log_decoder decoder(std::unique_ptr<log_formatter>(new text_formatter));
+
+  ASSERT_EQ(decoder.decode(reinterpret_cast<const uint8_t*>(text), sizeof(text) - 1, out), -1);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_log_entry_is_decoded_then_output_matches_text_formatter);
+  TEST_FUNCTION(when_all_argument_types_are_used_then_they_are_decoded);
+  TEST_FUNCTION(when_log_entry_has_no_arguments_and_hex_dump_then_they_are_decoded);
+  TEST_FUNCTION(when_argument_can_not_be_stored_raw_then_message_is_preformatted);
+  TEST_FUNCTION(when_strings_repeat_then_they_are_defined_once);
+  TEST_FUNCTION(when_context_is_decoded_then_output_matches_json_formatter);
+  TEST_FUNCTION(when_input_is_split_then_records_are_decoded_once_complete);
+  TEST_FUNCTION(when_input_is_not_a_binary_log_then_decoding_fails);
+
+  return 0;
+}
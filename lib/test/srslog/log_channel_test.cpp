@@ -279,6 +279,62 @@ static bool when_logging_with_context_and_message_then_filled_in_log_entry_is_pu
   return true;
 }
 
+namespace {
+
+/// A log backend that has run out of space: arg stores can be allocated but
+/// every pushed entry is rejected.
+class backend_full : public detail::log_backend
+{
+public:
+  void start(srslog::backend_priority priority) override {}
+
+  bool push(detail::log_entry&& entry) override { return false; }
+
+  bool is_running() const override { return true; }
+
+  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override { return &store; }
+
+private:
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+};
+
+} // namespace
+
+static bool when_backend_discards_log_entries_then_dropped_entries_are_counted()
+{
+  backend_full             backend;
+  test_dummies::sink_dummy s;
+  log_channel              log("id", s, backend);
+
+  ASSERT_EQ(log.dropped_entries(), 0);
+
+  log("test", 42, "Hello");
+  my_ctx ctx("myctx");
+  log(ctx);
+
+  ASSERT_EQ(log.dropped_entries(), 2);
+
+  return true;
+}
+
+static bool when_backend_has_no_free_arg_stores_then_dropped_entries_are_counted()
+{
+  test_dummies::backend_dummy backend;
+  test_dummies::sink_dummy    s;
+  log_channel                 log("id", s, backend);
+  log_channel                 other_log("other", s, backend);
+
+  log("test", 42, "Hello");
+  uint8_t hex[] = {0, 1, 2};
+  log(hex, sizeof(hex), "test");
+
+  // Counters are kept per channel.
+  ASSERT_EQ(log.dropped_entries(), 2);
+  ASSERT_EQ(other_log.dropped_entries(), 0);
+
+  return true;
+}
+
 int main()
 {
   TEST_FUNCTION(when_log_channel_is_created_then_id_matches_expected_value);
@@ -291,6 +347,8 @@ int main()
   TEST_FUNCTION(when_hex_array_length_is_less_than_hex_log_max_size_then_array_length_is_used);
   TEST_FUNCTION(when_logging_with_context_then_filled_in_log_entry_is_pushed_into_the_backend);
   TEST_FUNCTION(when_logging_with_context_and_message_then_filled_in_log_entry_is_pushed_into_the_backend);
+  TEST_FUNCTION(when_backend_discards_log_entries_then_dropped_entries_are_counted);
+  TEST_FUNCTION(when_backend_has_no_free_arg_stores_then_dropped_entries_are_counted);
 
   return 0;
 }
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/srslog/detail/support/work_queue.h"
+#include "testing_helpers.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace srslog;
+
+static bool when_queue_is_full_then_push_fails()
+{
+  detail::work_queue<int, 4> queue;
+
+  for (int i = 0; i != 4; ++i) {
+    ASSERT_EQ(queue.push(i), true);
+  }
+  ASSERT_EQ(queue.push(4), false);
+  ASSERT_EQ(queue.size(), 4);
+  ASSERT_EQ(queue.is_almost_full(), true);
+
+  // Popping an element makes room for a new one.
+  auto item = queue.try_pop();
+  ASSERT_EQ(item.first, true);
+  ASSERT_EQ(item.second, 0);
+  ASSERT_EQ(queue.push(4), true);
+
+  return true;
+}
+
+static bool when_queue_is_empty_then_try_pop_fails()
+{
+  detail::work_queue<int, 4> queue;
+
+  ASSERT_EQ(queue.try_pop().first, false);
+  ASSERT_EQ(queue.push(1), true);
+  ASSERT_EQ(queue.try_pop().first, true);
+  ASSERT_EQ(queue.try_pop().first, false);
+
+  return true;
+}
+
+static bool when_popping_a_batch_then_elements_are_received_in_order()
+{
+  detail::work_queue<int, 8> queue;
+  std::vector<int>           received;
+  auto                       sink = [&received](int&& value) { received.push_back(value); };
+
+  // Wrap around the ring a few times.
+  int next = 0;
+  for (unsigned lap = 0; lap != 5; ++lap) {
+    for (unsigned i = 0; i != 6; ++i) {
+      ASSERT_EQ(queue.push(next++), true);
+    }
+    ASSERT_EQ(queue.pop_batch(sink, 4), 4);
+    ASSERT_EQ(queue.pop_batch(sink), 2);
+    ASSERT_EQ(queue.pop_batch(sink), 0);
+  }
+
+  ASSERT_EQ(received.size(), 30);
+  for (int i = 0; i != 30; ++i) {
+    ASSERT_EQ(received[i], i);
+  }
+
+  return true;
+}
+
+static bool when_queue_is_destroyed_then_pending_elements_are_destroyed()
+{
+  auto value = std::make_shared<int>(3);
+  {
+    detail::work_queue<std::shared_ptr<int>, 4> queue;
+    ASSERT_EQ(queue.push(value), true);
+    ASSERT_EQ(queue.push(value), true);
+    ASSERT_EQ(value.use_count(), 3);
+  }
+  ASSERT_EQ(value.use_count(), 1);
+
+  return true;
+}
+
+static bool when_many_producers_push_then_consumer_receives_all_elements_in_producer_order()
+{
+  constexpr unsigned nof_producers = 4;
+  constexpr unsigned nof_items     = 100000;
+
+  detail::work_queue<uint64_t, 1024> queue;
+  std::vector<std::thread>           producers;
+
+  for (unsigned p = 0; p != nof_producers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (unsigned i = 0; i != nof_items; ++i) {
+        // Retry when the consumer falls behind.
+        while (!queue.push((uint64_t(p) << 32U) | i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<unsigned> next_expected(nof_producers, 0);
+  unsigned              nof_received = 0;
+  bool                  in_order     = true;
+  while (nof_received != nof_producers * nof_items) {
+    nof_received += queue.pop_batch([&](uint64_t&& value) {
+      unsigned p = value >> 32U;
+      in_order   = in_order && (next_expected[p] == (value & 0xffffffffU));
+      ++next_expected[p];
+    });
+  }
+
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  ASSERT_EQ(in_order, true);
+  ASSERT_EQ(queue.try_pop().first, false);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_queue_is_full_then_push_fails);
+  TEST_FUNCTION(when_queue_is_empty_then_try_pop_fails);
+  TEST_FUNCTION(when_popping_a_batch_then_elements_are_received_in_order);
+  TEST_FUNCTION(when_queue_is_destroyed_then_pending_elements_are_destroyed);
+  TEST_FUNCTION(when_many_producers_push_then_consumer_receives_all_elements_in_producer_order);
+
+  return 0;
+}
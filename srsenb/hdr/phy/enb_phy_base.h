@@ -28,6 +28,7 @@
 #define SRSENB_PHY_BASE_H
 
 #include "srsenb/hdr/phy/phy_metrics.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include <vector>
 
 namespace srsenb {
@@ -46,6 +47,8 @@ public:
 
   virtual void get_metrics(std::vector<phy_metrics_t>& m) = 0;
 
+  virtual void get_scrambling_cache_metrics(srsran_sequence_cache_metrics_t& m) = 0;
+
   virtual void cmd_cell_gain(uint32_t cell_idx, float gain_db) = 0;
 
   virtual void cmd_cell_measure() = 0;
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -37,7 +38,7 @@ class cc_worker
 public:
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
-  void init(phy_common* phy, uint32_t cc_idx);
+  void init(phy_common* phy, uint32_t cc_idx, srsran::work_stealing_pool* task_pool = nullptr);
   void reset();
 
   cf_t* get_buffer_rx(uint32_t antenna_idx);
@@ -69,14 +70,17 @@ private:
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
+  bool decode_pusch_rnti(srsran_enb_ul_t&                           q,
+                         stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
                          srsran_ul_cfg_t&                           ul_cfg,
                          srsran_pusch_res_t&                        pusch_res);
+  bool decode_pusch_grant(srsran_enb_ul_t& q, stack_interface_phy_lte::ul_sched_grant_t& ul_grant);
   void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
+  void decode_ul_tasks(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
-  int  decode_pucch();
+  int  decode_pucch(srsran_enb_ul_t& q);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -90,6 +94,11 @@ private:
   srsran_enb_dl_t enb_dl = {};
   srsran_enb_ul_t enb_ul = {};
 
+  // In work-stealing mode, the PUSCH grants and the PUCCH of a subframe are decoded by several tasks. Each task uses
+  // enb_ul or one of these decoders, which share the resource grid of enb_ul
+  srsran::work_stealing_pool*  task_pool = nullptr;
+  std::vector<srsran_enb_ul_t> ul_decoders;
+
   srsran_dl_sf_cfg_t dl_sf = {};
   srsran_ul_sf_cfg_t ul_sf = {};
 
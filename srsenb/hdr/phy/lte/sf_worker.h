@@ -38,7 +38,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, srsran::work_stealing_pool* task_pool = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -61,12 +61,18 @@ public:
 private:
   void work_imp() final;
 
+  /// Calls func for every carrier index, as parallel tasks in work-stealing mode. It returns once all carriers are
+  /// done, so worker_end() keeps handing the subframes to the radio in TTI order
+  template <typename F>
+  void for_each_carrier(const F& func);
+
   /* Common objects */
-  srslog::basic_logger& logger;
-  phy_common*           phy       = nullptr;
-  bool                  initiated = false;
-  bool                  running   = false;
-  std::mutex            work_mutex;
+  srslog::basic_logger&       logger;
+  phy_common*                 phy       = nullptr;
+  srsran::work_stealing_pool* task_pool = nullptr;
+  bool                        initiated = false;
+  bool                        running   = false;
+  std::mutex                  work_mutex;
 
   uint32_t                                       tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
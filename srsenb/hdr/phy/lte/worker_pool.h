@@ -30,8 +30,9 @@ namespace lte {
 
 class worker_pool
 {
-  srsran::thread_pool                      pool;
-  std::vector<std::unique_ptr<sf_worker> > workers;
+  srsran::thread_pool                         pool;
+  std::unique_ptr<srsran::work_stealing_pool> task_pool;
+  std::vector<std::unique_ptr<sf_worker> >    workers;
 
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -33,6 +33,7 @@
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/channel/channel.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/radio/radio.h"
 
 #include <map>
@@ -45,6 +46,7 @@ class phy_common : public srsran::phy_common_interface
 {
 public:
   phy_common() = default;
+  ~phy_common();
 
   bool init(const phy_cell_cfg_list_t&    cell_list_,
             const phy_cell_cfg_list_nr_t& cell_list_nr_,
@@ -276,6 +278,12 @@ public:
   void             set_cfr_config(srsran_cfr_cfg_t cfr_cfg) { cfr_config = cfr_cfg; }
   srsran_cfr_cfg_t get_cfr_config() { return cfr_config; }
 
+  /**
+   * Scrambling sequence cache shared by the LTE and NR workers, nullptr if it is disabled
+   */
+  srsran_sequence_cache_t* get_scrambling_cache() { return scrambling_cache_enabled ? &scrambling_cache : nullptr; }
+  void                     get_scrambling_cache_metrics(srsran_sequence_cache_metrics_t& m);
+
   // Common Physical Uplink DMRS configuration
   srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg = {};
 
@@ -321,6 +329,9 @@ private:
   srsran::rf_buffer_t     tx_buffer        = {};
   bool                    is_mch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
   bool                    is_mcch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
+
+  srsran_sequence_cache_t scrambling_cache         = {};
+  bool                    scrambling_cache_enabled = false;
 };
 
 } // namespace srsenb
@@ -66,12 +66,32 @@ struct mac_cc_info_t {
   uint32_t cc_rach_counter;
 };
 
+/// Usage of the UL soft-buffer pool shared by all UEs.
+struct mac_softbuffer_pool_metrics_t {
+  /// Code blocks owned by the pool, zero if the pool is disabled.
+  uint32_t nof_cb;
+  /// Code blocks leased by active HARQ processes.
+  uint32_t nof_cb_used;
+  /// Highest number of code blocks leased at the same time.
+  uint32_t nof_cb_peak;
+  /// Successful leases.
+  uint64_t nof_leases;
+  /// Leases refused because the pool was exhausted.
+  uint64_t nof_lease_fail;
+  /// Memory owned by the pool in bytes.
+  uint64_t nof_bytes;
+  /// Memory held by leased code blocks in bytes.
+  uint64_t nof_bytes_used;
+};
+
 /// Main MAC metrics.
 struct mac_metrics_t {
   /// Per CC info.
   std::vector<mac_cc_info_t> cc_info;
   /// Per UE MAC metrics.
   std::vector<mac_ue_metrics_t> ues;
+  /// UL soft-buffer pool usage.
+  mac_softbuffer_pool_metrics_t ul_softbuffer_pool;
 };
 
 } // namespace srsenb
@@ -214,6 +214,10 @@ private:
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
+  // Shared pool of UL code blocks, it must outlive the softbuffers leasing from it
+  srsran_softbuffer_pool_t ul_softbuffer_pool         = {};
+  bool                     ul_softbuffer_pool_enabled = false;
+
   // Softbuffer pool
   std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
 };
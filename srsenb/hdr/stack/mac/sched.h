@@ -26,6 +26,7 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
 #include <map>
 #include <mutex>
@@ -94,6 +95,7 @@ public:
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void generate_tti_results_parallel(srsran::tti_point tti_rx, const std::vector<uint32_t>& cc_list);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
@@ -112,6 +114,10 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // Threads computing the carriers' allocations of a TTI in parallel. Unused if nof_cc_workers == 0
+  std::unique_ptr<srsran::work_stealing_pool> cc_worker_pool;
+  std::vector<uint32_t>                       pending_ccs;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
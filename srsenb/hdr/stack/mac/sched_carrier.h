@@ -48,6 +48,13 @@ public:
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
   int                    pdcch_order_info(dl_sched_po_info_t pdcch_order_info);
 
+  /* Steps of generate_tti_result. new_tti() and finish_tti() touch state shared by all carriers (UEs, sched results
+   * ringbuffer) and must be called from one thread at a time. alloc_tti_grants() only writes to this carrier's state,
+   * so it can run concurrently with the alloc_tti_grants() of the other carriers */
+  void                   new_tti(srsran::tti_point tti_rx);
+  void                   alloc_tti_grants(srsran::tti_point tti_rx);
+  const cc_sched_result& finish_tti(srsran::tti_point tti_rx);
+
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
   //! Get a subframe result for a given tti
@@ -62,6 +69,7 @@ private:
   sf_sched* get_sf_sched(srsran::tti_point tti_rx);
   //! Schedule PDCCH orders
   void pdcch_order_sched(sf_sched* tti_sched);
+  bool is_dl_active(const sf_sched* tti_sched) const;
 
   // args
   const sched_cell_params_t* cc_cfg = nullptr;
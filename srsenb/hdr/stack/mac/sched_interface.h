@@ -127,6 +127,7 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_cc_workers            = 0; ///< Threads running the carriers' allocations in parallel (0=serial)
   };
 
   struct cell_cfg_t {
@@ -248,6 +249,7 @@ public:
   typedef struct {
     bool            needs_pdcch;
     uint32_t        current_tx_nb;
+    bool            is_last_tx; ///< The TB is dropped if this transmission fails
     uint32_t        tbs;
     srsran_dci_ul_t dci;
   } ul_sched_data_t;
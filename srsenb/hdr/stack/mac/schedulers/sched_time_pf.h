@@ -25,7 +25,7 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include <vector>
 
 namespace srsenb {
 
@@ -46,47 +46,56 @@ private:
 
   srsran::tti_point current_tti_rx;
 
+  /// The average rates of all UEs decay by the same factor every TTI. Each UE stores its average rates divided by
+  /// this common scale, so that only the UEs that got allocated or that are in the fast start need to be updated.
+  double avg_rate_scale = 1;
+
   struct ue_ctxt {
     ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
+    double   dl_avg_rate(double scale) const { return dl_avg_rate_ * scale; }
+    double   ul_avg_rate(double scale) const { return ul_avg_rate_ * scale; }
     void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    void     save_dl_alloc(uint32_t alloc_bytes, float alpha, double scale);
+    void     save_ul_alloc(uint32_t alloc_bytes, float alpha, double scale);
+    void     rescale_avg_rates(double scale);
 
     const uint16_t rnti;
     const float    fairness_coeff;
 
     int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
     const dl_harq_proc* dl_retx_h  = nullptr;
     const dl_harq_proc* dl_newtx_h = nullptr;
     const ul_harq_proc* ul_h       = nullptr;
+    bool                ul_retx    = false;
+    bool                ul_enabled = false;
+
+    /// PF priorities, without the factor scale^-fairness_coeff common to all UEs
+    double dl_prio         = 0;
+    double ul_prio         = 0;
+    bool   dl_prio_changed = true;
+    bool   ul_prio_changed = true;
 
   private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
+    void update_dl_prio();
+    void update_ul_prio();
+
+    int      dl_cqi         = -1;
+    int      ul_cqi         = -1;
+    float    dl_coderate    = 0;
+    float    ul_coderate    = 0;
+    double   dl_avg_rate_   = 0;
+    double   ul_avg_rate_   = 0;
     uint32_t dl_nof_samples = 0;
     uint32_t ul_nof_samples = 0;
   };
 
   rnti_map_t<ue_ctxt> ue_history_db;
 
-  struct ue_dl_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-  struct ue_ul_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
+  /// UEs sorted by decreasing priority. Only the UEs whose priority changed are moved within the lists
+  std::vector<ue_ctxt*> dl_prio_list;
+  std::vector<ue_ctxt*> ul_prio_list;
 
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  void update_prio_lists();
 
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
   uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
@@ -56,8 +56,13 @@ struct ue_cc_softbuffers {
   const uint32_t          nof_rx_harq_proc;
   cc_softbuffer_tx_list_t softbuffer_tx_list;
   cc_softbuffer_rx_list_t softbuffer_rx_list;
+  // Whether the scheduled transmission of each Rx HARQ process is its last one
+  std::vector<bool>       rx_last_tx;
 
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
+  ue_cc_softbuffers(uint32_t                  nof_prb,
+                    uint32_t                  nof_tx_harq_proc_,
+                    uint32_t                  nof_rx_harq_proc_,
+                    srsran_softbuffer_pool_t* rx_pool = nullptr);
   ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
   ~ue_cc_softbuffers();
   void clear();
@@ -67,6 +72,8 @@ struct ue_cc_softbuffers {
     return softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
+  void                    set_rx_last_tx(uint32_t tti, bool last) { rx_last_tx.at(tti % nof_rx_harq_proc) = last; }
+  bool                    is_rx_last_tx(uint32_t tti) const { return rx_last_tx.at(tti % nof_rx_harq_proc); }
 };
 
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
@@ -111,6 +118,8 @@ public:
     return cc_softbuffers->get_tx(pid, tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx_softbuffer(uint32_t tti) { return cc_softbuffers->get_rx(tti); }
+  void                    set_rx_last_tx(uint32_t tti, bool last_tx) { cc_softbuffers->set_rx_last_tx(tti, last_tx); }
+  bool                    is_rx_last_tx(uint32_t tti) const { return cc_softbuffers->is_rx_last_tx(tti); }
   srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb)
   {
     return tx_payload_buffer[harq_pid][tb].get();
@@ -170,6 +179,9 @@ public:
 
   srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
   srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti);
+  /// Whether the UL transmission in the given TTI is the last one of its HARQ process
+  void                    set_ul_last_tx(uint32_t enb_cc_idx, uint32_t tti, bool last_tx);
+  bool                    is_ul_last_tx(uint32_t enb_cc_idx, uint32_t tti);
 
   uint8_t* request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len);
   void     process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs);
@@ -152,6 +152,9 @@ private:
   // PCAP
   srsran::s1ap_pcap* pcap = nullptr;
 
+  // Storage of the containers of the last received PDU
+  asn1::unpack_arena rx_pdu_arena;
+
   asn1::s1ap::s1_setup_resp_s s1setupresponse;
 
   void build_tai_cgi();
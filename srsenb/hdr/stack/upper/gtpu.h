@@ -24,6 +24,7 @@
 #include <unordered_map>
 
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsenb/hdr/stack/upper/gtpu_metrics.h"
 #include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
@@ -155,6 +156,7 @@ public:
 
   int  init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_);
   void stop();
+  void get_metrics(gtpu_metrics_t& m);
 
   // gtpu_interface_rrc
   srsran::expected<uint32_t> add_bearer(uint16_t            rnti,
@@ -176,7 +178,8 @@ public:
   void handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
 
 private:
-  static const int GTPU_PORT = 2152;
+  static const int      GTPU_PORT         = 2152;
+  static const uint32_t GTPU_MAX_TX_BATCH = 32;
 
   void rem_tunnel(uint32_t teidin);
 
@@ -228,7 +231,17 @@ private:
   // Socket file descriptor
   int fd = -1;
 
+  // S1-U PDUs waiting to be sent with a single sendmmsg(...) call
+  struct tx_pdu_t {
+    srsran::unique_byte_buffer_t pdu;
+    sockaddr_in                  addr;
+  };
+  srsran::bounded_vector<tx_pdu_t, GTPU_MAX_TX_BATCH> tx_batch;
+
+  gtpu_metrics_t metrics = {};
+
   void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
+  void flush_tx_batch();
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
   void error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid);
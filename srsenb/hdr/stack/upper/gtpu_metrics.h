@@ -0,0 +1,59 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_GTPU_METRICS_H
+#define SRSENB_GTPU_METRICS_H
+
+#include <array>
+#include <stdint.h>
+
+namespace srsenb {
+
+/// Number of bins of the GTP-U batch size histograms. Bin 0 counts batches of a single PDU and bin i>0 counts batches
+/// of (2^(i-1), 2^i] PDUs
+constexpr uint32_t GTPU_BATCH_HIST_NOF_BINS = 6;
+
+/// Largest batch size counted by the i-th bin of the GTP-U batch size histograms
+constexpr uint32_t gtpu_batch_hist_bin_max(uint32_t bin)
+{
+  return 1u << bin;
+}
+
+/// Index of the bin of the GTP-U batch size histograms that counts batches of "batch_size" PDUs
+inline uint32_t gtpu_batch_hist_bin(uint32_t batch_size)
+{
+  uint32_t bin = 0;
+  while (bin + 1 < GTPU_BATCH_HIST_NOF_BINS and gtpu_batch_hist_bin_max(bin) < batch_size) {
+    bin++;
+  }
+  return bin;
+}
+
+struct gtpu_metrics_t {
+  uint64_t                                       rx_pdus       = 0;
+  uint64_t                                       tx_pdus       = 0;
+  std::array<uint64_t, GTPU_BATCH_HIST_NOF_BINS> rx_batch_hist = {}; ///< S1-U PDUs read per socket system call
+  std::array<uint64_t, GTPU_BATCH_HIST_NOF_BINS> tx_batch_hist = {}; ///< S1-U PDUs written per socket system call
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_GTPU_METRICS_H
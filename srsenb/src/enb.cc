@@ -231,14 +231,17 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_scrambling_cache_metrics(m->scrambling_cache);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
   if (nr_stack) {
     nr_stack->get_metrics(&m->nr_stack);
   }
-  m->running = true;
-  m->sys     = sys_proc.get_metrics();
+  m->running     = true;
+  m->sys         = sys_proc.get_metrics();
+  m->pool        = srsran::get_byte_buffer_pool_metrics();
+  m->tti_latency = srsran::get_tti_latency_metrics();
   return true;
 }
 
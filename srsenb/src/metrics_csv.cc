@@ -63,6 +63,14 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
       file << "time;nof_ue;dl_brate;ul_brate;"
               "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;system_load;thread_count";
 
+      // Add the TTI pipeline stages
+      for (uint32_t i = 0; i != srsran::NOF_TTI_STAGES; ++i) {
+        std::string stage = srsran::tti_stage_to_string((srsran::tti_stage)i);
+        file << ";" << stage << "_mean_us;" << stage << "_p99_us;" << stage << "_max_us";
+      }
+
+      file << ";scrambling_hit_rate";
+
       // Add the cpus
       for (uint32_t i = 0, e = metrics.sys.cpu_count; i != e; ++i) {
         file << ";cpu_" << std::to_string(i);
@@ -108,6 +116,18 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
     file << float_to_string(m.process_cpu_usage, 2);
     file << std::to_string(m.thread_count) << ";";
 
+    // Write the TTI pipeline latencies.
+    for (const srsran::latency_hist_metrics_t& hist : metrics.tti_latency.stages) {
+      file << float_to_string(hist.mean_us(), 2);
+      file << float_to_string(hist.percentile_us(0.99), 2);
+      file << float_to_string(hist.max_ns / 1000.0, 2);
+    }
+
+    // Write the percentage of scrambling sequences served from the PHY cache since start.
+    const srsran_sequence_cache_metrics_t& sc          = metrics.scrambling_cache;
+    uint64_t                               nof_lookups = sc.nof_hits + sc.nof_misses + sc.nof_bypass;
+    file << float_to_string((nof_lookups > 0) ? 100.0f * sc.nof_hits / nof_lookups : 0.0f, 2);
+
     // Write the cpu metrics.
     for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
       file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
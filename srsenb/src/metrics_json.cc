@@ -95,13 +95,67 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// Byte buffer pool container metrics.
+DECLARE_METRIC("payload_size", metric_pool_payload_size, uint32_t, "");
+DECLARE_METRIC("block_size", metric_pool_block_size, uint32_t, "");
+DECLARE_METRIC("nof_blocks", metric_pool_nof_blocks, uint32_t, "");
+DECLARE_METRIC("nof_free_blocks", metric_pool_nof_free_blocks, uint32_t, "");
+DECLARE_METRIC_SET("pool_container",
+                   mset_pool_container,
+                   metric_pool_payload_size,
+                   metric_pool_block_size,
+                   metric_pool_nof_blocks,
+                   metric_pool_nof_free_blocks);
+
+/// GTP-U batch size histogram bin metrics.
+DECLARE_METRIC("max_batch_size", metric_gtpu_max_batch_size, uint32_t, "");
+DECLARE_METRIC("nof_rx_batches", metric_gtpu_nof_rx_batches, uint64_t, "");
+DECLARE_METRIC("nof_tx_batches", metric_gtpu_nof_tx_batches, uint64_t, "");
+DECLARE_METRIC_SET("gtpu_batch_container",
+                   mset_gtpu_batch_container,
+                   metric_gtpu_max_batch_size,
+                   metric_gtpu_nof_rx_batches,
+                   metric_gtpu_nof_tx_batches);
+
+/// TTI pipeline latency histogram bin metrics.
+DECLARE_METRIC("max_latency_us", metric_latency_bin_max_us, float, "");
+DECLARE_METRIC("count", metric_latency_bin_count, uint64_t, "");
+DECLARE_METRIC_SET("latency_bin_container",
+                   mset_latency_bin_container,
+                   metric_latency_bin_max_us,
+                   metric_latency_bin_count);
+
+/// TTI pipeline stage container metrics.
+DECLARE_METRIC("stage", metric_latency_stage, std::string, "");
+DECLARE_METRIC("nof_samples", metric_latency_nof_samples, uint64_t, "");
+DECLARE_METRIC("mean_us", metric_latency_mean_us, float, "");
+DECLARE_METRIC("p99_us", metric_latency_p99_us, float, "");
+DECLARE_METRIC("max_us", metric_latency_max_us, float, "");
+DECLARE_METRIC_LIST("bin_list", mlist_latency_bins, std::vector<mset_latency_bin_container>);
+DECLARE_METRIC_SET("tti_latency_container",
+                   mset_tti_latency_container,
+                   metric_latency_stage,
+                   metric_latency_nof_samples,
+                   metric_latency_mean_us,
+                   metric_latency_p99_us,
+                   metric_latency_max_us,
+                   mlist_latency_bins);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("buffer_pool_list", mlist_buffer_pool, std::vector<mset_pool_container>);
+DECLARE_METRIC_LIST("gtpu_batch_list", mlist_gtpu_batch, std::vector<mset_gtpu_batch_container>);
+DECLARE_METRIC_LIST("tti_latency_list", mlist_tti_latency, std::vector<mset_tti_latency_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag,
+                                                    metric_timestamp_tag,
+                                                    mlist_cell,
+                                                    mlist_buffer_pool,
+                                                    mlist_gtpu_batch,
+                                                    mlist_tti_latency>;
 
 } // namespace
 
@@ -238,6 +292,49 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // Byte buffer pool occupancy, one entry per size class.
+  auto& pool_list = ctx.get<mlist_buffer_pool>();
+  for (const auto& pool : m.pool.classes) {
+    pool_list.emplace_back();
+    pool_list.back().write<metric_pool_payload_size>(pool.payload_size);
+    pool_list.back().write<metric_pool_block_size>(pool.block_size);
+    pool_list.back().write<metric_pool_nof_blocks>(pool.nof_blocks);
+    pool_list.back().write<metric_pool_nof_free_blocks>(pool.nof_free_blocks);
+  }
+
+  // S1-U GTP-U PDUs handled per socket system call, one entry per histogram bin.
+  auto& gtpu_batch_list = ctx.get<mlist_gtpu_batch>();
+  for (uint32_t bin = 0; bin != GTPU_BATCH_HIST_NOF_BINS; ++bin) {
+    gtpu_batch_list.emplace_back();
+    gtpu_batch_list.back().write<metric_gtpu_max_batch_size>(gtpu_batch_hist_bin_max(bin));
+    gtpu_batch_list.back().write<metric_gtpu_nof_rx_batches>(m.stack.gtpu.rx_batch_hist[bin]);
+    gtpu_batch_list.back().write<metric_gtpu_nof_tx_batches>(m.stack.gtpu.tx_batch_hist[bin]);
+  }
+
+  // TTI pipeline latencies, one entry per stage with its non-empty histogram bins.
+  auto& tti_latency_list = ctx.get<mlist_tti_latency>();
+  for (uint32_t i = 0; i != srsran::NOF_TTI_STAGES; ++i) {
+    const srsran::latency_hist_metrics_t& hist = m.tti_latency.stages[i];
+    tti_latency_list.emplace_back();
+    auto& stage = tti_latency_list.back();
+    stage.write<metric_latency_stage>(srsran::tti_stage_to_string((srsran::tti_stage)i));
+    stage.write<metric_latency_nof_samples>(hist.count);
+    stage.write<metric_latency_mean_us>(hist.mean_us());
+    stage.write<metric_latency_p99_us>(hist.percentile_us(0.99));
+    stage.write<metric_latency_max_us>(hist.max_ns / 1000.0);
+    for (uint32_t bin = 0; bin != srsran::LATENCY_HIST_NOF_BINS; ++bin) {
+      if (hist.bins[bin] == 0) {
+        continue;
+      }
+      // The last bin is unbounded, report the largest latency it holds
+      uint64_t bin_max_ns =
+          (bin + 1 == srsran::LATENCY_HIST_NOF_BINS) ? hist.max_ns : srsran::latency_hist_bin_max_ns(bin);
+      stage.get<mlist_latency_bins>().emplace_back();
+      stage.get<mlist_latency_bins>().back().write<metric_latency_bin_max_us>(bin_max_ns / 1000.0);
+      stage.get<mlist_latency_bins>().back().write<metric_latency_bin_count>(hist.bins[bin]);
+    }
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -21,6 +21,7 @@
 
 #include <iomanip>
 
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -65,6 +66,9 @@ cc_worker::~cc_worker()
 {
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
+  for (srsran_enb_ul_t& q : ul_decoders) {
+    srsran_enb_ul_free(&q);
+  }
   srsran_enb_ul_free(&enb_ul);
 
   for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
@@ -86,10 +90,11 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, srsran::work_stealing_pool* task_pool_)
 {
   phy                         = phy_;
   cc_idx                      = cc_idx_;
+  task_pool                   = task_pool_;
   srsran_cell_t    cell       = phy_->get_cell(cc_idx);
   uint32_t         nof_prb    = phy_->get_nof_prb(cc_idx);
   uint32_t         sf_len     = SRSRAN_SF_LEN_PRB(nof_prb);
@@ -156,6 +161,29 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
   }
+  if (srsran_sch_enable_cb_coworkers(&enb_ul.pusch.ul_sch, phy->params.pusch_cb_coworkers)) {
+    ERROR("Error enabling PUSCH code block coworkers");
+  }
+  srsran_enb_dl_set_sequence_cache(&enb_dl, phy->get_scrambling_cache());
+  srsran_enb_ul_set_sequence_cache(&enb_ul, phy->get_scrambling_cache());
+
+  // One decoder for each thread that can steal UL tasks of this carrier, the worker thread uses enb_ul
+  if (task_pool != nullptr) {
+    ul_decoders.resize(task_pool->nof_workers());
+    for (srsran_enb_ul_t& q : ul_decoders) {
+      if (srsran_enb_ul_init_shared(&q, &enb_ul, nof_prb)) {
+        ERROR("Error initiating ENB UL decoder");
+        return;
+      }
+      if (srsran_enb_ul_set_cell(&q, cell, &phy->dmrs_pusch_cfg, nullptr)) {
+        ERROR("Error initiating ENB UL decoder");
+        return;
+      }
+      q.pusch.llr_is_8bit        = enb_ul.pusch.llr_is_8bit;
+      q.pusch.ul_sch.llr_is_8bit = enb_ul.pusch.ul_sch.llr_is_8bit;
+      srsran_enb_ul_set_sequence_cache(&q, phy->get_scrambling_cache());
+    }
+  }
   initiated = true;
 
 #ifdef DEBUG_WRITE_FILE
@@ -219,13 +247,22 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
   logger.set_context(ul_sf.tti);
 
   // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  {
+    srsran::tti_latency_scope latency_scope(srsran::tti_stage::fft);
+    srsran_enb_ul_fft(&enb_ul);
+  }
+
+  srsran::tti_latency_scope latency_scope(srsran::tti_stage::ul_decode);
+  if (not ul_decoders.empty()) {
+    decode_ul_tasks(ul_grants.pusch, ul_grants.nof_grants);
+    return;
+  }
 
   // Decode pending UL grants for the tti they were scheduled
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
-  decode_pucch();
+  decode_pucch(enb_ul);
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
@@ -236,24 +273,28 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
 
-  // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
-  srsran_enb_dl_put_base(&enb_dl, &dl_sf);
+  {
+    srsran::tti_latency_scope latency_scope(srsran::tti_stage::dl_encode);
+
+    // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
+    srsran_enb_dl_put_base(&enb_dl, &dl_sf);
 
-  // Put DL grants to resource grid. PDSCH data will be encoded as well.
-  if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
-    encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
-    encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
-  } else {
-    if (mbsfn_cfg->enable) {
-      encode_pmch(dl_grants.pdsch, mbsfn_cfg);
+    // Put DL grants to resource grid. PDSCH data will be encoded as well.
+    if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
+      encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
+      encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
+    } else {
+      if (mbsfn_cfg->enable) {
+        encode_pmch(dl_grants.pdsch, mbsfn_cfg);
+      }
     }
-  }
 
-  // Put UL grants to resource grid.
-  encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
+    // Put UL grants to resource grid.
+    encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
 
-  // Put pending PHICH HARQ ACK/NACK indications into subframe
-  encode_phich(ul_grants.phich, ul_grants.nof_phich);
+    // Put pending PHICH HARQ ACK/NACK indications into subframe
+    encode_phich(ul_grants.phich, ul_grants.nof_phich);
+  }
 
   // Generate signal and transmit
   srsran_enb_dl_gen_signal(&enb_dl);
@@ -283,7 +324,8 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   }
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
+bool cc_worker::decode_pusch_rnti(srsran_enb_ul_t&                           q,
+                                  stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
                                   srsran_ul_cfg_t&                           ul_cfg,
                                   srsran_pusch_res_t&                        pusch_res)
 {
@@ -312,7 +354,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
 
   // Compute UL grant
   srsran_pusch_grant_t& grant = ul_cfg.pusch.grant;
-  if (srsran_ra_ul_dci_to_grant(&enb_ul.cell, &ul_sf, &ul_cfg.hopping, &ul_grant.dci, &grant)) {
+  if (srsran_ra_ul_dci_to_grant(&q.cell, &ul_sf, &ul_cfg.hopping, &ul_grant.dci, &grant)) {
     Error("Computing PUSCH dci for RNTI %x", rnti);
     return false;
   }
@@ -342,7 +384,11 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
   pusch_res.data              = ul_grant.data;
   if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
+    {
+      srsran::tti_latency_scope latency_scope(srsran::tti_stage::chest);
+      srsran_enb_ul_estimate_pusch(&q, &ul_sf, &ul_cfg.pusch);
+    }
+    if (srsran_enb_ul_decode_pusch(&q, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
       Error("Decoding PUSCH for RNTI %x", rnti);
       return false;
     }
@@ -351,7 +397,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
   ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  float snr_db = q.chest_res.snr_db;
 
   // Notify MAC of RL status
   if (snr_db >= PUSCH_RL_SNR_DB_TH) {
@@ -359,8 +405,8 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
 
     // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    if (ul_cfg.pusch.meas_ta_en and not std::isnan(q.chest_res.ta_us) and not std::isinf(q.chest_res.ta_us)) {
+      phy->stack->ta_info(ul_sf.tti, rnti, q.chest_res.ta_us);
     }
   }
 
@@ -373,47 +419,80 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   if (ul_grant.data != nullptr) {
     // Save metrics stats
     ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
-                            enb_ul.chest_res.epre_dBfs - phy->params.rx_gain_offset,
-                            enb_ul.chest_res.snr_db,
+                            q.chest_res.epre_dBfs - phy->params.rx_gain_offset,
+                            q.chest_res.snr_db,
                             pusch_res.avg_iterations_block);
   }
   return true;
 }
 
+bool cc_worker::decode_pusch_grant(srsran_enb_ul_t& q, stack_interface_phy_lte::ul_sched_grant_t& ul_grant)
+{
+  uint16_t rnti = ul_grant.dci.rnti;
+
+  srsran_pusch_res_t pusch_res = {};
+  srsran_ul_cfg_t    ul_cfg    = {};
+
+  // Decodes PUSCH for the given grant
+  if (!decode_pusch_rnti(q, ul_grant, ul_cfg, pusch_res)) {
+    return false;
+  }
+
+  // Notify MAC new received data and HARQ Indication value
+  if (ul_grant.data != nullptr) {
+    // Inform MAC about the CRC result
+    phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
+    // Push PDU buffer
+    phy->stack->push_pdu(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &q.chest_res, str, sizeof(str));
+      logger.info("PUSCH: cc=%d, %s", cc_idx, str);
+    }
+  }
+  return true;
+}
+
 void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
 {
   // Iterate over all the grants, all the grants need to report MAC the CRC status
   for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
-
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
-
-    // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
+    if (!decode_pusch_grant(enb_ul, grants[i])) {
       return;
     }
+  }
+}
 
-    // Notify MAC new received data and HARQ Indication value
-    if (ul_grant.data != nullptr) {
-      // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Push PDU buffer
-      phy->stack->push_pdu(
-          tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
-      // Logging
-      if (logger.info.enabled()) {
-        char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
-        logger.info("PUSCH: cc=%d, %s", cc_idx, str);
+void cc_worker::decode_ul_tasks(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
+{
+  // Job 0 decodes the PUCCH of all users, job i > 0 the PUSCH grant i - 1. Each task takes jobs until none is left
+  struct ul_jobs_t {
+    stack_interface_phy_lte::ul_sched_grant_t* grants;
+    uint32_t                                   nof_jobs;
+    std::atomic<uint32_t>                      next_job;
+  } jobs = {grants, nof_pusch + 1, {0}};
+
+  srsran::work_stealing_pool::task_group group;
+
+  uint32_t nof_tasks = std::min(jobs.nof_jobs, (uint32_t)ul_decoders.size() + 1);
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    srsran_enb_ul_t* q = (i == 0) ? &enb_ul : &ul_decoders[i - 1];
+    task_pool->push_task(group, [this, q, &jobs]() {
+      for (uint32_t job = jobs.next_job++; job < jobs.nof_jobs; job = jobs.next_job++) {
+        if (job == 0) {
+          decode_pucch(*q);
+        } else {
+          // A failed grant does not stop the decoding of the others
+          decode_pusch_grant(*q, jobs.grants[job - 1]);
+        }
       }
-    }
+    });
   }
+  task_pool->wait(group);
 }
 
-int cc_worker::decode_pucch()
+int cc_worker::decode_pucch(srsran_enb_ul_t& q)
 {
   srsran_pucch_res_t pucch_res = {};
 
@@ -439,7 +518,7 @@ int cc_worker::decode_pucch()
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
         // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
+        if (srsran_enb_ul_get_pucch(&q, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
           Error("Error getting PUCCH");
           continue;
         }
@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -72,9 +73,10 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+void sf_worker::init(phy_common* phy_, srsran::work_stealing_pool* task_pool_)
 {
-  phy = phy_;
+  phy       = phy_;
+  task_pool = task_pool_;
 
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
@@ -82,7 +84,7 @@ void sf_worker::init(phy_common* phy_)
     auto q = new cc_worker(logger);
 
     // Initialise
-    q->init(phy, i);
+    q->init(phy, i, task_pool);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -147,6 +149,24 @@ uint32_t sf_worker::get_nof_rnti()
   return cc_workers[0]->get_nof_rnti();
 }
 
+template <typename F>
+void sf_worker::for_each_carrier(const F& func)
+{
+  if (task_pool == nullptr or cc_workers.size() == 1) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      func(cc);
+    }
+    return;
+  }
+
+  // Idle workers can steal the carriers this worker has not started yet
+  srsran::work_stealing_pool::task_group group;
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    task_pool->push_task(group, [&func, cc]() { func(cc); });
+  }
+  task_pool->wait(group);
+}
+
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
@@ -163,6 +183,8 @@ void sf_worker::work_imp()
     return;
   }
 
+  std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+
   srsran_mbsfn_cfg_t mbsfn_cfg;
   srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
 
@@ -189,9 +211,7 @@ void sf_worker::work_imp()
   }
 
   // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
-  }
+  for_each_carrier([this, &ul_sf, &ul_grants](uint32_t cc) { cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]); });
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -225,14 +245,15 @@ void sf_worker::work_imp()
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+  for_each_carrier([&](uint32_t cc) {
     // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
+    srsran_dl_sf_cfg_t cc_dl_sf = dl_sf;
+    cc_dl_sf.cfi                = dl_grants[cc].cfi;
+    cc_dl_sf.cfi                = SRSRAN_MAX(cc_dl_sf.cfi, 1);
+    cc_dl_sf.cfi                = SRSRAN_MIN(cc_dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
-  }
+    cc_workers[cc]->work_dl(cc_dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+  });
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
@@ -244,6 +265,8 @@ void sf_worker::work_imp()
     }
   }
 
+  srsran::get_tti_latency_histogram(srsran::tti_stage::sf_proc).record(std::chrono::steady_clock::now() - t_start);
+
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
 
@@ -27,6 +27,11 @@ worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
+  // In work-stealing mode, the carriers and UL users of a subframe are split in tasks that idle threads can steal
+  if (args.nof_steal_threads > 0) {
+    task_pool.reset(new srsran::work_stealing_pool(args.nof_steal_threads, args.nof_phy_threads, "PHY_STEAL", prio));
+  }
+
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -35,7 +40,7 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    w->init(common, task_pool.get());
     pool.init_worker(i, w.get(), prio);
     workers.push_back(std::move(w));
   }
@@ -61,6 +66,9 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  if (task_pool != nullptr) {
+    task_pool->stop();
+  }
 }
 
 }; // namespace lte
@@ -104,6 +104,9 @@ bool slot_worker::init(const args_t& args)
     return false;
   }
 
+  srsran_gnb_dl_set_sequence_cache(&gnb_dl, args.scrambling_cache);
+  srsran_gnb_ul_set_sequence_cache(&gnb_ul, args.scrambling_cache);
+
 #ifdef DEBUG_WRITE_FILE
   const char* filename = "nr_baseband.dat";
   printf("Opening %s to dump baseband\n", filename);
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/phy/txrx.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/threads.h"
 #include "srsran/phy/channel/channel.h"
 #include <sstream>
@@ -31,6 +32,13 @@ using namespace asn1::rrc;
 
 namespace srsenb {
 
+phy_common::~phy_common()
+{
+  if (scrambling_cache_enabled) {
+    srsran_sequence_cache_free(&scrambling_cache);
+  }
+}
+
 void phy_common::reset()
 {
   for (auto& q : ul_grants) {
@@ -60,6 +68,23 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
     dl_channel->set_signal_power_dBfs(srsran_enb_dl_get_maximum_signal_power_dBfs(channel_prbs));
   }
 
+  // Create the scrambling sequence cache, sized for the largest codeword of any cell
+  if (params.scrambling_cache > 0 && not scrambling_cache_enabled) {
+    uint32_t max_len = 0;
+    for (const phy_cell_cfg_t& c : cell_list_lte) {
+      max_len = SRSRAN_MAX(max_len, SRSRAN_SF_LEN_RE(c.cell.nof_prb, c.cell.cp) * 8);
+    }
+    for (const phy_cell_cfg_nr_t& c : cell_list_nr) {
+      max_len = SRSRAN_MAX(max_len, SRSRAN_SLOT_LEN_RE_NR(c.carrier.nof_prb) * 8 * c.carrier.max_mimo_layers);
+    }
+    if (srsran_sequence_cache_init(&scrambling_cache, params.scrambling_cache, max_len) < SRSRAN_SUCCESS) {
+      srslog::fetch_basic_logger("PHY").error("Error initialising scrambling cache for %d sequences",
+                                              params.scrambling_cache);
+      return false;
+    }
+    scrambling_cache_enabled = true;
+  }
+
   // Create grants
   for (auto& q : ul_grants) {
     q.resize(cell_list_lte.size());
@@ -86,6 +111,14 @@ void phy_common::stop()
   semaphore.wait_all();
 }
 
+void phy_common::get_scrambling_cache_metrics(srsran_sequence_cache_metrics_t& m)
+{
+  m = {};
+  if (scrambling_cache_enabled) {
+    srsran_sequence_cache_get_metrics(&scrambling_cache, &m);
+  }
+}
+
 void phy_common::clear_grants(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(grant_mutex);
@@ -158,7 +191,10 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   }
 
   // Always transmit on single radio
-  radio->tx(tx_buffer, tx_time);
+  {
+    srsran::tti_latency_scope latency_scope(srsran::tti_stage::radio_tx);
+    radio->tx(tx_buffer, tx_time);
+  }
 
   // Reset transmit buffer
   tx_buffer = {};
@@ -23,6 +23,7 @@
 
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -186,7 +187,10 @@ void txrx::run_thread()
     }
 
     buffer.set_nof_samples(sf_len);
-    radio_h->rx_now(buffer, timestamp);
+    {
+      srsran::tti_latency_scope latency_scope(srsran::tti_stage::rx_wait);
+      radio_h->rx_now(buffer, timestamp);
+    }
 
     if (ul_channel) {
       ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
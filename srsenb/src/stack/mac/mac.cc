@@ -24,6 +24,7 @@
 
 #include "srsenb/hdr/stack/mac/mac.h"
 #include "srsran/adt/pool/obj_pool.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/time_prof.h"
@@ -47,6 +48,10 @@ mac::mac(srsran::ext_task_sched_handle task_sched_, srslog::basic_logger& logger
 mac::~mac()
 {
   stop();
+  softbuffer_pool.reset();
+  if (ul_softbuffer_pool_enabled) {
+    srsran_softbuffer_pool_free(&ul_softbuffer_pool);
+  }
   pthread_rwlock_destroy(&rwlock);
 }
 
@@ -79,10 +84,25 @@ bool mac::init(const mac_args_t&        args_,
     srsran_softbuffer_tx_init(&cc.rar_softbuffer_tx, args.nof_prb);
   }
 
+  // UL code blocks are shared by all UEs. They are stored as 8-bit when the PUSCH decoder uses 8-bit LLRs
+  srsran_softbuffer_pool_t* ul_pool = nullptr;
+  if (args.ul_softbuffer_pool_cb > 0) {
+    if (srsran_softbuffer_pool_init(&ul_softbuffer_pool,
+                                    args.ul_softbuffer_pool_cb,
+                                    SOFTBUFFER_SIZE,
+                                    args.ul_softbuffer_8bit ? SRSRAN_SOFTBUFFER_LLR_8BIT
+                                                            : SRSRAN_SOFTBUFFER_LLR_16BIT) < SRSRAN_SUCCESS) {
+      logger.error("Error initiating UL softbuffer pool of %d code blocks", args.ul_softbuffer_pool_cb);
+      return false;
+    }
+    ul_softbuffer_pool_enabled = true;
+    ul_pool                    = &ul_softbuffer_pool;
+  }
+
   // Initiate common pool of softbuffers
   uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+  auto     init_softbuffers = [nof_prb, ul_pool](void* ptr) {
+    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ, ul_pool);
   };
   auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
   softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
@@ -264,6 +284,19 @@ void mac::get_metrics(mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
   }
+
+  metrics.ul_softbuffer_pool = {};
+  if (ul_softbuffer_pool_enabled) {
+    srsran_softbuffer_pool_metrics_t m = {};
+    srsran_softbuffer_pool_get_metrics(&ul_softbuffer_pool, &m);
+    metrics.ul_softbuffer_pool.nof_cb         = m.nof_cb;
+    metrics.ul_softbuffer_pool.nof_cb_used    = m.nof_cb_used;
+    metrics.ul_softbuffer_pool.nof_cb_peak    = m.nof_cb_peak;
+    metrics.ul_softbuffer_pool.nof_leases     = m.nof_leases;
+    metrics.ul_softbuffer_pool.nof_lease_fail = m.nof_lease_fail;
+    metrics.ul_softbuffer_pool.nof_bytes      = m.nof_bytes;
+    metrics.ul_softbuffer_pool.nof_bytes_used = m.nof_bytes_used;
+  }
 }
 
 void mac::toggle_padding()
@@ -317,6 +350,12 @@ int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
   ue_db[rnti]->set_tti(tti_rx);
   ue_db[rnti]->metrics_rx(crc, nof_bytes);
 
+  // A decoded TB, or one that failed its last transmission, does not need its soft bits anymore. Give the code blocks
+  // back to the shared pool
+  if (crc or ue_db[rnti]->is_ul_last_tx(enb_cc_idx, tti_rx)) {
+    srsran_softbuffer_rx_release(ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_rx));
+  }
+
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
   // Scheduler uses eNB's CC mapping
@@ -643,6 +682,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   }
 
   trace_threshold_complete_event("mac::get_dl_sched", "total_time", std::chrono::microseconds(100));
+  srsran::tti_latency_scope latency_scope(srsran::tti_stage::mac_sched);
   logger.set_context(TTI_SUB(tti_tx_dl, FDD_HARQ_DELAY_UL_MS));
   if (do_padding) {
     add_padding();
@@ -1036,9 +1076,14 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
             continue;
           }
 
-          if (sched_result.pusch[n].current_tx_nb == 0) {
-            srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
+          if (sched_result.pusch[i].current_tx_nb == 0) {
+            if (srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx,
+                                               sched_result.pusch[i].tbs * 8) < SRSRAN_SUCCESS) {
+              logger.warning("UL softbuffer pool exhausted for rnti=0x%x, tti=%d, cc=%d", rnti, tti_tx_ul, enb_cc_idx);
+              continue;
+            }
           }
+          ue_db[rnti]->set_ul_last_tx(enb_cc_idx, tti_tx_ul, sched_result.pusch[i].is_last_tx);
           phy_ul_sched_res->pusch[n].data =
               ue_db[rnti]->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
           if (phy_ul_sched_res->pusch[n].data) {
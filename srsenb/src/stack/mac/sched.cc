@@ -42,7 +42,12 @@ namespace srsenb {
 
 sched::sched() {}
 
-sched::~sched() {}
+sched::~sched()
+{
+  if (cc_worker_pool != nullptr) {
+    cc_worker_pool->stop();
+  }
+}
 
 void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 {
@@ -52,6 +57,10 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
+  if (sched_cfg.nof_cc_workers > 0 and cc_worker_pool == nullptr) {
+    cc_worker_pool.reset(new srsran::work_stealing_pool(sched_cfg.nof_cc_workers, 1, "SCHED_CC"));
+  }
+
   reset();
 }
 
@@ -361,13 +370,50 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
-  // Generate sched results for all CCs, if not yet generated
-  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+  // Find the CCs whose sched result is not yet generated
+  pending_ccs.clear();
+  for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
-      // Generate carrier scheduling result
-      carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+      pending_ccs.push_back(cc_idx);
     }
   }
+
+  if (cc_worker_pool != nullptr and pending_ccs.size() > 1) {
+    generate_tti_results_parallel(tti_rx, pending_ccs);
+    return;
+  }
+
+  // Generate carrier scheduling results one after the other
+  for (uint32_t cc_idx : pending_ccs) {
+    carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+  }
+}
+
+/// Generate the sched result of several CCs, running their DL/UL allocations concurrently. Cross-carrier state is
+/// only touched at two sync points, by the calling thread:
+/// - before the allocations, the UEs are refreshed for the new TTI, the sched results ringbuffer slots are reset and
+///   the PHICHs are allocated. During the allocations, the UEs are only read.
+/// - after all the allocations are done, each CC, in increasing index order, picks its DCI combination, writes its
+///   sched result and updates the UE HARQs.
+/// NOTE: Contrarily to the serial scheduling, a CC allocation does not see the grants of lower-index CCs in the same
+///       TTI. A CA UE may get a small PUSCH grant for its UCI in more than one CC, and a DL newtx whose data was
+///       consumed by the lower-index CCs is dropped when its PDU is built. The result is still deterministic.
+void sched::generate_tti_results_parallel(tti_point tti_rx, const std::vector<uint32_t>& cc_list)
+{
+  for (uint32_t cc_idx : cc_list) {
+    carrier_schedulers[cc_idx]->new_tti(tti_rx);
+  }
+
+  srsran::work_stealing_pool::task_group group;
+  for (uint32_t cc_idx : cc_list) {
+    carrier_sched* carrier = carrier_schedulers[cc_idx].get();
+    cc_worker_pool->push_task(group, [carrier, tti_rx]() { carrier->alloc_tti_grants(tti_rx); });
+  }
+  cc_worker_pool->wait(group);
+
+  for (uint32_t cc_idx : cc_list) {
+    carrier_schedulers[cc_idx]->finish_tti(tti_rx);
+  }
 }
 
 /// Check if TTI result is generated
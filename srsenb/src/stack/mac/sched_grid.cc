@@ -720,6 +720,16 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
         data_alloc.pid, data, get_tti_tx_dl(), cc_cfg->enb_cc_idx, tti_alloc.get_cfi(), data_alloc.user_mask);
 
     if (tbs <= 0) {
+      uint32_t pending_bytes = user->get_pending_dl_bytes(cc_cfg->enb_cc_idx);
+      if (is_newtx and pending_bytes == 0) {
+        // The UE buffer was emptied by other grants of this TTI (e.g. of carriers scheduled in parallel to this one)
+        dl_result->data.pop_back();
+        logger.info("SCHED: DL tx cancelled rnti=0x%x, cc=%d, pid=%d. No pending data left",
+                    user->get_rnti(),
+                    cc_cfg->enb_cc_idx,
+                    data_alloc.pid);
+        continue;
+      }
       fmt::memory_buffer str_buffer;
       fmt::format_to(str_buffer,
                      "SCHED: DL {} failed rnti=0x{:x}, pid={}, mask={:x}, tbs={}, buffer={}",
@@ -728,7 +738,7 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
                      data_alloc.pid,
                      data_alloc.user_mask,
                      tbs,
-                     user->get_pending_dl_bytes(cc_cfg->enb_cc_idx));
+                     pending_bytes);
       logger.warning("%s", srsran::to_c_str(str_buffer));
       continue;
     }
@@ -660,6 +660,7 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
   if (tbinfo.tbs_bytes >= 0) {
     data->tbs           = tbinfo.tbs_bytes;
     data->current_tx_nb = h->nof_retx(0);
+    data->is_last_tx    = h->nof_retx(0) + 1 >= h->max_nof_retx();
     dci->rnti           = rnti;
     dci->format         = SRSRAN_DCI_FORMAT0;
     dci->ue_cc_idx      = cells[enb_cc_idx].get_ue_cc_idx();
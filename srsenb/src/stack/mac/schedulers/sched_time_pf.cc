@@ -20,12 +20,17 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
-#include <vector>
+#include <algorithm>
 
 namespace srsenb {
 
 using srsran::tti_point;
 
+/// Weight of the last TTI in the exponential average of the UE rates
+static const float exp_avg_alpha = 0.01;
+/// Below this value, the common scale of the average rates is folded into the UE contexts
+static const double min_avg_rate_scale = 1e-6;
+
 sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args)
 {
   cc_cfg = &cell_params_;
@@ -33,50 +38,66 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
 
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+  dl_prio_list.reserve(SRSENB_MAX_UES);
+  ul_prio_list.reserve(SRSENB_MAX_UES);
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
-  }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
+  avg_rate_scale *= 1 - exp_avg_alpha;
+
   // remove deleted users from history
   for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
     if (not ue_db.contains(it->first)) {
+      dl_prio_list.erase(std::find(dl_prio_list.begin(), dl_prio_list.end(), &it->second));
+      ul_prio_list.erase(std::find(ul_prio_list.begin(), ul_prio_list.end(), &it->second));
       it = ue_history_db.erase(it);
     } else {
       ++it;
     }
   }
-  // add new users to history db, and update priority queues
+
+  bool rescale = avg_rate_scale < min_avg_rate_scale;
+  // add new users to history db, and refresh HARQs and CQIs
   for (auto& u : ue_db) {
     auto it = ue_history_db.find(u.first);
     if (it == ue_history_db.end()) {
       it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+      dl_prio_list.push_back(&it->second);
+      ul_prio_list.push_back(&it->second);
+    }
+    if (rescale) {
+      it->second.rescale_avg_rates(avg_rate_scale);
     }
     it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+  }
+  if (rescale) {
+    avg_rate_scale = 1;
+  }
+
+  update_prio_lists();
+}
+
+/// Moves the UEs whose priority changed to their new position in the priority lists
+void sched_time_pf::update_prio_lists()
+{
+  auto reposition = [](std::vector<ue_ctxt*>& list, ue_ctxt* ue, double ue_ctxt::*prio) {
+    list.erase(std::find(list.begin(), list.end(), ue));
+    auto pos = std::upper_bound(
+        list.begin(), list.end(), ue->*prio, [prio](double p, const ue_ctxt* other) { return p > other->*prio; });
+    list.insert(pos, ue);
+  };
+
+  for (auto& u : ue_history_db) {
+    ue_ctxt& ue = u.second;
+    if (ue.dl_prio_changed) {
+      reposition(dl_prio_list, &ue, &ue_ctxt::dl_prio);
+      ue.dl_prio_changed = false;
     }
-    if (it->second.ul_h != nullptr) {
-      // Allocate only if UL carrier is enabled
-      for (auto& i : u.second->get_ue_cfg().supported_cc_list) {
-        if (i.enb_cc_idx == cc_cfg->enb_cc_idx and not i.ul_disabled) {
-          ul_queue.push(&it->second);
-          break;
-        }
-      }
+    if (ue.ul_prio_changed) {
+      reposition(ul_prio_list, &ue, &ue_ctxt::ul_prio);
+      ue.ul_prio_changed = false;
     }
   }
 }
@@ -92,10 +113,17 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
+  // Retransmissions go first
+  for (ue_ctxt* ue : dl_prio_list) {
+    if (ue->dl_retx_h != nullptr) {
+      ue->save_dl_alloc(try_dl_alloc(*ue, *ue_db[ue->rnti], tti_sched), exp_avg_alpha, avg_rate_scale);
+    }
+  }
+  for (ue_ctxt* ue : dl_prio_list) {
+    if (ue->dl_retx_h == nullptr and ue->ue_cc_idx >= 0) {
+      uint32_t alloc_bytes = ue->dl_newtx_h != nullptr ? try_dl_alloc(*ue, *ue_db[ue->rnti], tti_sched) : 0;
+      ue->save_dl_alloc(alloc_bytes, exp_avg_alpha, avg_rate_scale);
+    }
   }
 }
 
@@ -131,10 +159,17 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
+  // Retransmissions go first
+  for (ue_ctxt* ue : ul_prio_list) {
+    if (ue->ul_enabled and ue->ul_retx) {
+      ue->save_ul_alloc(try_ul_alloc(*ue, *ue_db[ue->rnti], tti_sched), exp_avg_alpha, avg_rate_scale);
+    }
+  }
+  for (ue_ctxt* ue : ul_prio_list) {
+    if (ue->ul_enabled and not ue->ul_retx) {
+      uint32_t alloc_bytes = ue->ul_h != nullptr ? try_ul_alloc(*ue, *ue_db[ue->rnti], tti_sched) : 0;
+      ue->save_ul_alloc(alloc_bytes, exp_avg_alpha, avg_rate_scale);
+    }
   }
 }
 
@@ -155,6 +190,10 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
     code            = try_ul_retx_alloc(*tti_sched, ue, *ue_ctxt.ul_h);
     estim_tbs_bytes = code == alloc_result::success ? ue_ctxt.ul_h->get_pending_data() : 0;
   } else {
+    // If all PRBs are occupied, the next steps can be shortcut
+    if (tti_sched->get_ul_mask().all()) {
+      return 0;
+    }
     // Note: h->is_empty check is required, in case CA allocated a small UL grant for UCI
     uint32_t pending_data = ue.get_pending_ul_new_data(tti_sched->get_tti_tx_ul(), cc_cfg->enb_cc_idx);
     // Check if there is a empty harq, and data to transmit
@@ -183,69 +222,103 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
   dl_retx_h  = nullptr;
   dl_newtx_h = nullptr;
   ul_h       = nullptr;
-  dl_prio    = 0;
+  ul_retx    = false;
+  ul_enabled = false;
   ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
   if (ue_cc_idx < 0) {
     // not active
     return;
   }
 
-  // Calculate DL priority
+  // The PF priorities only need to be recomputed if the CQIs changed
+  const sched_ue_cell* ue_cell = ue.find_ue_carrier(cell.enb_cc_idx);
+  int                  cqi     = ue_cell->get_dl_cqi();
+  if (cqi != dl_cqi) {
+    dl_cqi      = cqi;
+    dl_coderate = srsran_cqi_to_coderate(std::min(cqi + 1, 15), ue.get_ue_cfg().use_tbs_index_alt);
+    update_dl_prio();
+  }
+  cqi = ue_cell->get_ul_cqi();
+  if (cqi != ul_cqi) {
+    ul_cqi      = cqi;
+    ul_coderate = srsran_cqi_to_coderate(std::min(cqi + 1, 15), false);
+    update_ul_prio();
+  }
+
   dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
   dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
-  if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
-    // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
-  }
 
-  // Calculate UL priority
-  ul_h = get_ul_retx_harq(ue, tti_sched);
+  ul_h    = get_ul_retx_harq(ue, tti_sched);
+  ul_retx = ul_h != nullptr;
   if (ul_h == nullptr) {
     ul_h = get_ul_newtx_harq(ue, tti_sched);
   }
-  if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  // Allocate only if UL carrier is enabled
+  for (auto& i : ue.get_ue_cfg().supported_cc_list) {
+    if (i.enb_cc_idx == cell.enb_cc_idx and not i.ul_disabled) {
+      ul_enabled = true;
+      break;
+    }
   }
 }
 
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha, double scale)
 {
+  // the new average is stored relative to the scale of the next TTI
+  double next_scale = scale * (1 - exp_avg_alpha);
   if (dl_nof_samples < 1 / exp_avg_alpha) {
     // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
-  } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    double avg_rate = dl_avg_rate(scale);
+    avg_rate        = avg_rate + (alloc_bytes - avg_rate) / (dl_nof_samples + 1);
+    dl_avg_rate_    = avg_rate / next_scale;
+    dl_nof_samples++;
+    update_dl_prio();
+  } else if (alloc_bytes > 0) {
+    // the decay of the average is accounted in the common scale
+    dl_avg_rate_ += exp_avg_alpha * alloc_bytes / next_scale;
+    update_dl_prio();
   }
-  dl_nof_samples++;
 }
 
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha, double scale)
 {
+  // the new average is stored relative to the scale of the next TTI
+  double next_scale = scale * (1 - exp_avg_alpha);
   if (ul_nof_samples < 1 / exp_avg_alpha) {
     // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
-  } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    double avg_rate = ul_avg_rate(scale);
+    avg_rate        = avg_rate + (alloc_bytes - avg_rate) / (ul_nof_samples + 1);
+    ul_avg_rate_    = avg_rate / next_scale;
+    ul_nof_samples++;
+    update_ul_prio();
+  } else if (alloc_bytes > 0) {
+    // the decay of the average is accounted in the common scale
+    ul_avg_rate_ += exp_avg_alpha * alloc_bytes / next_scale;
+    update_ul_prio();
   }
-  ul_nof_samples++;
 }
 
-bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+void sched_time_pf::ue_ctxt::rescale_avg_rates(double scale)
+{
+  // Scaling all the UEs by the same factor does not change their order
+  dl_avg_rate_ *= scale;
+  ul_avg_rate_ *= scale;
+  update_dl_prio();
+  update_ul_prio();
+}
+
+void sched_time_pf::ue_ctxt::update_dl_prio()
 {
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
+  double R        = dl_avg_rate_;
+  dl_prio         = (R != 0) ? dl_coderate / pow(R, fairness_coeff) : std::numeric_limits<double>::max();
+  dl_prio_changed = true;
 }
 
-bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+void sched_time_pf::ue_ctxt::update_ul_prio()
 {
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
+  double R        = ul_avg_rate_;
+  ul_prio         = (R != 0) ? ul_coderate / pow(R, fairness_coeff) : std::numeric_limits<double>::max();
+  ul_prio_changed = true;
 }
 
 } // namespace srsenb
@@ -32,13 +32,22 @@
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
+ue_cc_softbuffers::ue_cc_softbuffers(uint32_t                  nof_prb,
+                                     uint32_t                  nof_tx_harq_proc_,
+                                     uint32_t                  nof_rx_harq_proc_,
+                                     srsran_softbuffer_pool_t* rx_pool) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
-  // Create and init Rx buffers
+  // Create and init Rx buffers. With a pool, code blocks are only leased while the HARQ process is active
   softbuffer_rx_list.resize(nof_rx_harq_proc);
+  rx_last_tx.resize(nof_rx_harq_proc, false);
   for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+    if (rx_pool != nullptr) {
+      uint32_t max_cb = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+      srsran_softbuffer_rx_init_pool(&buffer, rx_pool, max_cb);
+    } else {
+      srsran_softbuffer_rx_init(&buffer, nof_prb);
+    }
   }
 
   // Create and init Tx buffers
@@ -66,6 +75,7 @@ void ue_cc_softbuffers::clear()
   for (auto& buffer : softbuffer_rx_list) {
     srsran_softbuffer_rx_reset(&buffer);
   }
+  std::fill(rx_last_tx.begin(), rx_last_tx.end(), false);
   for (auto& buffer : softbuffer_tx_list) {
     srsran_softbuffer_tx_reset(&buffer);
   }
@@ -255,6 +265,26 @@ srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti)
   return &cc_buffers[enb_cc_idx].get_rx_softbuffer(tti);
 }
 
+void ue::set_ul_last_tx(uint32_t enb_cc_idx, uint32_t tti, bool last_tx)
+{
+  if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
+    ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
+    return;
+  }
+
+  cc_buffers[enb_cc_idx].set_rx_last_tx(tti, last_tx);
+}
+
+bool ue::is_ul_last_tx(uint32_t enb_cc_idx, uint32_t tti)
+{
+  if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
+    ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
+    return false;
+  }
+
+  return cc_buffers[enb_cc_idx].is_rx_last_tx(tti);
+}
+
 srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
@@ -427,10 +427,23 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
   }
 
   // Assign a handler to rx S1U packets
-  auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
-    handle_gtpu_s1u_rx_packet(std::move(pdu), from);
-  };
-  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  if (args.mmsg_enable) {
+    auto rx_callback = [this](srsran::rx_sdu_burst_t& burst) {
+      metrics.rx_pdus += burst.size();
+      metrics.rx_batch_hist[gtpu_batch_hist_bin(burst.size())]++;
+      for (srsran::rx_sdu_t& rx_sdu : burst) {
+        handle_gtpu_s1u_rx_packet(std::move(rx_sdu.sdu), rx_sdu.from);
+      }
+    };
+    rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_burst_handler(logger, gtpu_queue, rx_callback));
+  } else {
+    auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+      metrics.rx_pdus++;
+      metrics.rx_batch_hist[0]++;
+      handle_gtpu_s1u_rx_packet(std::move(pdu), from);
+    };
+    rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  }
 
   // Start MCH socket if enabled
   if (args.embms_enable) {
@@ -443,6 +456,8 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
 void gtpu::stop()
 {
+  // Send the pending PDUs while the socket is still open
+  flush_tx_batch();
   if (fd > 0) {
     close(fd);
     fd = -1;
@@ -496,9 +511,65 @@ void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buf
     logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
     return;
   }
+
+  if (args.mmsg_enable) {
+    // The PDUs written within the same stack task are sent together once the task finishes
+    if (tx_batch.empty()) {
+      task_sched.defer_task([this]() { flush_tx_batch(); });
+    }
+    tx_batch.push_back(tx_pdu_t{std::move(pdu), servaddr});
+    if (tx_batch.full()) {
+      flush_tx_batch();
+    }
+    return;
+  }
+
   if (sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) < 0) {
     perror("sendto");
+    return;
+  }
+  metrics.tx_pdus++;
+  metrics.tx_batch_hist[0]++;
+}
+
+void gtpu::flush_tx_batch()
+{
+  // The deferred flush may run after stop() has closed the socket
+  if (fd < 0) {
+    tx_batch.clear();
+    return;
+  }
+
+  std::array<mmsghdr, GTPU_MAX_TX_BATCH> msgs   = {};
+  std::array<iovec, GTPU_MAX_TX_BATCH>   iovecs = {};
+  for (uint32_t i = 0; i < tx_batch.size(); ++i) {
+    iovecs[i].iov_base          = tx_batch[i].pdu->msg;
+    iovecs[i].iov_len           = tx_batch[i].pdu->N_bytes;
+    msgs[i].msg_hdr.msg_name    = &tx_batch[i].addr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    msgs[i].msg_hdr.msg_iov     = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  // sendmmsg(...) may stop early, e.g. if the socket buffer fills up
+  uint32_t nof_sent = 0;
+  while (nof_sent < tx_batch.size()) {
+    int ret = sendmmsg(fd, &msgs[nof_sent], tx_batch.size() - nof_sent, MSG_EOR);
+    if (ret <= 0) {
+      perror("sendmmsg");
+      break;
+    }
+    metrics.tx_pdus += ret;
+    metrics.tx_batch_hist[gtpu_batch_hist_bin(ret)]++;
+    nof_sent += ret;
   }
+  tx_batch.clear();
+}
+
+void gtpu::get_metrics(gtpu_metrics_t& m)
+{
+  m       = metrics;
+  metrics = {};
 }
 
 srsran::expected<uint32_t> gtpu::add_bearer(uint16_t            rnti,
@@ -845,6 +916,9 @@ bool gtpu::send_end_marker(uint32_t teidin)
   servaddr.sin_addr.s_addr    = htonl(tx_tun->spgw_addr);
   servaddr.sin_port           = htons(GTPU_PORT);
 
+  // The End Marker must follow the data PDUs still waiting to be sent
+  flush_tx_batch();
+
   bool success =
       sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) > 0;
   if (success) {
@@ -33,6 +33,8 @@ struct run_params {
   uint32_t    nof_ttis;
   uint32_t    cqi;
   const char* sched_policy;
+  uint32_t    nof_ccs;
+  uint32_t    nof_cc_workers;
 };
 
 struct run_params_range {
@@ -40,9 +42,15 @@ struct run_params_range {
   std::vector<uint32_t>    nof_ues      = {1, 2, 5, 32};
   uint32_t                 nof_ttis     = 10000;
   std::vector<uint32_t>    cqi          = {5, 10, 15};
-  std::vector<const char*> sched_policy = {"time_rr", "time_pf"};
+  std::vector<const char*> sched_policy   = {"time_rr", "time_pf"};
+  std::vector<uint32_t>    nof_ccs        = {1};
+  std::vector<uint32_t>    nof_cc_workers = {0};
 
-  size_t     nof_runs() const { return nof_prbs.size() * nof_ues.size() * cqi.size() * sched_policy.size(); }
+  size_t nof_runs() const
+  {
+    return nof_prbs.size() * nof_ues.size() * cqi.size() * sched_policy.size() * nof_ccs.size() *
+           nof_cc_workers.size();
+  }
   run_params get_params(size_t idx) const
   {
     run_params r = {};
@@ -53,7 +61,11 @@ struct run_params_range {
     idx /= nof_ues.size();
     r.cqi = cqi[idx % cqi.size()];
     idx /= cqi.size();
-    r.sched_policy = sched_policy.at(idx);
+    r.sched_policy = sched_policy[idx % sched_policy.size()];
+    idx /= sched_policy.size();
+    r.nof_ccs = nof_ccs[idx % nof_ccs.size()];
+    idx /= nof_ccs.size();
+    r.nof_cc_workers = nof_cc_workers.at(idx);
     return r;
   }
 };
@@ -101,15 +113,16 @@ public:
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    // The latency accounts for the scheduling of all carriers in the TTI
+    std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
-      std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
       TESTASSERT(sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]) == SRSRAN_SUCCESS);
-      std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
-      std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
-      total_stats.avg_latency.push(tdur.count());
-      total_stats.latency_samples.push_back(tdur.count());
     }
+    std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
+    total_stats.avg_latency.push(tdur.count());
+    total_stats.latency_samples.push_back(tdur.count());
 
     sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
     update(sf_out);
@@ -171,10 +184,14 @@ struct run_data {
 
 int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results)
 {
-  std::vector<sched_interface::cell_cfg_t> cell_list(1, generate_default_cell_cfg(params.nof_prbs));
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_ccs, generate_default_cell_cfg(params.nof_prbs));
   sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
   sched_interface::sched_args_t            sched_args     = {};
   sched_args.sched_policy                                 = params.sched_policy;
+  sched_args.nof_cc_workers                               = params.nof_cc_workers;
+  for (uint32_t cc = 0; cc < cell_list.size(); ++cc) {
+    cell_list[cc].cell.id = cc + 1;
+  }
 
   sched     sched_obj;
   rrc_dummy rrc{};
@@ -186,6 +203,8 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
 
   for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
     uint16_t rnti = 0x46 + ue_idx;
+    // UEs are evenly spread across carriers
+    ue_cfg_default.supported_cc_list[0].enb_cc_idx = ue_idx % params.nof_ccs;
     // Add user (first need to advance to a PRACH TTI)
     while (not srsran_prach_tti_opportunity_config_fdd(
         tester.get_cell_params()[ue_cfg_default.supported_cc_list[0].enb_cc_idx].cfg.prach_config,
@@ -264,10 +283,10 @@ run_data expected_run_result(run_params params)
 void print_benchmark_results(const std::vector<run_data>& run_results)
 {
   srslog::flush();
-  fmt::print("run | Nprb | cqi | sched pol | Nue | DL/UL [Mbps] | DL/UL mcs | DL/UL OH [%] | latency | latency q0.9 "
-             "[usec]\n");
+  fmt::print("run | Nprb | cqi | sched pol | Nue | Ncc | Nwrk | DL/UL [Mbps] | DL/UL mcs | DL/UL OH [%] | latency | "
+             "latency q0.9 [usec]\n");
   fmt::print("------------------------------------------------------------------------------------------------------"
-             "------\n");
+             "-------------------\n");
   for (uint32_t i = 0; i < run_results.size(); ++i) {
     const run_data& r = run_results[i];
 
@@ -279,12 +298,15 @@ void print_benchmark_results(const std::vector<run_data>& run_results)
     tbs                     = srsran_ra_tbs_from_idx(tbs_idx, nof_pusch_prbs);
     float ul_rate_overhead  = 1.0F - r.avg_ul_throughput / (static_cast<float>(tbs) * 1e3F);
 
-    fmt::print("{:>3d}{:>6d}{:>6d}{:>12}{:>6d}{:>9.2}/{:>4.2}{:>9.1f}/{:>4.1f}{:9.1f}/{:>4.1f}{:>9d}{:12d}\n",
+    fmt::print("{:>3d}{:>6d}{:>6d}{:>12}{:>6d}{:>6d}{:>7d}{:>9.2}/{:>4.2}{:>9.1f}/{:>4.1f}{:9.1f}/{:>4.1f}{:>9d}"
+               "{:12d}\n",
                i,
                r.params.nof_prbs,
                r.params.cqi,
                r.params.sched_policy,
                r.params.nof_ues,
+               r.params.nof_ccs,
+               r.params.nof_cc_workers,
                r.avg_dl_throughput / 1e6,
                r.avg_ul_throughput / 1e6,
                r.avg_dl_mcs,
@@ -394,6 +416,62 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+/// Scheduling time per TTI with as many UEs as the eNB supports, all of them with full buffers
+int run_large_ue_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis = 100000;
+  run_param_list.nof_prbs = {100};
+  run_param_list.cqi      = {15};
+  run_param_list.nof_ues  = {SRSENB_MAX_UES / 4, SRSENB_MAX_UES};
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running Benchmark with up to {} UEs\n", SRSENB_MAX_UES);
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Scheduling time per TTI of all carriers of a CA deployment, with the carriers scheduled serially and in parallel.
+/// The UEs are evenly spread across carriers, and each carrier reports its own DL/UL rate
+int run_multi_carrier_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis       = 20000;
+  run_param_list.nof_prbs       = {100};
+  run_param_list.cqi            = {15};
+  run_param_list.nof_ues        = {SRSENB_MAX_UES / 4, SRSENB_MAX_UES};
+  run_param_list.sched_policy   = {"time_pf"};
+  run_param_list.nof_ccs        = {3};
+  run_param_list.nof_cc_workers = {0, 1, 2};
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running multi-carrier Benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -424,6 +502,10 @@ int main(int argc, char* argv[])
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark_ues") == 0) {
+    TESTASSERT(srsenb::run_large_ue_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark_ca") == 0) {
+    TESTASSERT(srsenb::run_multi_carrier_benchmark() == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
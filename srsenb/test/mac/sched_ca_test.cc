@@ -62,16 +62,18 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 
   sim_args.default_ue_sim_cfg.ue_cfg = generate_default_ue_cfg2();
 
-  // setup two cells
+  // setup cells. Each cell has all the other cells as SCells
   std::vector<srsenb::sched_interface::cell_cfg_t> cell_cfg(nof_ccs, generate_default_cell_cfg(nof_prb));
-  cell_cfg[0].scell_list.resize(1);
-  cell_cfg[0].scell_list[0].enb_cc_idx               = 1;
-  cell_cfg[0].scell_list[0].cross_carrier_scheduling = false;
-  cell_cfg[0].scell_list[0].ul_allowed               = true;
-  cell_cfg[1].cell.id                                = 2; // id=2
-  cell_cfg[1].scell_list                             = cell_cfg[0].scell_list;
-  cell_cfg[1].scell_list[0].enb_cc_idx               = 0;
-  sim_args.cell_cfg                                  = std::move(cell_cfg);
+  for (uint32_t cc = 0; cc < nof_ccs; ++cc) {
+    cell_cfg[cc].cell.id = cc + 1;
+    cell_cfg[cc].scell_list.resize(nof_ccs - 1);
+    for (uint32_t i = 0; i < cell_cfg[cc].scell_list.size(); ++i) {
+      cell_cfg[cc].scell_list[i].enb_cc_idx               = i < cc ? i : i + 1;
+      cell_cfg[cc].scell_list[i].cross_carrier_scheduling = false;
+      cell_cfg[cc].scell_list[i].ul_allowed               = true;
+    }
+  }
+  sim_args.cell_cfg = std::move(cell_cfg);
 
   /* Setup Derived Params */
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(nof_ccs);
@@ -84,14 +86,16 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 }
 
 struct test_scell_activation_params {
-  uint32_t pcell_idx = 0;
+  uint32_t pcell_idx      = 0;
+  uint32_t nof_ccs        = 2;
+  uint32_t nof_cc_workers = 0; ///< if > 0, the carriers' allocations run in parallel
 };
 
 int test_scell_activation(uint32_t sim_number, test_scell_activation_params params)
 {
   /* Simulation Configuration Arguments */
   uint32_t nof_prb   = srsran::lte_cell_nof_prbs[std::uniform_int_distribution<uint32_t>{0, 5}(get_rand_gen())];
-  uint32_t nof_ccs   = 2;
+  uint32_t nof_ccs   = params.nof_ccs;
   uint32_t start_tti = 0; // rand_int(0, 10240);
 
   /* Internal configurations. Do not touch */
@@ -111,8 +115,9 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
   std::iter_swap(cc_idxs.begin(), std::find(cc_idxs.begin(), cc_idxs.end(), params.pcell_idx));
 
   /* Setup simulation arguments struct */
-  sim_sched_args sim_args = generate_default_sim_args(nof_prb, nof_ccs);
-  sim_args.start_tti      = start_tti;
+  sim_sched_args sim_args            = generate_default_sim_args(nof_prb, nof_ccs);
+  sim_args.start_tti                 = start_tti;
+  sim_args.sched_args.nof_cc_workers = params.nof_cc_workers;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(1);
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].active                                = true;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx                            = cc_idxs[0];
@@ -282,6 +287,19 @@ int main()
     TESTASSERT(test_scell_activation(n * 2 + 1, p) == SRSRAN_SUCCESS);
   }
 
+  // Three carriers, scheduled serially and in parallel
+  for (uint32_t n = 0; n < N_runs; ++n) {
+    printf("[TESTER] Sim run number: %u\n", N_runs + n);
+
+    test_scell_activation_params p = {};
+    p.pcell_idx                    = n % 3;
+    p.nof_ccs                      = 3;
+    TESTASSERT(test_scell_activation(2 * N_runs + n * 2, p) == SRSRAN_SUCCESS);
+
+    p.nof_cc_workers = 2;
+    TESTASSERT(test_scell_activation(2 * N_runs + n * 2 + 1, p) == SRSRAN_SUCCESS);
+  }
+
   srslog::flush();
 
   return 0;
@@ -331,7 +331,7 @@ private:
   std::queue<tti_dl_info_t>  tti_dl_info_sched_queue;
   std::queue<tti_dl_info_t>  tti_dl_info_ack_queue;
   std::queue<tti_ul_info_t>  tti_ul_info_sched_queue;
-  std::queue<tti_ul_info_t>  tti_ul_info_ack_queue;
+  std::deque<tti_ul_info_t>  tti_ul_info_ack_queue;
   std::queue<tti_sr_info_t>  tti_sr_info_queue;
   std::queue<tti_cqi_info_t> tti_cqi_info_queue;
   std::vector<uint32_t>      active_cell_list;
@@ -514,7 +514,13 @@ public:
     tti_ul_info.tti           = tti;
     tti_ul_info.cc_idx        = cc_idx;
     tti_ul_info.crc           = crc_res;
-    tti_ul_info_ack_queue.push(tti_ul_info);
+
+    // With work stealing, the carriers of a TTI are decoded in parallel. Keep them in the order they were scheduled
+    auto it = tti_ul_info_ack_queue.end();
+    while (it != tti_ul_info_ack_queue.begin() and std::prev(it)->tti == tti and std::prev(it)->cc_idx > cc_idx) {
+      --it;
+    }
+    tti_ul_info_ack_queue.insert(it, tti_ul_info);
 
     logger.info("Received UL ACK tti=%d; rnti=0x%x; cc=%d; ack=%d;", tti, rnti, cc_idx, crc_res);
     notify_crc_info();
@@ -758,7 +764,7 @@ public:
       }
 
       tti_ul_info_sched_queue.pop();
-      tti_ul_info_ack_queue.pop();
+      tti_ul_info_ack_queue.pop_front();
     }
 
     //  Check SR match with TTI
@@ -1173,6 +1179,7 @@ public:
     std::string           log_level           = "none";
     uint32_t              tm_u32              = 1;
     uint32_t              period_pcell_rotate = 0;
+    uint32_t              nof_steal_threads   = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
     args_t()
@@ -1242,7 +1249,8 @@ public:
 
     // PHY arguments
     phy_args.log.phy_level   = args.log_level;
-    phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.nof_phy_threads   = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.nof_steal_threads = args.nof_steal_threads;
 
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
@@ -1462,6 +1470,7 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("nof_steal_threads", bpo::value<uint32_t>(&args.nof_steal_threads),               "Number of threads stealing carrier and UL user tasks, set to zero to disable")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
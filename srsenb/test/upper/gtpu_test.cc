@@ -382,6 +382,70 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   return SRSRAN_SUCCESS;
 }
 
+int test_gtpu_tx_batching()
+{
+  std::random_device    rd;
+  std::mt19937          g(rd());
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("GTPU");
+  logger.info("\n\n**** Test GTPU Tx batching ****\n");
+  uint16_t           rnti           = 0x46;
+  uint32_t           drb1_bearer_id = 5;
+  const char *       sgw_addr_str = "127.0.1.3", *senb_addr_str = "127.0.1.4";
+  struct sockaddr_in senb_sockaddr = {}, sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&senb_sockaddr, senb_addr_str, GTPU_PORT);
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+  uint32_t senb_addr = ntohl(senb_sockaddr.sin_addr.s_addr);
+  uint32_t sgw_addr  = ntohl(sgw_sockaddr.sin_addr.s_addr);
+
+  // Initiate layers. The SeNB batches its S1-U socket I/O, and the peer GTPU plays the role of the SGW
+  srslog::basic_logger& logger1 = srslog::fetch_basic_logger("GTPU1");
+  srslog::basic_logger& logger2 = srslog::fetch_basic_logger("GTPU2");
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   senb_rx_sockets, sgw_rx_sockets;
+  srsenb::gtpu           senb_gtpu(&task_sched, logger1, srsran::srsran_rat_t::lte, &senb_rx_sockets),
+      sgw_gtpu(&task_sched, logger2, srsran::srsran_rat_t::lte, &sgw_rx_sockets);
+  pdcp_tester senb_pdcp, sgw_pdcp;
+  gtpu_args_t gtpu_args;
+  gtpu_args.gtp_bind_addr = senb_addr_str;
+  gtpu_args.mme_addr      = sgw_addr_str;
+  gtpu_args.mmsg_enable   = true;
+  TESTASSERT(senb_gtpu.init(gtpu_args, &senb_pdcp) == SRSRAN_SUCCESS);
+  gtpu_args.gtp_bind_addr = sgw_addr_str;
+  gtpu_args.mmsg_enable   = false;
+  TESTASSERT(sgw_gtpu.init(gtpu_args, &sgw_pdcp) == SRSRAN_SUCCESS);
+  uint32_t addr_in;
+  uint32_t sgw_teid_in = sgw_gtpu.add_bearer(rnti, drb1_bearer_id, senb_addr, 0, addr_in).value();
+  senb_gtpu.add_bearer(rnti, drb1_bearer_id, sgw_addr, sgw_teid_in, addr_in);
+
+  // TEST: UL PDUs written within the same task are only sent once the task finishes
+  size_t N_pdus = std::uniform_int_distribution<size_t>{2, 20}(g);
+  for (size_t i = 0; i < N_pdus; ++i) {
+    std::vector<uint8_t> data(10, i);
+    senb_gtpu.write_pdu(rnti, drb1_bearer_id, encode_ipv4_packet(data, 0, senb_sockaddr, sgw_sockaddr));
+  }
+  uint8_t dummy;
+  TESTASSERT(recv(sgw_rx_sockets.s1u_fd, &dummy, sizeof(dummy), MSG_DONTWAIT | MSG_PEEK) < 0);
+  task_sched.run_pending_tasks();
+
+  // TEST: all the PDUs reach the SGW, in order
+  for (size_t i = 0; i < N_pdus; ++i) {
+    sgw_pdcp.clear();
+    sgw_gtpu.handle_gtpu_s1u_rx_packet(read_socket(sgw_rx_sockets.s1u_fd), senb_sockaddr);
+    TESTASSERT(sgw_pdcp.last_sdu != nullptr);
+    srsran::span<uint8_t> pdu_view = srsran::make_span(sgw_pdcp.last_sdu);
+    TESTASSERT(std::count(pdu_view.begin() + PDU_HEADER_SIZE, pdu_view.end(), i) == 10);
+  }
+
+  // TEST: the PDUs were sent with a single system call
+  gtpu_metrics_t metrics;
+  senb_gtpu.get_metrics(metrics);
+  TESTASSERT(metrics.tx_pdus == N_pdus);
+  TESTASSERT(metrics.tx_batch_hist[gtpu_batch_hist_bin(N_pdus)] == 1);
+  TESTASSERT(std::accumulate(metrics.tx_batch_hist.begin(), metrics.tx_batch_hist.end(), 0) == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -399,6 +463,7 @@ int main(int argc, char** argv)
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::reest_senb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_gtpu_tx_batching() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
@@ -23,13 +23,16 @@
 #define SRSEPC_GTPU_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <cstddef>
 #include <queue>
+#include <sys/socket.h>
 
 namespace srsepc {
 
@@ -46,9 +49,15 @@ public:
   int get_sgi();
   int get_s1u();
 
+  // Read and handle all the packets pending in the SGi/S1-U interfaces (up to MAX_BURST_SIZE).
+  // Return the number of packets handled, or -1 on error.
+  int handle_sgi_burst();
+  int handle_s1u_burst();
+
   void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
   void handle_s1u_pdu(srsran::byte_buffer_t* msg);
-  void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
+  void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::unique_byte_buffer_t msg);
+  void flush_s1u_pdus();
 
   virtual in_addr_t get_s1u_addr();
 
@@ -68,10 +77,29 @@ public:
   int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  static const uint32_t MAX_BURST_SIZE = 32;
+
+  // Tunnels of a UE. The control TEID is kept while the UE is attached without an active user-plane, which is
+  // necessary to trigger downlink data notifications.
+  struct ue_tunnel_t {
+    bool                usr_present = false;
+    bool                ctr_present = false;
+    srsran::gtp_fteid_t usr_fteid   = {}; // User-plane TEID for downlink traffic
+    uint32_t            ctr_teid    = 0;
+  };
+  srsran::flat_hash_map<in_addr_t, ue_tunnel_t> m_ip_to_tunnel; // Map UE IP to its tunnels
+
+  // Downlink S1-U PDUs pending to be sent with a single sendmmsg()
+  uint32_t                                                 m_nof_tx_pdus = 0;
+  std::array<srsran::unique_byte_buffer_t, MAX_BURST_SIZE> m_tx_pdus;
+  std::array<sockaddr_in, MAX_BURST_SIZE>                  m_tx_addrs;
+  std::array<iovec, MAX_BURST_SIZE>                        m_tx_iovs;
+  std::array<mmsghdr, MAX_BURST_SIZE>                      m_tx_hdrs;
+
+  // Uplink S1-U PDUs received with a single recvmmsg()
+  std::array<srsran::unique_byte_buffer_t, MAX_BURST_SIZE> m_rx_pdus;
+  std::array<iovec, MAX_BURST_SIZE>                        m_rx_iovs;
+  std::array<mmsghdr, MAX_BURST_SIZE>                      m_rx_hdrs;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
@@ -64,6 +64,7 @@ class spgw : public srsran::thread
 {
   class gtpc;
   class gtpu;
+  friend class spgw_gtpu_benchmark;
 
 public:
   static spgw* get_instance(void);
@@ -86,13 +86,12 @@ int spgw::gtpc::init(spgw_args_t*                           args,
 
 void spgw::gtpc::stop()
 {
-  std::map<uint32_t, spgw_tunnel_ctx*>::iterator it = m_teid_to_tunnel_ctx.begin();
-  while (it != m_teid_to_tunnel_ctx.end()) {
-    m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", it->second->imsi);
-    srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", it->second->imsi);
-    delete it->second;
-    m_teid_to_tunnel_ctx.erase(it++);
+  for (auto& it : m_teid_to_tunnel_ctx) {
+    m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", it.second->imsi);
+    srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", it.second->imsi);
+    delete it.second;
   }
+  m_teid_to_tunnel_ctx.clear();
   return;
 }
 
@@ -240,8 +239,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
   m_logger.info("Received Modified Bearer Request");
 
   // Get control tunnel info from mb_req PDU
-  uint32_t                                         ctrl_teid = mb_req_hdr.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = mb_req_hdr.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID %d to modify", ctrl_teid);
     return;
@@ -303,8 +302,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
 void spgw::gtpc::handle_delete_session_request(const srsran::gtpc_header&                 header,
                                                const srsran::gtpc_delete_session_request& del_req_pdu)
 {
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to delete session", ctrl_teid);
     return;
@@ -320,8 +319,8 @@ void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header
                                                        const srsran::gtpc_release_access_bearers_request& rel_req)
 {
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to release bearers", ctrl_teid);
     return;
@@ -344,7 +343,7 @@ bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
   struct srsran::gtpc_downlink_data_notification* dl_not = &dl_not_pdu.choice.downlink_data_notification;
 
   // Find MME Ctrl TEID
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
+  auto tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to send downlink notification.", spgw_ctr_teid);
     return false;
@@ -382,8 +381,8 @@ void spgw::gtpc::handle_downlink_data_notification_acknowledge(
   m_logger.debug("Handling downlink data notification acknowledge");
 
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification acknowldge", ctrl_teid);
     return;
@@ -410,8 +409,8 @@ void spgw::gtpc::handle_downlink_data_notification_failure_indication(
 {
   m_logger.debug("Handling downlink data notification failure indication");
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification failure indication", ctrl_teid);
     return;
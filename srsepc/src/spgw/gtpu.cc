@@ -122,6 +122,13 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // Non-blocking, so that all the pending packets can be drained in bursts
+  if (fcntl(m_sgi, F_SETFL, fcntl(m_sgi, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set TUN device as non-blocking: %s", strerror(errno));
+    close(m_sgi);
+    return SRSRAN_ERROR_CANT_START;
+  }
+
   // Bring up the interface
   sgi_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (ioctl(sgi_sock, SIOCGIFFLAGS, &ifr) < 0) {
@@ -199,20 +206,84 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
+  // Allocate the buffers used to receive S1-U bursts. They are reused across bursts.
+  for (srsran::unique_byte_buffer_t& pdu : m_rx_pdus) {
+    pdu = srsran::make_byte_buffer("spgw::gtpu::s1u_rx");
+    if (pdu == nullptr) {
+      m_logger.error("Failed to allocate S1-U receive buffers");
+      return SRSRAN_ERROR_CANT_START;
+    }
+  }
+
   m_logger.info("Initialized S1-U interface");
   return SRSRAN_SUCCESS;
 }
 
+int spgw::gtpu::handle_sgi_burst()
+{
+  size_t buf_len  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  int    nof_pdus = 0;
+  for (; nof_pdus < (int)MAX_BURST_SIZE; ++nof_pdus) {
+    /*
+     * SGi messages may need to be queued when waiting for UE Paging procedure.
+     * For this reason, buffers for SGi pdus are allocated here and deallocated
+     * when the PDU is sent (see flush_s1u_pdus()), at handle_sgi_pdu() when the PDU is dropped or at
+     * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
+     * procedure fails (see handle_downlink_data_notification_acknowledgment and
+     * handle_downlink_data_notification_failure)
+     */
+    srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer("spgw::gtpu::sgi_pdu");
+    if (msg == nullptr) {
+      m_logger.error("Couldn't allocate buffer for SGi PDU");
+      break;
+    }
+    int n = read(m_sgi, msg->msg, buf_len);
+    if (n <= 0) {
+      if (n < 0 and errno != EAGAIN and errno != EWOULDBLOCK) {
+        m_logger.error("Error reading from TUN interface: %s", strerror(errno));
+        nof_pdus = (nof_pdus == 0) ? -1 : nof_pdus;
+      }
+      break;
+    }
+    msg->N_bytes = n;
+    handle_sgi_pdu(std::move(msg));
+  }
+  flush_s1u_pdus();
+  return nof_pdus;
+}
+
+int spgw::gtpu::handle_s1u_burst()
+{
+  size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  for (uint32_t i = 0; i < MAX_BURST_SIZE; ++i) {
+    m_rx_pdus[i]->clear();
+    m_rx_iovs[i].iov_base           = m_rx_pdus[i]->msg;
+    m_rx_iovs[i].iov_len            = buf_len;
+    m_rx_hdrs[i]                    = {};
+    m_rx_hdrs[i].msg_hdr.msg_iov    = &m_rx_iovs[i];
+    m_rx_hdrs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n = recvmmsg(m_s1u, m_rx_hdrs.data(), MAX_BURST_SIZE, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno == EAGAIN or errno == EWOULDBLOCK) {
+      return 0;
+    }
+    m_logger.error("Error reading from S1-U socket: %s", strerror(errno));
+    return -1;
+  }
+
+  // TUN devices take a single packet per write(), so the burst is forwarded with back-to-back writes
+  for (int i = 0; i < n; ++i) {
+    m_rx_pdus[i]->N_bytes = m_rx_hdrs[i].msg_len;
+    handle_s1u_pdu(m_rx_pdus[i].get());
+  }
+  return n;
+}
+
 void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
 {
-  bool usr_found = false;
-  bool ctr_found = false;
-
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  struct iphdr* iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -225,39 +296,34 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   }
 
   // Logging PDU info
-  m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
-  fmt::memory_buffer buffer;
-  srsran::gtpu_ntoa(buffer, iph->saddr);
-  m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
-  buffer.clear();
-  srsran::gtpu_ntoa(buffer, iph->daddr);
-  m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+  if (m_logger.debug.enabled()) {
+    m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
+    fmt::memory_buffer buffer;
+    srsran::gtpu_ntoa(buffer, iph->saddr);
+    m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
+    buffer.clear();
+    srsran::gtpu_ntoa(buffer, iph->daddr);
+    m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+  }
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
-  }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+  auto tunnel_it = m_ip_to_tunnel.find(iph->daddr);
+  if (tunnel_it == m_ip_to_tunnel.end()) {
+    m_logger.debug("Packet for unknown UE.");
+    return;
   }
+  const ue_tunnel_t& tunnel = tunnel_it->second;
 
   // Handle SGi packet
-  if (usr_found == false && ctr_found == false) {
-    m_logger.debug("Packet for unknown UE.");
-  } else if (usr_found == false && ctr_found == true) {
+  if (not tunnel.usr_present) {
     m_logger.debug("Packet for attached UE that is not ECM connected.");
     m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
-    return;
-  } else if (usr_found == true && ctr_found == false) {
+    m_gtpc->send_downlink_data_notification(tunnel.ctr_teid);
+    m_gtpc->queue_downlink_packet(tunnel.ctr_teid, std::move(msg));
+  } else if (not tunnel.ctr_present) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    send_s1u_pdu(tunnel.usr_fteid, std::move(msg));
   }
 }
 
@@ -277,13 +343,18 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::unique_byte_buffer_t msg)
 {
+  if (m_nof_tx_pdus == MAX_BURST_SIZE) {
+    flush_s1u_pdus();
+  }
+
   // Set eNB destination address
-  struct sockaddr_in enb_addr;
-  enb_addr.sin_family      = AF_INET;
-  enb_addr.sin_port        = htons(GTPU_RX_PORT);
-  enb_addr.sin_addr.s_addr = enb_fteid.ipv4;
+  struct sockaddr_in& enb_addr = m_tx_addrs[m_nof_tx_pdus];
+  enb_addr                     = {};
+  enb_addr.sin_family          = AF_INET;
+  enb_addr.sin_port            = htons(GTPU_RX_PORT);
+  enb_addr.sin_addr.s_addr     = enb_fteid.ipv4;
 
   // Setup GTP-U header
   srsran::gtpu_header_t header;
@@ -293,26 +364,59 @@ void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer
   header.teid         = enb_fteid.teid;
 
   m_logger.debug("User plane tunnel found SGi PDU. Forwarding packet to S1-U.");
-  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
+  if (m_logger.debug.enabled()) {
+    m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
+  }
 
   // Write header into packet
-  int n;
-  if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
+  if (!srsran::gtpu_write_header(&header, msg.get(), m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
+    return;
   }
 
-  // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
-  if (n < 0) {
-    m_logger.error("Error sending packet to eNB");
-  } else if ((unsigned int)n != msg->N_bytes) {
-    m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
+  // Queue packet. It is sent in the next flush_s1u_pdus()
+  m_tx_iovs[m_nof_tx_pdus].iov_base = msg->msg;
+  m_tx_iovs[m_nof_tx_pdus].iov_len  = msg->N_bytes;
+  m_tx_pdus[m_nof_tx_pdus]          = std::move(msg);
+  m_nof_tx_pdus++;
+}
+
+void spgw::gtpu::flush_s1u_pdus()
+{
+  if (m_nof_tx_pdus == 0) {
+    return;
   }
 
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
+  for (uint32_t i = 0; i < m_nof_tx_pdus; ++i) {
+    m_tx_hdrs[i]                     = {};
+    m_tx_hdrs[i].msg_hdr.msg_name    = &m_tx_addrs[i];
+    m_tx_hdrs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    m_tx_hdrs[i].msg_hdr.msg_iov     = &m_tx_iovs[i];
+    m_tx_hdrs[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  // Send packets to destination. sendmmsg() stops at the first packet that fails, which is then skipped.
+  uint32_t nof_sent = 0;
+  while (nof_sent < m_nof_tx_pdus) {
+    int n = sendmmsg(m_s1u, &m_tx_hdrs[nof_sent], m_nof_tx_pdus - nof_sent, 0);
+    if (n <= 0) {
+      m_logger.error("Error sending packet to eNB: %s", strerror(errno));
+      m_tx_hdrs[nof_sent].msg_len = m_tx_iovs[nof_sent].iov_len;
+      n                           = 1;
+    }
+    nof_sent += n;
+  }
+
+  for (uint32_t i = 0; i < m_nof_tx_pdus; ++i) {
+    if (m_tx_hdrs[i].msg_len != m_tx_iovs[i].iov_len) {
+      m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%zd",
+                     m_tx_hdrs[i].msg_len,
+                     m_tx_iovs[i].iov_len);
+    }
+    m_tx_pdus[i].reset();
+  }
+  m_logger.debug("Deallocated %d packets after sending S1-U messages", m_nof_tx_pdus);
+  m_nof_tx_pdus = 0;
 }
 
 void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
@@ -320,11 +424,10 @@ void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t
 {
   m_logger.debug("Sending all queued packets");
   while (!pkt_queue.empty()) {
-    srsran::unique_byte_buffer_t msg = std::move(pkt_queue.front());
-    send_s1u_pdu(dw_user_fteid, msg.get());
+    send_s1u_pdu(dw_user_fteid, std::move(pkt_queue.front()));
     pkt_queue.pop();
   }
-  return;
+  flush_s1u_pdus();
 }
 
 /*
@@ -340,32 +443,41 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  ue_tunnel_t& tunnel = m_ip_to_tunnel[ue_ipv4];
+  tunnel.usr_present = true;
+  tunnel.usr_fteid   = dw_user_fteid;
+  tunnel.ctr_present = true;
+  tunnel.ctr_teid    = up_ctrl_teid;
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  auto tunnel_it = m_ip_to_tunnel.find(ue_ipv4);
+  if (tunnel_it == m_ip_to_tunnel.end() or not tunnel_it->second.usr_present) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
+  tunnel_it->second.usr_present = false;
+  if (not tunnel_it->second.ctr_present) {
+    m_ip_to_tunnel.erase(ue_ipv4);
+  }
   return true;
 }
 
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  auto tunnel_it = m_ip_to_tunnel.find(ue_ipv4);
+  if (tunnel_it == m_ip_to_tunnel.end() or not tunnel_it->second.ctr_present) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
+  tunnel_it->second.ctr_present = false;
+  if (not tunnel_it->second.usr_present) {
+    m_ip_to_tunnel.erase(ue_ipv4);
+  }
   return true;
 }
 
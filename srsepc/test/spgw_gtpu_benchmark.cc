@@ -0,0 +1,420 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * SP-GW user-plane throughput benchmark.
+ *
+ * Runs the SP-GW GTP-U entity with a local TUN device (SGi) and an S1-U socket on the loopback interface, and forwards
+ * traffic through it:
+ *  - Downlink: UDP packets are sent to the UE IPs, routed by the kernel to the TUN device, and received as GTP-U PDUs
+ *    by a dummy eNB socket.
+ *  - Uplink: the dummy eNB sends GTP-U PDUs to the S1-U socket, which are written to the TUN device and received by a
+ *    UDP socket bound to the SGi address.
+ *
+ * Creating the TUN device requires CAP_NET_ADMIN. Without it, the benchmark is skipped.
+ */
+
+#include "srsepc/hdr/spgw/gtpu.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <getopt.h>
+#include <linux/if_tun.h>
+#include <linux/ip.h>
+#include <net/if.h>
+#include <netinet/udp.h>
+#include <sys/ioctl.h>
+#include <thread>
+
+using namespace srsepc;
+
+namespace {
+
+const uint16_t SGI_SINK_PORT = 9001;
+const uint16_t UE_PORT       = 9000;
+
+struct bench_args_t {
+  uint32_t    nof_ues     = 16;
+  uint32_t    nof_pdus    = 200000;
+  uint32_t    pdu_len     = 1400;
+  std::string sgi_if_name = "srs_spgw_bench";
+  std::string sgi_if_addr = "172.16.250.1";
+  std::string s1u_addr    = "127.0.1.1";
+  std::string enb_addr    = "127.0.1.2";
+} args;
+
+class gtpc_dummy : public gtpc_interface_gtpu
+{
+public:
+  bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override { return false; }
+  bool send_downlink_data_notification(uint32_t spgw_ctr_teid) override { return false; }
+};
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Counts datagrams received on a socket until "stop" is set
+struct rx_counter {
+  std::atomic<uint32_t> count{0};
+  std::atomic<bool>     stop{false};
+  std::atomic<int64_t>  last_rx_ns{0};
+  std::thread           thread;
+  std::vector<uint8_t>  buffer = std::vector<uint8_t>(SRSRAN_MAX_BUFFER_SIZE_BYTES);
+
+  void start(int fd)
+  {
+    thread = std::thread([this, fd]() {
+      while (not stop) {
+        if (recv(fd, buffer.data(), buffer.size(), 0) > 0) {
+          count++;
+          last_rx_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now().time_since_epoch())
+                           .count();
+        }
+      }
+    });
+  }
+  void join()
+  {
+    stop = true;
+    thread.join();
+  }
+};
+
+int open_udp_socket(const char* addr, uint16_t port)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    perror("socket");
+    return -1;
+  }
+  int rcvbuf = 8 * 1024 * 1024;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  struct timeval tv = {0, 100000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  sockaddr_in bind_addr = {};
+  if (not srsran::net_utils::set_sockaddr(&bind_addr, addr, port) or
+      bind(fd, (sockaddr*)&bind_addr, sizeof(bind_addr)) < 0) {
+    fprintf(stderr, "Failed to bind socket to %s:%d: %s\n", addr, port, strerror(errno));
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+in_addr_t ue_ip(uint32_t ue_idx)
+{
+  return htonl(ntohl(inet_addr(args.sgi_if_addr.c_str())) + 1 + ue_idx);
+}
+
+uint16_t ip_checksum(const uint16_t* data, size_t len)
+{
+  uint32_t sum = 0;
+  for (size_t i = 0; i < len / 2; ++i) {
+    sum += data[i];
+  }
+  while (sum >> 16U) {
+    sum = (sum & 0xffffU) + (sum >> 16U);
+  }
+  return (uint16_t)~sum;
+}
+
+/// Builds an uplink GTP-U PDU carrying an IPv4/UDP packet from the given UE to the SGi sink socket
+void build_ul_pdu(srsran::byte_buffer_t* pdu, uint32_t ue_idx)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("BENCH");
+  uint32_t              ip_len = std::max(args.pdu_len, (uint32_t)(sizeof(iphdr) + sizeof(udphdr)));
+  pdu->clear();
+  pdu->N_bytes = ip_len;
+  memset(pdu->msg, 0xab, ip_len);
+
+  iphdr* iph    = (iphdr*)pdu->msg;
+  iph->version  = 4;
+  iph->ihl      = 5;
+  iph->tos      = 0;
+  iph->tot_len  = htons(ip_len);
+  iph->id       = 0;
+  iph->frag_off = 0;
+  iph->ttl      = 64;
+  iph->protocol = IPPROTO_UDP;
+  iph->check    = 0;
+  iph->saddr    = ue_ip(ue_idx);
+  iph->daddr    = inet_addr(args.sgi_if_addr.c_str());
+  iph->check    = ip_checksum((uint16_t*)iph, sizeof(iphdr));
+
+  udphdr* udph = (udphdr*)(pdu->msg + sizeof(iphdr));
+  udph->source = htons(UE_PORT);
+  udph->dest   = htons(SGI_SINK_PORT);
+  udph->len    = htons(ip_len - sizeof(iphdr));
+  udph->check  = 0;
+
+  srsran::gtpu_header_t header = {};
+  header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  header.message_type          = GTPU_MSG_DATA_PDU;
+  header.length                = pdu->N_bytes;
+  header.teid                  = 0x1000 + ue_idx;
+  srsran::gtpu_write_header(&header, pdu, logger);
+}
+
+/// Waits until no more packets are received, and returns the time of the last received packet
+bench_clock::time_point wait_rx_idle(rx_counter& counter, uint32_t nof_pdus)
+{
+  uint32_t prev_count = counter.count;
+  do {
+    prev_count = counter.count;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  } while (counter.count != prev_count and counter.count < nof_pdus);
+  return bench_clock::time_point(std::chrono::nanoseconds(counter.last_rx_ns.load()));
+}
+
+void print_result(const char* dir, uint32_t nof_sent, uint32_t nof_rx, bench_clock::duration elapsed)
+{
+  double elapsed_s = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() * 1e-6;
+  if (elapsed_s <= 0) {
+    elapsed_s = 1e-6;
+  }
+  printf("%s: sent=%d, forwarded=%d (%.1f%%), %.1f kpps, %.1f Mbps\n",
+         dir,
+         nof_sent,
+         nof_rx,
+         100.0 * nof_rx / std::max(nof_sent, 1U),
+         nof_rx / elapsed_s / 1e3,
+         nof_rx * args.pdu_len * 8 / elapsed_s / 1e6);
+}
+
+/// Returns the number of PDUs forwarded in downlink
+uint32_t run_dl(int enb_fd)
+{
+  int tx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (tx_fd < 0) {
+    perror("socket");
+    return 0;
+  }
+  std::vector<uint8_t>     payload(args.pdu_len - sizeof(iphdr) - sizeof(udphdr), 0xcd);
+  std::vector<sockaddr_in> ue_addrs(args.nof_ues);
+  for (uint32_t i = 0; i < args.nof_ues; ++i) {
+    ue_addrs[i].sin_family      = AF_INET;
+    ue_addrs[i].sin_port        = htons(UE_PORT);
+    ue_addrs[i].sin_addr.s_addr = ue_ip(i);
+  }
+
+  rx_counter counter;
+  counter.start(enb_fd);
+  bench_clock::time_point tstart   = bench_clock::now();
+  uint32_t                nof_sent = 0;
+  for (uint32_t i = 0; i < args.nof_pdus; ++i) {
+    const sockaddr_in& addr = ue_addrs[i % args.nof_ues];
+    if (sendto(tx_fd, payload.data(), payload.size(), 0, (const sockaddr*)&addr, sizeof(addr)) > 0) {
+      nof_sent++;
+    }
+  }
+  bench_clock::time_point tend = wait_rx_idle(counter, nof_sent);
+  counter.join();
+  print_result("DL", nof_sent, counter.count, tend - tstart);
+  close(tx_fd);
+  return counter.count;
+}
+
+/// Returns the number of PDUs forwarded in uplink
+uint32_t run_ul(int enb_fd, int sink_fd)
+{
+  std::vector<srsran::unique_byte_buffer_t> pdus(args.nof_ues);
+  for (uint32_t i = 0; i < args.nof_ues; ++i) {
+    pdus[i] = srsran::make_byte_buffer();
+    build_ul_pdu(pdus[i].get(), i);
+  }
+  sockaddr_in s1u_addr = {};
+  srsran::net_utils::set_sockaddr(&s1u_addr, args.s1u_addr.c_str(), GTPU_RX_PORT);
+
+  rx_counter counter;
+  counter.start(sink_fd);
+  bench_clock::time_point tstart   = bench_clock::now();
+  uint32_t                nof_sent = 0;
+  for (uint32_t i = 0; i < args.nof_pdus; ++i) {
+    srsran::byte_buffer_t* pdu = pdus[i % args.nof_ues].get();
+    if (sendto(enb_fd, pdu->msg, pdu->N_bytes, 0, (const sockaddr*)&s1u_addr, sizeof(s1u_addr)) > 0) {
+      nof_sent++;
+    }
+  }
+  bench_clock::time_point tend = wait_rx_idle(counter, nof_sent);
+  counter.join();
+  print_result("UL", nof_sent, counter.count, tend - tstart);
+  return counter.count;
+}
+
+/// Checks whether a TUN device can be created, i.e. whether the process has CAP_NET_ADMIN
+bool tun_available()
+{
+  int fd = open("/dev/net/tun", O_RDWR);
+  if (fd < 0) {
+    return false;
+  }
+  // The kernel picks the device name, and removes the non-persistent device when the descriptor is closed
+  struct ifreq ifr = {};
+  ifr.ifr_flags    = IFF_TUN | IFF_NO_PI;
+  bool ret         = ioctl(fd, TUNSETIFF, &ifr) == 0;
+  close(fd);
+  return ret;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nplsiue]\n", prog);
+  printf("\t-n Number of UEs [Default %d]\n", args.nof_ues);
+  printf("\t-p Number of PDUs per direction [Default %d]\n", args.nof_pdus);
+  printf("\t-l IP packet length in bytes [Default %d]\n", args.pdu_len);
+  printf("\t-s SGi interface name [Default %s]\n", args.sgi_if_name.c_str());
+  printf("\t-i SGi interface address [Default %s]\n", args.sgi_if_addr.c_str());
+  printf("\t-u S1-U bind address [Default %s]\n", args.s1u_addr.c_str());
+  printf("\t-e Dummy eNB address [Default %s]\n", args.enb_addr.c_str());
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nplsiue")) != -1) {
+    switch (opt) {
+      case 'n':
+        args.nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        args.nof_pdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        args.pdu_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        args.sgi_if_name = argv[optind];
+        break;
+      case 'i':
+        args.sgi_if_addr = argv[optind];
+        break;
+      case 'u':
+        args.s1u_addr = argv[optind];
+        break;
+      case 'e':
+        args.enb_addr = argv[optind];
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (args.nof_ues == 0 or args.pdu_len < sizeof(iphdr) + sizeof(udphdr) or
+      args.pdu_len > SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - 16) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+} // namespace
+
+namespace srsepc {
+
+/// Drives the SP-GW GTP-U entity, which is private to spgw
+class spgw_gtpu_benchmark
+{
+public:
+  static int run()
+  {
+    spgw_args_t spgw_args      = {};
+    spgw_args.gtpu_bind_addr   = args.s1u_addr;
+    spgw_args.sgi_if_addr      = args.sgi_if_addr;
+    spgw_args.sgi_if_name      = args.sgi_if_name;
+    spgw_args.max_paging_queue = 0;
+
+    gtpc_dummy gtpc;
+    spgw::gtpu gtpu;
+    if (gtpu.init(&spgw_args, nullptr, &gtpc) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Failed to initialize the SP-GW GTP-U. Note: creating the TUN device requires CAP_NET_ADMIN\n");
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t i = 0; i < args.nof_ues; ++i) {
+      srsran::gtp_fteid_t enb_fteid = {};
+      enb_fteid.teid                = 0x100 + i;
+      enb_fteid.ipv4                = inet_addr(args.enb_addr.c_str());
+      gtpu.modify_gtpu_tunnel(ue_ip(i), enb_fteid, 0x1000 + i);
+    }
+
+    int enb_fd  = open_udp_socket(args.enb_addr.c_str(), GTPU_RX_PORT);
+    int sink_fd = open_udp_socket(args.sgi_if_addr.c_str(), SGI_SINK_PORT);
+    if (enb_fd < 0 or sink_fd < 0) {
+      gtpu.stop();
+      return SRSRAN_ERROR;
+    }
+
+    // SP-GW user-plane loop, as in spgw::run_thread()
+    std::atomic<bool> running{true};
+    std::thread       spgw_thread([&gtpu, &running]() {
+      int sgi    = gtpu.get_sgi();
+      int s1u    = gtpu.get_s1u();
+      int max_fd = std::max(sgi, s1u);
+      while (running) {
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(sgi, &set);
+        FD_SET(s1u, &set);
+        struct timeval tv = {0, 100000};
+        if (select(max_fd + 1, &set, NULL, NULL, &tv) > 0) {
+          if (FD_ISSET(sgi, &set)) {
+            gtpu.handle_sgi_burst();
+          }
+          if (FD_ISSET(s1u, &set)) {
+            gtpu.handle_s1u_burst();
+          }
+        }
+      }
+    });
+
+    printf("SP-GW user-plane benchmark: %d UEs, %d PDUs of %d bytes\n", args.nof_ues, args.nof_pdus, args.pdu_len);
+    uint32_t nof_dl = run_dl(enb_fd);
+    uint32_t nof_ul = run_ul(enb_fd, sink_fd);
+
+    running = false;
+    spgw_thread.join();
+    close(enb_fd);
+    close(sink_fd);
+    gtpu.stop();
+    srslog::flush();
+    return (nof_dl > 0 and nof_ul > 0) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  }
+};
+
+} // namespace srsepc
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  if (not tun_available()) {
+    printf("Cannot create a TUN device (CAP_NET_ADMIN required), skipping benchmark\n");
+    return SRSRAN_SUCCESS;
+  }
+
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  return spgw_gtpu_benchmark::run();
+}
@@ -26,6 +26,7 @@
 #include "srsran/adt/span.h"
 extern "C" {
 #include "srsran/phy/common/phy_common_nr.h"
+#include "srsran/phy/fec/cbsegm.h"
 #include "srsran/phy/fec/softbuffer.h"
 #include "srsran/phy/phch/sch_nr.h"
 #include "srsran/phy/utils/vector.h"
@@ -84,6 +85,11 @@ public:
     // Note: for now we use same size regardless of nof_prb_
     srsran_softbuffer_rx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
   }
+  /// Code blocks are leased from the shared pool only while the HARQ process is active
+  rx_harq_softbuffer(srsran_softbuffer_pool_t* pool, uint32_t max_cb)
+  {
+    srsran_softbuffer_rx_init_pool(&buffer, pool, max_cb);
+  }
   rx_harq_softbuffer(const rx_harq_softbuffer&) = delete;
   rx_harq_softbuffer(rx_harq_softbuffer&& other) noexcept
   {
@@ -103,7 +109,20 @@ public:
   ~rx_harq_softbuffer() { destroy(); }
 
   void reset() { srsran_softbuffer_rx_reset(&buffer); }
-  void reset(uint32_t tbs_bits) { srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits); }
+  bool reset(uint32_t tbs_bits) { return srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits) == SRSRAN_SUCCESS; }
+  /// Resets (or leases) exactly the LDPC code blocks of a transport block with the given size and target code rate
+  bool reset(uint32_t tbs_bits, double R)
+  {
+    srsran_cbsegm_t cbsegm = {};
+    int             ret    = (srsran_sch_nr_select_basegraph(tbs_bits, R) == BG1)
+                                 ? srsran_cbsegm_ldpc_bg1(&cbsegm, tbs_bits)
+                                 : srsran_cbsegm_ldpc_bg2(&cbsegm, tbs_bits);
+    if (ret < SRSRAN_SUCCESS) {
+      return false;
+    }
+    return srsran_softbuffer_rx_reset_cb(&buffer, cbsegm.C) == SRSRAN_SUCCESS;
+  }
+  void release() { srsran_softbuffer_rx_release(&buffer); }
 
   srsran_softbuffer_rx_t&       operator*() { return buffer; }
   const srsran_softbuffer_rx_t& operator*() const { return buffer; }
@@ -126,11 +145,19 @@ public:
   harq_softbuffer_pool& operator=(const harq_softbuffer_pool&) = delete;
   harq_softbuffer_pool& operator=(harq_softbuffer_pool&&) = delete;
 
-  void init_pool(uint32_t nof_prb, uint32_t batch_size = MAX_HARQ * 4, uint32_t thres = 0, uint32_t init_size = 0);
+  /// rx_pool_cb code blocks are shared by the Rx softbuffers of this bandwidth, 0 allocates them per softbuffer
+  void init_pool(uint32_t nof_prb,
+                 uint32_t rx_pool_cb = 0,
+                 uint32_t batch_size = MAX_HARQ * 4,
+                 uint32_t thres      = 0,
+                 uint32_t init_size  = 0);
 
   srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx(uint32_t nof_prb);
   srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx(uint32_t nof_prb);
 
+  /// Usage of the code blocks shared by the Rx softbuffers of a given bandwidth
+  void get_rx_metrics(uint32_t nof_prb, srsran_softbuffer_pool_metrics_t& metrics);
+
   static harq_softbuffer_pool& get_instance()
   {
     static harq_softbuffer_pool pool;
@@ -142,7 +169,16 @@ private:
 
   harq_softbuffer_pool() = default;
 
+  struct cb_pool_deleter {
+    void operator()(srsran_softbuffer_pool_t* p)
+    {
+      srsran_softbuffer_pool_free(p);
+      delete p;
+    }
+  };
+
   std::array<std::unique_ptr<srsran::obj_pool_itf<tx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> tx_pool;
+  std::array<std::unique_ptr<srsran_softbuffer_pool_t, cb_pool_deleter>, SRSRAN_MAX_PRB_NR> rx_cb_pool;
   std::array<std::unique_ptr<srsran::obj_pool_itf<rx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> rx_pool;
 };
 
@@ -57,6 +57,7 @@ public:
 
   bool clear_if_maxretx(slot_point slot_rx);
   void reset();
+  void cancel_new_tx();
   bool new_retx(slot_point slot_tx, slot_point slot_ack);
 
   // NOTE: Has to be used before first tx is dispatched
@@ -127,6 +128,42 @@ public:
     softbuffer->reset(tbs);
     return harq_proc::set_tbs(tbs);
   }
+  /// Sets the TBS and leases the softbuffer code blocks that the PUSCH decoder will need for it. Returns false if the
+  /// code blocks could not be leased, in which case the grant has to be dropped
+  bool set_tbs(const srsran_sch_tb_t& tb)
+  {
+    if (not softbuffer->reset(tb.tbs, tb.R)) {
+      return false;
+    }
+    return harq_proc::set_tbs(tb.tbs);
+  }
+
+  /// Undoes a new_tx() whose grant could not be scheduled, and gives back the code blocks leased by set_tbs()
+  void cancel_new_tx()
+  {
+    harq_proc::cancel_new_tx();
+    softbuffer->release();
+  }
+
+  /// A TB dropped after its last retransmission does not need its code blocks anymore
+  bool clear_if_maxretx(slot_point slot_rx)
+  {
+    if (not harq_proc::clear_if_maxretx(slot_rx)) {
+      return false;
+    }
+    softbuffer->release();
+    return true;
+  }
+
+  /// Feedback from the decoder. A decoded TB does not need its code blocks anymore
+  int crc_info(bool crc)
+  {
+    int ret = ack_info(0, crc);
+    if (crc and ret >= SRSRAN_SUCCESS) {
+      softbuffer->release();
+    }
+    return ret;
+  }
 
 private:
   void fill_dci(srsran_dci_ul_nr_t& dci);
@@ -141,7 +178,7 @@ public:
   void new_slot(slot_point slot_rx_);
 
   int dl_ack_info(uint32_t pid, uint32_t tb_idx, bool ack) { return dl_harqs[pid].ack_info(tb_idx, ack); }
-  int ul_crc_info(uint32_t pid, bool ack) { return ul_harqs[pid].ack_info(0, ack); }
+  int ul_crc_info(uint32_t pid, bool ack) { return ul_harqs[pid].crc_info(ack); }
 
   uint32_t            nof_dl_harqs() const { return dl_harqs.size(); }
   uint32_t            nof_ul_harqs() const { return ul_harqs.size(); }
@@ -117,12 +117,13 @@ public:
 
   ///// Configuration /////
   struct sched_args_t {
-    bool        pdsch_enabled      = true;
-    bool        pusch_enabled      = true;
-    bool        auto_refill_buffer = false;
-    int         fixed_dl_mcs       = 28;
-    int         fixed_ul_mcs       = 28;
-    std::string logger_name        = "MAC-NR";
+    bool        pdsch_enabled         = true;
+    bool        pusch_enabled         = true;
+    bool        auto_refill_buffer    = false;
+    int         fixed_dl_mcs          = 28;
+    int         fixed_ul_mcs          = 28;
+    uint32_t    ul_softbuffer_pool_cb = 0; // UL code blocks per bandwidth, shared by all cells, 0 for per-HARQ buffers
+    std::string logger_name           = "MAC-NR";
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
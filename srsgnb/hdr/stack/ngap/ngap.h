@@ -154,6 +154,9 @@ private:
   // PCAP
   srsran::ngap_pcap* pcap = nullptr;
 
+  // Storage of the containers of the last received PDU
+  asn1::unpack_arena rx_pdu_arena;
+
   class user_list
   {
   public:
@@ -24,11 +24,24 @@
 
 namespace srsenb {
 
-void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint32_t thres, uint32_t init_size)
+/// Upper bound of the number of code blocks of an UL transport block, assuming all the REs of a slot carry 256-QAM
+/// symbols of 4 layers
+static uint32_t max_ul_cb(uint32_t nof_prb)
+{
+  uint32_t max_bits = nof_prb * SRSRAN_NRE * SRSRAN_NSYMB_PER_SLOT_NR * 8 * 4;
+  return SRSRAN_MIN(max_bits / (SRSRAN_LDPC_BG1_MAX_LEN_CB - 24) + 1, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC);
+}
+
+void harq_softbuffer_pool::init_pool(uint32_t nof_prb,
+                                     uint32_t rx_pool_cb,
+                                     uint32_t batch_size,
+                                     uint32_t thres,
+                                     uint32_t init_size)
 {
   srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid nof prb=%d", nof_prb);
   size_t idx = nof_prb - 1;
   if (tx_pool[idx] != nullptr) {
+    // The pools are per bandwidth, so cells with the same number of PRBs share them
     return;
   }
   if (thres == 0) {
@@ -42,8 +55,25 @@ void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint
   tx_pool[idx].reset(new srsran::background_obj_pool<tx_harq_softbuffer>(
       batch_size, thres, init_size, init_tx_softbuffers, recycle_tx_softbuffers));
 
-  auto init_rx_softbuffers    = [nof_prb](void* ptr) { new (ptr) rx_harq_softbuffer(nof_prb); };
   auto recycle_rx_softbuffers = [](rx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
+  if (rx_pool_cb == 0) {
+    auto init_rx_softbuffers = [nof_prb](void* ptr) { new (ptr) rx_harq_softbuffer(nof_prb); };
+    rx_pool[idx].reset(new srsran::background_obj_pool<rx_harq_softbuffer>(
+        batch_size, thres, init_size, init_rx_softbuffers, recycle_rx_softbuffers));
+    return;
+  }
+
+  // The Rx softbuffers lease their code blocks from a pool of fixed size, however many softbuffers get created. The
+  // LDPC decoder works with 8-bit LLRs, so the pool stores them as 8-bit too
+  uint32_t max_cb = max_ul_cb(nof_prb);
+  rx_cb_pool[idx].reset(new srsran_softbuffer_pool_t{});
+  int ret = srsran_softbuffer_pool_init(
+      rx_cb_pool[idx].get(), rx_pool_cb, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, SRSRAN_SOFTBUFFER_LLR_8BIT);
+  srsran_always_assert(ret == SRSRAN_SUCCESS, "Failed to allocate Rx softbuffer pool for Nprb=%d", nof_prb);
+  srsran_softbuffer_pool_t* cb_pool             = rx_cb_pool[idx].get();
+  auto                      init_rx_softbuffers = [cb_pool, max_cb](void* ptr) {
+    new (ptr) rx_harq_softbuffer(cb_pool, max_cb);
+  };
   rx_pool[idx].reset(new srsran::background_obj_pool<rx_harq_softbuffer>(
       batch_size, thres, init_size, init_rx_softbuffers, recycle_rx_softbuffers));
 }
@@ -68,4 +98,13 @@ srsran::unique_pool_ptr<rx_harq_softbuffer> harq_softbuffer_pool::get_rx(uint32_
   return rx_pool[idx]->make();
 }
 
+void harq_softbuffer_pool::get_rx_metrics(uint32_t nof_prb, srsran_softbuffer_pool_metrics_t& metrics)
+{
+  srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
+  metrics = {};
+  if (rx_cb_pool[nof_prb - 1] != nullptr) {
+    srsran_softbuffer_pool_get_metrics(rx_cb_pool[nof_prb - 1].get(), &metrics);
+  }
+}
+
 } // namespace srsenb
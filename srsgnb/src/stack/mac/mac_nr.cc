@@ -20,6 +20,7 @@
  */
 
 #include "srsgnb/hdr/stack/mac/mac_nr.h"
+#include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsgnb/hdr/stack/mac/sched_nr.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/phy_cfg_nr_default.h"
@@ -287,6 +288,26 @@ void mac_nr::get_metrics_nolock(srsenb::mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].pci : 0;
   }
+
+  // The UL code block pools are per bandwidth, so cells sharing a bandwidth count their pool once
+  metrics.ul_softbuffer_pool = {};
+  for (auto it = cell_config.begin(); it != cell_config.end(); ++it) {
+    uint32_t nof_prb = it->dl_cell_nof_prb;
+    if (std::any_of(cell_config.begin(), it, [nof_prb](const sched_nr_cell_cfg_t& c) {
+          return c.dl_cell_nof_prb == nof_prb;
+        })) {
+      continue;
+    }
+    srsran_softbuffer_pool_metrics_t m = {};
+    harq_softbuffer_pool::get_instance().get_rx_metrics(nof_prb, m);
+    metrics.ul_softbuffer_pool.nof_cb += m.nof_cb;
+    metrics.ul_softbuffer_pool.nof_cb_used += m.nof_cb_used;
+    metrics.ul_softbuffer_pool.nof_cb_peak += m.nof_cb_peak;
+    metrics.ul_softbuffer_pool.nof_leases += m.nof_leases;
+    metrics.ul_softbuffer_pool.nof_lease_fail += m.nof_lease_fail;
+    metrics.ul_softbuffer_pool.nof_bytes += m.nof_bytes;
+    metrics.ul_softbuffer_pool.nof_bytes_used += m.nof_bytes_used;
+  }
 }
 
 int mac_nr::cell_cfg(const std::vector<srsenb::sched_nr_cell_cfg_t>& nr_cells)
@@ -278,7 +278,18 @@ alloc_result bwp_slot_allocator::alloc_rar_and_msg3(uint16_t
     success = ue->phy().get_pusch_cfg(slot_cfg, rar_grant.msg3_dci, pusch.sch);
     srsran_assert(success, "Error converting DCI to PUSCH grant");
     pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
-    ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs);
+    if (not ue.h_ul->set_tbs(pusch.sch.grant.tb[0])) {
+      // Postpone the whole RAR, as the UL softbuffer pool cannot hold the Msg3 of this UE
+      logger.warning("SCHED: Cannot allocate Msg3 for rnti=0x%x due to lack of UL softbuffers", ue->rnti);
+      for (const dl_sched_rar_info_t& alloc_grant : pending_rachs.subspan(0, rar_out.grants.size())) {
+        slot_ues[alloc_grant.temp_crnti].h_ul->cancel_new_tx();
+        bwp_msg3_slot.puschs.cancel_last_pusch();
+      }
+      bwp_pdcch_slot.dl.rar.pop_back();
+      bwp_pdcch_slot.pdschs.cancel_last_pdsch();
+      bwp_pdcch_slot.pdcchs.cancel_last_pdcch();
+      return alloc_result::no_grant_space;
+    }
   }
 
   return alloc_result::success;
@@ -475,7 +486,14 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
   srsran_assert(success, "Error converting DCI to PUSCH grant");
   pusch.sch.grant.tb[0].softbuffer.rx = ue.h_ul->get_softbuffer().get();
   if (ue.h_ul->nof_retx() == 0) {
-    ue.h_ul->set_tbs(pusch.sch.grant.tb[0].tbs); // update HARQ with correct TBS
+    // update HARQ with correct TBS
+    if (not ue.h_ul->set_tbs(pusch.sch.grant.tb[0])) {
+      logger.warning("SCHED: Cannot allocate PUSCH for rnti=0x%x due to lack of UL softbuffers", ue->rnti);
+      ue.h_ul->cancel_new_tx();
+      bwp_pusch_slot.puschs.cancel_last_pusch();
+      bwp_pdcch_slot.pdcchs.cancel_last_pdcch();
+      return alloc_result::no_grant_space;
+    }
   } else {
     srsran_assert(pusch.sch.grant.tb[0].tbs == (int)ue.h_ul->tbs(), "The TBS did not remain constant in retx");
   }
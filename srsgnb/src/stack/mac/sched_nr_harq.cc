@@ -55,6 +55,13 @@ void harq_proc::reset()
   tb[0].tbs       = std::numeric_limits<uint32_t>::max();
 }
 
+/// Undoes a new_tx() whose grant could not be scheduled. The NDI is restored so that the next new_tx() toggles it
+void harq_proc::cancel_new_tx()
+{
+  reset();
+  tb[0].ndi = !tb[0].ndi;
+}
+
 bool harq_proc::new_tx(slot_point       slot_tx_,
                        slot_point       slot_ack_,
                        const prb_grant& grant,
@@ -222,7 +229,7 @@ void harq_entity::new_slot(slot_point slot_rx_)
                   dl_h.max_nof_retx());
     }
   }
-  for (harq_proc& ul_h : ul_harqs) {
+  for (ul_harq_proc& ul_h : ul_harqs) {
     if (ul_h.clear_if_maxretx(slot_rx)) {
       logger.info("SCHED: discarding rnti=0x%x, UL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
                   rnti,
@@ -35,7 +35,7 @@ cc_worker::cc_worker(const cell_config_manager& params) :
   }
 
   // Pre-allocate HARQs in common pool of softbuffers
-  harq_softbuffer_pool::get_instance().init_pool(cfg.nof_prb());
+  harq_softbuffer_pool::get_instance().init_pool(cfg.nof_prb(), cfg.sched_args.ul_softbuffer_pool_cb);
 }
 
 void cc_worker::dl_rach_info(const sched_nr_interface::rar_info_t& rar_info)
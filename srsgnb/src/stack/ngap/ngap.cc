@@ -403,10 +403,12 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
   }
 
   // Unpack
+  // The PDU of the previous call has been destroyed, so its arena memory can be reused
+  rx_pdu_arena.reset();
   ngap_pdu_c     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (asn1::unpack_with_arena(rx_pdu, bref, rx_pdu_arena) != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;